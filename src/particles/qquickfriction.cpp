@@ -74,28 +74,44 @@ static const qreal epsilon = 0.00001;
 QQuickFrictionAffector::QQuickFrictionAffector(QQuickItem *parent) :
     QQuickParticleAffector(parent), m_factor(0.0), m_threshold(0.0)
 {
+    m_batched = true;
+    m_threadSafe = true;
 }
 
-bool QQuickFrictionAffector::affectParticle(QQuickParticleData *d, qreal dt)
+void QQuickFrictionAffector::affectBatch(QQuickParticleBatch &batch, int from, int to, qreal dt)
 {
     if (!m_factor)
-        return false;
-    qreal curVX = d->curVX();
-    qreal curVY = d->curVY();
-    if (!curVX && !curVY)
-        return false;
-    qreal newVX = curVX + (curVX * m_factor * -1 * dt);
-    qreal newVY = curVY + (curVY * m_factor * -1 * dt);
+        return;
 
     if (!m_threshold) {
-        if (sign(curVX) != sign(newVX))
-            newVX = 0;
-        if (sign(curVY) != sign(newVY))
-            newVY = 0;
-    } else {
+        //A component which would change sign stops instead
+        const float scale = qMax<qreal>(0.0, 1.0 - m_factor * dt) - 1.0f;
+        for (int i = from; i < to; ++i) {
+            if (!batch.active[i])
+                continue;
+            float curVX = batch.vxAt(i);
+            float curVY = batch.vyAt(i);
+            if (!curVX && !curVY)
+                continue;
+            batch.accelerate(i, curVX * scale, curVY * scale);
+            batch.affected[i] = true;
+        }
+        return;
+    }
+
+    for (int i = from; i < to; ++i) {
+        if (!batch.active[i])
+            continue;
+        qreal curVX = batch.vxAt(i);
+        qreal curVY = batch.vyAt(i);
+        if (!curVX && !curVY)
+            continue;
+        qreal newVX = curVX + (curVX * m_factor * -1 * dt);
+        qreal newVY = curVY + (curVY * m_factor * -1 * dt);
+
         qreal curMag = sqrt(curVX*curVX + curVY*curVY);
         if (curMag <= m_threshold + epsilon)
-            return false;
+            continue;
         qreal newMag = sqrt(newVX*newVX + newVY*newVY);
         if (newMag <= m_threshold + epsilon || //went past the threshold, stop there instead
             sign(curVX) != sign(newVX) || //went so far past maybe it came out the other side!
@@ -104,10 +120,10 @@ bool QQuickFrictionAffector::affectParticle(QQuickParticleData *d, qreal dt)
             newVX = m_threshold * cos(theta);
             newVY = m_threshold * sin(theta);
         }
-    }
 
-    d->setInstantaneousVX(newVX);
-    d->setInstantaneousVY(newVY);
-    return true;
+        batch.accelerate(i, newVX - curVX, newVY - curVY);
+        batch.affected[i] = true;
+    }
 }
+
 QT_END_NAMESPACE
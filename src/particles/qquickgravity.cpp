@@ -80,20 +80,33 @@ const qreal CONV = 0.017453292520444443;
 QQuickGravityAffector::QQuickGravityAffector(QQuickItem *parent) :
     QQuickParticleAffector(parent), m_magnitude(-10), m_angle(90), m_needRecalc(true)
 {
+    m_batched = true;
+    m_threadSafe = true;
 }
 
-bool QQuickGravityAffector::affectParticle(QQuickParticleData *d, qreal dt)
+void QQuickGravityAffector::affectSystem(qreal dt)
 {
-    if (!m_magnitude)
-        return false;
+    //Not in affectBatch, which may run on several threads at once
     if (m_needRecalc) {
         m_needRecalc = false;
         m_dx = m_magnitude * cos(m_angle * CONV);
         m_dy = m_magnitude * sin(m_angle * CONV);
     }
+    QQuickParticleAffector::affectSystem(dt);
+}
+
+void QQuickGravityAffector::affectBatch(QQuickParticleBatch &batch, int from, int to, qreal dt)
+{
+    if (!m_magnitude)
+        return;
 
-    d->setInstantaneousVX(d->curVX() + m_dx*dt);
-    d->setInstantaneousVY(d->curVY() + m_dy*dt);
-    return true;
+    const float dvx = m_dx * dt;
+    const float dvy = m_dy * dt;
+    for (int i = from; i < to; ++i) {
+        if (!batch.active[i])
+            continue;
+        batch.accelerate(i, dvx, dvy);
+        batch.affected[i] = true;
+    }
 }
 QT_END_NAMESPACE
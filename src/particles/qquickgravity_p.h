@@ -62,8 +62,10 @@ public:
     {
         return m_angle;
     }
+
+    virtual void affectSystem(qreal dt);
 protected:
-    virtual bool affectParticle(QQuickParticleData *d, qreal dt);
+    virtual void affectBatch(QQuickParticleBatch &batch, int from, int to, qreal dt);
 signals:
 
     void magnitudeChanged(qreal arg);
@@ -41,9 +41,61 @@
 
 #include "qquickparticleaffector_p.h"
 #include <QDebug>
+#include <QtCore/qrunnable.h>
+#include <QtCore/qsemaphore.h>
+#include <QtCore/qthread.h>
+#include <QtCore/qthreadpool.h>
 #include <private/qqmlglobal_p.h>
 QT_BEGIN_NAMESPACE
 
+//Thread safe affectors split large batches into ranges of at least this many particles, one per thread.
+//QML_PARTICLES_THREADS limits the number of threads used, including the GUI thread. 1 disables it.
+static const int minimumRangeSize = 1024;
+
+class QQuickParticleThreadPool : public QThreadPool
+{
+public:
+    QQuickParticleThreadPool()
+    {
+        bool ok = false;
+        int threads = qgetenv("QML_PARTICLES_THREADS").toInt(&ok);
+        setThreadCount(ok && threads > 0 ? threads : QThread::idealThreadCount());
+    }
+
+    void setThreadCount(int count)
+    {
+        threadCount = qMax(1, count);
+        //The GUI thread works on one of the ranges itself
+        setMaxThreadCount(qMax(1, threadCount - 1));
+    }
+
+    int threadCount;
+};
+
+Q_GLOBAL_STATIC(QQuickParticleThreadPool, particleThreadPool)
+
+class QQuickParticleBatchJob : public QRunnable
+{
+public:
+    QQuickParticleBatchJob(QQuickParticleAffector *affector, int from, int to, qreal dt, QSemaphore *done)
+        : affector(affector), from(from), to(to), dt(dt), done(done)
+    {
+    }
+
+    void run()
+    {
+        affector->affectBatch(affector->m_batch, from, to, dt);
+        done->release();
+    }
+
+private:
+    QQuickParticleAffector *affector;
+    int from;
+    int to;
+    qreal dt;
+    QSemaphore *done;
+};
+
 /*!
     \qmltype Affector
     \instantiates QQuickParticleAffector
@@ -131,6 +183,7 @@ QT_BEGIN_NAMESPACE
 */
 QQuickParticleAffector::QQuickParticleAffector(QQuickItem *parent) :
     QQuickItem(parent), m_needsReset(false), m_ignoresTime(false), m_onceOff(false), m_enabled(true)
+    , m_batched(false), m_threadSafe(false)
     , m_system(0), m_updateIntSet(false), m_shape(new QQuickParticleExtruder(this))
 {
 }
@@ -199,6 +252,32 @@ void QQuickParticleAffector::affectSystem(qreal dt)
     updateOffsets();//### Needed if an ancestor is transformed.
     if (m_onceOff)
         dt = 1.0;
+    if (m_batched) {
+        foreach (QQuickParticleGroupData* gd, m_system->groupData) {
+            if (!activeGroup(m_system->groupData.key(gd)))
+                continue;
+            gatherBatch(gd);
+            if (!m_batch.count)
+                continue;
+            //Same time steps as below, taken by all the particles at once
+            qreal myDt = dt;
+            if (!m_ignoresTime && myDt < simulationCutoff) {
+                qreal back = myDt;
+                while (myDt > simulationDelta) {
+                    back -= simulationDelta;
+                    m_batch.prepareStep(back, true);
+                    affectBatchStep(simulationDelta);
+                    myDt -= simulationDelta;
+                }
+            }
+            if (myDt > 0.0) {
+                m_batch.prepareStep(0, false);
+                affectBatchStep(myDt);
+            }
+            commitBatch();
+        }
+        return;
+    }
     foreach (QQuickParticleGroupData* gd, m_system->groupData) {
         if (activeGroup(m_system->groupData.key(gd))) {
             foreach (QQuickParticleData* d, gd->data) {
@@ -231,6 +310,77 @@ bool QQuickParticleAffector::affectParticle(QQuickParticleData *, qreal )
     return true;
 }
 
+void QQuickParticleAffector::affectBatch(QQuickParticleBatch &batch, int from, int to, qreal)
+{
+    for (int i = from; i < to; ++i)
+        batch.affected[i] = batch.affected[i] || batch.active[i];
+}
+
+/*!
+    \internal
+    Returns the number of threads thread safe affectors spread a batch over,
+    including the GUI thread.
+*/
+int QQuickParticleAffector::threadCount()
+{
+    QQuickParticleThreadPool *pool = particleThreadPool();
+    return pool ? pool->threadCount : 1;
+}
+
+/*!
+    \internal
+    Spreads the batches of thread safe affectors over up to \a count threads,
+    including the GUI thread.  1 runs them on the GUI thread only.  The default
+    is the value of QML_PARTICLES_THREADS, or QThread::idealThreadCount().
+*/
+void QQuickParticleAffector::setThreadCount(int count)
+{
+    if (QQuickParticleThreadPool *pool = particleThreadPool())
+        pool->setThreadCount(count);
+}
+
+void QQuickParticleAffector::affectBatchStep(qreal dt)
+{
+    const int count = m_batch.count;
+    QQuickParticleThreadPool *pool = m_threadSafe ? particleThreadPool() : 0;
+    int ranges = 1;
+    if (pool && pool->threadCount > 1)
+        ranges = qMin(pool->threadCount, count / minimumRangeSize);
+
+    if (ranges <= 1) {
+        affectBatch(m_batch, 0, count, dt);
+        return;
+    }
+
+    //Results are all in m_batch, and only committed once every range is done
+    QSemaphore done;
+    const int rangeSize = (count + ranges - 1) / ranges;
+    for (int i = 1; i < ranges; ++i)
+        pool->start(new QQuickParticleBatchJob(this, i * rangeSize, qMin(count, (i + 1) * rangeSize), dt, &done));
+    affectBatch(m_batch, 0, rangeSize, dt);
+    done.acquire(ranges - 1);
+}
+
+void QQuickParticleAffector::gatherBatch(QQuickParticleGroupData* gd)
+{
+    qreal time = m_system->timeInt / 1000.0;
+    m_batch.reserve(gd->data.count());
+    m_batch.clear();
+    foreach (QQuickParticleData* d, gd->data)
+        if (shouldAffect(d))
+            m_batch.append(d, time);
+}
+
+void QQuickParticleAffector::commitBatch()
+{
+    for (int i = 0; i < m_batch.count; ++i) {
+        if (m_batch.affected[i]) {
+            m_batch.commit(i);
+            postAffect(m_batch.data[i]);
+        }
+    }
+}
+
 void QQuickParticleAffector::reset(QQuickParticleData* pd)
 {//TODO: This, among other ones, should be restructured so they don't all need to remember to call the superclass
     if (m_onceOff)
@@ -48,7 +48,7 @@
 
 QT_BEGIN_NAMESPACE
 
-class QQuickParticleAffector : public QQuickItem
+class Q_AUTOTEST_EXPORT QQuickParticleAffector : public QQuickItem
 {
     Q_OBJECT
     Q_PROPERTY(QQuickParticleSystem* system READ system WRITE setSystem NOTIFY systemChanged)
@@ -62,6 +62,8 @@ public:
     explicit QQuickParticleAffector(QQuickItem *parent = 0);
     virtual void affectSystem(qreal dt);
     virtual void reset(QQuickParticleData*);//As some store their own data per particle?
+    static int threadCount();
+    static void setThreadCount(int count);
     QQuickParticleSystem* system() const
     {
         return m_system;
@@ -164,17 +166,25 @@ public slots:
 
 protected:
     friend class QQuickParticleSystem;
+    friend class QQuickParticleBatchJob;
     virtual bool affectParticle(QQuickParticleData *d, qreal dt);
+    //Used instead of affectParticle if m_batched is set. Sets batch.affected for the particles in [from, to) it changed.
+    virtual void affectBatch(QQuickParticleBatch &batch, int from, int to, qreal dt);
     bool m_needsReset:1;//### What is this really saving?
     bool m_ignoresTime:1;
     bool m_onceOff:1;
     bool m_enabled:1;
+    bool m_batched:1;
+    bool m_threadSafe:1;//affectBatch only touches its range of the batch, so ranges can run on different threads
 
     QQuickParticleSystem* m_system;
     QStringList m_groups;
     bool activeGroup(int g);
     bool shouldAffect(QQuickParticleData* datum);//Call to do the logic on whether it is affecting that datum
     void postAffect(QQuickParticleData* datum);//Call to do the post-affect logic on particles which WERE affected(once off, needs reset, affected signal)
+    void gatherBatch(QQuickParticleGroupData* gd);//Fills m_batch with the particles of the group which shouldAffect
+    void commitBatch();//Writes back and postAffects the particles in m_batch which were affected
+    void affectBatchStep(qreal dt);//Runs affectBatch over m_batch, split over several threads if m_threadSafe
     virtual void componentComplete();
     bool isAffectedConnected();
     static const qreal simulationDelta;
@@ -182,6 +192,7 @@ protected:
 
     QPointF m_offset;
     QSet<QPair<int, int> > m_onceOffed;
+    QQuickParticleBatch m_batch;
 private:
     QSet<int> m_groupIds;
     bool m_updateIntSet;
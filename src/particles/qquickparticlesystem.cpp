@@ -682,6 +682,79 @@ void QQuickParticleData::extendLife(float time)
     vy = evy;
 }
 
+QQuickParticleBatch::QQuickParticleBatch()
+    : count(0), back(0), data(0), t(0), lifeLeft(0), x(0), y(0), vx(0), vy(0), ax(0), ay(0)
+    , active(0), affected(0), m_capacity(0)
+{
+}
+
+void QQuickParticleBatch::reserve(int size)
+{
+    if (size <= m_capacity)
+        return;
+
+    //One allocation for all the attribute arrays, previous contents are not kept
+    m_capacity = size;
+    m_floats.resize(m_capacity * 8);
+    m_data.resize(m_capacity);
+    m_flags.resize(m_capacity * 2);
+
+    float* f = m_floats.data();
+    t = f;
+    lifeLeft = f + m_capacity;
+    x = f + m_capacity * 2;
+    y = f + m_capacity * 3;
+    vx = f + m_capacity * 4;
+    vy = f + m_capacity * 5;
+    ax = f + m_capacity * 6;
+    ay = f + m_capacity * 7;
+    data = m_data.data();
+    active = m_flags.data();
+    affected = m_flags.data() + m_capacity;
+    count = 0;
+}
+
+void QQuickParticleBatch::append(QQuickParticleData* d, qreal time)
+{
+    Q_ASSERT(count < m_capacity);
+    int i = count++;
+    qreal age = time - d->t;
+    data[i] = d;
+    t[i] = age;
+    lifeLeft[i] = d->t + d->lifeSpan - time;
+    x[i] = d->x + d->vx * age + 0.5 * d->ax * age * age;
+    y[i] = d->y + d->vy * age + 0.5 * d->ay * age * age;
+    vx[i] = d->vx + d->ax * age;
+    vy[i] = d->vy + d->ay * age;
+    ax[i] = d->ax;
+    ay[i] = d->ay;
+    affected[i] = false;
+}
+
+void QQuickParticleBatch::prepareStep(qreal back, bool checkAlive)
+{
+    this->back = back;
+    if (!checkAlive) {
+        memset(active, 1, count);
+        return;
+    }
+    for (int i = 0; i < count; ++i)
+        active[i] = (t[i] - back > EPSILON) && (lifeLeft[i] + back > EPSILON);
+}
+
+//Converts the instantaneous state back to the particle's parameters from the start of its life
+void QQuickParticleBatch::commit(int i)
+{
+    QQuickParticleData* d = data[i];
+    qreal age = t[i];
+    d->ax = ax[i];
+    d->ay = ay[i];
+    d->vx = vx[i] - age * ax[i];
+    d->vy = vy[i] - age * ay[i];
+    d->x = x[i] - age * d->vx - 0.5 * age * age * ax[i];
+    d->y = y[i] - age * d->vy - 0.5 * age * age * ay[i];
+}
+
 QQuickParticleSystem::QQuickParticleSystem(QQuickItem *parent) :
     QQuickItem(parent),
     stateEngine(0),
@@ -234,6 +234,68 @@ private:
     QQuickV8ParticleData* v8Datum;
 };
 
+//The kinematic state of a range of particles at the current system time, one contiguous array per attribute,
+//so that affectors can process whole groups in simple loops. Changes are written back with commit().
+class Q_AUTOTEST_EXPORT QQuickParticleBatch {
+public:
+    QQuickParticleBatch();
+
+    void clear() { count = 0; }
+    void reserve(int size);
+    void append(QQuickParticleData* d, qreal time);
+    void commit(int i);
+
+    //Starts a simulation step which lies back seconds before the current time. With checkAlive, only
+    //particles which were alive at that point are active.
+    void prepareStep(qreal back, bool checkAlive);
+
+    //State at the time of the current step
+    float xAt(int i) const { return x[i] - back * (vx[i] - 0.5f * back * ax[i]); }
+    float yAt(int i) const { return y[i] - back * (vy[i] - 0.5f * back * ay[i]); }
+    float vxAt(int i) const { return vx[i] - back * ax[i]; }
+    float vyAt(int i) const { return vy[i] - back * ay[i]; }
+
+    //Changes made at the time of the current step, carried forward to the current time
+    void move(int i, float dx, float dy) { x[i] += dx; y[i] += dy; }
+    void accelerate(int i, float dvx, float dvy)
+    {
+        vx[i] += dvx;
+        vy[i] += dvy;
+        x[i] += dvx * back;
+        y[i] += dvy * back;
+    }
+    void changeAcceleration(int i, float dax, float day)
+    {
+        ax[i] += dax;
+        ay[i] += day;
+        accelerate(i, dax * back, day * back);
+        x[i] -= 0.5f * dax * back * back;
+        y[i] -= 0.5f * day * back * back;
+    }
+
+    int count;
+    float back;
+
+    QQuickParticleData** data;
+    float* t;//Age at the current time
+    float* lifeLeft;
+    float* x;
+    float* y;
+    float* vx;
+    float* vy;
+    float* ax;
+    float* ay;
+    uchar* active;
+    uchar* affected;
+
+private:
+    Q_DISABLE_COPY(QQuickParticleBatch)
+    int m_capacity;
+    QVector<float> m_floats;
+    QVector<QQuickParticleData*> m_data;
+    QVector<uchar> m_flags;
+};
+
 class Q_AUTOTEST_EXPORT QQuickParticleSystem : public QQuickItem
 {
     Q_OBJECT
@@ -111,54 +111,61 @@ QQuickAttractorAffector::QQuickAttractorAffector(QQuickItem *parent) :
     QQuickParticleAffector(parent), m_strength(0.0), m_x(0), m_y(0)
   , m_physics(Velocity), m_proportionalToDistance(Linear)
 {
+    m_batched = true;
+    m_threadSafe = true;
 }
 
-bool QQuickAttractorAffector::affectParticle(QQuickParticleData *d, qreal dt)
+void QQuickAttractorAffector::affectBatch(QQuickParticleBatch &batch, int from, int to, qreal dt)
 {
     if (m_strength == 0.0)
-        return false;
-    qreal dx = m_x+m_offset.x() - d->curX();
-    qreal dy = m_y+m_offset.y() - d->curY();
-    qreal r = sqrt((dx*dx) + (dy*dy));
-    qreal theta = atan2(dy,dx);
-    qreal ds = 0;
-    switch (m_proportionalToDistance){
-    case InverseQuadratic:
-        ds = (m_strength / qMax<qreal>(1.,r*r));
-        break;
-    case InverseLinear:
-        ds = (m_strength / qMax<qreal>(1.,r));
-        break;
-    case Quadratic:
-        ds = (m_strength * qMax<qreal>(1.,r*r));
-        break;
-    case Linear:
-        ds = (m_strength * qMax<qreal>(1.,r));
-        break;
-    default: //also Constant
-        ds = m_strength;
+        return;
+    const qreal targetX = m_x + m_offset.x();
+    const qreal targetY = m_y + m_offset.y();
+    for (int i = from; i < to; ++i) {
+        if (!batch.active[i])
+            continue;
+        qreal dx = targetX - batch.xAt(i);
+        qreal dy = targetY - batch.yAt(i);
+        qreal r = sqrt((dx*dx) + (dy*dy));
+        qreal ds = 0;
+        switch (m_proportionalToDistance){
+        case InverseQuadratic:
+            ds = (m_strength / qMax<qreal>(1.,r*r));
+            break;
+        case InverseLinear:
+            ds = (m_strength / qMax<qreal>(1.,r));
+            break;
+        case Quadratic:
+            ds = (m_strength * qMax<qreal>(1.,r*r));
+            break;
+        case Linear:
+            ds = (m_strength * qMax<qreal>(1.,r));
+            break;
+        default: //also Constant
+            ds = m_strength;
+        }
+        ds *= dt;
+        //Along the direction to the target, without going through atan2, cos and sin
+        if (r > 0) {
+            dx = ds * dx / r;
+            dy = ds * dy / r;
+        } else {
+            dx = ds;
+            dy = 0;
+        }
+        switch (m_physics){
+        case Position:
+            batch.move(i, dx, dy);
+            break;
+        case Acceleration:
+            batch.changeAcceleration(i, dx, dy);
+            break;
+        case Velocity: //also default
+        default:
+            batch.accelerate(i, dx, dy);
+        }
+        batch.affected[i] = true;
     }
-    ds *= dt;
-    dx = ds * cos(theta);
-    dy = ds * sin(theta);
-    qreal vx,vy;
-    switch (m_physics){
-    case Position:
-        d->x = (d->x + dx);
-        d->y = (d->y + dy);
-        break;
-    case Acceleration:
-        d->setInstantaneousAX(d->ax + dx);
-        d->setInstantaneousAY(d->ay + dy);
-        break;
-    case Velocity: //also default
-    default:
-        vx = d->curVX();
-        vy = d->curVY();
-        d->setInstantaneousVX(vx + dx);
-        d->setInstantaneousVY(vy + dy);
-    }
-
-    return true;
 }
+
 QT_END_NAMESPACE
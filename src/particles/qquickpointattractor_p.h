@@ -151,7 +151,7 @@ void setProportionalToDistance(Proportion arg)
 }
 
 protected:
-    virtual bool affectParticle(QQuickParticleData *d, qreal dt);
+    virtual void affectBatch(QQuickParticleBatch &batch, int from, int to, qreal dt);
 private:
 qreal m_strength;
 qreal m_x;
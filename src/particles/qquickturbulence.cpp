@@ -84,6 +84,7 @@ QQuickTurbulenceAffector::QQuickTurbulenceAffector(QQuickItem *parent) :
     QQuickParticleAffector(parent),
     m_strength(10), m_lastT(0), m_gridSize(0), m_field(0), m_vectorField(0), m_inited(false)
 {
+    m_threadSafe = true;
 }
 
 void QQuickTurbulenceAffector::geometryChanged(const QRectF &, const QRectF &)
@@ -181,25 +182,28 @@ void QQuickTurbulenceAffector::affectSystem(qreal dt)
 
     updateOffsets();//### Needed if an ancestor is transformed.
 
-    QRect boundsRect(0,0,m_gridSize,m_gridSize);
     foreach (QQuickParticleGroupData *gd, m_system->groupData){
         if (!activeGroup(m_system->groupData.key(gd)))
             continue;
-        foreach (QQuickParticleData *d, gd->data){
-            if (!shouldAffect(d))
-                continue;
-            QPoint pos = (QPointF(d->curX(), d->curY()) - m_offset).toPoint();
-            if (!boundsRect.contains(pos,true))//Need to redo bounds checking due to quantization.
-                continue;
-            qreal fx = 0.0;
-            qreal fy = 0.0;
-            fx += m_vectorField[pos.x()][pos.y()].x() * m_strength;
-            fy += m_vectorField[pos.x()][pos.y()].y() * m_strength;
-            if (fx || fy){
-                d->setInstantaneousVX(d->curVX()+ fx * dt);
-                d->setInstantaneousVY(d->curVY()+ fy * dt);
-                postAffect(d);
-            }
+        gatherBatch(gd);
+        m_batch.prepareStep(0, false);
+        affectBatchStep(dt);
+        commitBatch();
+    }
+}
+
+void QQuickTurbulenceAffector::affectBatch(QQuickParticleBatch &batch, int from, int to, qreal dt)
+{
+    QRect boundsRect(0,0,m_gridSize,m_gridSize);
+    for (int i = from; i < to; ++i) {
+        QPoint pos = (QPointF(batch.x[i], batch.y[i]) - m_offset).toPoint();
+        if (!boundsRect.contains(pos,true))//Need to redo bounds checking due to quantization.
+            continue;
+        qreal fx = m_vectorField[pos.x()][pos.y()].x() * m_strength;
+        qreal fy = m_vectorField[pos.x()][pos.y()].y() * m_strength;
+        if (fx || fy){
+            batch.accelerate(i, fx * dt, fy * dt);
+            batch.affected[i] = true;
         }
     }
 }
@@ -95,6 +95,7 @@ public slots:
 protected:
     virtual void geometryChanged(const QRectF &newGeometry,
                                  const QRectF &oldGeometry);
+    virtual void affectBatch(QQuickParticleBatch &batch, int from, int to, qreal dt);
 private:
     void ensureInit();
     void mapUpdate();
@@ -86,6 +86,8 @@ QQuickWanderAffector::QQuickWanderAffector(QQuickItem *parent) :
     , m_affectedParameter(Velocity)
 {
     m_needsReset = true;
+    m_batched = true;
+    //Not thread safe, as qrand() would give each thread the same sequence
 }
 
 QQuickWanderAffector::~QQuickWanderAffector()
@@ -119,7 +121,7 @@ WanderData* QQuickWanderAffector::getData(int idx)
 //    m_wanderData.remove(systemIdx);
 //}
 
-bool QQuickWanderAffector::affectParticle(QQuickParticleData* data, qreal dt)
+void QQuickWanderAffector::affectBatch(QQuickParticleBatch &batch, int from, int to, qreal dt)
 {
     /*TODO: Add a mode which does basically this - picking a direction, going in it (random velocity) and then going back
     WanderData* d = getData(data->systemIndex);
@@ -148,36 +150,32 @@ bool QQuickWanderAffector::affectParticle(QQuickParticleData* data, qreal dt)
     p->y += dy;
     return true;
     */
-    qreal dx = dt * m_pace * (2 * qreal(qrand())/RAND_MAX - 1);
-    qreal dy = dt * m_pace * (2 * qreal(qrand())/RAND_MAX - 1);
-    qreal newX, newY;
-    switch (m_affectedParameter){
-    case Position:
-        newX = data->curX() + dx;
-        if (m_xVariance > qAbs(newX) )
-            data->x += dx;
-        newY = data->curY() + dy;
-        if (m_yVariance > qAbs(newY) )
-            data->y += dy;
-        break;
-    default:
-    case Velocity:
-        newX = data->curVX() + dx;
-        if (m_xVariance > qAbs(newX) )
-            data->setInstantaneousVX(newX);
-        newY = data->curVY() + dy;
-        if (m_yVariance > qAbs(newY) )
-            data->setInstantaneousVY(newY);
-        break;
-    case Acceleration:
-        newX = data->ax + dx;
-        if (m_xVariance > qAbs(newX) )
-            data->setInstantaneousAX(newX);
-        newY = data->ay + dy;
-        if (m_yVariance > qAbs(newY) )
-            data->setInstantaneousAY(newY);
-        break;
+    for (int i = from; i < to; ++i) {
+        if (!batch.active[i])
+            continue;
+
+        qreal dx = dt * m_pace * (2 * qreal(qrand())/RAND_MAX - 1);
+        qreal dy = dt * m_pace * (2 * qreal(qrand())/RAND_MAX - 1);
+        qreal newX, newY;
+        switch (m_affectedParameter){
+        case Position:
+            newX = batch.xAt(i) + dx;
+            newY = batch.yAt(i) + dy;
+            batch.move(i, m_xVariance > qAbs(newX) ? dx : 0, m_yVariance > qAbs(newY) ? dy : 0);
+            break;
+        default:
+        case Velocity:
+            newX = batch.vxAt(i) + dx;
+            newY = batch.vyAt(i) + dy;
+            batch.accelerate(i, m_xVariance > qAbs(newX) ? dx : 0, m_yVariance > qAbs(newY) ? dy : 0);
+            break;
+        case Acceleration:
+            newX = batch.ax[i] + dx;
+            newY = batch.ay[i] + dy;
+            batch.changeAcceleration(i, m_xVariance > qAbs(newX) ? dx : 0, m_yVariance > qAbs(newY) ? dy : 0);
+            break;
+        }
+        batch.affected[i] = true;
     }
-    return true;
 }
 QT_END_NAMESPACE
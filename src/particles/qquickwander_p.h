@@ -96,7 +96,7 @@ public:
     }
 
 protected:
-    virtual bool affectParticle(QQuickParticleData *d, qreal dt);
+    virtual void affectBatch(QQuickParticleBatch &batch, int from, int to, qreal dt);
 signals:
 
     void xVarianceChanged(qreal arg);
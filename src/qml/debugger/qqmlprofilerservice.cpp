@@ -82,6 +82,10 @@ QByteArray QQmlProfilerData::toByteArray() const
         case QQmlProfilerService::PixmapSizeKnown: ds << line << column; break;
         case QQmlProfilerService::PixmapReferenceCountChanged: ds << animationcount; break;
         case QQmlProfilerService::PixmapCacheCountChanged: ds << animationcount; break;
+        case QQmlProfilerService::PixmapCacheHit: ds << animationcount; break;
+        case QQmlProfilerService::PixmapCacheMiss: ds << animationcount; break;
+        case QQmlProfilerService::PixmapCacheEviction: ds << animationcount; break;
+        case QQmlProfilerService::PixmapDecoded: ds << animationcount; break;
         default: break;
         }
     }
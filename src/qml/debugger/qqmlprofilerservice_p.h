@@ -77,7 +77,7 @@ struct Q_AUTOTEST_EXPORT QQmlProfilerData
     int line;           //used by RangeLocation, also as "width" for pixmaps
     int column;         //used by RangeLocation, also as "height" for pixmaps
     int framerate;      //used by animation events
-    int animationcount; //used by animation events, also as "cache/reference count" for pixmaps
+    int animationcount; //used by animation events, also as "cache/reference/hit/miss/eviction count" and decoded bytes for pixmaps
     int bindingType;
 
     qint64 subtime_1;
@@ -147,6 +147,10 @@ public:
         PixmapLoadingStarted,
         PixmapLoadingFinished,
         PixmapLoadingError,
+        PixmapCacheHit,
+        PixmapCacheMiss,
+        PixmapCacheEviction,
+        PixmapDecoded,
 
         MaximumPixmapEventType
     };
@@ -372,6 +376,26 @@ struct QQmlPixmapProfiler {
             QQmlProfilerService::instance->pixmapEventImpl(QQmlProfilerService::PixmapSizeKnown, pixmapUrl, width, height);
         }
     }
+    void cacheHit(const QUrl &pixmapUrl, int hitCount) {
+        if (enabled) {
+            QQmlProfilerService::instance->pixmapEventImpl(QQmlProfilerService::PixmapCacheHit, pixmapUrl, hitCount);
+        }
+    }
+    void cacheMiss(const QUrl &pixmapUrl, int missCount) {
+        if (enabled) {
+            QQmlProfilerService::instance->pixmapEventImpl(QQmlProfilerService::PixmapCacheMiss, pixmapUrl, missCount);
+        }
+    }
+    void cacheEviction(const QUrl &pixmapUrl, int evictionCount) {
+        if (enabled) {
+            QQmlProfilerService::instance->pixmapEventImpl(QQmlProfilerService::PixmapCacheEviction, pixmapUrl, evictionCount);
+        }
+    }
+    void decoded(const QUrl &pixmapUrl, int byteCount) {
+        if (enabled) {
+            QQmlProfilerService::instance->pixmapEventImpl(QQmlProfilerService::PixmapDecoded, pixmapUrl, byteCount);
+        }
+    }
 
     bool enabled;
 };
@@ -15,6 +15,7 @@ SOURCES += \
     $$PWD/qqmlvme.cpp \
     $$PWD/qqmlcompiler.cpp \
     $$PWD/qqmlcompileddata.cpp \
+    $$PWD/qqmlinternpool.cpp \
     $$PWD/qqmlboundsignal.cpp \
     $$PWD/qqmlmetatype.cpp \
     $$PWD/qqmlstringconverters.cpp \
@@ -48,6 +49,7 @@ SOURCES += \
     $$PWD/qqmlglobal.cpp \
     $$PWD/qqmlfile.cpp \
     $$PWD/qqmlbundle.cpp \
+    $$PWD/qqmlcompilationcache.cpp \
     $$PWD/qqmlmemoryprofiler.cpp \
     $$PWD/qqmlplatform.cpp \
     $$PWD/qqmlbinding.cpp \
@@ -75,6 +77,7 @@ HEADERS += \
     $$PWD/qqmlproxymetaobject_p.h \
     $$PWD/qqmlvme_p.h \
     $$PWD/qqmlcompiler_p.h \
+    $$PWD/qqmlinternpool_p.h \
     $$PWD/qqmlengine_p.h \
     $$PWD/qqmlexpression_p.h \
     $$PWD/qqmlprivate.h \
@@ -120,6 +123,7 @@ HEADERS += \
     $$PWD/qqmlvaluetypeproxybinding_p.h \
     $$PWD/qqmlfile.h \
     $$PWD/qqmlbundle_p.h \
+    $$PWD/qqmlcompilationcache_p.h \
     $$PWD/qqmlmemoryprofiler_p.h \
     $$PWD/qqmlplatform_p.h \
     $$PWD/qqmlbinding_p.h \
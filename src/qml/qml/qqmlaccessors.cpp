@@ -104,4 +104,48 @@ void QQmlAccessorProperties::registerProperties(const QMetaObject *mo, int count
     This->properties.insert(mo, properties);
 }
 
+/*!
+\internal
+Finds the registered accessor property using \a accessors and \a data, and returns the name of
+its class in \a className and of the property itself in \a name.
+*/
+bool QQmlAccessorProperties::findProperty(QQmlAccessors *accessors, intptr_t data,
+                                          QByteArray *className, QByteArray *name)
+{
+    AccessorProperties *This = accessorProperties();
+
+    QReadLocker lock(&This->lock);
+    QHash<const QMetaObject *, Properties>::ConstIterator iter = This->properties.constBegin();
+    for (; iter != This->properties.constEnd(); ++iter) {
+        for (int ii = 0; ii < iter->count; ++ii) {
+            const Property &property = iter->properties[ii];
+            if (property.accessors == accessors && property.data == data) {
+                *className = iter.key()->className();
+                *name = QByteArray(property.name, property.nameLength);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/*!
+\internal
+Returns the accessor property \a name registered for the class \a className, or 0 if there is
+no such property.
+*/
+QQmlAccessorProperties::Property *
+QQmlAccessorProperties::property(const QByteArray &className, const QByteArray &name)
+{
+    AccessorProperties *This = accessorProperties();
+
+    QReadLocker lock(&This->lock);
+    QHash<const QMetaObject *, Properties>::Iterator iter = This->properties.begin();
+    for (; iter != This->properties.end(); ++iter) {
+        if (className == iter.key()->className())
+            return iter->property(name.constData());
+    }
+    return 0;
+}
+
 QT_END_NAMESPACE
@@ -134,6 +134,10 @@ namespace QQmlAccessorProperties {
 
     Properties properties(const QMetaObject *);
     void Q_QML_PRIVATE_EXPORT registerProperties(const QMetaObject *, int, Property *);
+
+    // Used by QQmlCompilationCache to persist accessors by name
+    bool findProperty(QQmlAccessors *, intptr_t, QByteArray *className, QByteArray *name);
+    Property *property(const QByteArray &className, const QByteArray &name);
 };
 
 QQmlAccessorProperties::Property *
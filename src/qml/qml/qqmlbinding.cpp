@@ -342,6 +342,16 @@ QString QQmlBinding::expressionIdentifier(QQmlJavaScriptExpression *e)
 void QQmlBinding::expressionChanged(QQmlJavaScriptExpression *e)
 {
     QQmlBinding *This = static_cast<QQmlBinding *>(e);
+
+    QQmlContextData *ctxt = This->context();
+    if (ctxt && ctxt->engine) {
+        QQmlEnginePrivate *ep = QQmlEnginePrivate::get(ctxt->engine);
+        if (ep->deferBindingUpdates) {
+            ep->deferBindingUpdate(This, This);
+            return;
+        }
+    }
+
     This->update();
 }
 
@@ -40,6 +40,9 @@
 ****************************************************************************/
 
 #include "qqmlbundle_p.h"
+#include <QtCore/qhash.h>
+#include <QtCore/qvector.h>
+#include <QtCore/qalgorithms.h>
 #include <iostream>
 #include <cstdlib>
 
@@ -54,10 +57,15 @@ QString QQmlBundle::FileEntry::fileName() const
     return QString((QChar *)&data[0], fileNameLength / sizeof(QChar));
 }
 
+static inline bool isFileName(const QQmlBundle::FileEntry *entry, const QChar *fileName, int length)
+{
+    return length * sizeof(QChar) == (unsigned)entry->fileNameLength &&
+           0 == ::memcmp(fileName, &entry->data[0], entry->fileNameLength);
+}
+
 bool QQmlBundle::FileEntry::isFileName(const QString &fileName) const
 {
-    return fileName.length() * sizeof(QChar) == (unsigned)fileNameLength &&
-           0 == ::memcmp(fileName.constData(), &data[0], fileNameLength);
+    return ::isFileName(this, fileName.constData(), fileName.length());
 }
 
 const char *QQmlBundle::FileEntry::contents() const {
@@ -77,6 +85,7 @@ QQmlBundle::QQmlBundle(const QString &fileName)
 : file(fileName),
   buffer(0),
   bufferSize(0),
+  index(0),
   opened(false),
   headerWritten(false)
 {
@@ -93,8 +102,7 @@ bool QQmlBundle::open(QIODevice::OpenMode mode)
         if (!file.open(mode))
             return false;
 
-        bufferSize = file.size();
-        buffer = file.map(0, bufferSize);
+        map();
 
         if (bufferSize == 0 ||
             (bufferSize >= 8 && 0 == ::memcmp(buffer, qmlBundleHeaderData, qmlBundleHeaderLength))) {
@@ -114,7 +122,10 @@ void QQmlBundle::close()
     if (opened) {
         opened = false;
         headerWritten = false;
+        index = 0;
         file.unmap(buffer);
+        buffer = 0;
+        bufferSize = 0;
         file.close();
     }
 }
@@ -135,6 +146,7 @@ QList<const QQmlBundle::FileEntry *> QQmlBundle::files() const
         }   break;
 
         case Entry::Link:
+        case Entry::Index:
         case Entry::Skip: {
             // Skip
         }   break;
@@ -195,7 +207,36 @@ const QQmlBundle::Entry *QQmlBundle::findInsertPoint(quint32 size, qint32 *offse
 
 const QQmlBundle::FileEntry *QQmlBundle::find(const QString &fileName) const
 {
-    const char *ptr = (const char *) buffer + qmlBundleHeaderLength;
+    return find(fileName.constData(), fileName.length());
+}
+
+//
+// Looks the file up in the index if there is one. Entries which were added
+// after the index was written are not covered by it and are searched linearly.
+//
+const QQmlBundle::FileEntry *QQmlBundle::find(const QChar *fileName, int length) const
+{
+    if (!index)
+        return findLinear((const char *) buffer + qmlBundleHeaderLength, fileName, length);
+
+    IndexRecord key;
+    key.hash = hashFileName(fileName, length);
+    key.offset = 0;
+
+    const IndexRecord *end = index->records + index->count;
+    const IndexRecord *record = qLowerBound(index->records, end, key);
+    for (; record != end && record->hash == key.hash; ++record) {
+        const FileEntry *fileEntry = reinterpret_cast<const FileEntry *>(buffer + record->offset);
+        // Removed files are turned into Skip entries but stay in the index
+        if (fileEntry->kind == Entry::File && isFileName(fileEntry, fileName, length))
+            return fileEntry;
+    }
+
+    return findLinear((const char *) buffer + index->indexedSize, fileName, length);
+}
+
+const QQmlBundle::FileEntry *QQmlBundle::findLinear(const char *ptr, const QChar *fileName, int length) const
+{
     const char *end = (const char *) buffer + bufferSize;
 
     while (ptr < end) {
@@ -204,7 +245,7 @@ const QQmlBundle::FileEntry *QQmlBundle::find(const QString &fileName) const
         if (cmd->kind == Entry::File) {
             const FileEntry *fileEntry = static_cast<const FileEntry *>(cmd);
 
-            if (fileEntry->isFileName(fileName))
+            if (isFileName(fileEntry, fileName, length))
                 return fileEntry;
         }
 
@@ -233,11 +274,6 @@ const QQmlBundle::FileEntry *QQmlBundle::link(const FileEntry *entry, const QStr
     return 0;
 }
 
-const QQmlBundle::FileEntry *QQmlBundle::find(const QChar *fileName, int length) const
-{
-    return find(QString::fromRawData(fileName, length));
-}
-
 bool QQmlBundle::add(const QString &name, const QString &fileName)
 {
     if (!file.isWritable())
@@ -316,3 +352,121 @@ bool QQmlBundle::addMetaLink(const QString &fileName,
     file.write((const char *) data.constData(), inputFileSize);
     return true;
 }
+
+quint32 QQmlBundle::hashFileName(const QChar *fileName, int length)
+{
+    // FNV-1a, the value is stored in the bundle so it must not change
+    quint32 h = 2166136261u;
+    for (int ii = 0; ii < length; ++ii) {
+        h ^= fileName[ii].unicode();
+        h *= 16777619u;
+    }
+    return h;
+}
+
+//
+// (Re)maps the whole file and picks up the index, if the bundle has one of
+// a version we understand.
+//
+bool QQmlBundle::map()
+{
+    if (buffer)
+        file.unmap(buffer);
+
+    index = 0;
+    bufferSize = file.size();
+    buffer = bufferSize ? file.map(0, bufferSize) : 0;
+    if (bufferSize && !buffer)
+        return false;
+
+    if (bufferSize >= qmlBundleHeaderLength + sizeof(IndexEntry)) {
+        const IndexEntry *cmd = reinterpret_cast<const IndexEntry *>(buffer + qmlBundleHeaderLength);
+        if (cmd->kind == Entry::Index
+                && cmd->version == IndexEntry::CurrentVersion
+                && cmd->indexedSize <= bufferSize
+                && sizeof(IndexEntry) + cmd->count * sizeof(IndexRecord) <= cmd->size)
+            index = cmd;
+    }
+    return true;
+}
+
+//
+// Rewrites the bundle with an index of all files right after the header.
+// Removed entries are dropped in the process. The bundle must be opened
+// for reading and writing.
+//
+bool QQmlBundle::writeIndex()
+{
+    if (!opened || !file.isReadable() || !file.isWritable())
+        return false;
+
+    file.flush();
+    if (!map())
+        return false;
+
+    QByteArray entries;
+    QHash<quint32, quint32> offsets; // old offset -> offset in entries
+    QVector<IndexRecord> records;
+
+    const char *ptr = (const char *) buffer + qmlBundleHeaderLength;
+    const char *end = (const char *) buffer + bufferSize;
+    while (ptr < end) {
+        const Entry *cmd = (const Entry *) ptr;
+        if (cmd->size == 0 || ptr + cmd->size > end)
+            return false;
+
+        if (cmd->kind == Entry::File || cmd->kind == Entry::Link) {
+            offsets.insert(ptr - (const char *) buffer, entries.size());
+            if (cmd->kind == Entry::File) {
+                const FileEntry *fileEntry = static_cast<const FileEntry *>(cmd);
+                IndexRecord record;
+                record.hash = hashFileName((const QChar *) &fileEntry->data[0],
+                                           fileEntry->fileNameLength / sizeof(QChar));
+                record.offset = entries.size();
+                records.append(record);
+            }
+            entries.append(ptr, cmd->size);
+        }
+
+        ptr += cmd->size;
+    }
+
+    const quint32 indexSize = sizeof(IndexEntry) + records.count() * sizeof(IndexRecord);
+    const quint32 base = qmlBundleHeaderLength + indexSize;
+
+    // Fix up the link chains for the new entry offsets
+    char *data = entries.data();
+    for (int offset = 0; offset < entries.size();) {
+        FileEntry *fileEntry = reinterpret_cast<FileEntry *>(data + offset);
+        if (fileEntry->link)
+            fileEntry->link = base + offsets.value(fileEntry->link);
+        offset += fileEntry->size;
+    }
+
+    for (int ii = 0; ii < records.count(); ++ii)
+        records[ii].offset += base;
+    qSort(records);
+
+    IndexEntry cmd;
+    cmd.kind = Entry::Index;
+    cmd.size = indexSize;
+    cmd.version = IndexEntry::CurrentVersion;
+    cmd.indexedSize = base + entries.size();
+    cmd.count = records.count();
+
+    file.unmap(buffer);
+    buffer = 0;
+    bufferSize = 0;
+    index = 0;
+
+    if (!file.resize(0) || !file.seek(0))
+        return false;
+    file.write((const char *)qmlBundleHeaderData, qmlBundleHeaderLength);
+    file.write((const char *) &cmd, sizeof(IndexEntry));
+    file.write((const char *) records.constData(), records.count() * sizeof(IndexRecord));
+    file.write(entries);
+    file.flush();
+    headerWritten = true;
+
+    return map() && index != 0;
+}
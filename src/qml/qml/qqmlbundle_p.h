@@ -62,9 +62,10 @@ public:
         enum Kind {
             File = 123, // Normal file
             Skip,       // Empty space
-            Link        // A meta data linked file
+            Link,       // A meta data linked file
+            Index       // Sorted file name index, directly after the header
 
-            // ### add entries for qmldir, index, ...
+            // ### add entries for qmldir, ...
         };
 
         int kind;
@@ -89,6 +90,24 @@ public:
         const char *contents() const;
     };
 
+    struct Q_QML_PRIVATE_EXPORT IndexRecord
+    {
+        quint32 hash;
+        quint32 offset; // from the start of the bundle
+
+        bool operator<(const IndexRecord &other) const { return hash < other.hash; }
+    };
+
+    struct Q_QML_PRIVATE_EXPORT IndexEntry : public Entry
+    {
+        enum { CurrentVersion = 1 };
+
+        quint32 version;
+        quint32 indexedSize; // bytes of the bundle covered by the index
+        quint32 count;
+        IndexRecord records[]; // sorted by hash
+    };
+
     QQmlBundle(const QString &fileName);
     ~QQmlBundle();
 
@@ -109,15 +128,22 @@ public:
 
     const FileEntry *link(const FileEntry *, const QString &linkName) const;
 
+    bool hasIndex() const { return index != 0; }
+    bool writeIndex();
+
     static int bundleHeaderLength();
     static bool isBundleHeader(const char *, int size);
+    static quint32 hashFileName(const QChar *fileName, int length);
 private:
     const Entry *findInsertPoint(quint32 size, qint32 *offset);
+    const FileEntry *findLinear(const char *ptr, const QChar *fileName, int length) const;
+    bool map();
 
 private:
     QFile file;
     uchar *buffer;
     quint32 bufferSize;
+    const IndexEntry *index;
     bool opened:1;
     bool headerWritten:1;
 };
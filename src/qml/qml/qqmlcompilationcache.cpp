@@ -0,0 +1,1143 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the QtQml module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qqmlcompilationcache_p.h"
+
+#include <private/qqmlcompiler_p.h>
+#include <private/qqmltypeloader_p.h>
+#include <private/qqmlengine_p.h>
+#include <private/qqmlmetatype_p.h>
+#include <private/qqmlaccessors_p.h>
+#include <private/qqmltypenamecache_p.h>
+#include <private/qqmlintegercache_p.h>
+#include <private/qqmlvme_p.h>
+#include <private/qv4bindings_p.h>
+#include <private/qv4instruction_p.h>
+#include <private/qv4program_p.h>
+
+#include <QtCore/qcryptographichash.h>
+#include <QtCore/qdatastream.h>
+#include <QtCore/qdir.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qmetaobject.h>
+#include <QtCore/qsavefile.h>
+#include <QtCore/qsysinfo.h>
+
+QT_BEGIN_NAMESPACE
+
+static const quint32 qml_cache_magic = 0x514d4c43; // "QMLC"
+static const quint32 qml_cache_version = 3;
+
+#define QML_CACHE_COUNT_INSTR(I, FMT) + 1
+static const int qml_instr_count = 0 FOR_EACH_QML_INSTR(QML_CACHE_COUNT_INSTR);
+static const int qml_v4_instr_count = 0 FOR_EACH_V4_INSTR(QML_CACHE_COUNT_INSTR);
+#undef QML_CACHE_COUNT_INSTR
+
+using QQmlJS::V4Instr;
+
+/*
+The cached bytecode contains raw instruction structs, so it can only be used by the build of the
+engine that wrote it.
+*/
+static QByteArray buildKey()
+{
+    QByteArray key(QT_VERSION_STR);
+    key += ' ' + QByteArray::number(QSysInfo::WordSize);
+    key += ' ' + QByteArray::number(QSysInfo::ByteOrder);
+    key += ' ' + QByteArray::number(qml_instr_count);
+    key += ' ' + QByteArray::number(int(sizeof(QQmlInstruction)));
+    key += ' ' + QByteArray::number(qml_v4_instr_count);
+    key += ' ' + QByteArray::number(int(sizeof(V4Instr)));
+    key += ' ' + QByteArray::number(int(sizeof(QV4Program)));
+    return key;
+}
+
+/*
+Cache files are shared by every copy of a document, wherever it is loaded from, so URLs on the
+same host as the document are stored relative to it.  An installed or resource deployed
+application resolves them against its own location.
+*/
+static QString relativeUrl(const QUrl &base, const QUrl &url)
+{
+    if (url.scheme() != base.scheme() || url.authority() != base.authority()
+        || url.hasQuery() || url.hasFragment() || url.path().endsWith(QLatin1Char('/'))) {
+        return url.toString();
+    }
+
+    QString basePath = base.path(QUrl::FullyEncoded);
+    basePath.truncate(basePath.lastIndexOf(QLatin1Char('/')) + 1);
+    QString path = QDir(basePath).relativeFilePath(url.path(QUrl::FullyEncoded));
+    if (!path.startsWith(QLatin1String("../")))
+        path.prepend(QLatin1String("./"));
+    return path;
+}
+
+static QUrl resolvedUrl(const QUrl &base, const QString &url)
+{
+    return base.resolved(QUrl(url));
+}
+
+static QDataStream &operator<<(QDataStream &out, const QQmlScript::Location &l)
+{
+    return out << l.line << l.column;
+}
+
+static QDataStream &operator>>(QDataStream &in, QQmlScript::Location &l)
+{
+    return in >> l.line >> l.column;
+}
+
+namespace {
+
+// The accessors of a fast property are function pointers, so properties that use them are
+// stored by name and resolved again when loaded.
+struct AccessorFixup
+{
+    qint32 data; // -1 for the bytecode, or an index into QQmlCompiledData::datas
+    qint32 offset; // Offset of the QQmlPropertyRawData
+    QByteArray className;
+    QByteArray name;
+};
+
+QDataStream &operator<<(QDataStream &out, const AccessorFixup &f)
+{
+    return out << f.data << f.offset << f.className << f.name;
+}
+
+QDataStream &operator>>(QDataStream &in, AccessorFixup &f)
+{
+    return in >> f.data >> f.offset >> f.className >> f.name;
+}
+
+struct CachedMethod
+{
+    QString name;
+    quint32 flags;
+    qint32 coreIndex;
+    QList<int> types;
+    QList<QByteArray> names;
+};
+
+struct CachedProperty
+{
+    QString name;
+    quint32 flags;
+    qint32 coreIndex;
+    qint32 propType;
+    qint32 notifyIndex;
+};
+
+}
+
+class QQmlCompilationCacheWriter
+{
+public:
+    QQmlCompilationCacheWriter(QQmlCompiledData *data, const QQmlTypeData *unit)
+    : data(data), unit(unit), engine(QQmlEnginePrivate::get(data->engine)) {}
+
+    bool write(QDataStream &);
+
+private:
+    bool writeTypes(QDataStream &);
+    bool writePropertyCache(QDataStream &, QQmlPropertyCache *);
+    bool writeContextCache(QDataStream &, QQmlIntegerCache *);
+    bool writeRootType(QDataStream &);
+
+    bool encodeBytecode(QByteArray &);
+    bool encodeV4Program(QByteArray &, int index);
+    bool encodeProperty(QQmlPropertyRawData *, int index, int offset);
+    bool addTypeId(int);
+    void addAttachedId(int);
+
+    QQmlCompiledData *data;
+    const QQmlTypeData *unit;
+    QQmlEnginePrivate *engine;
+
+    QList<AccessorFixup> fixups;
+    QList<int> typeIds;
+    QList<int> attachedIds;
+    QList<int> v4Programs;
+};
+
+class QQmlCompilationCacheReader
+{
+public:
+    QQmlCompilationCacheReader(QQmlCompiledData *data, const QQmlTypeData *unit)
+    : data(data), unit(unit), engine(QQmlEnginePrivate::get(data->engine)) {}
+
+    bool read(QDataStream &);
+
+private:
+    bool readTypes(QDataStream &);
+    bool readTypeIds(QDataStream &);
+    bool readPropertyCache(QDataStream &);
+    bool readRootType(QDataStream &);
+
+    bool decodeBytecode(QByteArray &);
+    bool decodeV4Program(QByteArray &);
+    bool decodeProperty(QByteArray &, const AccessorFixup &);
+
+    QQmlCompiledData *data;
+    const QQmlTypeData *unit;
+    QQmlEnginePrivate *engine;
+    QList<int> v4Programs;
+};
+
+bool QQmlCompilationCacheWriter::write(QDataStream &out)
+{
+    // Lazily compiled component bodies are not part of the bytecode
+    if (!data->lazyComponents.isEmpty())
+        return false;
+
+    if (!writeTypes(out))
+        return false;
+
+    QByteArray bytecode = data->bytecode;
+    QList<QByteArray> datas = data->datas;
+    if (!encodeBytecode(bytecode))
+        return false;
+    foreach (int index, v4Programs) {
+        if (!encodeV4Program(datas[index], index))
+            return false;
+    }
+
+    QByteArray caches;
+    QDataStream cachesOut(&caches, QIODevice::WriteOnly);
+    cachesOut << qint32(data->propertyCaches.count());
+    foreach (QQmlPropertyCache *cache, data->propertyCaches) {
+        if (!writePropertyCache(cachesOut, cache))
+            return false;
+    }
+    cachesOut << qint32(data->contextCaches.count());
+    foreach (QQmlIntegerCache *cache, data->contextCaches) {
+        if (!writeContextCache(cachesOut, cache))
+            return false;
+    }
+    if (!writeRootType(cachesOut))
+        return false;
+
+    // The meta type ids baked into the bytecode and property caches are only valid while they
+    // refer to the same types, which is checked before anything else is loaded
+    out << qint32(typeIds.count());
+    foreach (int id, typeIds) {
+        QUrl url = engine->compositeTypeUrl(id);
+        QByteArray name;
+        if (url.isEmpty()) {
+            name = QMetaType::typeName(id);
+            if (name.isEmpty())
+                return false;
+        }
+        out << qint32(id) << name << (url.isEmpty() ? QString() : relativeUrl(unit->finalUrl(), url));
+    }
+    out << qint32(attachedIds.count());
+    foreach (int id, attachedIds) {
+        QQmlType *type = QQmlMetaType::qmlTypeFromIndex(id);
+        if (!type || !type->attachedPropertiesType())
+            return false;
+        out << qint32(id) << QByteArray(type->attachedPropertiesType()->className());
+    }
+
+    QStringList urls;
+    foreach (const QUrl &url, data->urls)
+        urls << relativeUrl(unit->finalUrl(), url);
+    out << data->primitives << urls;
+    out << qint32(data->programs.count());
+    foreach (const QQmlCompiledData::V8Program &program, data->programs)
+        out << program.program;
+    out.writeRawData(caches.constData(), caches.size());
+    out << datas << bytecode << fixups << v4Programs;
+
+    return out.status() == QDataStream::Ok;
+}
+
+bool QQmlCompilationCacheWriter::writeTypes(QDataStream &out)
+{
+    const QList<QQmlTypeData::TypeReference> &resolvedTypes = unit->resolvedTypes();
+
+    // The resolved types come first, followed by any types the compiler added itself
+    out << qint32(data->types.count());
+    for (int ii = 0; ii < data->types.count(); ++ii) {
+        const QQmlCompiledData::TypeReference &ref = data->types.at(ii);
+        if (ii < resolvedTypes.count()) {
+            if (ref.type != resolvedTypes.at(ii).type && !ref.component)
+                return false;
+        } else {
+            if (!ref.type)
+                return false;
+            out << ref.type->qmlTypeName() << qint32(ref.type->majorVersion())
+                << qint32(ref.type->minorVersion());
+        }
+    }
+    return true;
+}
+
+bool QQmlCompilationCacheWriter::writePropertyCache(QDataStream &out, QQmlPropertyCache *cache)
+{
+    QQmlPropertyCache *parent = cache->parent();
+
+    int parentType = -1;
+    for (int ii = 0; parentType == -1 && ii < data->types.count(); ++ii) {
+        if (data->types.at(ii).propertyCache() == parent)
+            parentType = ii;
+    }
+
+    QByteArray parentClassName;
+    if (parentType == -1) {
+        // Grouped properties are based on the cache of the property type
+        const QMetaObject *mo = parent->metaObject();
+        if (!mo || parent->_ownMetaObject)
+            return false;
+        parentClassName = mo->className();
+        int id = QMetaType::type((parentClassName + '*').constData());
+        if (QMetaType::metaObjectForType(id) != mo || engine->cache(mo) != parent)
+            return false;
+    }
+
+    QByteArray classNamePrefix = cache->_dynamicClassName;
+    while (!classNamePrefix.isEmpty() && classNamePrefix.at(classNamePrefix.length() - 1) >= '0'
+           && classNamePrefix.at(classNamePrefix.length() - 1) <= '9')
+        classNamePrefix.chop(1);
+
+    QHash<const QQmlPropertyData *, QString> names;
+    for (QQmlPropertyCache::StringCache::ConstIterator iter = cache->stringCache.begin();
+         iter != cache->stringCache.end(); ++iter) {
+        names.insert((*iter).second, iter.key());
+    }
+
+    out << qint32(parentType) << parentClassName << classNamePrefix << cache->_defaultPropertyName;
+
+    const quint32 flagsMask = ~quint32(QQmlPropertyData::IsOverridden);
+
+    out << qint32(cache->methodIndexCache.count());
+    for (int ii = 0; ii < cache->methodIndexCache.count(); ++ii) {
+        const QQmlPropertyData *method = &cache->methodIndexCache.at(ii);
+        if (!names.contains(method))
+            return false;
+
+        QList<int> types;
+        QList<QByteArray> parameterNames;
+        QQmlPropertyCache::methodArguments(method, &types, &parameterNames);
+        if (method->isSignal()) {
+            foreach (int type, types) {
+                if (!addTypeId(type))
+                    return false;
+            }
+        }
+
+        out << names.value(method) << quint32(method->getFlags() & flagsMask)
+            << qint32(method->coreIndex) << types << parameterNames;
+    }
+
+    out << qint32(cache->propertyIndexCache.count());
+    for (int ii = 0; ii < cache->propertyIndexCache.count(); ++ii) {
+        const QQmlPropertyData *property = &cache->propertyIndexCache.at(ii);
+        if (!names.contains(property) || !addTypeId(property->propType))
+            return false;
+
+        out << names.value(property) << quint32(property->getFlags() & flagsMask)
+            << qint32(property->coreIndex) << qint32(property->propType)
+            << qint32(property->notifyIndex);
+    }
+
+    return true;
+}
+
+bool QQmlCompilationCacheWriter::writeContextCache(QDataStream &out, QQmlIntegerCache *cache)
+{
+    QStringList ids;
+    for (int ii = 0; ii < cache->count(); ++ii) {
+        QString id = cache->findId(ii);
+        if (id.isEmpty())
+            return false;
+        ids << id;
+    }
+    out << ids;
+    return true;
+}
+
+bool QQmlCompilationCacheWriter::writeRootType(QDataStream &out)
+{
+    qint32 rootCache = data->propertyCaches.indexOf(data->rootPropertyCache);
+    qint32 rootType = -1;
+    for (int ii = 0; rootType == -1 && ii < data->types.count(); ++ii) {
+        const QQmlCompiledData::TypeReference &ref = data->types.at(ii);
+        if (ref.propertyCache() != data->rootPropertyCache)
+            continue;
+        if (data->isRegisteredWithEngine ||
+            (ref.component ? ref.component->metaTypeId : ref.type->typeId()) == data->metaTypeId)
+            rootType = ii;
+    }
+
+    if (rootCache == -1 && rootType == -1)
+        return false;
+    if (!data->isRegisteredWithEngine && rootType == -1)
+        return false;
+
+    out << rootCache << rootType << data->isRegisteredWithEngine;
+    return true;
+}
+
+bool QQmlCompilationCacheWriter::encodeBytecode(QByteArray &bytecode)
+{
+    char *start = bytecode.data();
+    char *code = start;
+    char *end = start + bytecode.size();
+
+    while (code < end) {
+        QQmlInstruction *instr = reinterpret_cast<QQmlInstruction *>(code);
+        QQmlInstruction::Type type = data->instructionType(instr);
+
+        bool ok = true;
+        switch (type) {
+        case QQmlInstruction::Init:
+            if (instr->init.compiledBinding != -1 && !v4Programs.contains(instr->init.compiledBinding))
+                v4Programs << instr->init.compiledBinding;
+            break;
+        case QQmlInstruction::CreateSimpleObject:
+            instr->createSimple.create = 0;
+            break;
+        case QQmlInstruction::StoreBinding:
+        case QQmlInstruction::StoreV8Binding:
+            ok = encodeProperty(&instr->assignBinding.property, -1,
+                                reinterpret_cast<char *>(&instr->assignBinding.property) - start);
+            break;
+        case QQmlInstruction::StoreValueSource:
+            ok = encodeProperty(&instr->assignValueSource.property, -1,
+                                reinterpret_cast<char *>(&instr->assignValueSource.property) - start);
+            break;
+        case QQmlInstruction::StoreValueInterceptor:
+            ok = encodeProperty(&instr->assignValueInterceptor.property, -1,
+                                reinterpret_cast<char *>(&instr->assignValueInterceptor.property) - start);
+            break;
+        case QQmlInstruction::StoreV4Binding:
+            ok = addTypeId(instr->assignV4Binding.propType);
+            break;
+        case QQmlInstruction::AssignCustomType:
+            ok = addTypeId(instr->assignCustomType.type);
+            break;
+        case QQmlInstruction::FetchQList:
+            ok = addTypeId(instr->fetchQmlList.type);
+            break;
+        case QQmlInstruction::FetchValueType:
+        case QQmlInstruction::PopValueType:
+            ok = addTypeId(instr->fetchValue.type);
+            break;
+        case QQmlInstruction::FetchAttached:
+            addAttachedId(instr->fetchAttached.id);
+            break;
+        default:
+            break;
+        }
+        if (!ok)
+            return false;
+
+#ifdef QML_THREADED_VME_INTERPRETER
+        instr->common.code = reinterpret_cast<void *>(quintptr(type));
+#endif
+        code += QQmlInstruction::size(type);
+    }
+
+    return true;
+}
+
+bool QQmlCompilationCacheWriter::encodeV4Program(QByteArray &program, int index)
+{
+    if (program.size() < int(sizeof(QV4Program)))
+        return false;
+
+    char *start = program.data();
+    char *code = const_cast<char *>(reinterpret_cast<QV4Program *>(start)->instructions());
+    char *end = start + program.size();
+
+    QQmlJS::Bytecode bytecode;
+    while (code < end) {
+        V4Instr *instr = reinterpret_cast<V4Instr *>(code);
+        V4Instr::Type type = bytecode.instructionType(instr);
+
+        if (type == V4Instr::FetchAndSubscribe) {
+            if (!encodeProperty(&instr->fetchAndSubscribe.property, index,
+                                reinterpret_cast<char *>(&instr->fetchAndSubscribe.property) - start))
+                return false;
+        } else if (type == V4Instr::LoadAttached) {
+            addAttachedId(instr->attached.id);
+        }
+
+#ifdef QML_THREADED_INTERPRETER
+        instr->common.code = reinterpret_cast<void *>(quintptr(type));
+#endif
+        code += V4Instr::size(type);
+    }
+
+    return true;
+}
+
+bool QQmlCompilationCacheWriter::encodeProperty(QQmlPropertyRawData *property, int index, int offset)
+{
+    if (property->isFunction() || property->getFlags() & QQmlPropertyData::NotFullyResolved)
+        return false;
+
+    if (property->hasAccessors()) {
+        AccessorFixup fixup;
+        fixup.data = index;
+        fixup.offset = offset;
+        if (!QQmlAccessorProperties::findProperty(property->accessors, property->accessorData,
+                                                  &fixup.className, &fixup.name))
+            return false;
+        fixups << fixup;
+
+        property->accessors = 0;
+        property->accessorData = 0;
+    }
+
+    return addTypeId(property->propType);
+}
+
+bool QQmlCompilationCacheWriter::addTypeId(int id)
+{
+    if (id >= QMetaType::User && !typeIds.contains(id))
+        typeIds << id;
+    return true;
+}
+
+void QQmlCompilationCacheWriter::addAttachedId(int id)
+{
+    if (!attachedIds.contains(id))
+        attachedIds << id;
+}
+
+bool QQmlCompilationCacheReader::read(QDataStream &in)
+{
+    if (!readTypes(in) || !readTypeIds(in))
+        return false;
+
+    QStringList urls;
+    qint32 programCount;
+    in >> data->primitives >> urls >> programCount;
+    foreach (const QString &url, urls)
+        data->urls << resolvedUrl(unit->finalUrl(), url);
+    for (int ii = 0; in.status() == QDataStream::Ok && ii < programCount; ++ii) {
+        QByteArray program;
+        in >> program;
+        data->programs.append(QQmlCompiledData::V8Program(program, data));
+    }
+
+    qint32 cacheCount;
+    in >> cacheCount;
+    for (int ii = 0; ii < cacheCount; ++ii) {
+        if (!readPropertyCache(in))
+            return false;
+    }
+
+    in >> cacheCount;
+    for (int ii = 0; in.status() == QDataStream::Ok && ii < cacheCount; ++ii) {
+        QStringList ids;
+        in >> ids;
+
+        QQmlIntegerCache *cache = new QQmlIntegerCache();
+        cache->reserve(ids.count());
+        for (int jj = 0; jj < ids.count(); ++jj)
+            cache->add(ids.at(jj), jj);
+        data->contextCaches.append(cache);
+    }
+
+    if (!readRootType(in))
+        return false;
+
+    QList<AccessorFixup> fixups;
+    in >> data->datas >> data->bytecode >> fixups >> v4Programs;
+    if (in.status() != QDataStream::Ok)
+        return false;
+
+    if (!decodeBytecode(data->bytecode))
+        return false;
+    foreach (int index, v4Programs) {
+        if (index < 0 || index >= data->datas.count() || !decodeV4Program(data->datas[index]))
+            return false;
+    }
+    foreach (const AccessorFixup &fixup, fixups) {
+        if (fixup.data == -1) {
+            if (!decodeProperty(data->bytecode, fixup))
+                return false;
+        } else if (!v4Programs.contains(fixup.data) || !decodeProperty(data->datas[fixup.data], fixup)) {
+            return false;
+        }
+    }
+
+    // Built the same way as QQmlCompiler::compileTree()
+    data->importCache = unit->createImportCache();
+    foreach (const QQmlTypeData::ScriptReference &script, unit->resolvedScripts()) {
+        QQmlScriptData *scriptData = script.script->scriptData();
+        scriptData->addref();
+        data->scripts << scriptData;
+    }
+
+    data->squeeze();
+    return true;
+}
+
+bool QQmlCompilationCacheReader::readTypes(QDataStream &in)
+{
+    const QList<QQmlTypeData::TypeReference> &resolvedTypes = unit->resolvedTypes();
+
+    qint32 count;
+    in >> count;
+    if (in.status() != QDataStream::Ok || count < resolvedTypes.count())
+        return false;
+
+    for (int ii = 0; ii < count; ++ii) {
+        QQmlCompiledData::TypeReference ref;
+        if (ii < resolvedTypes.count()) {
+            const QQmlTypeData::TypeReference &tref = resolvedTypes.at(ii);
+            if (tref.typeData) {
+                ref.component = tref.typeData->compiledData();
+                ref.component->addref();
+            } else {
+                ref.type = tref.type;
+                if (ref.type->containsRevisionedAttributes()) {
+                    QQmlError cacheError;
+                    ref.typePropertyCache = engine->cache(ref.type, tref.minorVersion, cacheError);
+                    if (!ref.typePropertyCache)
+                        return false;
+                    ref.typePropertyCache->addref();
+                }
+            }
+        } else {
+            QString name;
+            qint32 majorVersion, minorVersion;
+            in >> name >> majorVersion >> minorVersion;
+            ref.type = QQmlMetaType::qmlType(name, majorVersion, minorVersion);
+            if (!ref.type)
+                return false;
+        }
+        data->types << ref;
+        if (data->types.last().type)
+            data->types.last().createPropertyCache(data->engine);
+    }
+
+    return in.status() == QDataStream::Ok;
+}
+
+bool QQmlCompilationCacheReader::readTypeIds(QDataStream &in)
+{
+    qint32 count;
+    in >> count;
+    for (int ii = 0; in.status() == QDataStream::Ok && ii < count; ++ii) {
+        qint32 id;
+        QByteArray name;
+        QString url;
+        in >> id >> name >> url;
+        if (url.isEmpty() ? QMetaType::type(name.constData()) != id
+                          : engine->compositeTypeUrl(id) != resolvedUrl(unit->finalUrl(), url))
+            return false;
+    }
+
+    in >> count;
+    for (int ii = 0; in.status() == QDataStream::Ok && ii < count; ++ii) {
+        qint32 id;
+        QByteArray className;
+        in >> id >> className;
+        QQmlType *type = QQmlMetaType::qmlTypeFromIndex(id);
+        if (!type || !type->attachedPropertiesType() ||
+            className != type->attachedPropertiesType()->className())
+            return false;
+    }
+
+    return in.status() == QDataStream::Ok;
+}
+
+bool QQmlCompilationCacheReader::readPropertyCache(QDataStream &in)
+{
+    qint32 parentType;
+    QByteArray parentClassName;
+    QByteArray classNamePrefix;
+    QString defaultPropertyName;
+    in >> parentType >> parentClassName >> classNamePrefix >> defaultPropertyName;
+    if (in.status() != QDataStream::Ok)
+        return false;
+
+    QQmlPropertyCache *parent = 0;
+    if (parentType >= 0 && parentType < data->types.count()) {
+        parent = data->types.at(parentType).propertyCache();
+    } else if (parentType == -1) {
+        if (const QMetaObject *mo = QMetaType::metaObjectForType(QMetaType::type((parentClassName + '*').constData())))
+            parent = engine->cache(mo);
+    }
+    if (!parent)
+        return false;
+
+    qint32 count;
+    QList<CachedMethod> methods;
+    int signalCount = 0;
+    in >> count;
+    for (int ii = 0; in.status() == QDataStream::Ok && ii < count; ++ii) {
+        CachedMethod m;
+        in >> m.name >> m.flags >> m.coreIndex >> m.types >> m.names;
+        if (m.flags & QQmlPropertyData::IsSignal)
+            ++signalCount;
+        methods.append(m);
+    }
+    QList<CachedProperty> properties;
+    in >> count;
+    for (int ii = 0; in.status() == QDataStream::Ok && ii < count; ++ii) {
+        CachedProperty p;
+        in >> p.name >> p.flags >> p.coreIndex >> p.propType >> p.notifyIndex;
+        properties.append(p);
+    }
+    if (in.status() != QDataStream::Ok)
+        return false;
+
+    // Replay the appends made by QQmlCompiler::buildDynamicMeta()
+    QQmlPropertyCache *cache = parent->copyAndReserve(data->engine, properties.count(),
+                                                      methods.count() + properties.count(),
+                                                      signalCount + properties.count());
+    cache->_dynamicClassName = QQmlCompiler::uniqueClassName(classNamePrefix);
+    cache->_defaultPropertyName = defaultPropertyName;
+    data->propertyCaches << cache;
+
+    for (int ii = 0; ii < methods.count(); ++ii) {
+        const CachedMethod &m = methods.at(ii);
+        if (m.flags & QQmlPropertyData::IsSignal) {
+            QVarLengthArray<int, 10> types;
+            if (!m.types.isEmpty()) {
+                types.append(m.types.count());
+                foreach (int type, m.types)
+                    types.append(type);
+            }
+            cache->appendSignal(m.name, m.flags, m.coreIndex,
+                                types.isEmpty() ? 0 : types.constData(), m.names);
+        } else {
+            cache->appendMethod(m.name, m.flags, m.coreIndex, m.names);
+        }
+    }
+    for (int ii = 0; ii < properties.count(); ++ii) {
+        const CachedProperty &p = properties.at(ii);
+        cache->appendProperty(p.name, p.flags, p.coreIndex, p.propType, p.notifyIndex);
+    }
+
+    return true;
+}
+
+bool QQmlCompilationCacheReader::readRootType(QDataStream &in)
+{
+    qint32 rootCache;
+    qint32 rootType;
+    bool registered;
+    in >> rootCache >> rootType >> registered;
+    if (in.status() != QDataStream::Ok)
+        return false;
+
+    if (rootCache != -1) {
+        if (rootCache < 0 || rootCache >= data->propertyCaches.count())
+            return false;
+        data->rootPropertyCache = data->propertyCaches.at(rootCache);
+    } else {
+        if (rootType < 0 || rootType >= data->types.count())
+            return false;
+        data->rootPropertyCache = data->types[rootType].createPropertyCache(data->engine);
+    }
+    data->rootPropertyCache->addref();
+
+    if (registered) {
+        engine->registerInternalCompositeType(data);
+    } else {
+        if (rootType < 0 || rootType >= data->types.count())
+            return false;
+        const QQmlCompiledData::TypeReference &ref = data->types.at(rootType);
+        data->metaTypeId = ref.component ? ref.component->metaTypeId : ref.type->typeId();
+        data->listMetaTypeId = ref.component ? ref.component->listMetaTypeId : ref.type->qListTypeId();
+    }
+
+    return true;
+}
+
+bool QQmlCompilationCacheReader::decodeBytecode(QByteArray &bytecode)
+{
+#ifdef QML_THREADED_VME_INTERPRETER
+    void *const *jumpTable = QQmlVME::instructionJumpTable();
+#endif
+
+    char *code = bytecode.data();
+    char *end = code + bytecode.size();
+
+    while (code < end) {
+        if (end - code < int(sizeof(QQmlInstruction::instr_common)))
+            return false;
+
+        QQmlInstruction *instr = reinterpret_cast<QQmlInstruction *>(code);
+#ifdef QML_THREADED_VME_INTERPRETER
+        quintptr type = reinterpret_cast<quintptr>(instr->common.code);
+#else
+        quintptr type = instr->common.instructionType;
+#endif
+        if (type >= quintptr(qml_instr_count))
+            return false;
+        int size = QQmlInstruction::size(QQmlInstruction::Type(type));
+        if (end - code < size)
+            return false;
+
+#ifdef QML_THREADED_VME_INTERPRETER
+        instr->common.code = jumpTable[type];
+#endif
+
+        if (type == QQmlInstruction::CreateSimpleObject) {
+            int index = instr->createSimple.type;
+            if (index < 0 || index >= data->types.count() || !data->types.at(index).type)
+                return false;
+            QQmlType *t = data->types.at(index).type;
+            if (t->createSize() != instr->createSimple.typeSize)
+                return false;
+            instr->createSimple.create = t->createFunction();
+        }
+
+        code += size;
+    }
+
+    return true;
+}
+
+bool QQmlCompilationCacheReader::decodeV4Program(QByteArray &program)
+{
+    if (program.size() < int(sizeof(QV4Program)))
+        return false;
+
+#ifdef QML_THREADED_INTERPRETER
+    void **decodeInstr = QV4Bindings::getDecodeInstrTable();
+#endif
+
+    char *start = program.data();
+    const QV4Program *header = reinterpret_cast<QV4Program *>(start);
+    if (program.size() - int(sizeof(QV4Program)) < int(header->dataLength))
+        return false;
+
+    char *code = const_cast<char *>(header->instructions());
+    char *end = start + program.size();
+
+    while (code < end) {
+        if (end - code < int(sizeof(V4Instr::instr_common)))
+            return false;
+
+        V4Instr *instr = reinterpret_cast<V4Instr *>(code);
+#ifdef QML_THREADED_INTERPRETER
+        quintptr type = reinterpret_cast<quintptr>(instr->common.code);
+#else
+        quintptr type = instr->common.type;
+#endif
+        if (type >= quintptr(qml_v4_instr_count))
+            return false;
+        int size = V4Instr::size(V4Instr::Type(type));
+        if (end - code < size)
+            return false;
+
+#ifdef QML_THREADED_INTERPRETER
+        instr->common.code = decodeInstr[type];
+#endif
+        code += size;
+    }
+
+    return true;
+}
+
+bool QQmlCompilationCacheReader::decodeProperty(QByteArray &buffer, const AccessorFixup &fixup)
+{
+    if (fixup.offset < 0 || buffer.size() - fixup.offset < int(sizeof(QQmlPropertyRawData)))
+        return false;
+
+    QQmlPropertyRawData *property =
+            reinterpret_cast<QQmlPropertyRawData *>(buffer.data() + fixup.offset);
+    if (!property->hasAccessors())
+        return false;
+
+    QQmlAccessorProperties::Property *accessor =
+            QQmlAccessorProperties::property(fixup.className, fixup.name);
+    if (!accessor)
+        return false;
+
+    property->accessors = accessor->accessors;
+    property->accessorData = accessor->data;
+    return true;
+}
+
+/*!
+\internal
+\class QQmlCompilationCache
+\brief The QQmlCompilationCache class stores compiled QML documents in the directory \a path.
+*/
+QQmlCompilationCache::QQmlCompilationCache(const QString &path)
+: m_path(path)
+{
+}
+
+QQmlCompilationCache::~QQmlCompilationCache()
+{
+}
+
+QString QQmlCompilationCache::path() const
+{
+    return m_path;
+}
+
+/*!
+Returns the name of the cache file for documents whose source has the hash \a sourceHash.
+
+Files are not named after the document URL, so that a cache written from the source tree is
+also found by an application that loads its documents from an install directory or from
+resources.
+*/
+QString QQmlCompilationCache::fileName(const QByteArray &sourceHash) const
+{
+    return m_path + QLatin1Char('/') + QString::fromLatin1(sourceHash.toHex()) + QLatin1String(".qmlc");
+}
+
+QByteArray QQmlCompilationCache::sourceHash(const QByteArray &source)
+{
+    return QCryptographicHash::hash(source, QCryptographicHash::Sha1);
+}
+
+/*
+Adds the members \a mo declares itself to \a hash, in index order.  The compiled form refers
+to properties and methods by index, so any change to their order, names or types must change
+the key.
+*/
+static void addMetaObject(QCryptographicHash *hash, const QMetaObject *mo)
+{
+    hash->addData(mo->className());
+
+    for (int ii = mo->propertyOffset(); ii < mo->propertyCount(); ++ii) {
+        QMetaProperty property = mo->property(ii);
+        hash->addData("P", 1);
+        hash->addData(property.name());
+        hash->addData(" ", 1);
+        hash->addData(property.typeName());
+    }
+
+    for (int ii = mo->methodOffset(); ii < mo->methodCount(); ++ii) {
+        QMetaMethod method = mo->method(ii);
+        hash->addData("M", 1);
+        hash->addData(method.methodSignature());
+        hash->addData(" ", 1);
+        hash->addData(method.typeName());
+    }
+
+    for (int ii = mo->enumeratorOffset(); ii < mo->enumeratorCount(); ++ii) {
+        QMetaEnum enumerator = mo->enumerator(ii);
+        hash->addData("E", 1);
+        hash->addData(enumerator.name());
+        for (int jj = 0; jj < enumerator.keyCount(); ++jj) {
+            hash->addData(" ", 1);
+            hash->addData(enumerator.key(jj));
+            hash->addData(QByteArray::number(enumerator.value(jj)));
+        }
+    }
+}
+
+/*!
+Returns the key of everything outside its own source that the compiled form of \a unit depends
+on: the resolved types, including the keys of other QML documents, and the imported scripts.
+Returns an empty key if a dependency cannot be identified, in which case \a unit is not cached.
+*/
+QByteArray QQmlCompilationCache::dependencyKey(const QQmlTypeData *unit)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+
+    foreach (const QQmlTypeData::TypeReference &type, unit->resolvedTypes()) {
+        if (type.typeData) {
+            if (type.typeData->cacheKey().isEmpty())
+                return QByteArray();
+            hash.addData("F", 1);
+            hash.addData(type.typeData->cacheKey());
+        } else {
+            hash.addData("T", 1);
+            hash.addData(type.type->qmlTypeName().toUtf8());
+            hash.addData(QByteArray::number(type.majorVersion) + '.' +
+                         QByteArray::number(type.minorVersion));
+            // Property and method indexes come from the C++ meta objects
+            for (const QMetaObject *mo = type.type->metaObject(); mo; mo = mo->superClass())
+                addMetaObject(&hash, mo);
+        }
+    }
+
+    foreach (const QQmlTypeData::ScriptReference &script, unit->resolvedScripts()) {
+        hash.addData("S", 1);
+        hash.addData(relativeUrl(unit->finalUrl(), script.script->url()).toUtf8());
+        hash.addData(script.qualifier.toUtf8());
+    }
+
+    QStringList namespaces = unit->namespaces().toList();
+    namespaces.sort();
+    foreach (const QString &ns, namespaces) {
+        hash.addData("N", 1);
+        hash.addData(ns.toUtf8());
+    }
+
+    return hash.result();
+}
+
+/*!
+Reads the unit section of the cache file for the source with the hash \a sourceHash into
+\a unit.  Returns false if there is no cache file, or if it was written by a different build.
+*/
+bool QQmlCompilationCache::loadUnit(const QByteArray &sourceHash, Unit *unit) const
+{
+    QFile file(fileName(sourceHash));
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_5_0);
+
+    quint32 magic, version;
+    QByteArray key;
+    QByteArray hash;
+    in >> magic >> version;
+    if (magic != qml_cache_magic || version != qml_cache_version)
+        return false;
+    in >> key >> hash;
+    if (key != buildKey() || hash != sourceHash)
+        return false;
+
+    qint32 count;
+    in >> count;
+    QList<QQmlScript::Import> imports;
+    for (int ii = 0; in.status() == QDataStream::Ok && ii < count; ++ii) {
+        QQmlScript::Import import;
+        qint32 type, majorVersion, minorVersion;
+        in >> type >> import.uri >> import.qualifier >> majorVersion >> minorVersion
+           >> import.location.start >> import.location.end
+           >> import.location.range.offset >> import.location.range.length;
+        import.type = QQmlScript::Import::Type(type);
+        import.majorVersion = majorVersion;
+        import.minorVersion = minorVersion;
+        imports << import;
+    }
+
+    in >> count;
+    QList<QPair<QString, QQmlScript::Location> > referencedTypes;
+    for (int ii = 0; in.status() == QDataStream::Ok && ii < count; ++ii) {
+        QPair<QString, QQmlScript::Location> type;
+        in >> type.first >> type.second;
+        referencedTypes << type;
+    }
+
+    QByteArray dependencyKey;
+    QByteArray data;
+    in >> dependencyKey >> data;
+    if (in.status() != QDataStream::Ok || data.isEmpty())
+        return false;
+
+    unit->sourceHash = sourceHash;
+    unit->imports = imports;
+    unit->referencedTypes = referencedTypes;
+    unit->dependencyKey = dependencyKey;
+    unit->data = data;
+    return true;
+}
+
+/*!
+Fills \a data from the compiled data cached in \a unit for the type \a typeData, whose
+dependencies must all be complete.  Returns false if the cached data is stale or cannot be
+restored, in which case \a data must be discarded and the type compiled.
+*/
+bool QQmlCompilationCache::loadCompiledData(const QQmlTypeData *typeData, const Unit &unit,
+                                            QQmlCompiledData *data) const
+{
+    if (!unit.hasCompiledData() || unit.dependencyKey != dependencyKey(typeData))
+        return false;
+
+    QDataStream in(unit.data);
+    in.setVersion(QDataStream::Qt_5_0);
+
+    QQmlCompilationCacheReader reader(data, typeData);
+    return reader.read(in);
+}
+
+/*!
+Writes the cache file for the type \a typeData, compiled into \a data from the source and
+references recorded in \a unit.  Returns false if \a data cannot be cached.
+*/
+bool QQmlCompilationCache::store(const QQmlTypeData *typeData, const Unit &unit,
+                                 QQmlCompiledData *data) const
+{
+    if (unit.sourceHash.isEmpty())
+        return false;
+    QByteArray key = dependencyKey(typeData);
+    if (key.isEmpty())
+        return false;
+
+    QByteArray body;
+    {
+        QDataStream out(&body, QIODevice::WriteOnly);
+        out.setVersion(QDataStream::Qt_5_0);
+        QQmlCompilationCacheWriter writer(data, typeData);
+        if (!writer.write(out))
+            return false;
+    }
+
+    if (!QDir().mkpath(m_path))
+        return false;
+
+    QSaveFile file(fileName(unit.sourceHash));
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_0);
+
+    out << qml_cache_magic << qml_cache_version;
+    out << buildKey() << unit.sourceHash;
+
+    out << qint32(unit.imports.count());
+    foreach (const QQmlScript::Import &import, unit.imports) {
+        out << qint32(import.type) << import.uri << import.qualifier
+            << qint32(import.majorVersion) << qint32(import.minorVersion)
+            << import.location.start << import.location.end
+            << import.location.range.offset << import.location.range.length;
+    }
+
+    out << qint32(unit.referencedTypes.count());
+    for (int ii = 0; ii < unit.referencedTypes.count(); ++ii)
+        out << unit.referencedTypes.at(ii).first << unit.referencedTypes.at(ii).second;
+
+    out << key << body;
+
+    return out.status() == QDataStream::Ok && file.commit();
+}
+
+QT_END_NAMESPACE
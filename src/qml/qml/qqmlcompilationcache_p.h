@@ -0,0 +1,114 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the QtQml module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QQMLCOMPILATIONCACHE_P_H
+#define QQMLCOMPILATIONCACHE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qstring.h>
+#include <QtCore/qbytearray.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qpair.h>
+#include <QtCore/qurl.h>
+
+#include <private/qqmlscript_p.h>
+
+QT_BEGIN_NAMESPACE
+
+class QQmlTypeData;
+class QQmlCompiledData;
+
+// QQmlCompilationCache persists successfully compiled QML documents to disk, so that later
+// runs can skip both parsing and compiling a file that has not changed.
+//
+// A cache file is named after the SHA1 of the document source and only valid for the build of
+// the QML engine that wrote it.  URLs in it are relative to the document, so the same file
+// serves every copy of the document, wherever it is loaded from.
+// Its "unit" section holds the imports and type names referenced by the document, which is all
+// the type loader needs to resolve the dependencies without parsing.  The compiled data is
+// only used once the dependencies have been loaded and the dependency key (derived from
+// the resolved types and scripts) still matches, otherwise the document is parsed and compiled
+// as usual and the file is rewritten.
+class Q_QML_PRIVATE_EXPORT QQmlCompilationCache
+{
+    Q_DISABLE_COPY(QQmlCompilationCache)
+public:
+    struct Unit
+    {
+        QByteArray sourceHash;
+        QList<QQmlScript::Import> imports;
+        QList<QPair<QString, QQmlScript::Location> > referencedTypes;
+        QByteArray dependencyKey;
+        QByteArray data;
+
+        bool hasCompiledData() const { return !data.isEmpty(); }
+    };
+
+    QQmlCompilationCache(const QString &path);
+    ~QQmlCompilationCache();
+
+    QString path() const;
+    QString fileName(const QByteArray &sourceHash) const;
+
+    static QByteArray sourceHash(const QByteArray &source);
+    static QByteArray dependencyKey(const QQmlTypeData *);
+
+    bool loadUnit(const QByteArray &sourceHash, Unit *) const;
+    bool loadCompiledData(const QQmlTypeData *, const Unit &, QQmlCompiledData *) const;
+    bool store(const QQmlTypeData *, const Unit &, QQmlCompiledData *) const;
+
+private:
+    QString m_path;
+};
+
+QT_END_NAMESPACE
+
+#endif // QQMLCOMPILATIONCACHE_P_H
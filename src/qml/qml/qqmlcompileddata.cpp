@@ -55,39 +55,77 @@
 
 QT_BEGIN_NAMESPACE
 
+struct QQmlCompiledData::OperandIndexes
+{
+    QHash<QString, int> strings;
+    QHash<QByteArray, int> datas;
+    QHash<QUrl, int> urls;
+};
+
 int QQmlCompiledData::indexForString(const QString &data)
 {
-    int idx = primitives.indexOf(data);
-    if (idx == -1) {
-        idx = primitives.count();
-        primitives << data;
-    }
+    if (!operandIndexes)
+        operandIndexes = new OperandIndexes;
+    QHash<QString, int>::ConstIterator iter = operandIndexes->strings.constFind(data);
+    if (iter != operandIndexes->strings.constEnd())
+        return *iter;
+
+    int idx = primitives.count();
+    primitives << data;
+    operandIndexes->strings.insert(data, idx);
     return idx;
 }
 
 int QQmlCompiledData::indexForByteArray(const QByteArray &data)
 {
-    int idx = datas.indexOf(data);
-    if (idx == -1) {
-        idx = datas.count();
-        datas << data;
-    }
+    if (!operandIndexes)
+        operandIndexes = new OperandIndexes;
+    QHash<QByteArray, int>::ConstIterator iter = operandIndexes->datas.constFind(data);
+    if (iter != operandIndexes->datas.constEnd())
+        return *iter;
+
+    int idx = datas.count();
+    datas << data;
+    operandIndexes->datas.insert(data, idx);
     return idx;
 }
 
 int QQmlCompiledData::indexForUrl(const QUrl &data)
 {
-    int idx = urls.indexOf(data);
-    if (idx == -1) {
-        idx = urls.count();
-        urls << data;
-    }
+    if (!operandIndexes)
+        operandIndexes = new OperandIndexes;
+    QHash<QUrl, int>::ConstIterator iter = operandIndexes->urls.constFind(data);
+    if (iter != operandIndexes->urls.constEnd())
+        return *iter;
+
+    int idx = urls.count();
+    urls << data;
+    operandIndexes->urls.insert(data, idx);
     return idx;
 }
 
+/*!
+Releases the memory only needed while building the compiled data, and replaces the strings in
+the primitives and datas tables with the engine's shared copies.  Call this once the compiled
+data is complete.
+*/
+void QQmlCompiledData::squeeze()
+{
+    delete operandIndexes;
+    operandIndexes = 0;
+
+    QQmlInternPool *pool = &QQmlEnginePrivate::get(engine)->internPool;
+    for (int ii = 0; ii < primitives.count(); ++ii)
+        primitives[ii] = pool->intern(primitives.at(ii));
+    for (int ii = 0; ii < datas.count(); ++ii)
+        datas[ii] = pool->intern(datas.at(ii));
+
+    bytecode.squeeze();
+}
+
 QQmlCompiledData::QQmlCompiledData(QQmlEngine *engine)
 : engine(engine), importCache(0), metaTypeId(-1), listMetaTypeId(-1), isRegisteredWithEngine(false),
-  rootPropertyCache(0)
+  rootPropertyCache(0), operandIndexes(0), lazyUnit(0), ownsLazyUnit(false)
 {
     Q_ASSERT(engine);
 
@@ -130,12 +168,93 @@ QQmlCompiledData::~QQmlCompiledData()
 
     if (rootPropertyCache)
         rootPropertyCache->release();
+
+    for (int ii = 0; ii < lazyComponents.count(); ++ii)
+        if (lazyComponents.at(ii).compiledData)
+            lazyComponents.at(ii).compiledData->release();
+
+    delete operandIndexes;
 }
 
 void QQmlCompiledData::clear()
 {
     for (int ii = 0; ii < programs.count(); ++ii)
         qPersistentDispose(programs[ii].bindings);
+
+    // Lazy components can no longer be compiled once the engine is gone
+    releaseLazyUnit();
+}
+
+/*!
+Returns true if any of the lazy components have not been compiled yet.
+*/
+bool QQmlCompiledData::hasPendingLazyComponents() const
+{
+    for (int ii = 0; ii < lazyComponents.count(); ++ii) {
+        const LazyComponent &component = lazyComponents.at(ii);
+        if (!component.compiledData && component.errors.isEmpty())
+            return true;
+    }
+    return false;
+}
+
+/*!
+Returns the compiled data for the lazy component \a index, compiling its body the first time it is
+needed.  The compiled data is not referenced.  Returns 0 and sets \a errors if the body does not
+compile; the errors are remembered, so that the body is not parsed and compiled again.
+*/
+QQmlCompiledData *QQmlCompiledData::lazyComponent(int index, QList<QQmlError> *errors)
+{
+    Q_ASSERT(index >= 0 && index < lazyComponents.count());
+    LazyComponent &component = lazyComponents[index];
+
+    if (!component.compiledData && component.errors.isEmpty()) {
+        if (!lazyUnit || !hasEngine()) {
+            QQmlError error;
+            error.setUrl(url);
+            error.setDescription(QQmlCompiler::tr("Component is no longer available"));
+            component.errors << error;
+        } else {
+            QQmlCompiledData *data = new QQmlCompiledData(engine);
+            data->url = url;
+            data->name = name;
+            data->importCache = importCache;
+            data->importCache->addref();
+
+            if (lazyUnit->compileComponent(component.offset, data, &component.errors))
+                component.compiledData = data;
+            else
+                data->release();
+
+            // The source is only needed until the last body is compiled
+            if (!hasPendingLazyComponents())
+                releaseLazyUnit();
+        }
+    }
+
+    if (!component.compiledData)
+        *errors = component.errors;
+    return component.compiledData;
+}
+
+void QQmlCompiledData::releaseLazyUnit()
+{
+    QQmlTypeData *unit = lazyUnit;
+    lazyUnit = 0;
+    if (ownsLazyUnit)
+        delete unit;
+    else if (unit)
+        unit->clearParser();
+    ownsLazyUnit = false;
+}
+
+/*!
+Returns the number of bytes kept so that the pending lazy components can be compiled.  Only the
+source of the document is kept, it is parsed again when a body is compiled.
+*/
+int QQmlCompiledData::lazyUnitSize() const
+{
+    return lazyUnit ? lazyUnit->m_source.size() * int(sizeof(QChar)) : 0;
 }
 
 /*!
@@ -82,6 +82,7 @@ QT_BEGIN_NAMESPACE
 
 DEFINE_BOOL_CONFIG_OPTION(compilerDump, QML_COMPILER_DUMP);
 DEFINE_BOOL_CONFIG_OPTION(compilerStatDump, QML_COMPILER_STATS);
+DEFINE_BOOL_CONFIG_OPTION(compilerEagerComponents, QML_COMPILER_EAGER_COMPONENTS);
 
 using namespace QQmlJS;
 using namespace QQmlScript;
@@ -100,7 +101,7 @@ static QString qsTrId_string(QLatin1String("qsTrId"));
 */
 QQmlCompiler::QQmlCompiler(QQmlPool *pool)
 : compileState(0), pool(pool), output(0), engine(0), enginePrivate(0), unitRoot(0), unit(0), cachedComponentTypeRef(-1),
-  cachedTranslationContextIndex(-1), componentStats(0)
+  cachedTranslationContextIndex(-1), lazyComponentsEnabled(false), componentStats(0)
 {
     if (compilerStatDump()) 
         componentStats = pool->New<ComponentStats>();
@@ -778,7 +779,9 @@ void QQmlCompiler::reset(QQmlCompiledData *data)
     data->types.clear();
     data->primitives.clear();
     data->datas.clear();
+    data->lazyComponents.clear();
     data->bytecode.resize(0);
+    data->squeeze();
 }
 
 /*!
@@ -795,19 +798,55 @@ void QQmlCompiler::reset(QQmlCompiledData *data)
 bool QQmlCompiler::compile(QQmlEngine *engine,
                                    QQmlTypeData *unit,
                                    QQmlCompiledData *out)
+{
+    return compile(engine, unit, unit->parser().tree(), out);
+}
+
+/*!
+    Compile the body of the component whose root object is \a root, and store the
+    output in \a out.  \a root must belong to the parse tree of \a unit, and must be
+    the root of a body left unbuilt by an earlier compile() of \a unit with lazy
+    components enabled.  The parse tree may be a fresh parse of the same source.
+    \a out must already share the import cache of the enclosing document.
+
+    Returns true on success, false on failure.
+
+    \sa setLazyComponents()
+*/
+bool QQmlCompiler::compileComponent(QQmlEngine *engine, QQmlTypeData *unit,
+                                    QQmlScript::Object *root, QQmlCompiledData *out)
+{
+    Q_ASSERT(root != unit->parser().tree());
+    Q_ASSERT(out->importCache);
+    return compile(engine, unit, root, out);
+}
+
+/*!
+    Sets whether the bodies of nested components are left uncompiled until the component is first
+    created.  Lazy components are disabled by default, and are never used when the compiler
+    statistics are collected or the QML_COMPILER_EAGER_COMPONENTS environment variable is set.
+
+    \sa compileComponent()
+*/
+void QQmlCompiler::setLazyComponents(bool enabled)
+{
+    lazyComponentsEnabled = enabled && !componentStats && !compilerEagerComponents();
+}
+
+bool QQmlCompiler::compile(QQmlEngine *engine, QQmlTypeData *unit,
+                           QQmlScript::Object *root, QQmlCompiledData *out)
 {
     exceptions.clear();
 
     Q_ASSERT(out);
     reset(out);
 
-    QQmlScript::Object *root = unit->parser().tree();
     Q_ASSERT(root);
 
     this->engine = engine;
     this->enginePrivate = QQmlEnginePrivate::get(engine);
     this->unit = unit;
-    this->unitRoot = root;
+    this->unitRoot = unit->parser().tree();
     this->output = out;
 
     // Compile types
@@ -846,14 +885,18 @@ bool QQmlCompiler::compile(QQmlEngine *engine,
         out->types << ref;
     }
 
-    compileTree(root);
+    if (root == unitRoot)
+        compileTree(root);
+    else
+        compileComponentTree(root);
 
     if (!isError()) {
+        out->squeeze();
         if (compilerDump())
             out->dumpInstructions();
         if (componentStats)
             dumpStats();
-        Q_ASSERT(out->rootPropertyCache);
+        Q_ASSERT(out->rootPropertyCache || root != unitRoot);
     } else {
         reset(out);
     }
@@ -881,26 +924,7 @@ void QQmlCompiler::compileTree(QQmlScript::Object *tree)
     // We generate the importCache before we build the tree so that
     // it can be used in the binding compiler.  Given we "expect" the
     // QML compilation to succeed, this isn't a waste.
-    output->importCache = new QQmlTypeNameCache();
-    foreach (const QString &ns, unit->namespaces()) {
-        output->importCache->add(ns);
-    }
-
-    int scriptIndex = 0;
-    foreach (const QQmlTypeData::ScriptReference &script, unit->resolvedScripts()) {
-        QString qualifier = script.qualifier;
-        QString enclosingNamespace;
-
-        const int lastDotIndex = qualifier.lastIndexOf(QLatin1Char('.'));
-        if (lastDotIndex != -1) {
-            enclosingNamespace = qualifier.left(lastDotIndex);
-            qualifier = qualifier.mid(lastDotIndex+1);
-        }
-
-        output->importCache->add(qualifier, scriptIndex++, enclosingNamespace);
-    }
-
-    unit->imports().populateCache(output->importCache);
+    output->importCache = unit->createImportCache();
 
     if (!buildObject(tree, BindingContext()) || !completeComponentBuild())
         return;
@@ -962,6 +986,14 @@ void QQmlCompiler::compileTree(QQmlScript::Object *tree)
         enginePrivate->registerInternalCompositeType(output);
 }
 
+void QQmlCompiler::compileComponentTree(QQmlScript::Object *tree)
+{
+    if (!buildComponentFromRoot(tree, BindingContext()))
+        return;
+
+    genComponentBody(tree);
+}
+
 static bool QStringList_contains(const QStringList &list, const QHashedStringRef &string)
 {
     for (int ii = 0; ii < list.count(); ++ii)
@@ -1443,9 +1475,42 @@ void QQmlCompiler::genComponent(QQmlScript::Object *obj)
     create.column = root->location.start.column;
     create.endLine = root->location.end.line;
     create.isRoot = (compileState->root == obj);
-    int createInstruction = output->addInstruction(create);
-    int nextInstructionIndex = output->nextInstructionIndex();
 
+    if (!root->componentCompileState) {
+        // The body was not built, so it is compiled when the component is first created
+        create.count = 0;
+        create.lazyComponent = output->lazyComponents.count();
+        output->addInstruction(create);
+
+        QQmlCompiledData::LazyComponent lazy;
+        lazy.offset = root->location.range.offset;
+        output->lazyComponents.append(lazy);
+    } else {
+        create.lazyComponent = -1;
+        int createInstruction = output->addInstruction(create);
+        int nextInstructionIndex = output->nextInstructionIndex();
+
+        genComponentBody(root);
+
+        output->instruction(createInstruction)->createComponent.count =
+            output->nextInstructionIndex() - nextInstructionIndex;
+    }
+
+    if (!obj->id.isEmpty()) {
+        Instruction::SetId id;
+        id.value = output->indexForString(obj->id);
+        id.index = obj->idIndex;
+        output->addInstruction(id);
+    }
+
+    if (obj == unitRoot) {
+        output->rootPropertyCache = output->types[obj->type].createPropertyCache(engine);
+        output->rootPropertyCache->addref();
+    }
+}
+
+void QQmlCompiler::genComponentBody(QQmlScript::Object *root)
+{
     ComponentCompileState *oldCompileState = compileState;
     compileState = componentState(root);
 
@@ -1481,22 +1546,7 @@ void QQmlCompiler::genComponent(QQmlScript::Object *obj)
     Instruction::Done done;
     output->addInstruction(done);
 
-    output->instruction(createInstruction)->createComponent.count = 
-        output->nextInstructionIndex() - nextInstructionIndex;
-
     compileState = oldCompileState;
-
-    if (!obj->id.isEmpty()) {
-        Instruction::SetId id;
-        id.value = output->indexForString(obj->id);
-        id.index = obj->idIndex;
-        output->addInstruction(id);
-    }
-
-    if (obj == unitRoot) {
-        output->rootPropertyCache = output->types[obj->type].createPropertyCache(engine);
-        output->rootPropertyCache->addref();
-    }
 }
 
 bool QQmlCompiler::buildComponent(QQmlScript::Object *obj,
@@ -1550,8 +1600,9 @@ bool QQmlCompiler::buildComponent(QQmlScript::Object *obj,
     if (!root)
         COMPILE_EXCEPTION(obj, tr("Cannot create empty component specification"));
 
-    // Build the component tree
-    COMPILE_CHECK(buildComponentFromRoot(root, ctxt));
+    // Build the component tree, unless it can wait until the component is first created
+    if (!lazyComponentsEnabled)
+        COMPILE_CHECK(buildComponentFromRoot(root, ctxt));
 
     compileState->objectDepth.pop();
 
@@ -2805,6 +2856,15 @@ static QStringList astNodeToStringList(QQmlJS::AST::Node *node)
 
 static QAtomicInt classIndexCounter(0);
 
+/*!
+Returns a class name for a synthesized meta object, made unique by appending a
+counter to \a prefix.
+*/
+QByteArray QQmlCompiler::uniqueClassName(const QByteArray &prefix)
+{
+    return prefix + QByteArray::number(classIndexCounter.fetchAndAddRelaxed(1));
+}
+
 bool QQmlCompiler::buildDynamicMeta(QQmlScript::Object *obj, DynamicMetaMode mode)
 {
     Q_ASSERT(obj);
@@ -2853,14 +2913,11 @@ bool QQmlCompiler::buildDynamicMeta(QQmlScript::Object *obj, DynamicMetaMode mod
         if (lastSlash > -1) {
             QString nameBase = path.mid(lastSlash + 1, path.length()-lastSlash-5);
             if (!nameBase.isEmpty() && nameBase.at(0).isUpper())
-                newClassName = nameBase.toUtf8() + "_QMLTYPE_" +
-                               QByteArray::number(classIndexCounter.fetchAndAddRelaxed(1));
+                newClassName = uniqueClassName(nameBase.toUtf8() + "_QMLTYPE_");
         }
     }
     if (newClassName.isEmpty()) {
-        newClassName = QQmlMetaObject(obj->metatype).className();
-        newClassName.append("_QML_");
-        newClassName.append(QByteArray::number(classIndexCounter.fetchAndAddRelaxed(1)));
+        newClassName = uniqueClassName(QByteArray(QQmlMetaObject(obj->metatype).className()) + "_QML_");
     }
     QQmlPropertyCache *cache = obj->metatype->copyAndReserve(engine, obj->dynamicProperties.count(),
                                                              obj->dynamicProperties.count() +
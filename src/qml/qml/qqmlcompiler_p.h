@@ -126,6 +126,22 @@ public:
     QList<QQmlScriptData *> scripts;
     QList<QUrl> urls;
 
+    // Component bodies that are only compiled when the component is first created.  The body is
+    // found by the source offset of its root object in a fresh parse of the document.
+    struct LazyComponent
+    {
+        LazyComponent() : offset(0), compiledData(0) {}
+
+        quint32 offset;
+        QQmlCompiledData *compiledData;
+        QList<QQmlError> errors;
+    };
+    QList<LazyComponent> lazyComponents;
+
+    bool hasPendingLazyComponents() const;
+    QQmlCompiledData *lazyComponent(int index, QList<QQmlError> *errors);
+    int lazyUnitSize() const;
+
     struct Instruction {
 #define QML_INSTR_DATA_TYPEDEF(I, FMT) typedef QQmlInstructionData<QQmlInstruction::I> I;
     FOR_EACH_QML_INSTR(QML_INSTR_DATA_TYPEDEF)
@@ -150,12 +166,15 @@ public:
     bool isInitialized() const { return hasEngine(); }
     void initialize(QQmlEngine *);
 
+    void squeeze();
+
 protected:
     virtual void destroy(); // From QQmlRefCount
     virtual void clear(); // From QQmlCleanup
 
 private:
     friend class QQmlCompiler;
+    friend class QQmlTypeData;
 
     int addInstructionHelper(QQmlInstruction::Type type, QQmlInstruction &instr);
     void dump(QQmlInstruction *, int idx = -1);
@@ -165,6 +184,15 @@ private:
     int indexForString(const QString &);
     int indexForByteArray(const QByteArray &);
     int indexForUrl(const QUrl &);
+
+    // Only exists while compiling
+    struct OperandIndexes;
+    OperandIndexes *operandIndexes;
+
+    // The type data whose parse tree the lazy components are compiled from
+    QQmlTypeData *lazyUnit;
+    bool ownsLazyUnit;
+    void releaseLazyUnit();
 };
 
 namespace QQmlCompilerTypes {
@@ -288,6 +316,9 @@ public:
     QQmlCompiler(QQmlPool *);
 
     bool compile(QQmlEngine *, QQmlTypeData *, QQmlCompiledData *);
+    bool compileComponent(QQmlEngine *, QQmlTypeData *, QQmlScript::Object *, QQmlCompiledData *);
+
+    void setLazyComponents(bool);
 
     bool isError() const;
     QList<QQmlError> errors() const;
@@ -302,12 +333,16 @@ public:
     int rewriteBinding(const QQmlScript::Variant& value, const QString& name); // for QQmlCustomParser::rewriteBinding
     QString rewriteSignalHandler(const QQmlScript::Variant& value, const QString &name);  // for QQmlCustomParser::rewriteSignalHandler
 
+    static QByteArray uniqueClassName(const QByteArray &prefix);
+
 private:
     typedef QQmlCompiledData::Instruction Instruction;
 
     static void reset(QQmlCompiledData *);
 
+    bool compile(QQmlEngine *, QQmlTypeData *, QQmlScript::Object *, QQmlCompiledData *);
     void compileTree(QQmlScript::Object *tree);
+    void compileComponentTree(QQmlScript::Object *tree);
 
 
     bool buildObject(QQmlScript::Object *obj, const QQmlCompilerTypes::BindingContext &);
@@ -379,6 +414,7 @@ private:
     void genObjectBody(QQmlScript::Object *obj);
     void genValueTypeProperty(QQmlScript::Object *obj,QQmlScript::Property *);
     void genComponent(QQmlScript::Object *obj);
+    void genComponentBody(QQmlScript::Object *root);
     void genValueProperty(QQmlScript::Property *prop, QQmlScript::Object *obj);
     void genListProperty(QQmlScript::Property *prop, QQmlScript::Object *obj);
     void genPropertyAssignment(QQmlScript::Property *prop, 
@@ -436,6 +472,7 @@ private:
     QQmlTypeData *unit;
     int cachedComponentTypeRef;
     int cachedTranslationContextIndex;
+    bool lazyComponentsEnabled;
 
     // Compiler component statistics.  Only collected if QML_COMPILER_STATS=1
     struct ComponentStat
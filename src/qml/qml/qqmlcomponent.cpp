@@ -370,6 +370,36 @@ void QQmlComponentPrivate::clear()
         cc->release();
         cc = 0;
     }
+
+    lazyComponent = -1;
+}
+
+/*!
+    \internal
+
+    If the body of this component has not been compiled yet, compiles it and switches to the
+    compiled data of the body.  Returns false and sets the component's errors if the body does
+    not compile.
+*/
+bool QQmlComponentPrivate::compileLazyComponent()
+{
+    Q_Q(QQmlComponent);
+
+    if (lazyComponent == -1)
+        return true;
+
+    QQmlCompiledData *data = cc->lazyComponent(lazyComponent, &state.errors);
+    if (!data) {
+        emit q->statusChanged(q->status());
+        return false;
+    }
+
+    data->addref();
+    cc->release();
+    cc = data;
+    start = 0;
+    lazyComponent = -1;
+    return true;
 }
 
 /*!
@@ -854,6 +884,9 @@ QQmlComponentPrivate::beginCreate(QQmlContextData *context)
         return 0;
     }
 
+    if (!compileLazyComponent())
+        return 0;
+
     // Do not create infinite recursion in object creation
     static const int maxCreationDepth = 10;
     if (++creationDepth.localData() >= maxCreationDepth) {
@@ -1060,6 +1093,12 @@ void QQmlComponent::create(QQmlIncubator &incubator, QQmlContext *context,
     incubator.clear();
     QQmlIncubatorPrivate *p = incubator.d;
 
+    if (!d->compileLazyComponent()) {
+        p->errors = d->state.errors;
+        p->changeStatus(p->calculateStatus());
+        return;
+    }
+
     QQmlEnginePrivate *enginePriv = QQmlEnginePrivate::get(d->engine);
 
     p->compiledData = d->cc;
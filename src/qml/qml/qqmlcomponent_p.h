@@ -85,7 +85,7 @@ class Q_QML_PRIVATE_EXPORT QQmlComponentPrivate : public QObjectPrivate, public
         
 public:
     QQmlComponentPrivate()
-        : typeData(0), progress(0.), start(-1), cc(0), engine(0), creationContext(0), profiler(0), depthIncreased(false) {}
+        : typeData(0), progress(0.), start(-1), lazyComponent(-1), cc(0), engine(0), creationContext(0), profiler(0), depthIncreased(false) {}
 
     void loadUrl(const QUrl &newUrl, QQmlComponent::CompilationMode mode = QQmlComponent::PreferSynchronous);
 
@@ -103,7 +103,9 @@ public:
     qreal progress;
 
     int start;
+    int lazyComponent;
     QQmlCompiledData *cc;
+    bool compileLazyComponent();
 
     struct ConstructionState {
         ConstructionState() : completePending(false) {}
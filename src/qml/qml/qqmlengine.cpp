@@ -69,6 +69,9 @@
 #include "qqmlabstracturlinterceptor_p.h"
 #include <private/qv8profilerservice_p.h>
 #include <private/qqmlboundsignal_p.h>
+#include <private/qqmlmemoryprofiler_p.h>
+#include <private/qqmlbinding_p.h>
+#include <private/qv8bindings_p.h>
 
 #include <QtCore/qstandardpaths.h>
 #include <QtCore/qsettings.h>
@@ -80,6 +83,7 @@
 #include <QtCore/qdir.h>
 #include <QtCore/qmutex.h>
 #include <QtCore/qthread.h>
+#include <QtCore/qthreadstorage.h>
 #include <private/qthread_p.h>
 #include <QtNetwork/qnetworkconfigmanager.h>
 
@@ -210,6 +214,7 @@ void QQmlEnginePrivate::defineQtQuick2Module()
 
     // register the QtQuick2 types which are implemented in the QtQml module.
     registerQtQuick2Types("QtQuick",2,0);
+    qmlRegisterType<QQuickWorkerScript, 1>("QtQuick", 2, 2, "WorkerScript");
     qmlRegisterUncreatableType<QQmlLocale>("QtQuick", 2, 0, "Locale", QQmlEngine::tr("Locale cannot be instantiated.  Use Qt.locale()"));
 }
 
@@ -514,11 +519,19 @@ the same object as is returned from the Qt.include() call.
 // Qt.include() is implemented in qv8include.cpp
 
 
+// Engines in the current thread that have bindings waiting for an update
+typedef QThreadStorage<QList<QQmlEnginePrivate *> > PendingBindingEngines;
+Q_GLOBAL_STATIC(PendingBindingEngines, enginesWithPendingBindings)
+
+static const QEvent::Type UpdatePendingBindingsEvent = QEvent::Type(QEvent::User + 1);
+
 QQmlEnginePrivate::QQmlEnginePrivate(QQmlEngine *e)
 : propertyCapture(0), rootContext(0), isDebugging(false),
   outputWarningsToStdErr(true), sharedContext(0), sharedScope(0),
   cleanup(0), erroredBindings(0), inProgressCreations(0),
-  workerScriptEngine(0), activeVME(0),
+  deferBindingUpdates(false), updatingPendingBindings(false),
+  bindingNotifications(0), bindingEvaluations(0),
+  workerScriptThreadCount(1), nextWorkerScriptEngine(0), activeVME(0),
   networkAccessManager(0), networkAccessManagerFactory(0), urlInterceptor(0),
   scarceResourcesRefCount(0), typeLoader(e), importDatabase(e), uniqueId(1),
   incubatorCount(0), incubationController(0), mutex(QMutex::Recursive)
@@ -541,6 +554,9 @@ QQmlEnginePrivate::~QQmlEnginePrivate()
 
     doDeleteInEngineThread();
 
+    if (!pendingBindings.isEmpty() && !enginesWithPendingBindings.isDestroyed())
+        enginesWithPendingBindings()->localData().removeOne(this);
+
     if (incubationController) incubationController->d = 0;
     incubationController = 0;
 
@@ -732,6 +748,8 @@ void QQmlData::flushPendingBindingImpl(int coreIndex)
 }
 
 bool QQmlEnginePrivate::baseModulesUninitialized = true;
+DEFINE_BOOL_CONFIG_OPTION(deferredBindings, QML_DEFERRED_BINDINGS);
+
 void QQmlEnginePrivate::init()
 {
     Q_Q(QQmlEngine);
@@ -771,14 +789,156 @@ void QQmlEnginePrivate::init()
         offlineStoragePath = dataLocation.replace(QLatin1Char('/'), QDir::separator())
                            + QDir::separator() + QLatin1String("QML")
                            + QDir::separator() + QLatin1String("OfflineStorage");
+
+    deferBindingUpdates = deferredBindings();
+
+    // QML_WORKERSCRIPT_THREADS=n spreads WorkerScripts over n threads; zero or
+    // a negative value uses one thread per core.
+    QByteArray workerThreads = qgetenv("QML_WORKERSCRIPT_THREADS");
+    if (!workerThreads.isEmpty()) {
+        bool ok = false;
+        int count = workerThreads.toInt(&ok);
+        if (ok)
+            workerScriptThreadCount = count > 0 ? count : qMax(1, QThread::idealThreadCount());
+    }
+}
+
+static QQmlJavaScriptExpression *javaScriptExpression(QQmlAbstractBinding *binding)
+{
+    switch (binding->bindingType()) {
+    case QQmlAbstractBinding::Binding:
+        return static_cast<QQmlBinding *>(binding);
+    case QQmlAbstractBinding::V8:
+        return static_cast<QV8Bindings::Binding *>(binding);
+    default:
+        return 0;
+    }
+}
+
+/*
+Queues \a binding, whose JavaScript \a expression was notified of a change,
+for the next call to updatePendingBindings().  A binding that is already
+queued is not queued again, which is where the evaluations are saved.
+*/
+void QQmlEnginePrivate::deferBindingUpdate(QQmlAbstractBinding *binding,
+                                           QQmlJavaScriptExpression *expression)
+{
+    ++bindingNotifications;
+    if (expression->isPendingUpdate())
+        return;
+    expression->setPendingUpdate(true);
+
+    if (pendingBindings.isEmpty() && !updatingPendingBindings) {
+        Q_Q(QQmlEngine);
+        enginesWithPendingBindings()->localData().append(this);
+        QCoreApplication::postEvent(q, new QEvent(UpdatePendingBindingsEvent));
+    }
+
+    PendingBinding pending = { QQmlAbstractBinding::getPointer(binding), expression };
+    pendingBindings.append(pending);
+}
+
+/*
+Updates the queued binding on \a object's property \a coreIndex, if there is
+one.  Called when a binding reads the property, so that the bindings it
+depends on are brought up to date first.
+*/
+void QQmlEnginePrivate::updatePendingBinding(QObject *object, int coreIndex)
+{
+    QQmlAbstractBinding *binding = QQmlPropertyPrivate::binding(object, coreIndex, -1);
+    if (!binding)
+        return;
+
+    QQmlJavaScriptExpression *expression = javaScriptExpression(binding);
+    if (expression && expression->isPendingUpdate())
+        updatePendingBinding(QQmlAbstractBinding::getPointer(binding), expression);
+}
+
+void QQmlEnginePrivate::updatePendingBinding(const QWeakPointer<QQmlAbstractBinding> &binding,
+                                             QQmlJavaScriptExpression *expression)
+{
+    ++bindingEvaluations;
+    binding.data()->update();
+
+    // The binding stays marked until it has been updated, so that it is not
+    // queued again by the changes it makes itself
+    if (!binding.isNull())
+        expression->setPendingUpdate(false);
+}
+
+void QQmlEnginePrivate::updatePendingBindings()
+{
+    if (updatingPendingBindings || pendingBindings.isEmpty())
+        return;
+
+    updatingPendingBindings = true;
+
+    // Updating a binding queues the bindings that depend on it, so keep going
+    // until nothing is left.  Only a binding loop keeps the queue filled.
+    int maxPasses = 1000;
+    while (!pendingBindings.isEmpty() && --maxPasses > 0) {
+        QList<PendingBinding> pending;
+        pending.swap(pendingBindings);
+
+        for (int ii = 0; ii < pending.count(); ++ii) {
+            const PendingBinding &p = pending.at(ii);
+            if (!p.binding.isNull() && p.expression->isPendingUpdate())
+                updatePendingBinding(p.binding, p.expression);
+        }
+    }
+
+    if (maxPasses == 0) {
+        qWarning("QQmlEngine: possible binding loop, dropping %d queued binding updates",
+                 pendingBindings.count());
+        for (int ii = 0; ii < pendingBindings.count(); ++ii) {
+            const PendingBinding &p = pendingBindings.at(ii);
+            if (!p.binding.isNull())
+                p.expression->setPendingUpdate(false);
+        }
+        pendingBindings.clear();
+    }
+
+    updatingPendingBindings = false;
+    enginesWithPendingBindings()->localData().removeOne(this);
 }
 
-QQuickWorkerScriptEngine *QQmlEnginePrivate::getWorkerScriptEngine()
+/*
+Updates the queued bindings of every engine in the current thread.  Called by
+QQuickWindow before it polishes items, so that a frame never shows values
+from before the last batch of changes.
+*/
+void QQmlEnginePrivate::updatePendingBindingsInThread()
+{
+    if (!enginesWithPendingBindings()->hasLocalData())
+        return;
+
+    const QList<QQmlEnginePrivate *> engines = enginesWithPendingBindings()->localData();
+    for (int ii = 0; ii < engines.count(); ++ii) {
+        // Updating one engine's bindings may have destroyed another engine
+        if (enginesWithPendingBindings()->localData().contains(engines.at(ii)))
+            engines.at(ii)->updatePendingBindings();
+    }
+}
+
+QQuickWorkerScriptEngine *QQmlEnginePrivate::getWorkerScriptEngine(int thread)
 {
     Q_Q(QQmlEngine);
-    if (!workerScriptEngine)
-        workerScriptEngine = new QQuickWorkerScriptEngine(q);
-    return workerScriptEngine;
+    const int count = qMax(1, workerScriptThreadCount);
+
+    int index;
+    if (thread >= 0) {
+        index = thread % count;
+    } else {
+        index = nextWorkerScriptEngine % count;
+        nextWorkerScriptEngine = (index + 1) % count;
+    }
+
+    if (workerScriptEngines.count() <= index)
+        workerScriptEngines.resize(index + 1);
+    // Threads are only started once a WorkerScript is actually assigned to them
+    if (!workerScriptEngines.at(index))
+        workerScriptEngines[index] = new QQuickWorkerScriptEngine(q);
+    return workerScriptEngines.at(index);
 }
 
 /*!
@@ -835,6 +995,9 @@ QQmlEngine::QQmlEngine(QQmlEnginePrivate &dd, QObject *parent)
     d->init();
 }
 
+DEFINE_BOOL_CONFIG_OPTION(compiledDataStats, QML_COMPILED_DATA_STATS);
+DEFINE_BOOL_CONFIG_OPTION(bindingUpdateStats, QML_BINDING_UPDATE_STATS);
+
 /*!
   Destroys the QQmlEngine.
 
@@ -851,6 +1014,16 @@ QQmlEngine::~QQmlEngine()
         QQmlEngineDebugService::instance()->remEngine(this);
     }
 
+    if (compiledDataStats())
+        QQmlMemoryProfiler::reportCompiledData(this);
+
+    if (bindingUpdateStats()) {
+        quint64 avoided = d->bindingNotifications > d->bindingEvaluations
+                        ? d->bindingNotifications - d->bindingEvaluations : 0;
+        qWarning("QQmlEngine: %llu binding change notifications, %llu deferred evaluations, %llu evaluations avoided",
+                 d->bindingNotifications, d->bindingEvaluations, avoided);
+    }
+
     // Emit onDestruction signals for the root context before
     // we destroy the contexts, engine, Singleton Types etc. that
     // may be required to handle the destruction signal.
@@ -897,6 +1070,7 @@ void QQmlEngine::clearComponentCache()
 {
     Q_D(QQmlEngine);
     d->typeLoader.clearCache();
+    d->internPool.trim();
 }
 
 /*!
@@ -915,6 +1089,7 @@ void QQmlEngine::trimComponentCache()
 {
     Q_D(QQmlEngine);
     d->typeLoader.trimCache();
+    d->internPool.trim();
 }
 
 /*!
@@ -1272,6 +1447,8 @@ bool QQmlEngine::event(QEvent *e)
     Q_D(QQmlEngine);
     if (e->type() == QEvent::User)
         d->doDeleteInEngineThread();
+    else if (e->type() == UpdatePendingBindingsEvent)
+        d->updatePendingBindings();
 
     return QJSEngine::event(e);
 }
@@ -2222,6 +2399,18 @@ void QQmlEnginePrivate::unregisterInternalCompositeType(QQmlCompiledData *data)
     m_compositeTypes.remove(ptr_type);
 }
 
+// Returns the url of the component registered as the pointer or list type \a t, or an empty
+// url if \a t is not an internal composite type.
+QUrl QQmlEnginePrivate::compositeTypeUrl(int t) const
+{
+    Locker locker(this);
+    QHash<int, int>::ConstIterator list = m_qmlLists.find(t);
+    if (list != m_qmlLists.end())
+        t = *list;
+    QHash<int, QQmlCompiledData *>::ConstIterator iter = m_compositeTypes.find(t);
+    return iter != m_compositeTypes.end() ? (*iter)->url : QUrl();
+}
+
 bool QQmlEnginePrivate::isTypeLoaded(const QUrl &url) const
 {
     return typeLoader.isTypeLoaded(url);
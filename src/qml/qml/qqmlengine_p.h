@@ -67,6 +67,7 @@
 #include "qqmlpropertycache_p.h"
 #include "qqmlmetatype_p.h"
 #include "qqmldirparser_p.h"
+#include "qqmlinternpool_p.h"
 #include <private/qintrusivelist_p.h>
 #include <private/qrecyclepool_p.h>
 
@@ -76,6 +77,8 @@
 #include <QtCore/qmutex.h>
 #include <QtCore/qstring.h>
 #include <QtCore/qthread.h>
+#include <QtCore/qvector.h>
+#include <QtCore/qsharedpointer.h>
 
 #include <private/qobject_p.h>
 
@@ -97,6 +100,7 @@ class QQmlTypeNameCache;
 class QQmlComponentAttached;
 class QQmlCleanup;
 class QQmlDelayedError;
+class QQmlJavaScriptExpression;
 class QQuickWorkerScriptEngine;
 class QQmlVME;
 class QDir;
@@ -157,10 +161,35 @@ public:
     QQmlDelayedError *erroredBindings;
     int inProgressCreations;
 
+    // With deferBindingUpdates set (QML_DEFERRED_BINDINGS), a binding is only
+    // queued when one of its dependencies changes.  Queued bindings are
+    // re-evaluated together before items are polished, or when the engine gets
+    // to the event posted when the queue was started.
+    struct PendingBinding {
+        QWeakPointer<QQmlAbstractBinding> binding;
+        QQmlJavaScriptExpression *expression;
+    };
+    QList<PendingBinding> pendingBindings;
+    bool deferBindingUpdates;
+    bool updatingPendingBindings;
+    quint64 bindingNotifications;
+    quint64 bindingEvaluations;
+
+    void deferBindingUpdate(QQmlAbstractBinding *, QQmlJavaScriptExpression *);
+    void updatePendingBinding(QObject *, int coreIndex);
+    void updatePendingBinding(const QWeakPointer<QQmlAbstractBinding> &, QQmlJavaScriptExpression *);
+    void updatePendingBindings();
+    static void updatePendingBindingsInThread();
+
     QV8Engine *v8engine() const { return q_func()->handle(); }
 
-    QQuickWorkerScriptEngine *getWorkerScriptEngine();
-    QQuickWorkerScriptEngine *workerScriptEngine;
+    // WorkerScripts are spread over a pool of up to workerScriptThreadCount
+    // threads, each with its own V8 isolate.  A negative index picks the next
+    // thread round-robin; otherwise the WorkerScript is pinned to that thread.
+    QQuickWorkerScriptEngine *getWorkerScriptEngine(int thread = -1);
+    QVector<QQuickWorkerScriptEngine *> workerScriptEngines;
+    int workerScriptThreadCount;
+    int nextWorkerScriptEngine;
 
     QUrl baseUrl;
 
@@ -197,6 +226,7 @@ public:
 
     QQmlTypeLoader typeLoader;
     QQmlImportDatabase importDatabase;
+    QQmlInternPool internPool;
 
     QString offlineStoragePath;
 
@@ -242,6 +272,7 @@ public:
     QQmlPropertyCache *rawPropertyCacheForType(int);
     void registerInternalCompositeType(QQmlCompiledData *);
     void unregisterInternalCompositeType(QQmlCompiledData *);
+    QUrl compositeTypeUrl(int) const;
 
     bool isTypeLoaded(const QUrl &url) const;
     bool isScriptLoaded(const QUrl &url) const;
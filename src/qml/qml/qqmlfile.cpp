@@ -393,10 +393,12 @@ void QQmlFile::load(QQmlEngine *engine, const QString &url)
         d->error = QQmlFilePrivate::NotFound;
 
         if (bundle) {
-            QString filename = url.mid(index);
+            QString filename = url.mid(index + 1);
             const QQmlBundle::FileEntry *entry = bundle->find(filename);
             if (entry) {
-                d->data = QByteArray(entry->contents(), entry->fileSize());
+                d->file = entry;
+                d->bundle = bundle;
+                d->bundle->addref();
                 d->error = QQmlFilePrivate::None;
             }
             bundle->release();
@@ -82,7 +82,7 @@ void QQmlCompiledData::dump(QQmlInstruction *instr, int idx)
         qWarning().nospace() << idx << "\t\t" << "SET_DEFAULT";
         break;
     case QQmlInstruction::CreateComponent:
-        qWarning().nospace() << idx << "\t\t" << "CREATE_COMPONENT\t" << instr->createComponent.count;
+        qWarning().nospace() << idx << "\t\t" << "CREATE_COMPONENT\t" << instr->createComponent.count << "\t" << instr->createComponent.lazyComponent;
         break;
     case QQmlInstruction::StoreMetaObject:
         qWarning().nospace() << idx << "\t\t" << "STORE_META\t\t";
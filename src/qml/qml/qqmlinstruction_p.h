@@ -428,6 +428,7 @@ union QQmlInstruction
     struct instr_createComponent {
         QML_INSTR_HEADER
         int count;
+        int lazyComponent;
         int endLine;
         int metaObject;
         ushort column;
@@ -0,0 +1,147 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the QtQml module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qqmlinternpool_p.h"
+
+QT_BEGIN_NAMESPACE
+
+/*!
+\class QQmlInternPool
+\brief The QQmlInternPool class shares identical strings between compiled QML documents.
+\internal
+
+Property names, ids and type names recur across most of the documents an application
+loads.  Each QQmlCompiledData passes its string tables through the engine's pool, so that
+they all refer to one implicitly shared copy of each string.  The pool may be used from
+the type loader thread.
+*/
+
+QQmlInternPool::QQmlInternPool()
+: m_hits(0), m_bytesSaved(0)
+{
+}
+
+/*!
+Returns the pooled copy of \a string, adding \a string to the pool if it is not there yet.
+*/
+QString QQmlInternPool::intern(const QString &string)
+{
+    QMutexLocker locker(&m_mutex);
+    QSet<QString>::const_iterator iter = m_strings.constFind(string);
+    if (iter != m_strings.constEnd()) {
+        if (iter->constData() != string.constData()) {
+            ++m_hits;
+            m_bytesSaved += string.size() * sizeof(QChar);
+        }
+        return *iter;
+    }
+    m_strings.insert(string);
+    return string;
+}
+
+/*!
+Returns the pooled copy of \a data, adding \a data to the pool if it is not there yet.
+*/
+QByteArray QQmlInternPool::intern(const QByteArray &data)
+{
+    QMutexLocker locker(&m_mutex);
+    QSet<QByteArray>::const_iterator iter = m_byteArrays.constFind(data);
+    if (iter != m_byteArrays.constEnd()) {
+        if (iter->constData() != data.constData()) {
+            ++m_hits;
+            m_bytesSaved += data.size();
+        }
+        return *iter;
+    }
+    m_byteArrays.insert(data);
+    return data;
+}
+
+/*!
+Removes the strings that are no longer used outside the pool.
+*/
+void QQmlInternPool::trim()
+{
+    QMutexLocker locker(&m_mutex);
+    for (QSet<QString>::iterator iter = m_strings.begin(); iter != m_strings.end();) {
+        if (iter->isDetached())
+            iter = m_strings.erase(iter);
+        else
+            ++iter;
+    }
+    for (QSet<QByteArray>::iterator iter = m_byteArrays.begin(); iter != m_byteArrays.end();) {
+        if (iter->isDetached())
+            iter = m_byteArrays.erase(iter);
+        else
+            ++iter;
+    }
+}
+
+void QQmlInternPool::clear()
+{
+    QMutexLocker locker(&m_mutex);
+    m_strings.clear();
+    m_byteArrays.clear();
+    m_hits = 0;
+    m_bytesSaved = 0;
+}
+
+/*!
+Returns the number of pooled strings in \a count and the bytes they occupy in \a bytes.
+\a hits returns how often a duplicate was replaced by a pooled string, and \a bytesSaved
+the size of the replaced duplicates.
+*/
+void QQmlInternPool::stats(int *count, int *bytes, int *hits, int *bytesSaved) const
+{
+    QMutexLocker locker(&m_mutex);
+    int size = 0;
+    foreach (const QString &string, m_strings)
+        size += string.size() * sizeof(QChar);
+    foreach (const QByteArray &data, m_byteArrays)
+        size += data.size();
+
+    if (count) *count = m_strings.count() + m_byteArrays.count();
+    if (bytes) *bytes = size;
+    if (hits) *hits = m_hits;
+    if (bytesSaved) *bytesSaved = m_bytesSaved;
+}
+
+QT_END_NAMESPACE
@@ -251,6 +251,12 @@ void QQmlJavaScriptExpression::GuardCapture::captureProperty(QQmlNotifier *n)
 void QQmlJavaScriptExpression::GuardCapture::captureProperty(QObject *o, int c, int n)
 {
     if (expression) {
+        // Bring a queued binding on the property up to date before it is read,
+        // so that deferred bindings are evaluated in dependency order
+        QQmlEnginePrivate *ep = QQmlEnginePrivate::get(engine);
+        if (!ep->pendingBindings.isEmpty())
+            ep->updatePendingBinding(o, c);
+
         if (n == -1) {
             if (!errorString) {
                 errorString = new QStringList;
@@ -122,6 +122,8 @@ public:
     inline bool useSharedContext() const;
     inline void setUseSharedContext(bool v);
     inline bool notifyOnValueChanged() const;
+    inline bool isPendingUpdate() const;
+    inline void setPendingUpdate(bool v);
 
     void setNotifyOnValueChanged(bool v);
     void resetNotifyOnValueChanged();
@@ -185,6 +187,7 @@ private:
     QPointerValuePair<VTable, QQmlDelayedError> m_vtable;
 
     // We store some flag bits in the following flag pointers.
+    //    m_vtable:flag1      - pendingUpdate
     //    m_scopeObject:flag1 - requiresThisObject
     //    activeGuards:flag1  - notifyOnValueChanged
     //    activeGuards:flag2  - useSharedContext
@@ -242,6 +245,16 @@ bool QQmlJavaScriptExpression::notifyOnValueChanged() const
     return activeGuards.flag();
 }
 
+bool QQmlJavaScriptExpression::isPendingUpdate() const
+{
+    return m_vtable.flag();
+}
+
+void QQmlJavaScriptExpression::setPendingUpdate(bool v)
+{
+    m_vtable.setFlagValue(v);
+}
+
 QObject *QQmlJavaScriptExpression::scopeObject() const
 {
     if (m_scopeObject.isT1()) return m_scopeObject.asT1();
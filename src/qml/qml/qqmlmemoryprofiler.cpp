@@ -40,7 +40,10 @@
 ****************************************************************************/
 
 #include "qqmlmemoryprofiler_p.h"
+#include "qqmlcompiler_p.h"
+#include "qqmlengine_p.h"
 #include <QUrl>
+#include <QDebug>
 
 QT_BEGIN_NAMESPACE
 
@@ -158,4 +161,51 @@ void QQmlMemoryProfiler::save(const char *filename)
         memprofile_save(filename);
 }
 
+/*!
+Returns in \a stats the memory used by the compiled QML documents cached by \a engine.
+The byte counts of the primitive and data tables count strings shared between documents
+once for each document, while the pooled bytes count them once.
+
+Unlike the other functions, this does not require the memory profiling library.
+*/
+void QQmlMemoryProfiler::compiledDataStats(QQmlEngine *engine, CompiledDataStats *stats)
+{
+    *stats = CompiledDataStats();
+
+    QQmlEnginePrivate *ep = QQmlEnginePrivate::get(engine);
+    foreach (QQmlCompiledData *data, ep->typeLoader.compiledData()) {
+        ++stats->componentCount;
+        stats->instructionBytes += data->bytecode.size();
+        stats->primitiveCount += data->primitives.count();
+        foreach (const QString &primitive, data->primitives)
+            stats->primitiveBytes += primitive.size() * sizeof(QChar);
+        stats->dataCount += data->datas.count();
+        foreach (const QByteArray &bytes, data->datas)
+            stats->dataBytes += bytes.size();
+        data->release();
+    }
+
+    ep->internPool.stats(&stats->pooledCount, &stats->pooledBytes,
+                         &stats->poolHits, &stats->poolBytesSaved);
+}
+
+/*!
+Prints the statistics returned by compiledDataStats() for \a engine.
+*/
+void QQmlMemoryProfiler::reportCompiledData(QQmlEngine *engine)
+{
+    CompiledDataStats stats;
+    compiledDataStats(engine, &stats);
+
+    qWarning().nospace() << "QML compiled data: " << stats.componentCount << " components";
+    qWarning().nospace() << "    instructions: " << stats.instructionBytes << " bytes";
+    qWarning().nospace() << "    primitives:   " << stats.primitiveCount << " strings, "
+                         << stats.primitiveBytes << " bytes";
+    qWarning().nospace() << "    datas:        " << stats.dataCount << " entries, "
+                         << stats.dataBytes << " bytes";
+    qWarning().nospace() << "    intern pool:  " << stats.pooledCount << " entries, "
+                         << stats.pooledBytes << " bytes, " << stats.poolHits << " hits, "
+                         << stats.poolBytesSaved << " bytes saved";
+}
+
 QT_END_NAMESPACE
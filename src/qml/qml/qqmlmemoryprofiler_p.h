@@ -47,6 +47,7 @@
 QT_BEGIN_NAMESPACE
 
 class QUrl;
+class QQmlEngine;
 
 class Q_QML_PRIVATE_EXPORT QQmlMemoryScope
 {
@@ -69,6 +70,21 @@ public:
     static void clear();
     static void stats(int *allocCount, int *bytesAllocated);
     static void save(const char *filename);
+
+    struct CompiledDataStats {
+        int componentCount;
+        int instructionBytes;
+        int primitiveCount;
+        int primitiveBytes;
+        int dataCount;
+        int dataBytes;
+        int pooledCount;
+        int pooledBytes;
+        int poolHits;
+        int poolBytesSaved;
+    };
+    static void compiledDataStats(QQmlEngine *engine, CompiledDataStats *stats);
+    static void reportCompiledData(QQmlEngine *engine);
 };
 
 #define QML_MEMORY_SCOPE_URL(url)       QQmlMemoryScope _qml_memory_scope(url)
@@ -52,6 +52,7 @@
 #include <private/qqmlrewrite_p.h>
 
 #include <QtCore/qdebug.h>
+#include <QtCore/qmutex.h>
 
 #include <ctype.h> // for toupper
 #include <limits.h>
@@ -65,6 +66,9 @@ QT_BEGIN_NAMESPACE
 
 #define Q_INT16_MAX 32767
 
+// Guards the data property caches build lazily, as types are compiled on several threads
+Q_GLOBAL_STATIC_WITH_ARGS(QMutex, lazyDataMutex, (QMutex::Recursive))
+
 class QQmlPropertyCacheMethodArguments
 {
 public:
@@ -242,7 +246,7 @@ Creates a new empty QQmlPropertyCache.
 */
 QQmlPropertyCache::QQmlPropertyCache(QQmlEngine *e)
 : engine(e), _parent(0), propertyIndexCacheStart(0), methodIndexCacheStart(0),
-  signalHandlerIndexCacheStart(0), _hasPropertyOverrides(false), _ownMetaObject(false),
+  signalHandlerIndexCacheStart(0), nameTable(0), _hasPropertyOverrides(false), _ownMetaObject(false),
   _metaObject(0), argumentsCache(0)
 {
     Q_ASSERT(engine);
@@ -253,7 +257,7 @@ Creates a new QQmlPropertyCache of \a metaObject.
 */
 QQmlPropertyCache::QQmlPropertyCache(QQmlEngine *e, const QMetaObject *metaObject)
 : engine(e), _parent(0), propertyIndexCacheStart(0), methodIndexCacheStart(0),
-  signalHandlerIndexCacheStart(0), _hasPropertyOverrides(false), _ownMetaObject(false),
+  signalHandlerIndexCacheStart(0), nameTable(0), _hasPropertyOverrides(false), _ownMetaObject(false),
   _metaObject(0), argumentsCache(0)
 {
     Q_ASSERT(engine);
@@ -277,6 +281,7 @@ QQmlPropertyCache::~QQmlPropertyCache()
 
     // We must clear this prior to releasing the parent incase it is a
     // linked hash
+    clearNameTable();
     stringCache.clear();
     if (_parent) _parent->release();
 
@@ -519,6 +524,10 @@ const QMetaObject *QQmlPropertyCache::metaObject() const
 const QMetaObject *QQmlPropertyCache::createMetaObject()
 {
     if (!_metaObject) {
+        QMutexLocker locker(lazyDataMutex());
+        if (_metaObject)
+            return _metaObject;
+
         _ownMetaObject = true;
 
         QMetaObjectBuilder builder;
@@ -807,14 +816,18 @@ QQmlPropertyData *QQmlPropertyCache::ensureResolved(QQmlPropertyData *p) const
 
 void QQmlPropertyCache::resolve(QQmlPropertyData *data) const
 {
-    Q_ASSERT(data->notFullyResolved());
-
-    data->propType = QMetaType::type(data->propTypeName);
+    QMutexLocker locker(lazyDataMutex());
+    if (!data->notFullyResolved())
+        return;
 
+    int propType = QMetaType::type(data->propTypeName);
+    quint32 flags = data->flags;
     if (!data->isFunction())
-        data->flags |= flagsForPropertyType(data->propType, engine);
+        flags |= flagsForPropertyType(propType, engine);
 
-    data->flags &= ~QQmlPropertyData::NotFullyResolved;
+    // propType shares its storage with propTypeName
+    data->propType = propType;
+    data->flags = flags & ~QQmlPropertyData::NotFullyResolved;
 }
 
 void QQmlPropertyCache::updateRecur(QQmlEngine *engine, const QMetaObject *metaObject)
@@ -856,6 +869,7 @@ void QQmlPropertyCache::update(QQmlEngine *engine, const QMetaObject *metaObject
 */
 void QQmlPropertyCache::invalidate(QQmlEngine *engine, const QMetaObject *metaObject)
 {
+    clearNameTable();
     stringCache.clear();
     propertyIndexCache.clear();
     methodIndexCache.clear();
@@ -863,6 +877,7 @@ void QQmlPropertyCache::invalidate(QQmlEngine *engine, const QMetaObject *metaOb
 
     _hasPropertyOverrides = false;
     argumentsCache = 0;
+    overloadCache.clear();
 
     int pc = metaObject->propertyCount();
     int mc = metaObject->methodCount();
@@ -940,6 +955,60 @@ QQmlPropertyCache::method(int index) const
     return ensureResolved(rv);
 }
 
+static inline bool sameName(const QStringHashNode *node, const QStringHashNode *other)
+{
+    if (other->isQString())
+        return node->equals(QHashedStringRef((const QChar *)other->utf16Data(), other->length,
+                                             other->hash));
+    return node->equals(QHashedCStringRef(other->cStrData(), other->length, other->hash));
+}
+
+/*!
+Returns the name table of this cache, building it if necessary.  The table is built the first
+time a property is looked up by name, and is discarded whenever a name is added to the cache.
+*/
+const QQmlPropertyCache::NameTable *QQmlPropertyCache::createNameTable() const
+{
+    QMutexLocker locker(lazyDataMutex());
+    if (const NameTable *table = nameTable.loadAcquire())
+        return table;
+
+    // Keep the table at most half full, so that probe sequences stay short
+    int size = 2;
+    while (size < stringCache.count() * 2)
+        size <<= 1;
+
+    NameTable *table = new NameTable;
+    table->mask = size - 1;
+    table->entries.resize(size);
+    NameTable::Entry *entries = table->entries.data();
+
+    // Nodes of the same name share a bucket, and the first of them in the bucket chain is the one
+    // stringCache.find() returns
+    for (int ii = 0; ii < stringCache.data.numBuckets; ++ii) {
+        for (QStringHashNode *node = stringCache.data.buckets[ii]; node; node = *node->next) {
+            quint32 index = node->hash & table->mask;
+            while (entries[index].iter.node() && !(entries[index].hash == node->hash
+                                                   && sameName(entries[index].iter.node(), node)))
+                index = (index + 1) & table->mask;
+
+            if (!entries[index].iter.node()) {
+                entries[index].hash = node->hash;
+                entries[index].iter = stringCache.iterator(static_cast<StringCache::Node *>(node));
+            }
+        }
+    }
+
+    nameTable.storeRelease(table);
+    return table;
+}
+
+void QQmlPropertyCache::clearNameTable()
+{
+    if (nameTable.load())
+        delete nameTable.fetchAndStoreOrdered(0);
+}
+
 QQmlPropertyData *QQmlPropertyCache::findProperty(StringCache::ConstIterator it, QObject *object, QQmlContextData *context) const
 {
     QQmlData *data = (object ? QQmlData::get(object) : 0);
@@ -1097,12 +1166,31 @@ QQmlPropertyCacheMethodArguments *QQmlPropertyCache::createArgumentsObject(int a
     return args;
 }
 
+/*! \internal
+    Returns the argument \a types and \a names recorded for the method or signal \a data,
+    which must have been appended to a property cache with appendSignal() or appendMethod().
+*/
+void QQmlPropertyCache::methodArguments(const QQmlPropertyData *data, QList<int> *types,
+                                        QList<QByteArray> *names)
+{
+    if (!data->hasArguments() || !data->arguments)
+        return;
+
+    QQmlPropertyCacheMethodArguments *args = (QQmlPropertyCacheMethodArguments *)data->arguments;
+    for (int ii = 0; ii < args->arguments[0]; ++ii)
+        types->append(args->arguments[ii + 1]);
+    if (args->names)
+        *names = *args->names;
+}
+
 /*! \internal
     \a index MUST be in the signal index range (see QObjectPrivate::signalIndex()).
     This is different from QMetaMethod::methodIndex().
 */
 QString QQmlPropertyCache::signalParameterStringForJS(int index, int *count, QString *errorString)
 {
+    QMutexLocker locker(lazyDataMutex());
+
     QQmlPropertyCache *c = 0;
     QQmlPropertyData *signalData = signal(index, &c);
     if (!signalData)
@@ -1291,6 +1379,28 @@ int QQmlPropertyCache::methodReturnType(QObject *object, const QQmlPropertyData
     return type;
 }
 
+/*!
+Returns the overload of a method previously recorded for \a signature with
+setResolvedOverload(), or 0 if there is none.
+
+The signature is opaque to the cache.  The caller encodes the method and the
+types of the arguments it is called with into it.
+*/
+QQmlPropertyData *QQmlPropertyCache::resolvedOverload(const QByteArray &signature) const
+{
+    QHash<QByteArray, int>::ConstIterator iter = overloadCache.find(signature);
+    return iter == overloadCache.end() ? 0 : method(*iter);
+}
+
+/*!
+Records that calls matching \a signature resolve to the method \a coreIndex.
+*/
+void QQmlPropertyCache::setResolvedOverload(const QByteArray &signature, int coreIndex)
+{
+    // The signature may be a raw data reference to the caller's stack
+    overloadCache.insert(QByteArray(signature.constData(), signature.size()), coreIndex);
+}
+
 int QQmlPropertyCache::originalClone(int index)
 {
     while (signal(index)->isCloned())
@@ -59,6 +59,7 @@
 #include "qqmlnotifier_p.h"
 
 #include <private/qhashedstring_p.h>
+#include <QtCore/qhash.h>
 #include <QtCore/qvarlengtharray.h>
 #include <QtCore/qvector.h>
 
@@ -282,7 +283,10 @@ public:
     template<typename K>
     QQmlPropertyData *property(const K &key, QObject *object, QQmlContextData *context) const
     {
-        return findProperty(stringCache.find(key), object, context);
+        const NameTable *table = nameTable.loadAcquire();
+        if (!table)
+            table = createNameTable();
+        return findProperty(table->find(key), object, context);
     }
 
     QQmlPropertyData *property(int) const;
@@ -309,6 +313,9 @@ public:
     static int methodReturnType(QObject *, const QQmlPropertyData &data,
                                 QByteArray *unknownTypeError);
 
+    QQmlPropertyData *resolvedOverload(const QByteArray &signature) const;
+    void setResolvedOverload(const QByteArray &signature, int coreIndex);
+
     //see QMetaObjectPrivate::originalClone
     int originalClone(int index);
     static int originalClone(QObject *, int index);
@@ -337,6 +344,8 @@ private:
     friend class QQmlEnginePrivate;
     friend class QV8QObjectWrapper;
     friend class QQmlCompiler;
+    friend class QQmlCompilationCacheReader;
+    friend class QQmlCompilationCacheWriter;
 
     inline QQmlPropertyCache *copy(int reserve);
 
@@ -351,11 +360,47 @@ private:
     QQmlPropertyCacheMethodArguments *createArgumentsObject(int count,
                                                             const QList<QByteArray> &names = QList<QByteArray>());
     QQmlPropertyData *signal(int, QQmlPropertyCache **) const;
+    static void methodArguments(const QQmlPropertyData *, QList<int> *types,
+                                QList<QByteArray> *names);
 
     typedef QVector<QQmlPropertyData> IndexCache;
     typedef QStringMultiHash<QPair<int, QQmlPropertyData *> > StringCache;
     typedef QVector<int> AllowedRevisionCache;
 
+    // A flat, open addressed index of the names in stringCache, including those of the parent
+    // caches.  Each name maps to the node that stringCache.find() would return, so a lookup is a
+    // probe of a contiguous array instead of a walk of the bucket chains.
+    struct NameTable
+    {
+        struct Entry
+        {
+            Entry() : hash(0) {}
+
+            quint32 hash;
+            StringCache::ConstIterator iter;
+        };
+
+        quint32 mask;
+        QVector<Entry> entries;
+
+        template<typename K>
+        StringCache::ConstIterator find(const K &key) const
+        {
+            typename HashedForm<K>::Type hashedKey(QStringHashBase::hashedString(key));
+            quint32 hash = hashedKey.hash();
+
+            const Entry *data = entries.constData();
+            for (quint32 ii = hash & mask; data[ii].iter.node(); ii = (ii + 1) & mask) {
+                if (data[ii].hash == hash && data[ii].iter.equals(hashedKey))
+                    return data[ii].iter;
+            }
+            return StringCache::ConstIterator();
+        }
+    };
+
+    const NameTable *createNameTable() const;
+    void clearNameTable();
+
     QQmlPropertyData *findProperty(StringCache::ConstIterator it, QObject *, QQmlContextData *) const;
     QQmlPropertyData *findProperty(StringCache::ConstIterator it, const QQmlVMEMetaObject *, QQmlContextData *) const;
 
@@ -374,6 +419,7 @@ private:
     template<typename K>
     void setNamedProperty(const K &key, int index, QQmlPropertyData *data, bool isOverride)
     {
+        clearNameTable();
         stringCache.insert(key, qMakePair(index, data));
         _hasPropertyOverrides |= isOverride;
     }
@@ -389,8 +435,10 @@ private:
     IndexCache methodIndexCache;
     IndexCache signalHandlerIndexCache;
     StringCache stringCache;
+    mutable QAtomicPointer<NameTable> nameTable;
     AllowedRevisionCache allowedRevisionCache;
     v8::Persistent<v8::Function> constructor;
+    QHash<QByteArray, int> overloadCache;
 
     bool _hasPropertyOverrides : 1;
     bool _ownMetaObject : 1;
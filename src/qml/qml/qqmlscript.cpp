@@ -1730,6 +1730,7 @@ void QQmlScript::Parser::clear()
         data = 0;
     }
 
+    root = 0;
     _pool.clear();
 }
 
@@ -49,6 +49,7 @@
 #include <private/qqmlcomponent_p.h>
 #include <private/qqmlprofilerservice_p.h>
 #include <private/qqmlmemoryprofiler_p.h>
+#include <private/qqmltypenamecache_p.h>
 
 #include <QtCore/qdir.h>
 #include <QtCore/qfile.h>
@@ -148,11 +149,13 @@ public:
     void callCompleted(QQmlDataBlob *b);
     void callDownloadProgressChanged(QQmlDataBlob *b, qreal p);
     void initializeEngine(QQmlExtensionInterface *, const char *);
+    void finishBackgroundDone();
 
 protected:
     virtual void shutdownThread();
 
 private:
+    void finishBackgroundDoneThread();
     void loadThread(QQmlDataBlob *b);
     void loadWithStaticDataThread(QQmlDataBlob *b, const QByteArray &);
     void callCompletedMain(QQmlDataBlob *b);
@@ -239,7 +242,7 @@ Create a new QQmlDataBlob for \a url and of the provided \a type.
 */
 QQmlDataBlob::QQmlDataBlob(const QUrl &url, Type type)
 : m_type(type), m_url(url), m_finalUrl(url), m_manager(0), m_redirectCount(0), 
-  m_inCallback(false), m_isDone(false)
+  m_inCallback(false), m_isDone(false), m_isDoneDeferred(false)
 {
 }
 
@@ -359,11 +362,12 @@ Returns the final url of the data.  Initially this is the same as
 url(), but if a network redirect happens while fetching the data, this url
 is updated to reflect the new location.
 
-May only be called from the load thread, or after the blob isCompleteOrError().
+May only be called from the load thread, from doneInBackground(), or after the blob
+isCompleteOrError().
 */
 QUrl QQmlDataBlob::finalUrl() const
 {
-    Q_ASSERT(isCompleteOrError() || (m_manager && m_manager->m_thread->isThisThread()));
+    Q_ASSERT(isCompleteOrError() || m_isDoneDeferred || (m_manager && m_manager->m_thread->isThisThread()));
     return m_finalUrl;
 }
 
@@ -372,7 +376,7 @@ Returns the finalUrl() as a string.
 */
 QString QQmlDataBlob::finalUrlString() const
 {
-    Q_ASSERT(isCompleteOrError() || (m_manager && m_manager->m_thread->isThisThread()));
+    Q_ASSERT(isCompleteOrError() || m_isDoneDeferred || (m_manager && m_manager->m_thread->isThisThread()));
     if (m_finalUrlString.isEmpty())
         m_finalUrlString = m_finalUrl.toString();
 
@@ -382,11 +386,12 @@ QString QQmlDataBlob::finalUrlString() const
 /*!
 Return the errors on this blob.
 
-May only be called from the load thread, or after the blob isCompleteOrError().
+May only be called from the load thread, from doneInBackground(), or after the blob
+isCompleteOrError().
 */
 QList<QQmlError> QQmlDataBlob::errors() const
 {
-    Q_ASSERT(isCompleteOrError() || (m_manager && m_manager->m_thread->isThisThread()));
+    Q_ASSERT(isCompleteOrError() || m_isDoneDeferred || (m_manager && m_manager->m_thread->isThisThread()));
     return m_errors;
 }
 
@@ -481,6 +486,34 @@ void QQmlDataBlob::done()
 {
 }
 
+/*!
+Hands the remainder of the processing started in done() to a worker thread, where
+doneInBackground() is invoked.  The blob only becomes complete, and the blobs waiting for it
+are only notified, once doneInBackground() has returned.
+
+This may only be called from within done(), and only if QQmlDataLoader::workerThreadCount()
+is not 0.
+*/
+void QQmlDataBlob::deferDone()
+{
+    ASSERT_CALLBACK();
+    Q_ASSERT(m_isDone && m_manager->workerThreadCount() > 0);
+
+    m_isDoneDeferred = true;
+}
+
+/*!
+Invoked on a worker thread after done() called deferDone().
+
+The blob must not access other blobs that are not complete, nor add dependencies.  You can set
+an error in this method.
+
+The default implementation does nothing.
+*/
+void QQmlDataBlob::doneInBackground()
+{
+}
+
 /*!
 Invoked if there is a network error while fetching this blob.
 
@@ -610,22 +643,33 @@ void QQmlDataBlob::tryDone()
 #endif
         done();
 
-        if (status() != Error)
-            m_data.setStatus(Complete);
+        if (m_isDoneDeferred) {
+            // finishDone() is called once doneInBackground() has returned
+            m_manager->startDoneInBackground(this);
+            return;
+        }
+
+        finishDone();
+    }
+}
+
+void QQmlDataBlob::finishDone()
+{
+    if (status() != Error)
+        m_data.setStatus(Complete);
 
-        notifyAllWaitingOnMe();
+    notifyAllWaitingOnMe();
 
-        // Locking is not required here, as anyone expecting callbacks must
-        // already be protected against the blob being completed (as set above);
-        if (m_data.isAsync()) {
+    // Locking is not required here, as anyone expecting callbacks must
+    // already be protected against the blob being completed (as set above);
+    if (m_data.isAsync()) {
 #ifdef DATABLOB_DEBUG
-            qWarning("QQmlDataBlob: Dispatching completed");
+        qWarning("QQmlDataBlob: Dispatching completed");
 #endif
-            m_manager->m_thread->callCompleted(this);
-        }
-
-        release();
+        m_manager->m_thread->callCompleted(this);
     }
+
+    release();
 }
 
 void QQmlDataBlob::cancelAllWaitingFor()
@@ -795,6 +839,11 @@ void QQmlDataLoaderThread::initializeEngine(QQmlExtensionInterface *iface,
     callMethodInMain(&This::initializeEngineMain, iface, uri);
 }
 
+void QQmlDataLoaderThread::finishBackgroundDone()
+{
+    postMethodToThread(&This::finishBackgroundDoneThread);
+}
+
 void QQmlDataLoaderThread::shutdownThread()
 {
     delete m_networkAccessManager;
@@ -803,18 +852,45 @@ void QQmlDataLoaderThread::shutdownThread()
     m_networkReplyProxy = 0;
 }
 
+void QQmlDataLoaderThread::finishBackgroundDoneThread()
+{
+    m_loader->finishBackgroundDone();
+}
+
 void QQmlDataLoaderThread::loadThread(QQmlDataBlob *b) 
 { 
     m_loader->loadThread(b); 
+    if (!b->m_data.isAsync())
+        m_loader->waitForBackgroundDone(b);
     b->release();
 }
 
 void QQmlDataLoaderThread::loadWithStaticDataThread(QQmlDataBlob *b, const QByteArray &d)
 {
     m_loader->loadWithStaticDataThread(b, d);
+    if (!b->m_data.isAsync())
+        m_loader->waitForBackgroundDone(b);
     b->release();
 }
 
+class QQmlDataBlobDoneJob : public QRunnable
+{
+public:
+    QQmlDataBlobDoneJob(QQmlDataLoader *loader, QQmlDataBlob *blob)
+    : m_loader(loader), m_blob(blob) {}
+
+    virtual void run()
+    {
+        QML_MEMORY_SCOPE_URL(m_blob->url());
+        m_blob->doneInBackground();
+        m_loader->doneInBackgroundFinished(m_blob);
+    }
+
+private:
+    QQmlDataLoader *m_loader;
+    QQmlDataBlob *m_blob;
+};
+
 void QQmlDataLoaderThread::callCompletedMain(QQmlDataBlob *b) 
 { 
     QML_MEMORY_SCOPE_URL(b->url());
@@ -876,8 +952,11 @@ Thus QQmlDataBlob::done() will always eventually be called, even if the blob has
 Create a new QQmlDataLoader for \a engine.
 */
 QQmlDataLoader::QQmlDataLoader(QQmlEngine *engine)
-: m_engine(engine), m_thread(new QQmlDataLoaderThread(this))
+: m_engine(engine), m_thread(new QQmlDataLoaderThread(this)), m_backgroundPending(0)
 {
+    // Parallel compilation is opt-in
+    QByteArray threadCountEnv = qgetenv("QML_COMPILER_THREADS");
+    setWorkerThreadCount(threadCountEnv.isEmpty() ? 0 : threadCountEnv.toInt());
 }
 
 /*! \internal */
@@ -888,6 +967,10 @@ QQmlDataLoader::~QQmlDataLoader()
 
     shutdownThread();
     delete m_thread;
+
+    // Blobs finished in the background after the thread stopped processing messages
+    for (int ii = 0; ii < m_backgroundFinished.count(); ++ii)
+        m_backgroundFinished.at(ii)->release();
 }
 
 void QQmlDataLoader::lock()
@@ -1167,8 +1250,95 @@ void QQmlDataLoader::setData(QQmlDataBlob *blob, const QQmlDataBlob::Data &d)
 
 void QQmlDataLoader::shutdownThread()
 {
-    if (!m_thread->isShutdown())
+    if (!m_thread->isShutdown()) {
+        m_workerPool.waitForDone();
         m_thread->shutdown();
+    }
+}
+
+/*!
+Returns the number of worker threads that blobs may continue their processing on after
+done().  Types are compiled on these threads, so that independent types are compiled in
+parallel.  If the count is 0, all processing happens on the load thread.
+
+The count defaults to 0.  Parallel compilation can be enabled with the QML_COMPILER_THREADS
+environment variable, or with setWorkerThreadCount().
+*/
+int QQmlDataLoader::workerThreadCount() const
+{
+    return m_workerThreadCount;
+}
+
+/*!
+Sets the number of worker threads to \a count.  This must be called before any blobs are
+loaded.
+*/
+void QQmlDataLoader::setWorkerThreadCount(int count)
+{
+    m_workerThreadCount = qMax(0, count);
+    if (m_workerThreadCount > 0)
+        m_workerPool.setMaxThreadCount(m_workerThreadCount);
+}
+
+void QQmlDataLoader::startDoneInBackground(QQmlDataBlob *blob)
+{
+    ASSERT_LOADTHREAD();
+
+    {
+        QMutexLocker locker(&m_backgroundMutex);
+        ++m_backgroundPending;
+    }
+    m_workerPool.start(new QQmlDataBlobDoneJob(this, blob));
+}
+
+// Called on the worker thread
+void QQmlDataLoader::doneInBackgroundFinished(QQmlDataBlob *blob)
+{
+    {
+        QMutexLocker locker(&m_backgroundMutex);
+        m_backgroundFinished.append(blob);
+        m_backgroundCondition.wakeAll();
+    }
+    m_thread->finishBackgroundDone();
+}
+
+void QQmlDataLoader::finishBackgroundDone()
+{
+    ASSERT_LOADTHREAD();
+
+    QList<QQmlDataBlob *> finished;
+    {
+        QMutexLocker locker(&m_backgroundMutex);
+        finished.swap(m_backgroundFinished);
+        m_backgroundPending -= finished.count();
+    }
+
+    for (int ii = 0; ii < finished.count(); ++ii) {
+        QQmlDataBlob *blob = finished.at(ii);
+        blob->m_isDoneDeferred = false;
+        blob->finishDone();
+    }
+}
+
+/*!
+Processes the blobs finished in the background until \a blob is complete, or until no blob is
+processed in the background anymore.  This keeps loads that are expected to be synchronous
+synchronous.
+*/
+void QQmlDataLoader::waitForBackgroundDone(QQmlDataBlob *blob)
+{
+    ASSERT_LOADTHREAD();
+
+    while (!blob->m_isDone || blob->m_isDoneDeferred) {
+        {
+            QMutexLocker locker(&m_backgroundMutex);
+            if (m_backgroundPending == 0)
+                return;
+            while (m_backgroundFinished.isEmpty())
+                m_backgroundCondition.wait(&m_backgroundMutex);
+        }
+        finishBackgroundDone();
+    }
 }
 
 QQmlTypeLoader::Blob::Blob(const QUrl &url, QQmlDataBlob::Type type, QQmlTypeLoader *loader)
@@ -1447,8 +1617,11 @@ QString QQmlTypeLoader::QmldirContent::pluginLocation() const
 Constructs a new type loader that uses the given \a engine.
 */
 QQmlTypeLoader::QQmlTypeLoader(QQmlEngine *engine)
-: QQmlDataLoader(engine)
+: QQmlDataLoader(engine), m_compilationCache(0)
 {
+    QByteArray cachePath = qgetenv("QML_COMPILATION_CACHE_DIR");
+    if (!cachePath.isEmpty())
+        m_compilationCache = new QQmlCompilationCache(QString::fromLocal8Bit(cachePath));
 }
 
 /*!
@@ -1461,6 +1634,8 @@ QQmlTypeLoader::~QQmlTypeLoader()
     shutdownThread();
 
     clearCache();
+
+    delete m_compilationCache;
 }
 
 QQmlImportDatabase *QQmlTypeLoader::importDatabase()
@@ -1608,7 +1783,9 @@ void QQmlTypeLoader::addBundle(const QString &identifier, const QString &fileNam
 void QQmlTypeLoader::addBundleNoLock(const QString &identifier, const QString &fileName)
 {
     QQmlBundleData *data = new QQmlBundleData(fileName);
-    if (data->open()) {
+    // Opened read only, so that file contents are used straight from the
+    // mapping and deployed bundles do not need to be writable.
+    if (data->open(QIODevice::ReadOnly)) {
 
         m_bundleCache.insert(identifier, data);
 
@@ -1681,6 +1858,8 @@ QString QQmlTypeLoader::absoluteFilePath(const QString &path)
     int lastSlash = path.lastIndexOf(QLatin1Char('/'));
     QStringRef dirPath(&path, 0, lastSlash);
 
+    // Types are also resolved while compiling on worker threads
+    QMutexLocker locker(&m_importDirCacheMutex);
     StringSet **fileSet = m_importDirCache.value(QHashedStringRef(dirPath.constData(), dirPath.length()));
     if (!fileSet) {
         QHashedString dirPathString(dirPath.toString());
@@ -1753,6 +1932,8 @@ bool QQmlTypeLoader::directoryExists(const QString &path)
         --length;
     QStringRef dirPath(&path, 0, length);
 
+    // Types are also resolved while compiling on worker threads
+    QMutexLocker locker(&m_importDirCacheMutex);
     StringSet **fileSet = m_importDirCache.value(QHashedStringRef(dirPath.constData(), dirPath.length()));
     if (!fileSet) {
         QHashedString dirPathString(dirPath.toString());
@@ -1865,6 +2046,8 @@ and qmldir information.
 */
 void QQmlTypeLoader::clearCache()
 {
+    QMutexLocker locker(&m_importDirCacheMutex);
+
     for (TypeCache::Iterator iter = m_typeCache.begin(); iter != m_typeCache.end(); ++iter)
         (*iter)->release();
     for (ScriptCache::Iterator iter = m_scriptCache.begin(); iter != m_scriptCache.end(); ++iter) 
@@ -1908,6 +2091,24 @@ void QQmlTypeLoader::trimCache()
     // TODO: release any scripts which are no longer referenced by any types
 }
 
+/*!
+Returns the compiled data of all cached types.  The caller must release the returned
+compiled data.
+*/
+QList<QQmlCompiledData *> QQmlTypeLoader::compiledData()
+{
+    LockHolder<QQmlTypeLoader> holder(this);
+
+    QList<QQmlCompiledData *> rv;
+    for (TypeCache::Iterator iter = m_typeCache.begin(); iter != m_typeCache.end(); ++iter) {
+        if (QQmlCompiledData *data = iter.value()->m_compiledData) {
+            data->addref();
+            rv.append(data);
+        }
+    }
+    return rv;
+}
+
 bool QQmlTypeLoader::isTypeLoaded(const QUrl &url) const
 {
     LockHolder<QQmlTypeLoader> holder(const_cast<QQmlTypeLoader *>(this));
@@ -1920,13 +2121,34 @@ bool QQmlTypeLoader::isScriptLoaded(const QUrl &url) const
     return m_scriptCache.contains(url);
 }
 
+/*!
+Returns the cache used to store compiled QML documents on disk, or 0 if compiled documents
+are not cached.
+*/
+QQmlCompilationCache *QQmlTypeLoader::compilationCache() const
+{
+    return m_compilationCache;
+}
+
+/*!
+Stores compiled QML documents in the directory \a path, which overrides the
+QML_COMPILATION_CACHE_DIR environment variable.  An empty \a path disables the cache.
+
+This must be called before any types are loaded.
+*/
+void QQmlTypeLoader::setCompilationCachePath(const QString &path)
+{
+    delete m_compilationCache;
+    m_compilationCache = path.isEmpty() ? 0 : new QQmlCompilationCache(path);
+}
+
 QQmlTypeData::TypeDataCallback::~TypeDataCallback()
 {
 }
 
 QQmlTypeData::QQmlTypeData(const QUrl &url, QQmlTypeLoader::Options options, 
                                            QQmlTypeLoader *manager)
-: QQmlTypeLoader::Blob(url, QmlFile, manager), m_options(options),
+: QQmlTypeLoader::Blob(url, QmlFile, manager), m_options(options), m_compiledFromCache(false),
    m_typesResolved(false), m_compiledData(0), m_implicitImport(0), m_implicitImportLoaded(false)
 {
 }
@@ -1937,11 +2159,35 @@ QQmlTypeData::~QQmlTypeData()
         m_scripts.at(ii).script->release();
     for (int ii = 0; ii < m_types.count(); ++ii) 
         if (m_types.at(ii).typeData) m_types.at(ii).typeData->release();
-    if (m_compiledData)
+    if (m_compiledData) {
+        if (m_compiledData->lazyUnit == this)
+            m_compiledData->lazyUnit = 0;
         m_compiledData->release();
+    }
     delete m_implicitImport;
 }
 
+/*!
+\internal
+
+If components created from the compiled data still have bodies left to compile, the type data
+is handed over to the compiled data rather than deleted, as the bodies are compiled from its
+source.
+*/
+void QQmlTypeData::destroy()
+{
+    if (m_compiledData && m_compiledData->lazyUnit == this && m_compiledData->count() > 1
+        && m_compiledData->hasPendingLazyComponents()) {
+        QQmlCompiledData *compiledData = m_compiledData;
+        m_compiledData = 0;
+        compiledData->ownsLazyUnit = true;
+        compiledData->release();
+        return;
+    }
+
+    QQmlTypeLoader::Blob::destroy();
+}
+
 const QQmlScript::Parser &QQmlTypeData::parser() const
 {
     return scriptParser;
@@ -1967,6 +2213,52 @@ QQmlCompiledData *QQmlTypeData::compiledData() const
     return m_compiledData;
 }
 
+/*!
+Returns the key identifying the compiled form of this type in the compilation cache, which
+covers its source and everything it depends on.  The key is empty if the type is not cached.
+*/
+QByteArray QQmlTypeData::cacheKey() const
+{
+    return m_cacheKey;
+}
+
+/*!
+Returns true if the compiled data was read from the compilation cache rather than compiled from
+the source.
+*/
+bool QQmlTypeData::isCompiledFromCache() const
+{
+    return m_compiledFromCache;
+}
+
+/*!
+Returns a new type name cache for the namespaces, scripts and types imported by this type.
+*/
+QQmlTypeNameCache *QQmlTypeData::createImportCache() const
+{
+    QQmlTypeNameCache *cache = new QQmlTypeNameCache();
+    foreach (const QString &ns, m_namespaces) {
+        cache->add(ns);
+    }
+
+    int scriptIndex = 0;
+    foreach (const ScriptReference &script, m_scripts) {
+        QString qualifier = script.qualifier;
+        QString enclosingNamespace;
+
+        const int lastDotIndex = qualifier.lastIndexOf(QLatin1Char('.'));
+        if (lastDotIndex != -1) {
+            enclosingNamespace = qualifier.left(lastDotIndex);
+            qualifier = qualifier.mid(lastDotIndex+1);
+        }
+
+        cache->add(qualifier, scriptIndex++, enclosingNamespace);
+    }
+
+    m_imports.populateCache(cache);
+    return cache;
+}
+
 void QQmlTypeData::registerCallback(TypeDataCallback *callback)
 {
     Q_ASSERT(!m_callbacks.contains(callback));
@@ -2003,7 +2295,7 @@ void QQmlTypeData::done()
         const TypeReference &type = m_types.at(ii);
         Q_ASSERT(!type.typeData || type.typeData->isCompleteOrError());
         if (type.typeData && type.typeData->isError()) {
-            QString typeName = scriptParser.referencedTypes().at(ii)->name;
+            QString typeName = m_unit.referencedTypes.at(ii).first;
 
             QList<QQmlError> errors = type.typeData->errors();
             QQmlError error;
@@ -2016,12 +2308,22 @@ void QQmlTypeData::done()
         }
     }
 
-    // Compile component
-    if (!isError()) 
+    // Compile component, in parallel with other types if possible
+    if (!isError()) {
+        if (typeLoader()->workerThreadCount() > 0) {
+            deferDone();
+            return;
+        }
         compile();
+    }
 
-    if (!(m_options & QQmlTypeLoader::PreserveParser))
-        scriptParser.clear();
+    clearParser();
+}
+
+void QQmlTypeData::doneInBackground()
+{
+    compile();
+    clearParser();
 }
 
 void QQmlTypeData::completed()
@@ -2057,13 +2359,25 @@ bool QQmlTypeData::loadImplicitImport()
 void QQmlTypeData::dataReceived(const Data &data)
 {
     QString code = QString::fromUtf8(data.data(), data.size());
-    QByteArray preparseData;
 
-    if (data.isFile()) preparseData = data.asFile()->metaData(QLatin1String("qml:preparse"));
+    if (QQmlCompilationCache *cache = compilationCache()) {
+        QByteArray sourceHash =
+                QQmlCompilationCache::sourceHash(QByteArray::fromRawData(data.data(), data.size()));
+        if (!cache->loadUnit(sourceHash, &m_unit))
+            m_unit.sourceHash = sourceHash;
+    }
 
-    if (!scriptParser.parse(code, preparseData, finalUrl(), finalUrlString())) {
-        setError(scriptParser.errors());
-        return;
+    // The source is kept until the document is compiled: it is parsed again if cached compiled
+    // data turns out to be stale, or to compile nested component bodies on first creation
+    m_source = code;
+
+    if (!m_unit.hasCompiledData()) {
+        QByteArray preparseData;
+
+        if (data.isFile()) preparseData = data.asFile()->metaData(QLatin1String("qml:preparse"));
+
+        if (!parse(code, preparseData))
+            return;
     }
 
     m_imports.setBaseUrl(finalUrl(), finalUrlString());
@@ -2093,7 +2407,7 @@ void QQmlTypeData::dataReceived(const Data &data)
 
     QList<QQmlError> errors;
 
-    foreach (const QQmlScript::Import &import, scriptParser.imports()) {
+    foreach (const QQmlScript::Import &import, m_unit.imports) {
         if (!addImport(import, &errors)) {
             Q_ASSERT(errors.size());
             QQmlError error(errors.takeFirst());
@@ -2144,22 +2458,169 @@ void QQmlTypeData::downloadProgressChanged(qreal p)
     }
 }
 
+bool QQmlTypeData::parse(const QString &code, const QByteArray &preparseData)
+{
+    if (!scriptParser.parse(code, preparseData, finalUrl(), finalUrlString())) {
+        setError(scriptParser.errors());
+        return false;
+    }
+
+    if (!m_unit.hasCompiledData()) {
+        m_unit.imports = scriptParser.imports();
+        foreach (QQmlScript::TypeReference *parserRef, scriptParser.referencedTypes()) {
+            Q_ASSERT(parserRef->firstUse);
+            m_unit.referencedTypes.append(qMakePair(parserRef->name,
+                                                    parserRef->firstUse->location.start));
+        }
+    }
+
+    return true;
+}
+
 void QQmlTypeData::compile()
 {
     Q_ASSERT(m_compiledData == 0);
 
+    QQmlCompilationCache *cache = compilationCache();
+
     m_compiledData = new QQmlCompiledData(typeLoader()->engine());
     m_compiledData->url = finalUrl();
     m_compiledData->name = finalUrlString();
 
     QQmlCompilingProfiler prof(m_compiledData->name);
 
+    if (m_unit.hasCompiledData()) {
+        if (cache->loadCompiledData(this, m_unit, m_compiledData)) {
+            m_cacheKey = QQmlCompilationCache::sourceHash(m_unit.sourceHash + m_unit.dependencyKey);
+            m_compiledFromCache = true;
+            m_source.clear();
+            return;
+        }
+
+        // The cached data is stale, so compile from source after all
+        m_compiledData->release();
+        m_compiledData = new QQmlCompiledData(typeLoader()->engine());
+        m_compiledData->url = finalUrl();
+        m_compiledData->name = finalUrlString();
+
+        bool parsed = parse(m_source, QByteArray());
+        m_source.clear();
+        if (!parsed) {
+            m_compiledData->release();
+            m_compiledData = 0;
+            return;
+        }
+    }
+
+    // Nested component bodies are compiled from a fresh parse of the source when first created,
+    // which can't be done for cached data or when the parse tree has to stay intact
     QQmlCompiler compiler(&scriptParser._pool);
+    compiler.setLazyComponents(!cache && !(m_options & QQmlTypeLoader::PreserveParser));
     if (!compiler.compile(typeLoader()->engine(), this, m_compiledData)) {
         setError(compiler.errors());
         m_compiledData->release();
         m_compiledData = 0;
+        return;
+    }
+
+    if (m_compiledData->hasPendingLazyComponents())
+        m_compiledData->lazyUnit = this;
+
+    if (cache && cache->store(this, m_unit, m_compiledData))
+        m_cacheKey = QQmlCompilationCache::sourceHash(m_unit.sourceHash +
+                                                      QQmlCompilationCache::dependencyKey(this));
+}
+
+static QQmlScript::Object *findObject(QQmlScript::Object *obj, quint32 offset);
+
+static QQmlScript::Object *findObject(QQmlScript::Property *prop, quint32 offset)
+{
+    if (!prop)
+        return 0;
+
+    QQmlScript::Object *found = findObject(prop->value, offset);
+    for (QQmlScript::Value *v = prop->values.first(); !found && v; v = QQmlScript::Property::ValueList::next(v))
+        found = findObject(v->object, offset);
+    for (QQmlScript::Value *v = prop->onValues.first(); !found && v; v = QQmlScript::Property::ValueList::next(v))
+        found = findObject(v->object, offset);
+    return found;
+}
+
+// Returns the object in the tree below obj that starts at the source offset
+static QQmlScript::Object *findObject(QQmlScript::Object *obj, quint32 offset)
+{
+    if (!obj)
+        return 0;
+    if (obj->location.range.offset == offset)
+        return obj;
+    if (offset < obj->location.range.offset
+        || offset >= obj->location.range.offset + obj->location.range.length)
+        return 0;
+
+    QQmlScript::Object *found = findObject(obj->defaultProperty, offset);
+    for (QQmlScript::Property *prop = obj->properties.first(); !found && prop;
+         prop = obj->properties.next(prop)) {
+        found = findObject(prop, offset);
+    }
+    for (QQmlScript::Object::DynamicProperty *prop = obj->dynamicProperties.first(); !found && prop;
+         prop = obj->dynamicProperties.next(prop)) {
+        found = findObject(prop->defaultValue, offset);
     }
+    return found;
+}
+
+/*!
+\internal
+
+Compiles the body of the lazy component whose root object starts at the source \a offset into
+\a out.  The parse tree is not kept after the document is compiled, so the source is parsed
+again for the body and the tree cleared once it is compiled.  Returns false and sets \a errors
+if the body does not compile.
+*/
+bool QQmlTypeData::compileComponent(quint32 offset, QQmlCompiledData *out,
+                                    QList<QQmlError> *errors)
+{
+    QQmlCompilingProfiler prof(out->name);
+
+    if (!scriptParser.tree() && !scriptParser.parse(m_source, QByteArray(), finalUrl(), finalUrlString())) {
+        *errors = scriptParser.errors();
+        scriptParser.clear();
+        return false;
+    }
+
+    bool ok = false;
+    if (QQmlScript::Object *root = findObject(scriptParser.tree(), offset)) {
+        QQmlCompiler compiler(&scriptParser._pool);
+        ok = compiler.compileComponent(typeLoader()->engine(), this, root, out);
+        if (!ok)
+            *errors = compiler.errors();
+    } else {
+        QQmlError error;
+        error.setUrl(finalUrl());
+        error.setDescription(QQmlCompiler::tr("Component is no longer available"));
+        *errors << error;
+    }
+
+    if (!(m_options & QQmlTypeLoader::PreserveParser))
+        scriptParser.clear();
+    return ok;
+}
+
+void QQmlTypeData::clearParser()
+{
+    if (!(m_options & QQmlTypeLoader::PreserveParser))
+        scriptParser.clear();
+
+    // Only the source is kept while there are component bodies left to compile
+    if (!m_compiledData || m_compiledData->lazyUnit != this)
+        m_source.clear();
+}
+
+QQmlCompilationCache *QQmlTypeData::compilationCache() const
+{
+    if (m_options & QQmlTypeLoader::PreserveParser || finalUrl().isEmpty())
+        return 0;
+    return typeLoader()->compilationCache();
 }
 
 void QQmlTypeData::resolveTypes()
@@ -2185,7 +2646,8 @@ void QQmlTypeData::resolveTypes()
         m_scripts << ref;
     }
 
-    foreach (QQmlScript::TypeReference *parserRef, scriptParser.referencedTypes()) {
+    for (int ii = 0; ii < m_unit.referencedTypes.count(); ++ii) {
+        const QString &typeName = m_unit.referencedTypes.at(ii).first;
         TypeReference ref;
 
         QString url;
@@ -2194,14 +2656,14 @@ void QQmlTypeData::resolveTypes()
         QQmlImportNamespace *typeNamespace = 0;
         QList<QQmlError> errors;
 
-        bool typeFound = m_imports.resolveType(parserRef->name, &ref.type,
+        bool typeFound = m_imports.resolveType(typeName, &ref.type,
                 &majorVersion, &minorVersion, &typeNamespace, &errors);
         if (!typeNamespace && !typeFound && !m_implicitImportLoaded) {
             // Lazy loading of implicit import
             if (loadImplicitImport()) {
                 // Try again to find the type
                 errors.clear();
-                typeFound = m_imports.resolveType(parserRef->name, &ref.type,
+                typeFound = m_imports.resolveType(typeName, &ref.type,
                     &majorVersion, &minorVersion, &typeNamespace, &errors);
             } else {
                 return; //loadImplicitImport() hit an error, and called setError already
@@ -2214,7 +2676,7 @@ void QQmlTypeData::resolveTypes()
             //  - type with unknown namespace (UnknownNamespace.SomeType {})
             QQmlError error;
             if (typeNamespace) {
-                error.setDescription(QQmlTypeLoader::tr("Namespace %1 cannot be used as a type").arg(parserRef->name));
+                error.setDescription(QQmlTypeLoader::tr("Namespace %1 cannot be used as a type").arg(typeName));
             } else {
                 if (errors.size()) {
                     error = errors.takeFirst();
@@ -2224,12 +2686,11 @@ void QQmlTypeData::resolveTypes()
                     error.setDescription(QQmlTypeLoader::tr("Unreported error adding script import to import database"));
                 }
                 error.setUrl(m_imports.baseUrl());
-                error.setDescription(QQmlTypeLoader::tr("%1 %2").arg(parserRef->name).arg(error.description()));
+                error.setDescription(QQmlTypeLoader::tr("%1 %2").arg(typeName).arg(error.description()));
             }
 
-            Q_ASSERT(parserRef->firstUse);
-            error.setLine(parserRef->firstUse->location.start.line);
-            error.setColumn(parserRef->firstUse->location.start.column);
+            error.setLine(m_unit.referencedTypes.at(ii).second.line);
+            error.setColumn(m_unit.referencedTypes.at(ii).second.column);
 
             errors.prepend(error);
             setError(errors);
@@ -2243,8 +2704,7 @@ void QQmlTypeData::resolveTypes()
         ref.majorVersion = majorVersion;
         ref.minorVersion = minorVersion;
 
-        Q_ASSERT(parserRef->firstUse);
-        ref.location = parserRef->firstUse->location.start;
+        ref.location = m_unit.referencedTypes.at(ii).second;
 
         m_types << ref;
     }
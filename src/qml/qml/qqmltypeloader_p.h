@@ -55,6 +55,9 @@
 
 #include <QtCore/qobject.h>
 #include <QtCore/qatomic.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qthreadpool.h>
+#include <QtCore/qwaitcondition.h>
 #include <QtNetwork/qnetworkreply.h>
 #include <QtQml/qqmlerror.h>
 #include <QtQml/qqmlengine.h>
@@ -67,6 +70,7 @@
 #include <private/qqmlcleanup_p.h>
 #include <private/qqmldirparser_p.h>
 #include <private/qqmlbundle_p.h>
+#include <private/qqmlcompilationcache_p.h>
 #include <private/qflagpointer_p.h>
 #include <private/qqmlabstracturlinterceptor_p.h>
 
@@ -79,6 +83,7 @@ class QQmlTypeLoader;
 class QQmlCompiledData;
 class QQmlComponentPrivate;
 class QQmlTypeData;
+class QQmlTypeNameCache;
 class QQmlDataLoader;
 class QQmlExtensionInterface;
 
@@ -147,6 +152,9 @@ protected:
     void setError(const QList<QQmlError> &errors);
     void addDependency(QQmlDataBlob *);
 
+    // Can be called from within done()
+    void deferDone();
+
     // Callbacks made in load thread
     virtual void dataReceived(const Data &) = 0;
     virtual void done();
@@ -155,14 +163,19 @@ protected:
     virtual void dependencyComplete(QQmlDataBlob *);
     virtual void allDependenciesDone();
 
+    // Callbacks made in a worker thread
+    virtual void doneInBackground();
+
     // Callbacks made in main thread
     virtual void downloadProgressChanged(qreal);
     virtual void completed();
 private:
     friend class QQmlDataLoader;
     friend class QQmlDataLoaderThread;
+    friend class QQmlDataBlobDoneJob;
 
     void tryDone();
+    void finishDone();
     void cancelAllWaitingFor();
     void notifyAllWaitingOnMe();
     void notifyComplete(QQmlDataBlob *);
@@ -204,10 +217,11 @@ private:
     int m_redirectCount:30;
     bool m_inCallback:1;
     bool m_isDone:1;
+    bool m_isDoneDeferred:1;
 };
 
 class QQmlDataLoaderThread;
-class QQmlDataLoader
+class Q_QML_PRIVATE_EXPORT QQmlDataLoader
 {
 public:
     QQmlDataLoader(QQmlEngine *);
@@ -226,6 +240,9 @@ public:
     QQmlEngine *engine() const;
     void initializeEngine(QQmlExtensionInterface *, const char *);
 
+    int workerThreadCount() const;
+    void setWorkerThreadCount(int);
+
 protected:
     void shutdownThread();
 
@@ -233,6 +250,12 @@ private:
     friend class QQmlDataBlob;
     friend class QQmlDataLoaderThread;
     friend class QQmlDataLoaderNetworkReplyProxy;
+    friend class QQmlDataBlobDoneJob;
+
+    void startDoneInBackground(QQmlDataBlob *);
+    void doneInBackgroundFinished(QQmlDataBlob *);
+    void finishBackgroundDone();
+    void waitForBackgroundDone(QQmlDataBlob *);
 
     void loadThread(QQmlDataBlob *);
     void loadWithStaticDataThread(QQmlDataBlob *, const QByteArray &);
@@ -248,6 +271,14 @@ private:
     QQmlEngine *m_engine;
     QQmlDataLoaderThread *m_thread;
     NetworkReplies m_networkReplies;
+
+    // Blobs whose done() continues in the worker pool
+    QThreadPool m_workerPool;
+    QMutex m_backgroundMutex;
+    QWaitCondition m_backgroundCondition;
+    QList<QQmlDataBlob *> m_backgroundFinished;
+    int m_backgroundPending;
+    int m_workerThreadCount;
 };
 
 class QQmlBundleData : public QQmlBundle,
@@ -258,7 +289,7 @@ public:
     QString fileName;
 };
 
-class QQmlTypeLoader : public QQmlDataLoader
+class Q_QML_PRIVATE_EXPORT QQmlTypeLoader : public QQmlDataLoader
 {
     Q_DECLARE_TR_FUNCTIONS(QQmlTypeLoader)
 public:
@@ -348,9 +379,14 @@ public:
     void clearCache();
     void trimCache();
 
+    QList<QQmlCompiledData *> compiledData();
+
     bool isTypeLoaded(const QUrl &url) const;
     bool isScriptLoaded(const QUrl &url) const;
 
+    QQmlCompilationCache *compilationCache() const;
+    void setCompilationCachePath(const QString &);
+
 private:
     void addBundleNoLock(const QString &, const QString &);
     QString bundleIdForQmldir(const QString &qmldir, const QString &uriHint);
@@ -384,9 +420,11 @@ private:
     ScriptCache m_scriptCache;
     QmldirCache m_qmldirCache;
     ImportDirCache m_importDirCache;
+    QMutex m_importDirCacheMutex;
     ImportQmlDirCache m_importQmlDirCache;
     BundleCache m_bundleCache;
     QmldirBundleIdCache m_qmldirBundleIdCache;
+    QQmlCompilationCache *m_compilationCache;
 };
 
 Q_DECLARE_OPERATORS_FOR_FLAGS(QQmlTypeLoader::Options)
@@ -430,6 +468,10 @@ public:
 
     QQmlCompiledData *compiledData() const;
 
+    QByteArray cacheKey() const;
+    bool isCompiledFromCache() const;
+    QQmlTypeNameCache *createImportCache() const;
+
     // Used by QQmlComponent to get notifications
     struct TypeDataCallback {
         virtual ~TypeDataCallback();
@@ -440,15 +482,23 @@ public:
     void unregisterCallback(TypeDataCallback *);
 
 protected:
+    virtual void destroy();
     virtual void done();
+    virtual void doneInBackground();
     virtual void completed();
     virtual void dataReceived(const Data &);
     virtual void allDependenciesDone();
     virtual void downloadProgressChanged(qreal);
 
 private:
+    friend class QQmlCompiledData;
+
+    bool parse(const QString &code, const QByteArray &preparseData);
     void resolveTypes();
     void compile();
+    bool compileComponent(quint32 offset, QQmlCompiledData *out, QList<QQmlError> *errors);
+    void clearParser();
+    QQmlCompilationCache *compilationCache() const;
 
     virtual void scriptImported(QQmlScriptBlob *blob, const QQmlScript::Location &location, const QString &qualifier, const QString &nameSpace);
 
@@ -456,6 +506,12 @@ private:
 
     QQmlScript::Parser scriptParser;
 
+    // The imports and referenced types come from either the parser or the compilation cache
+    QQmlCompilationCache::Unit m_unit;
+    QString m_source;
+    QByteArray m_cacheKey;
+    bool m_compiledFromCache;
+
     QList<ScriptReference> m_scripts;
 
     QSet<QString> m_namespaces;
@@ -691,6 +691,7 @@ QObject *QQmlVME::run(QList<QQmlError> *errors,
             ddata->columnNumber = instr.column;
 
             QQmlComponentPrivate::get(qcomp)->creationContext = CTXT;
+            QQmlComponentPrivate::get(qcomp)->lazyComponent = instr.lazyComponent;
 
             objects.push(qcomp);
             INSTRUCTIONSTREAM += instr.count;
@@ -218,6 +218,16 @@ QString QV8Bindings::Binding::expressionIdentifier(QQmlJavaScriptExpression *e)
 void QV8Bindings::Binding::expressionChanged(QQmlJavaScriptExpression *e)
 {
     Binding *This = static_cast<Binding *>(e);
+
+    QQmlContextData *context = This->parent->context();
+    if (context && context->engine) {
+        QQmlEnginePrivate *ep = QQmlEnginePrivate::get(context->engine);
+        if (ep->deferBindingUpdates) {
+            ep->deferBindingUpdate(This, This);
+            return;
+        }
+    }
+
     This->update(QQmlPropertyPrivate::DontRemoveBinding);
 }
 
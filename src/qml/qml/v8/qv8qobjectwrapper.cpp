@@ -265,6 +265,8 @@ static inline v8::Handle<v8::Value> valueToHandle(QV8Engine *, double v)
 { return v8::Number::New(v); }
 static inline v8::Handle<v8::Value> valueToHandle(QV8Engine *e, QObject *v)
 { return e->newQObject(v); }
+static inline v8::Handle<v8::Value> valueToHandle(QV8Engine *e, const QUrl &v)
+{ return e->fromVariant(QVariant(v)); }
 
 template<typename T, void (*ReadFunction)(QObject *, const QQmlPropertyData &,
                                           void *, QQmlNotifier **)>
@@ -305,6 +307,74 @@ static v8::Handle<v8::Value> GenericValueGetter(v8::Local<v8::String>, const v8:
 #define FAST_GETTER_FUNCTION(property, cpptype) \
     (property->hasAccessors()?((v8::AccessorGetter)GenericValueGetter<cpptype, &ReadAccessor::Accessor>):(property->isDirect()?((v8::AccessorGetter)GenericValueGetter<cpptype, &ReadAccessor::Direct>):((v8::AccessorGetter)GenericValueGetter<cpptype, &ReadAccessor::Indirect>)))
 
+// Value types, lists and sequences are returned as references back to the property, rather
+// than as a copy of its value, so they are created by these loaders instead of valueToHandle().
+// None of them have accessors.
+static v8::Handle<v8::Value> loadValueTypeReference(QV8Engine *engine, QObject *object,
+                                                    const QQmlPropertyData &property)
+{
+    QQmlValueType *valueType = QQmlValueTypeFactory::valueType(property.propType);
+    Q_ASSERT(valueType);
+    return engine->newValueType(object, property.coreIndex, valueType);
+}
+
+static v8::Handle<v8::Value> loadListReference(QV8Engine *engine, QObject *object,
+                                               const QQmlPropertyData &property)
+{
+    return engine->listWrapper()->newList(object, property.coreIndex, property.propType);
+}
+
+static v8::Handle<v8::Value> loadSequenceReference(QV8Engine *engine, QObject *object,
+                                                   const QQmlPropertyData &property)
+{
+    bool succeeded = false;
+    v8::Handle<v8::Value> rv = engine->newSequence(property.propType, object, property.coreIndex,
+                                                   &succeeded);
+    return succeeded ? rv : v8::Handle<v8::Value>(v8::Undefined());
+}
+
+template<void (*ReadFunction)(QObject *, const QQmlPropertyData &,
+                              void *, QQmlNotifier **)>
+static v8::Handle<v8::Value> loadVariant(QV8Engine *engine, QObject *object,
+                                         const QQmlPropertyData &property)
+{
+    QVariant v;
+    ReadFunction(object, property, &v, 0);
+
+    if (QQmlValueTypeFactory::isValueType(v.userType())) {
+        if (QQmlValueType *valueType = QQmlValueTypeFactory::valueType(v.userType()))
+            return engine->newValueType(object, property.coreIndex, valueType); // VariantReference value-type.
+    }
+
+    return engine->fromVariant(v);
+}
+
+template<v8::Handle<v8::Value> (*LoadFunction)(QV8Engine *, QObject *, const QQmlPropertyData &)>
+static v8::Handle<v8::Value> GenericReferenceGetter(v8::Local<v8::String>, const v8::AccessorInfo &info)
+{
+    v8::Handle<v8::Object> This = info.This();
+    QV8QObjectResource *resource = v8_resource_check<QV8QObjectResource>(This);
+
+    QObject *object = resource->object;
+    if (QQmlData::wasDeleted(object)) return v8::Undefined();
+
+    QQmlPropertyData *property =
+        (QQmlPropertyData *)v8::External::Cast(*info.Data())->Value();
+
+    QQmlEngine *engine = resource->engine->engine();
+    QQmlEnginePrivate *ep = engine?QQmlEnginePrivate::get(engine):0;
+
+    QQmlData::flushPendingBinding(object, property->coreIndex);
+
+    if (ep && ep->propertyCapture && !property->isConstant())
+        ep->captureProperty(object, property->coreIndex, property->notifyIndex);
+
+    return LoadFunction(resource->engine, object, *property);
+}
+
+#define FAST_VARIANT_GETTER_FUNCTION(property) \
+    (property->isDirect()?((v8::AccessorGetter)GenericReferenceGetter<&loadVariant<&ReadAccessor::Direct> >):((v8::AccessorGetter)GenericReferenceGetter<&loadVariant<&ReadAccessor::Indirect> >))
+
 static quint32 toStringHash = quint32(-1);
 static quint32 destroyHash = quint32(-1);
 
@@ -566,13 +636,14 @@ v8::Handle<v8::Value> QV8QObjectWrapper::GetProperty(QV8Engine *engine, QObject
         if (ep && ep->propertyCapture && result->accessors->notifier)
             nptr = &n;
 
+        // Capture before reading, so a queued binding on the property is updated first
+        if (!result->accessors->notifier)
+            ep->captureProperty(object, result->coreIndex, result->notifyIndex);
+
         v8::Handle<v8::Value> rv = LoadProperty<ReadAccessor::Accessor>(engine, object, *result, nptr);
 
-        if (result->accessors->notifier) {
-            if (n) ep->captureProperty(n);
-        } else {
-            ep->captureProperty(object, result->coreIndex, result->notifyIndex);
-        }
+        if (n)
+            ep->captureProperty(n);
 
         return rv;
     }
@@ -1006,8 +1077,21 @@ v8::Local<v8::Object> QQmlPropertyCache::newQObject(QObject *object, QV8Engine *
                 fastgetter = FAST_GETTER_FUNCTION(property, uint);
             else if (property->propType == QMetaType::Float) 
                 fastgetter = FAST_GETTER_FUNCTION(property, float);
-            else if (property->propType == QMetaType::Double) 
+            else if (property->propType == QMetaType::Double)
                 fastgetter = FAST_GETTER_FUNCTION(property, double);
+            else if (property->propType == QMetaType::QUrl)
+                fastgetter = FAST_GETTER_FUNCTION(property, QUrl);
+            else if (property->hasAccessors() || property->isVarProperty() || property->isV8Handle())
+                fastgetter = 0;
+            else if (property->isQList())
+                fastgetter = GenericReferenceGetter<&loadListReference>;
+            else if (property->isQVariant())
+                fastgetter = FAST_VARIANT_GETTER_FUNCTION(property);
+            else if (QQmlValueTypeFactory::isValueType(property->propType)
+                     && QQmlValueTypeFactory::valueType(property->propType))
+                fastgetter = GenericReferenceGetter<&loadValueTypeReference>;
+            else if (engine->sequenceWrapper()->isSequenceType(property->propType))
+                fastgetter = GenericReferenceGetter<&loadSequenceReference>;
 
             if (fastgetter) {
                 if (ft.IsEmpty()) {
@@ -1021,7 +1105,7 @@ v8::Local<v8::Object> QQmlPropertyCache::newQObject(QObject *object, QV8Engine *
                 }
 
                 v8::AccessorSetter fastsetter = FastValueSetter;
-                if (!property->isWritable())
+                if (!property->isWritable() && !property->isQList())
                     fastsetter = FastValueSetterReadOnly;
 
                 // We wrap the raw QQmlPropertyData pointer here.  This is safe as the
@@ -1608,6 +1692,60 @@ static v8::Handle<v8::Value> CallMethod(QObject *object, int index, int returnTy
     }
 }
 
+namespace {
+/*
+    The properties of a JavaScript argument that overload resolution depends on.  These are
+    found once per argument, rather than once per argument for every candidate overload, and
+    also form the key used to cache the result of the resolution.
+*/
+struct ArgumentType
+{
+    enum Kind { Other, Number, String, Boolean, Date, RegExp, Array, Null,
+                QObjectWrapper, Variant, ValueType, Object };
+
+    int kind;
+    int userType; // The type of the contained value for Variant and ValueType
+};
+}
+
+static ArgumentType ArgumentTypeOf(v8::Handle<v8::Value> actual)
+{
+    ArgumentType rv = { ArgumentType::Other, QMetaType::UnknownType };
+
+    if (actual->IsNumber()) {
+        rv.kind = ArgumentType::Number;
+    } else if (actual->IsString()) {
+        rv.kind = ArgumentType::String;
+    } else if (actual->IsBoolean()) {
+        rv.kind = ArgumentType::Boolean;
+    } else if (actual->IsDate()) {
+        rv.kind = ArgumentType::Date;
+    } else if (actual->IsRegExp()) {
+        rv.kind = ArgumentType::RegExp;
+    } else if (actual->IsArray()) {
+        rv.kind = ArgumentType::Array;
+    } else if (actual->IsNull()) {
+        rv.kind = ArgumentType::Null;
+    } else if (actual->IsObject()) {
+        v8::Handle<v8::Object> obj = v8::Handle<v8::Object>::Cast(actual);
+
+        QV8ObjectResource *r = static_cast<QV8ObjectResource *>(obj->GetExternalResource());
+        if (r && r->resourceType() == QV8ObjectResource::QObjectType) {
+            rv.kind = ArgumentType::QObjectWrapper;
+        } else if (r && r->resourceType() == QV8ObjectResource::VariantType) {
+            rv.kind = ArgumentType::Variant;
+            rv.userType = r->engine->toVariant(actual, -1).userType();
+        } else if (r && r->resourceType() == QV8ObjectResource::ValueTypeType) {
+            rv.kind = ArgumentType::ValueType;
+            rv.userType = r->engine->toVariant(actual, -1).userType();
+        } else {
+            rv.kind = ArgumentType::Object;
+        }
+    }
+
+    return rv;
+}
+
 /*!
     Returns the match score for converting \a actual to be of type \a conversionType.  A 
     zero score means "perfect match" whereas a higher score is worse.
@@ -1615,9 +1753,10 @@ static v8::Handle<v8::Value> CallMethod(QObject *object, int index, int returnTy
     The conversion table is copied out of the \l QScript::callQtMethod()
     function.
 */
-static int MatchScore(v8::Handle<v8::Value> actual, int conversionType)
+static int MatchScore(const ArgumentType &actual, int conversionType)
 {
-    if (actual->IsNumber()) {
+    switch (actual.kind) {
+    case ArgumentType::Number:
         switch (conversionType) {
         case QMetaType::Double:
             return 0;
@@ -1644,7 +1783,7 @@ static int MatchScore(v8::Handle<v8::Value> actual, int conversionType)
         default:
             return 10;
         }
-    } else if (actual->IsString()) {
+    case ArgumentType::String:
         switch (conversionType) {
         case QMetaType::QString:
             return 0;
@@ -1653,7 +1792,7 @@ static int MatchScore(v8::Handle<v8::Value> actual, int conversionType)
         default:
             return 10;
         }
-    } else if (actual->IsBoolean()) {
+    case ArgumentType::Boolean:
         switch (conversionType) {
         case QMetaType::Bool:
             return 0;
@@ -1662,7 +1801,7 @@ static int MatchScore(v8::Handle<v8::Value> actual, int conversionType)
         default:
             return 10;
         }
-    } else if (actual->IsDate()) {
+    case ArgumentType::Date:
         switch (conversionType) {
         case QMetaType::QDateTime:
             return 0;
@@ -1673,14 +1812,14 @@ static int MatchScore(v8::Handle<v8::Value> actual, int conversionType)
         default:
             return 10;
         }
-    } else if (actual->IsRegExp()) {
+    case ArgumentType::RegExp:
         switch (conversionType) {
         case QMetaType::QRegExp:
             return 0;
         default:
             return 10;
         }
-    } else if (actual->IsArray()) {
+    case ArgumentType::Array:
         switch (conversionType) {
         case QMetaType::QJsonArray:
             return 3;
@@ -1695,7 +1834,7 @@ static int MatchScore(v8::Handle<v8::Value> actual, int conversionType)
         default:
             return 10;
         }
-    } else if (actual->IsNull()) {
+    case ArgumentType::Null:
         switch (conversionType) {
         case QMetaType::VoidStar:
         case QMetaType::QObjectStar:
@@ -1709,35 +1848,29 @@ static int MatchScore(v8::Handle<v8::Value> actual, int conversionType)
                 return 10;
         }
         }
-    } else if (actual->IsObject()) {
-        v8::Handle<v8::Object> obj = v8::Handle<v8::Object>::Cast(actual);
-
-        QV8ObjectResource *r = static_cast<QV8ObjectResource *>(obj->GetExternalResource());
-        if (r && r->resourceType() == QV8ObjectResource::QObjectType) {
-            switch (conversionType) {
-            case QMetaType::QObjectStar:
-                return 0;
-            default:
-                return 10;
-            }
-        } else if (r && r->resourceType() == QV8ObjectResource::VariantType) {
-            if (conversionType == qMetaTypeId<QVariant>())
-                return 0;
-            else if (r->engine->toVariant(actual, -1).userType() == conversionType)
-                return 0;
-            else
-                return 10;
-        } else if (r && r->resourceType() == QV8ObjectResource::ValueTypeType) {
-            if (r->engine->toVariant(actual, -1).userType() == conversionType)
-                return 0;
-            return 10;
-        } else if (conversionType == QMetaType::QJsonObject) {
-            return 5;
-        } else {
+    case ArgumentType::QObjectWrapper:
+        switch (conversionType) {
+        case QMetaType::QObjectStar:
+            return 0;
+        default:
             return 10;
         }
-
-    } else {
+    case ArgumentType::Variant:
+        if (conversionType == qMetaTypeId<QVariant>())
+            return 0;
+        else if (actual.userType == conversionType)
+            return 0;
+        else
+            return 10;
+    case ArgumentType::ValueType:
+        if (actual.userType == conversionType)
+            return 0;
+        return 10;
+    case ArgumentType::Object:
+        if (conversionType == QMetaType::QJsonObject)
+            return 5;
+        return 10;
+    default:
         return 10;
     }
 }
@@ -1853,16 +1986,16 @@ Resolve the overloaded method to call.  The algorithm works conceptually like th
     3.  Find the best remaining overload based on its match score.  
         If two or more overloads have the same match score, call the last one.  The match
         score is constructed by adding the matchScore() result for each of the parameters.
+
+The result only depends on the method and on the types of the arguments, so when the object has
+a property cache the chosen overload is remembered there, keyed by those types, and later calls
+with arguments of the same types skip the resolution.
 */
 static v8::Handle<v8::Value> CallOverloaded(QObject *object, const QQmlPropertyData &data,
                                             QV8Engine *engine, CallArgs &callArgs)
 {
     int argumentCount = callArgs.Length();
 
-    const QQmlPropertyData *best = 0;
-    int bestParameterScore = INT_MAX;
-    int bestMatchScore = INT_MAX;
-
     // Special handling is required for value types.
     // We need to save the current value in a temporary,
     // and reapply it after converting all arguments.
@@ -1873,6 +2006,31 @@ static v8::Handle<v8::Value> CallOverloaded(QObject *object, const QQmlPropertyD
     if (valueTypeObject)
         valueTypeValue = valueTypeObject->value();
 
+    // The first entry identifies the method and the number of arguments it is called with.
+    QVarLengthArray<ArgumentType, 9> argumentTypes(argumentCount + 1);
+    argumentTypes[0].kind = data.coreIndex;
+    argumentTypes[0].userType = argumentCount;
+    for (int ii = 0; ii < argumentCount; ++ii)
+        argumentTypes[ii + 1] = ArgumentTypeOf(callArgs[ii]);
+
+    const QByteArray signature = QByteArray::fromRawData(
+            reinterpret_cast<const char *>(argumentTypes.constData()),
+            argumentTypes.count() * sizeof(ArgumentType));
+
+    QQmlData *ddata = QQmlData::get(object, false);
+    QQmlPropertyCache *cache = ddata ? ddata->propertyCache : 0;
+    if (cache) {
+        if (const QQmlPropertyData *resolved = cache->resolvedOverload(signature)) {
+            if (valueTypeObject)
+                valueTypeObject->setValue(valueTypeValue);
+            return CallPrecise(object, *resolved, engine, callArgs);
+        }
+    }
+
+    const QQmlPropertyData *best = 0;
+    int bestParameterScore = INT_MAX;
+    int bestMatchScore = INT_MAX;
+
     QQmlPropertyData dummy;
     const QQmlPropertyData *attempt = &data;
 
@@ -1899,7 +2057,7 @@ static v8::Handle<v8::Value> CallOverloaded(QObject *object, const QQmlPropertyD
 
         int methodMatchScore = 0;
         for (int ii = 0; ii < methodArgumentCount; ++ii) 
-            methodMatchScore += MatchScore(callArgs[ii], methodArgTypes[ii]);
+            methodMatchScore += MatchScore(argumentTypes[ii + 1], methodArgTypes[ii]);
 
         if (bestParameterScore > methodParameterScore || bestMatchScore > methodMatchScore) {
             best = attempt;
@@ -1913,6 +2071,8 @@ static v8::Handle<v8::Value> CallOverloaded(QObject *object, const QQmlPropertyD
     } while((attempt = RelatedMethod(object, attempt, dummy)) != 0);
 
     if (best) {
+        if (cache)
+            cache->setResolvedOverload(signature, best->coreIndex);
         if (valueTypeObject)
             valueTypeObject->setValue(valueTypeValue);
         return CallPrecise(object, *best, engine, callArgs);
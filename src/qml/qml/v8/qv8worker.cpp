@@ -58,7 +58,14 @@ QT_BEGIN_NAMESPACE
 //    + Number
 //    + Date
 //    + RegExp
+//    + QByteArray variants
 // <quint8 type><quint24 size><data>
+//
+// Large payloads avoid being encoded into the stream: long strings are
+// copied once into a QString that the receiving engine adopts as an external
+// string, and byte arrays are passed as an implicitly shared reference.  Both
+// are kept in the message's payloads, and the stream holds their index.
+// Arrays holding only numbers are written as a flat block of doubles.
 
 enum Type {
     WorkerUndefined,
@@ -75,7 +82,27 @@ enum Type {
     WorkerDate,
     WorkerRegexp,
     WorkerListModel,
-    WorkerSequence
+    WorkerSequence,
+    WorkerSharedString,
+    WorkerNumberArray,
+    WorkerByteArray
+};
+
+// Strings of at least this many characters are shared instead of encoded
+static const int sharedStringThreshold = 1024;
+// Arrays of at least this many numbers are written as a block of doubles
+static const quint32 numberArrayThreshold = 16;
+
+class QV8WorkerStringResource : public v8::String::ExternalStringResource
+{
+public:
+    QV8WorkerStringResource(const QString &string) : m_string(string) {}
+
+    virtual const uint16_t *data() const { return reinterpret_cast<const uint16_t *>(m_string.constData()); }
+    virtual size_t length() const { return m_string.length(); }
+
+private:
+    QString m_string;
 };
 
 static inline quint32 valueheader(Type type, quint32 size = 0)
@@ -134,12 +161,31 @@ static inline void *popPtr(const char *&data)
     return rv;
 }
 
+// Returns false, leaving data untouched, if array holds anything but numbers
+static bool serializeNumberArray(QByteArray &data, v8::Handle<v8::Array> array, quint32 length)
+{
+    int start = data.size();
+    reserve(data, sizeof(quint32) + length * sizeof(double));
+    push(data, valueheader(WorkerNumberArray, length));
+    for (quint32 ii = 0; ii < length; ++ii) {
+        v8::Local<v8::Value> value = array->Get(ii);
+        if (!value->IsNumber()) {
+            data.resize(start);
+            return false;
+        }
+        push(data, value->NumberValue());
+    }
+    return true;
+}
+
 // XXX TODO: Check that worker script is exception safe in the case of 
 // serialization/deserialization failures
 
 #define ALIGN(size) (((size) + 3) & ~3)
-void QV8Worker::serialize(QByteArray &data, v8::Handle<v8::Value> v, QV8Engine *engine)
+void QV8Worker::serialize(Message &message, v8::Handle<v8::Value> v, QV8Engine *engine)
 {
+    QByteArray &data = message.data;
+
     if (v.IsEmpty()) {
     } else if (v->IsUndefined()) {
         push(data, valueheader(WorkerUndefined));
@@ -151,6 +197,14 @@ void QV8Worker::serialize(QByteArray &data, v8::Handle<v8::Value> v, QV8Engine *
         push(data, valueheader(WorkerFalse));
     } else if (v->IsString()) {
         v8::Handle<v8::String> string = v->ToString();
+        if (string->Length() >= sharedStringThreshold) {
+            QString shared(string->Length(), Qt::Uninitialized);
+            string->Write(reinterpret_cast<uint16_t *>(shared.data()), 0, shared.length());
+            push(data, valueheader(WorkerSharedString, message.payloads.count()));
+            message.payloads.append(shared);
+            return;
+        }
+
         int length = string->Length() + 1;
         if (length > 0xFFFFFF) {
             push(data, valueheader(WorkerUndefined));
@@ -177,10 +231,12 @@ void QV8Worker::serialize(QByteArray &data, v8::Handle<v8::Value> v, QV8Engine *
             push(data, valueheader(WorkerUndefined));
             return;
         }
+        if (length >= numberArrayThreshold && serializeNumberArray(data, array, length))
+            return;
         reserve(data, sizeof(quint32) + length * sizeof(quint32));
         push(data, valueheader(WorkerArray, length));
         for (uint32_t ii = 0; ii < length; ++ii)
-            serialize(data, array->Get(ii), engine);
+            serialize(message, array->Get(ii), engine);
     } else if (v->IsInt32()) {
         reserve(data, 2 * sizeof(quint32));
         push(data, valueheader(WorkerInt32));
@@ -229,14 +285,14 @@ void QV8Worker::serialize(QByteArray &data, v8::Handle<v8::Value> v, QV8Engine *
         v8::TryCatch tc;
         for (quint32 ii = 0; ii < length; ++ii) {
             v8::Local<v8::String> str = properties->Get(ii)->ToString();
-            serialize(data, str, engine);
+            serialize(message, str, engine);
 
             v8::Local<v8::Value> val = object->Get(str);
             if (tc.HasCaught()) {
-                serialize(data, v8::Undefined(), engine);
+                serialize(message, v8::Undefined(), engine);
                 tc.Reset();
             } else {
-                serialize(data, val, engine);
+                serialize(message, val, engine);
             }
         }
     } else if (engine->isQObject(v)) {
@@ -253,11 +309,18 @@ void QV8Worker::serialize(QByteArray &data, v8::Handle<v8::Value> v, QV8Engine *
         // No other QObject's are allowed to be sent
         push(data, valueheader(WorkerUndefined));
     } else {
-        // we can convert sequences, but not other types with external data.
+        // we can convert sequences and byte arrays, but not other types with external data.
         if (v->IsObject()) {
             v8::Handle<v8::Object> seqObj = v->ToObject();
             QV8ObjectResource *r = static_cast<QV8ObjectResource *>(seqObj->GetExternalResource());
-            if (r->resourceType() == QV8ObjectResource::SequenceType) {
+            if (r->resourceType() == QV8ObjectResource::VariantType) {
+                QVariant variant = QV8VariantWrapper::toVariant(r);
+                if (variant.userType() == QMetaType::QByteArray) {
+                    push(data, valueheader(WorkerByteArray, message.payloads.count()));
+                    message.payloads.append(variant);
+                    return;
+                }
+            } else if (r->resourceType() == QV8ObjectResource::SequenceType) {
                 QVariant sequenceVariant = engine->sequenceWrapper()->toVariant(r);
                 if (!sequenceVariant.isNull()) {
                     // valid sequence.  we generate a length (sequence length + 1 for the sequence type)
@@ -269,9 +332,9 @@ void QV8Worker::serialize(QByteArray &data, v8::Handle<v8::Value> v, QV8Engine *
                     }
                     reserve(data, sizeof(quint32) + length * sizeof(quint32));
                     push(data, valueheader(WorkerSequence, length));
-                    serialize(data, v8::Integer::New(sequenceVariant.userType()), engine); // sequence type
+                    serialize(message, v8::Integer::New(sequenceVariant.userType()), engine); // sequence type
                     for (uint32_t ii = 0; ii < seqLength; ++ii) {
-                        serialize(data, seqObj->Get(ii), engine); // sequence elements
+                        serialize(message, seqObj->Get(ii), engine); // sequence elements
                     }
 
                     return;
@@ -284,7 +347,8 @@ void QV8Worker::serialize(QByteArray &data, v8::Handle<v8::Value> v, QV8Engine *
     }
 }
 
-v8::Handle<v8::Value> QV8Worker::deserialize(const char *&data, QV8Engine *engine)
+v8::Handle<v8::Value> QV8Worker::deserialize(const char *&data, const QVariantList &payloads,
+                                             QV8Engine *engine)
 {
     quint32 header = popUint32(data);
     Type type = headertype(header);
@@ -313,7 +377,7 @@ v8::Handle<v8::Value> QV8Worker::deserialize(const char *&data, QV8Engine *engin
         quint32 size = headersize(header);
         v8::Local<v8::Array> array = v8::Array::New(size);
         for (quint32 ii = 0; ii < size; ++ii) {
-            array->Set(ii, deserialize(data, engine));
+            array->Set(ii, deserialize(data, payloads, engine));
         }
         return array;
     }
@@ -322,8 +386,8 @@ v8::Handle<v8::Value> QV8Worker::deserialize(const char *&data, QV8Engine *engin
         quint32 size = headersize(header);
         v8::Local<v8::Object> o = v8::Object::New();
         for (quint32 ii = 0; ii < size; ++ii) {
-            v8::Handle<v8::Value> name = deserialize(data, engine);
-            v8::Handle<v8::Value> value = deserialize(data, engine);
+            v8::Handle<v8::Value> name = deserialize(data, payloads, engine);
+            v8::Handle<v8::Value> value = deserialize(data, payloads, engine);
             o->Set(name, value);
         }
         return o;
@@ -363,29 +427,46 @@ v8::Handle<v8::Value> QV8Worker::deserialize(const char *&data, QV8Engine *engin
         bool succeeded = false;
         quint32 length = headersize(header);
         quint32 seqLength = length - 1;
-        int sequenceType = deserialize(data, engine)->Int32Value();
+        int sequenceType = deserialize(data, payloads, engine)->Int32Value();
         v8::Local<v8::Array> array = v8::Array::New(seqLength);
         for (quint32 ii = 0; ii < seqLength; ++ii)
-            array->Set(ii, deserialize(data, engine));
+            array->Set(ii, deserialize(data, payloads, engine));
         QVariant seqVariant = engine->sequenceWrapper()->toVariant(array, sequenceType, &succeeded);
         return engine->sequenceWrapper()->fromVariant(seqVariant, &succeeded);
     }
+    case WorkerSharedString:
+    {
+        const QString shared = payloads.at(headersize(header)).toString();
+        return v8::String::NewExternal(new QV8WorkerStringResource(shared));
+    }
+    case WorkerNumberArray:
+    {
+        quint32 size = headersize(header);
+        v8::Local<v8::Array> array = v8::Array::New(size);
+        for (quint32 ii = 0; ii < size; ++ii)
+            array->Set(ii, v8::Number::New(popDouble(data)));
+        return array;
+    }
+    case WorkerByteArray:
+    {
+        return engine->newVariant(payloads.at(headersize(header)));
+    }
     }
     Q_ASSERT(!"Unreachable");
     return v8::Undefined();
 }
 
-QByteArray QV8Worker::serialize(v8::Handle<v8::Value> value, QV8Engine *engine)
+QV8Worker::Message QV8Worker::serialize(v8::Handle<v8::Value> value, QV8Engine *engine)
 {
-    QByteArray rv;
+    Message rv;
     serialize(rv, value, engine);
     return rv;
 }
 
-v8::Handle<v8::Value> QV8Worker::deserialize(const QByteArray &data, QV8Engine *engine)
+v8::Handle<v8::Value> QV8Worker::deserialize(const Message &message, QV8Engine *engine)
 {
-    const char *stream = data.constData();
-    return deserialize(stream, engine);
+    const char *stream = message.data.constData();
+    return deserialize(stream, message.payloads, engine);
 }
 
 QT_END_NAMESPACE
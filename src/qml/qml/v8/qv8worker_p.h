@@ -57,17 +57,26 @@
 
 QT_BEGIN_NAMESPACE
 
+// A serialized value.  Long strings and byte arrays are not copied into
+// data, but held by reference in payloads, which the message owns.
+struct QV8WorkerMessage {
+    QByteArray data;
+    QVariantList payloads;
+};
+
 class QV8Worker {
 public:
+    typedef QV8WorkerMessage Message;
+
     struct SavedData {
     };
 
-    static QByteArray serialize(v8::Handle<v8::Value>, QV8Engine *);
-    static v8::Handle<v8::Value> deserialize(const QByteArray &, QV8Engine *);
+    static Message serialize(v8::Handle<v8::Value>, QV8Engine *);
+    static v8::Handle<v8::Value> deserialize(const Message &, QV8Engine *);
 
 private:
-    static void serialize(QByteArray &, v8::Handle<v8::Value>, QV8Engine *);
-    static v8::Handle<v8::Value> deserialize(const char *&, QV8Engine *);
+    static void serialize(Message &, v8::Handle<v8::Value>, QV8Engine *);
+    static v8::Handle<v8::Value> deserialize(const char *&, const QVariantList &, QV8Engine *);
 };
 
 QT_END_NAMESPACE
@@ -172,6 +172,7 @@ QQmlDelegateModelPrivate::QQmlDelegateModelPrivate(QQmlContext *ctxt)
     , m_reset(false)
     , m_transaction(false)
     , m_incubatorCleanupScheduled(false)
+    , m_reuseItems(false)
     , m_cacheItems(0)
     , m_items(0)
     , m_persistedItems(0)
@@ -215,7 +216,10 @@ QQmlDelegateModel::~QQmlDelegateModel()
 {
     Q_D(QQmlDelegateModel);
 
-    foreach (QQmlDelegateModelItem *cacheItem, d->m_cache) {
+    const QList<QQmlDelegateModelItem *> reusableItems = d->m_reusableItems;
+    d->m_reusableItems.clear();
+
+    foreach (QQmlDelegateModelItem *cacheItem, d->m_cache + reusableItems) {
         if (cacheItem->object) {
             delete cacheItem->object;
 
@@ -327,6 +331,7 @@ void QQmlDelegateModel::setModel(const QVariant &model)
     if (d->m_complete)
         _q_itemsRemoved(0, d->m_count);
 
+    d->drainReusableItems();
     d->m_adaptorModel.setModel(model, this, d->m_context->engine());
     d->m_adaptorModel.replaceWatchedRoles(QList<QByteArray>(), d->m_watchedRoles);
     for (int i = 0; d->m_parts && i < d->m_parts->models.count(); ++i) {
@@ -362,6 +367,8 @@ void QQmlDelegateModel::setDelegate(QQmlComponent *delegate)
         return;
     }
     bool wasValid = d->m_delegate != 0;
+    if (d->m_delegate != delegate)
+        d->drainReusableItems();
     d->m_delegate = delegate;
     d->m_delegateValidated = false;
     if (wasValid && d->m_complete) {
@@ -423,8 +430,10 @@ void QQmlDelegateModel::setRootIndex(const QVariant &root)
     if (changed || !d->m_adaptorModel.isValid()) {
         const int oldCount = d->m_count;
         d->m_adaptorModel.rootIndex = modelIndex;
-        if (!d->m_adaptorModel.isValid() && d->m_adaptorModel.aim())  // The previous root index was invalidated, so we need to reconnect the model.
+        if (!d->m_adaptorModel.isValid() && d->m_adaptorModel.aim()) { // The previous root index was invalidated, so we need to reconnect the model.
+            d->drainReusableItems();
             d->m_adaptorModel.setModel(d->m_adaptorModel.list.list(), this, d->m_context->engine());
+        }
         if (d->m_adaptorModel.canFetchMore())
             d->m_adaptorModel.fetchMore();
         if (d->m_complete) {
@@ -439,6 +448,42 @@ void QQmlDelegateModel::setRootIndex(const QVariant &root)
     }
 }
 
+/*!
+    \qmlproperty bool QtQml.Models2::DelegateModel::reuseItems
+
+    This property holds whether delegate instances released by a view are kept
+    for reuse instead of being destroyed.
+
+    When enabled, a delegate instance that is no longer referenced by the view is
+    placed in a pool.  The next time the view requests an item that has not been
+    instantiated, a pooled instance is rebound to the new index and model roles
+    rather than creating a new instance from the delegate.  The \c pooled() and
+    \c reused() attached signals are emitted as an instance enters and leaves the
+    pool so that a delegate can reset any state that does not derive from
+    bindings on the model data.
+
+    Instances are never reused across a change of \l model or \l delegate, and
+    delegates for models of QObject lists and packages are always destroyed.
+
+    The default value is false.
+*/
+bool QQmlDelegateModel::reuseItems() const
+{
+    Q_D(const QQmlDelegateModel);
+    return d->m_reuseItems;
+}
+
+void QQmlDelegateModel::setReuseItems(bool reuse)
+{
+    Q_D(QQmlDelegateModel);
+    if (d->m_reuseItems == reuse)
+        return;
+    d->m_reuseItems = reuse;
+    if (!reuse)
+        d->drainReusableItems();
+    emit reuseItemsChanged();
+}
+
 /*!
     \qmlmethod QModelIndex QtQml.Models2::DelegateModel::modelIndex(int index)
 
@@ -494,7 +539,10 @@ QQmlDelegateModel::ReleaseFlags QQmlDelegateModelPrivate::release(QObject *objec
         return stat;
 
     if (QQmlDelegateModelItem *cacheItem = QQmlDelegateModelItem::dataForObject(object)) {
-        if (cacheItem->releaseObject()) {
+        if (cacheItem->releaseObject() && canReuseItem(cacheItem)) {
+            poolItem(cacheItem);
+            stat |= QQmlInstanceModel::Pooled;
+        } else if (!cacheItem->isObjectReferenced()) {
             cacheItem->destroyObject();
             emitDestroyingItem(object);
             if (cacheItem->incubationTask) {
@@ -824,6 +872,66 @@ void QQmlDelegateModelPrivate::removeCacheItem(QQmlDelegateModelItem *cacheItem)
     Q_ASSERT(m_cache.count() == m_compositor.count(Compositor::Cache));
 }
 
+/*
+    Only fully instantiated items that nothing but their own context references can be pooled.
+    Proxied QObject models expose the model object itself as a context object, and packages are
+    shared between several parts models, so neither can be rebound to a different index.
+*/
+bool QQmlDelegateModelPrivate::canReuseItem(QQmlDelegateModelItem *cacheItem) const
+{
+    return m_reuseItems
+            && cacheItem->object
+            && cacheItem->delegate == m_delegate
+            && !cacheItem->incubationTask
+            && cacheItem->scriptRef == 1
+            && !(cacheItem->groups & Compositor::UnresolvedFlag)
+            && !m_adaptorModel.hasProxyObject()
+            && !qmlobject_cast<QQuickPackage *>(cacheItem->object);
+}
+
+void QQmlDelegateModelPrivate::poolItem(QQmlDelegateModelItem *cacheItem)
+{
+    removeCacheItem(cacheItem);
+    cacheItem->groups = 0;
+    cacheItem->index = -1;
+    m_reusableItems.append(cacheItem);
+
+    if (QQmlDelegateModelAttached *attached = cacheItem->attached)
+        emit attached->pooled();
+}
+
+/*
+    Rebinds a pooled item to the model index at \a it.  The item must already have been inserted
+    into the cache so the attached group indexes resolve.  Setting the index to -1 first lets
+    resolveIndex() refresh the model data and notify every role.
+*/
+void QQmlDelegateModelPrivate::reuseItem(QQmlDelegateModelItem *cacheItem, Compositor::iterator it)
+{
+    cacheItem->index = -1;
+    if (!cacheItem->resolveIndex(m_adaptorModel, it.modelIndex()))
+        cacheItem->setModelIndex(it.modelIndex());
+
+    if (QQmlDelegateModelAttached *attached = cacheItem->attached) {
+        for (int i = 1; i < m_groupCount; ++i)
+            attached->m_currentIndex[i] = it.index[i];
+        attached->emitChanges();
+        emit attached->reused();
+    }
+}
+
+void QQmlDelegateModelPrivate::drainReusableItems()
+{
+    const QList<QQmlDelegateModelItem *> reusableItems = m_reusableItems;
+    m_reusableItems.clear();
+
+    foreach (QQmlDelegateModelItem *cacheItem, reusableItems) {
+        QObject *object = cacheItem->object;
+        cacheItem->destroyObject();
+        emitDestroyingItem(object);
+        cacheItem->Dispose();
+    }
+}
+
 void QQmlDelegateModelPrivate::incubatorStatusChanged(QQDMIncubationTask *incubationTask, QQmlIncubator::Status status)
 {
     Q_Q(QQmlDelegateModel);
@@ -896,7 +1004,10 @@ QObject *QQmlDelegateModelPrivate::object(Compositor::Group group, int index, bo
     QQmlDelegateModelItem *cacheItem = it->inCache() ? m_cache.at(it.cacheIndex) : 0;
 
     if (!cacheItem) {
-        cacheItem = m_adaptorModel.createItem(m_cacheMetaType, m_context->engine(), it.modelIndex());
+        const bool reused = !m_reusableItems.isEmpty();
+        cacheItem = reused
+                ? m_reusableItems.takeLast()
+                : m_adaptorModel.createItem(m_cacheMetaType, m_context->engine(), it.modelIndex());
         if (!cacheItem)
             return 0;
 
@@ -905,6 +1016,9 @@ QObject *QQmlDelegateModelPrivate::object(Compositor::Group group, int index, bo
         m_cache.insert(it.cacheIndex, cacheItem);
         m_compositor.setFlags(it, 1, Compositor::CacheFlag);
         Q_ASSERT(m_cache.count() == m_compositor.count(Compositor::Cache));
+
+        if (reused)
+            reuseItem(cacheItem, it);
     }
 
     // Bump the reference counts temporarily so neither the content data or the delegate object
@@ -943,6 +1057,7 @@ QObject *QQmlDelegateModelPrivate::object(Compositor::Group group, int index, bo
             }
         }
 
+        cacheItem->delegate = m_delegate;
         cacheItem->incubateObject(
                     m_delegate,
                     m_context->engine(),
@@ -1770,6 +1885,7 @@ QQmlDelegateModelItem::QQmlDelegateModelItem(
     , metaType(metaType)
     , contextData(0)
     , object(0)
+    , delegate(0)
     , attached(0)
     , incubationTask(0)
     , objectRef(0)
@@ -1878,7 +1994,9 @@ int QQmlDelegateModelItem::groupIndex(Compositor::Group group)
     if (QQmlDelegateModelPrivate * const model = metaType->model
             ? QQmlDelegateModelPrivate::get(metaType->model)
             : 0) {
-        return model->m_compositor.find(Compositor::Cache, model->m_cache.indexOf(this)).index[group];
+        const int cacheIndex = model->m_cache.indexOf(this);
+        if (cacheIndex != -1)
+            return model->m_compositor.find(Compositor::Cache, cacheIndex).index[group];
     }
     return -1;
 }
@@ -2023,6 +2141,8 @@ void QQmlDelegateModelAttached::setGroups(const QStringList &groups)
 
     const int groupFlags = model->m_cacheMetaType->parseGroups(groups);
     const int cacheIndex = model->m_cache.indexOf(m_cacheItem);
+    if (cacheIndex == -1)   // The item is in the reuse pool.
+        return;
     Compositor::iterator it = model->m_compositor.find(Compositor::Cache, cacheIndex);
     model->setGroups(it, 1, Compositor::Cache, groupFlags);
 }
@@ -2047,6 +2167,26 @@ bool QQmlDelegateModelAttached::isUnresolved() const
     return m_cacheItem->groups & Compositor::UnresolvedFlag;
 }
 
+/*!
+    \qmlattachedsignal QtQml.Models2::DelegateModel::onPooled()
+
+    This handler is called when a view releases the delegate instance and it is
+    placed in the reuse pool instead of being destroyed.
+
+    \sa reuseItems
+*/
+
+/*!
+    \qmlattachedsignal QtQml.Models2::DelegateModel::onReused()
+
+    This handler is called when a pooled delegate instance has been rebound to a
+    new model index and is about to be shown again.  The \c index and model role
+    properties already refer to the new item, so the handler should reset any
+    state the delegate keeps that is not bound to them.
+
+    \sa reuseItems
+*/
+
 /*!
     \qmlattachedproperty int QtQml.Models2::DelegateModel::inItems
 
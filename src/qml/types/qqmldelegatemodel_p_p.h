@@ -149,6 +149,7 @@ public:
     QQmlDelegateModelItemMetaType * const metaType;
     QQmlContextData *contextData;
     QObject *object;
+    QQmlComponent *delegate;
     QQmlDelegateModelAttached *attached;
     QQDMIncubationTask *incubationTask;
     int objectRef;
@@ -257,6 +258,11 @@ public:
     void emitDestroyingItem(QObject *item) { emit q_func()->destroyingItem(item); }
     void removeCacheItem(QQmlDelegateModelItem *cacheItem);
 
+    bool canReuseItem(QQmlDelegateModelItem *cacheItem) const;
+    void poolItem(QQmlDelegateModelItem *cacheItem);
+    void reuseItem(QQmlDelegateModelItem *cacheItem, Compositor::iterator it);
+    void drainReusableItems();
+
     void updateFilterGroup();
 
     void addGroups(Compositor::iterator from, int count, Compositor::Group group, int groupFlags);
@@ -299,6 +305,7 @@ public:
     QQmlDelegateModelGroupEmitterList m_pendingParts;
 
     QList<QQmlDelegateModelItem *> m_cache;
+    QList<QQmlDelegateModelItem *> m_reusableItems;
     QList<QQDMIncubationTask *> m_finishedIncubating;
     QList<QByteArray> m_watchedRoles;
 
@@ -313,6 +320,7 @@ public:
     bool m_reset : 1;
     bool m_transaction : 1;
     bool m_incubatorCleanupScheduled : 1;
+    bool m_reuseItems : 1;
 
     union {
         struct {
@@ -54,6 +54,7 @@
 
 #include <QtCore/qdebug.h>
 #include <QtCore/qstack.h>
+#include <QtCore/qset.h>
 #include <QXmlStreamReader>
 
 QT_BEGIN_NAMESPACE
@@ -326,6 +327,123 @@ void ListModel::sync(ListModel *src, ListModel *target, QHash<int, ListModel *>
     }
 }
 
+/*
+    Replays the changes recorded by a worker's copy of a model onto the main thread's model,
+    copying only elements that were inserted or changed instead of rebuilding the whole list.
+
+    Returns false if the changes can't be replayed, either because they affect nested list models
+    or because they don't account for the differences between the two lists.  The target may then
+    be partially updated and must be brought up to date with a full sync().
+*/
+bool ListModel::sync(ListModel *src, ListModel *target, const QList<QQmlListModelWorkerAgent::Change> &changes)
+{
+    typedef QQmlListModelWorkerAgent::Change Change;
+
+    if (target->m_uid != src->m_uid)
+        return false;
+
+    bool structureChanged = false;
+    for (int i = 0; i < changes.count(); ++i) {
+        if (changes.at(i).modelUid != src->m_uid)
+            return false;
+        if (changes.at(i).type != Change::Changed)
+            structureChanged = true;
+    }
+
+    ListLayout::sync(src->m_layout, target->m_layout);
+
+    if (!structureChanged) {
+        // Indexes are stable, so each change can be applied directly to the matching elements.
+        for (int i = 0; i < changes.count(); ++i) {
+            const Change &change = changes.at(i);
+            if (change.index < 0 || change.index + change.count > target->elements.count())
+                return false;
+            for (int j = change.index; j < change.index + change.count; ++j) {
+                ListElement *srcElement = src->elements.at(j);
+                ListElement *targetElement = target->elements.at(j);
+                if (srcElement->uid != targetElement->uid)
+                    return false;
+                ListElement::sync(srcElement, src->m_layout, targetElement, target->m_layout, 0);
+                if (targetElement->m_objectCache)
+                    targetElement->m_objectCache->updateValues();
+            }
+        }
+        return target->elements.count() == src->elements.count();
+    }
+
+    // Inserted elements are given negative placeholder uids until their final position, and
+    // with it the source element they correspond to, is known.
+    QSet<ListElement *> changedElements;
+    int placeholderUid = -1;
+
+    for (int i = 0; i < changes.count(); ++i) {
+        const Change &change = changes.at(i);
+        const int elementCount = target->elements.count();
+        switch (change.type) {
+        case Change::Inserted:
+            if (change.index < 0 || change.index > elementCount)
+                return false;
+            target->elements.insertBlank(change.index, change.count);
+            for (int j = 0; j < change.count; ++j)
+                target->elements[change.index + j] = new ListElement(placeholderUid--);
+            break;
+        case Change::Removed: {
+            // A clear() discards the changes preceding it, so its count may exceed the target's.
+            if (change.index < 0 || change.index > elementCount)
+                return false;
+            const int count = qMin(change.count, elementCount - change.index);
+            for (int j = change.index; j < change.index + count; ++j) {
+                ListElement *e = target->elements.at(j);
+                changedElements.remove(e);
+                e->destroy(target->m_layout);
+                delete e;
+            }
+            target->elements.remove(change.index, count);
+            break;
+        }
+        case Change::Moved:
+            if (change.index < 0 || change.to < 0
+                    || change.index + change.count > elementCount
+                    || change.to + change.count > elementCount) {
+                return false;
+            }
+            target->moveElements(change.index, change.to, change.count);
+            break;
+        case Change::Changed:
+            if (change.index < 0 || change.index + change.count > elementCount)
+                return false;
+            for (int j = change.index; j < change.index + change.count; ++j) {
+                ListElement *e = target->elements.at(j);
+                if (e->uid >= 0)
+                    changedElements.insert(e);
+            }
+            break;
+        }
+    }
+
+    if (target->elements.count() != src->elements.count())
+        return false;
+
+    target->updateCacheIndices();
+
+    for (int i = 0; i < target->elements.count(); ++i) {
+        ListElement *srcElement = src->elements.at(i);
+        ListElement *targetElement = target->elements.at(i);
+        if (targetElement->uid < 0) {
+            targetElement->uid = srcElement->uid;
+            ListElement::sync(srcElement, src->m_layout, targetElement, target->m_layout, 0);
+        } else if (targetElement->uid != srcElement->uid) {
+            return false;
+        } else if (!changedElements.isEmpty() && changedElements.contains(targetElement)) {
+            ListElement::sync(srcElement, src->m_layout, targetElement, target->m_layout, 0);
+            if (targetElement->m_objectCache)
+                targetElement->m_objectCache->updateValues();
+        }
+    }
+
+    return true;
+}
+
 ListModel::ListModel(ListLayout *layout, QQmlListModel *modelCache, int uid) : m_layout(layout), m_modelCache(modelCache)
 {
     if (uid == -1)
@@ -357,6 +475,12 @@ void ListModel::insertElement(int index)
 }
 
 void ListModel::move(int from, int to, int n)
+{
+    moveElements(from, to, n);
+    updateCacheIndices();
+}
+
+void ListModel::moveElements(int from, int to, int n)
 {
     if (from > to) {
         // Only move forwards - flip if backwards moving
@@ -374,8 +498,6 @@ void ListModel::move(int from, int to, int n)
         store.append(elements[from+i]);
     for (int i=0 ; i < store.count() ; ++i)
         elements[from+i] = store[i];
-
-    updateCacheIndices();
 }
 
 void ListModel::newElement(int index)
@@ -1680,6 +1802,8 @@ void QQmlListModel::emitItemsChanged(int index, int count, const QVector<int> &r
 
     if (m_mainThread) {
         emit dataChanged(createIndex(index, 0), createIndex(index + count - 1, 0), roles);;
+        if (m_agent)
+            m_agent->m_origChanged = true;
     } else {
         int uid = m_dynamicRoles ? getUid() : m_listModel->getUid();
         m_agent->data.changedChange(uid, index, count, roles);
@@ -1695,6 +1819,8 @@ void QQmlListModel::emitItemsRemoved(int index, int count)
             beginRemoveRows(QModelIndex(), index, index + count - 1);
             endRemoveRows();
             emit countChanged();
+            if (m_agent)
+                m_agent->m_origChanged = true;
     } else {
         int uid = m_dynamicRoles ? getUid() : m_listModel->getUid();
         if (index == 0 && count == this->count())
@@ -1712,6 +1838,8 @@ void QQmlListModel::emitItemsInserted(int index, int count)
         beginInsertRows(QModelIndex(), index, index + count - 1);
         endInsertRows();
         emit countChanged();
+        if (m_agent)
+            m_agent->m_origChanged = true;
     } else {
         int uid = m_dynamicRoles ? getUid() : m_listModel->getUid();
         m_agent->data.insertChange(uid, index, count);
@@ -1726,6 +1854,8 @@ void QQmlListModel::emitItemsMoved(int from, int to, int n)
     if (m_mainThread) {
         beginMoveRows(QModelIndex(), from, from + n - 1, QModelIndex(), to > from ? to + n : to);
         endMoveRows();
+        if (m_agent)
+            m_agent->m_origChanged = true;
     } else {
         int uid = m_dynamicRoles ? getUid() : m_listModel->getUid();
         m_agent->data.moveChange(uid, from, n, to);
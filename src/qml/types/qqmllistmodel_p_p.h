@@ -54,6 +54,7 @@
 //
 
 #include "qqmllistmodel_p.h"
+#include "qqmllistmodelworkeragent_p.h"
 #include <private/qqmlengine_p.h>
 #include <private/qqmlopenmetaobject_p.h>
 #include <qqml.h>
@@ -350,6 +351,7 @@ public:
     int getUid() const { return m_uid; }
 
     static void sync(ListModel *src, ListModel *target, QHash<int, ListModel *> *srcModelHash);
+    static bool sync(ListModel *src, ListModel *target, const QList<QQmlListModelWorkerAgent::Change> &changes);
 
     ModelObject *getOrCreateModelObject(QQmlListModel *model, int elementIndex);
 
@@ -369,6 +371,7 @@ private:
     };
 
     void newElement(int index);
+    void moveElements(int from, int to, int n);
 
     void updateCacheIndices();
 
@@ -88,7 +88,8 @@ void QQmlListModelWorkerAgent::Data::changedChange(int uid, int index, int count
 }
 
 QQmlListModelWorkerAgent::QQmlListModelWorkerAgent(QQmlListModel *model)
-: m_ref(1), m_orig(model), m_copy(new QQmlListModel(model, this))
+: m_ref(1), m_orig(model), m_copy(new QQmlListModel(model, this)), m_origChanged(false)
+, m_lastSyncMode(NoSync)
 {
 }
 
@@ -195,10 +196,17 @@ bool QQmlListModelWorkerAgent::event(QEvent *e)
             QHash<int, ListModel *> targetModelStaticHash;
 
             Q_ASSERT(m_orig->m_dynamicRoles == s->list->m_dynamicRoles);
-            if (m_orig->m_dynamicRoles)
+            if (m_orig->m_dynamicRoles) {
                 QQmlListModel::sync(s->list, m_orig, &targetModelDynamicHash);
-            else
+                m_lastSyncMode = FullSync;
+            } else if (!m_origChanged && ListModel::sync(s->list->m_listModel, m_orig->m_listModel, changes)) {
+                targetModelStaticHash.insert(m_orig->m_listModel->getUid(), m_orig->m_listModel);
+                m_lastSyncMode = ReplaySync;
+            } else {
                 ListModel::sync(s->list->m_listModel, m_orig->m_listModel, &targetModelStaticHash);
+                m_lastSyncMode = FullSync;
+            }
+            m_origChanged = false;
 
             for (int ii = 0; ii < changes.count(); ++ii) {
                 const Change &change = changes.at(ii);
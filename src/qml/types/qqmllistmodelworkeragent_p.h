@@ -90,6 +90,10 @@ public:
     Q_INVOKABLE void move(int from, int to, int count);
     Q_INVOKABLE void sync();
 
+    // How the main thread's model was brought up to date by the last sync()
+    enum SyncMode { NoSync, ReplaySync, FullSync };
+    SyncMode lastSyncMode() const { return m_lastSyncMode; }
+
     struct VariantRef
     {
         VariantRef() : a(0) {}
@@ -112,6 +116,7 @@ protected:
 private:
     friend class QQuickWorkerScriptEnginePrivate;
     friend class QQmlListModel;
+    friend class ListModel;
 
     struct Change
     {
@@ -144,6 +149,8 @@ private:
     QAtomicInt m_ref;
     QQmlListModel *m_orig;
     QQmlListModel *m_copy;
+    bool m_origChanged;
+    SyncMode m_lastSyncMode;
     QMutex mutex;
     QWaitCondition syncDone;
 };
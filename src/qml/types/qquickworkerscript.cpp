@@ -68,15 +68,15 @@ class WorkerDataEvent : public QEvent
 public:
     enum Type { WorkerData = QEvent::User };
 
-    WorkerDataEvent(int workerId, const QByteArray &data);
+    WorkerDataEvent(int workerId, const QV8Worker::Message &data);
     virtual ~WorkerDataEvent();
 
     int workerId() const;
-    QByteArray data() const;
+    const QV8Worker::Message &data() const;
 
 private:
     int m_id;
-    QByteArray m_data;
+    QV8Worker::Message m_data; // Released with the event, even if it is never delivered
 };
 
 class WorkerLoadEvent : public QEvent
@@ -184,7 +184,7 @@ protected:
     virtual bool event(QEvent *);
 
 private:
-    void processMessage(int, const QByteArray &);
+    void processMessage(int, const QV8Worker::Message &);
     void processLoad(int, const QUrl &);
     void reportScriptException(WorkerScript *, const QQmlError &error);
 };
@@ -281,7 +281,7 @@ v8::Handle<v8::Value> QQuickWorkerScriptEnginePrivate::sendMessage(const v8::Arg
 
     int id = args[1]->Int32Value();
 
-    QByteArray data = QV8Worker::serialize(args[2], engine);
+    QV8Worker::Message data = QV8Worker::serialize(args[2], engine);
 
     QMutexLocker locker(&engine->p->m_lock);
     WorkerScript *script = engine->p->workers.value(id);
@@ -337,7 +337,7 @@ bool QQuickWorkerScriptEnginePrivate::event(QEvent *event)
     }
 }
 
-void QQuickWorkerScriptEnginePrivate::processMessage(int id, const QByteArray &data)
+void QQuickWorkerScriptEnginePrivate::processMessage(int id, const QV8Worker::Message &data)
 {
     WorkerScript *script = workers.value(id);
     if (!script)
@@ -411,7 +411,7 @@ void QQuickWorkerScriptEnginePrivate::reportScriptException(WorkerScript *script
         QCoreApplication::postEvent(script->owner, new WorkerErrorEvent(error));
 }
 
-WorkerDataEvent::WorkerDataEvent(int workerId, const QByteArray &data)
+WorkerDataEvent::WorkerDataEvent(int workerId, const QV8Worker::Message &data)
 : QEvent((QEvent::Type)WorkerData), m_id(workerId), m_data(data)
 {
 }
@@ -425,7 +425,7 @@ int WorkerDataEvent::workerId() const
     return m_id;
 }
 
-QByteArray WorkerDataEvent::data() const
+const QV8Worker::Message &WorkerDataEvent::data() const
 {
     return m_data;
 }
@@ -534,7 +534,7 @@ void QQuickWorkerScriptEngine::executeUrl(int id, const QUrl &url)
     QCoreApplication::postEvent(d, new WorkerLoadEvent(id, url));
 }
 
-void QQuickWorkerScriptEngine::sendMessage(int id, const QByteArray &data)
+void QQuickWorkerScriptEngine::sendMessage(int id, const QV8WorkerMessage &data)
 {
     QCoreApplication::postEvent(d, new WorkerDataEvent(id, data));
 }
@@ -602,11 +602,21 @@ void QQuickWorkerScriptEngine::run()
 
     Worker script can not use \l {qtqml-javascript-imports.html}{.import} syntax.
 
+    \section3 Worker Threads
+
+    By default all worker scripts created by an engine share a single
+    thread, so two busy scripts will take turns rather than run side by
+    side. Setting the \c QML_WORKERSCRIPT_THREADS environment variable to
+    a number greater than one makes the engine spread worker scripts over
+    that many threads instead, each with its own JavaScript context; zero
+    uses one thread per CPU core. Worker scripts are assigned to the
+    threads in turn, unless \l workerThread selects a specific one.
+
     \sa {declarative/threading/workerscript}{WorkerScript example},
         {declarative/threading/threadedlistmodel}{Threaded ListModel example}
 */
 QQuickWorkerScript::QQuickWorkerScript(QObject *parent)
-: QObject(parent), m_engine(0), m_scriptId(-1), m_componentComplete(true)
+: QObject(parent), m_engine(0), m_scriptId(-1), m_workerThread(-1), m_componentComplete(true)
 {
 }
 
@@ -639,6 +649,40 @@ void QQuickWorkerScript::setSource(const QUrl &source)
     emit sourceChanged();
 }
 
+/*!
+    \qmlproperty int WorkerScript::workerThread
+    \since QtQuick 2.2
+
+    This holds the index of the worker thread the script runs in.
+
+    Scripts with the same index share a thread and a JavaScript context,
+    while scripts with different indices may run concurrently. The index
+    wraps around the number of worker threads available to the engine;
+    see \c QML_WORKERSCRIPT_THREADS. The default value of -1 lets the
+    engine pick the next thread in turn.
+
+    The thread is chosen when the WorkerScript is created, so this property
+    has no effect once the component has completed.
+*/
+int QQuickWorkerScript::workerThread() const
+{
+    return m_workerThread;
+}
+
+void QQuickWorkerScript::setWorkerThread(int thread)
+{
+    if (m_workerThread == thread)
+        return;
+
+    if (m_engine) {
+        qWarning("QQuickWorkerScript: workerThread cannot be changed after the WorkerScript has started");
+        return;
+    }
+
+    m_workerThread = thread;
+    emit workerThreadChanged();
+}
+
 /*!
     \qmlmethod WorkerScript::sendMessage(jsobject message)
 
@@ -688,7 +732,7 @@ QQuickWorkerScriptEngine *QQuickWorkerScript::engine()
             return 0;
         }
 
-        m_engine = QQmlEnginePrivate::get(engine)->getWorkerScriptEngine();
+        m_engine = QQmlEnginePrivate::get(engine)->getWorkerScriptEngine(m_workerThread);
         m_scriptId = m_engine->registerWorkerScript(this);
 
         if (m_source.isValid())
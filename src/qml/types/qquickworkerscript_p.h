@@ -65,6 +65,7 @@ QT_BEGIN_NAMESPACE
 
 class QQuickWorkerScript;
 class QQuickWorkerScriptEnginePrivate;
+struct QV8WorkerMessage;
 class QQuickWorkerScriptEngine : public QThread
 {
 Q_OBJECT
@@ -75,7 +76,7 @@ public:
     int registerWorkerScript(QQuickWorkerScript *);
     void removeWorkerScript(int);
     void executeUrl(int, const QUrl &);
-    void sendMessage(int, const QByteArray &);
+    void sendMessage(int, const QV8WorkerMessage &);
 
 protected:
     virtual void run();
@@ -90,6 +91,7 @@ class Q_AUTOTEST_EXPORT QQuickWorkerScript : public QObject, public QQmlParserSt
 {
     Q_OBJECT
     Q_PROPERTY(QUrl source READ source WRITE setSource NOTIFY sourceChanged)
+    Q_PROPERTY(int workerThread READ workerThread WRITE setWorkerThread NOTIFY workerThreadChanged REVISION 1)
 
     Q_INTERFACES(QQmlParserStatus)
 public:
@@ -99,11 +101,15 @@ public:
     QUrl source() const;
     void setSource(const QUrl &);
 
+    int workerThread() const;
+    void setWorkerThread(int);
+
 public slots:
     void sendMessage(QQmlV8Function*);
 
 signals:
     void sourceChanged();
+    Q_REVISION(1) void workerThreadChanged();
     void message(const QQmlV8Handle &messageObject);
 
 protected:
@@ -115,6 +121,7 @@ private:
     QQuickWorkerScriptEngine *engine();
     QQuickWorkerScriptEngine *m_engine;
     int m_scriptId;
+    int m_workerThread;
     QUrl m_source;
     bool m_componentComplete;
 };
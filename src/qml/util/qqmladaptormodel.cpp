@@ -379,7 +379,7 @@ void QQmlDMCachedModelData::set_property(
 class QQmlDMAbstractItemModelData : public QQmlDMCachedModelData
 {
     Q_OBJECT
-    Q_PROPERTY(bool hasModelChildren READ hasModelChildren CONSTANT)
+    Q_PROPERTY(bool hasModelChildren READ hasModelChildren NOTIFY hasModelChildrenChanged)
 public:
     QQmlDMAbstractItemModelData(
             QQmlDelegateModelItemMetaType *metaType,
@@ -399,6 +399,16 @@ public:
         }
     }
 
+    bool resolveIndex(const QQmlAdaptorModel &model, int idx)
+    {
+        // A pooled delegate is rebound to another row here, which may differ in
+        // whether it has children.
+        if (!QQmlDMCachedModelData::resolveIndex(model, idx))
+            return false;
+        emit hasModelChildrenChanged();
+        return true;
+    }
+
     QVariant value(int role) const
     {
         return type->model->aim()->index(index, 0, type->model->rootIndex).data(role);
@@ -438,6 +448,9 @@ public:
             return v8::Boolean::New(false);
         }
     }
+
+Q_SIGNALS:
+    void hasModelChildrenChanged();
 };
 
 class VDMAbstractItemModelDataType : public VDMModelDelegateDataType
@@ -383,6 +383,11 @@ class QV8Context2DPixelArrayResource : public QV8ObjectResource
 public:
     QV8Context2DPixelArrayResource(QV8Engine *e) : QV8ObjectResource(e) {}
 
+    // The pixel array object indexes straight into the bits of this image, so
+    // it is kept in RGBA byte order and must never be detached or reassigned
+    // once it has been handed to V8.  Use toImage() to pass it on to painting.
+    QImage toImage() const { return image.convertToFormat(QImage::Format_ARGB32); }
+
     QImage image;
 };
 
@@ -588,14 +593,17 @@ static v8::Local<v8::Object> qt_create_image_data(qreal w, qreal h, QV8Engine* e
     v8::Local<v8::Object> imageData = ed->constructorImageData->NewInstance();
     QV8Context2DPixelArrayResource *r = new QV8Context2DPixelArrayResource(engine);
     if (image.isNull()) {
-        r->image = QImage(w, h, QImage::Format_ARGB32);
+        r->image = QImage(w, h, QImage::Format_RGBA8888);
         r->image.fill(0x00000000);
     } else {
         Q_ASSERT(image.width() == int(w) && image.height() == int(h));
-        r->image = image.format() == QImage::Format_ARGB32 ? image : image.convertToFormat(QImage::Format_ARGB32);
+        r->image = image.convertToFormat(QImage::Format_RGBA8888);
     }
     v8::Local<v8::Object> pixelData = ed->constructorPixelArray->NewInstance();
     pixelData->SetExternalResource(r);
+    // Let V8 read and write the pixels directly, with the clamping semantics
+    // of a Uint8ClampedArray, instead of going through an indexed interceptor.
+    pixelData->SetIndexedPropertiesToPixelData(r->image.bits(), r->image.byteCount());
 
     imageData->SetInternalField(0, pixelData);
     return imageData;
@@ -1371,7 +1379,7 @@ static v8::Handle<v8::Value> ctx2d_createPattern(const v8::Arguments &args)
             if (args[0]->IsObject()) {
                 QV8Context2DPixelArrayResource *pixelData = v8_resource_cast<QV8Context2DPixelArrayResource>(args[0]->ToObject()->Get(v8::String::New("data"))->ToObject());
                 if (pixelData) {
-                    patternTexture = pixelData->image;
+                    patternTexture = pixelData->toImage();
                 }
             } else {
                 patternTexture = r->context->createPixmap(QUrl(engine->toString(args[0]->ToString())))->image();
@@ -2533,7 +2541,7 @@ static v8::Handle<v8::Value> ctx2d_drawImage(const v8::Arguments &args)
 
         QV8Context2DPixelArrayResource *pix = v8_resource_cast<QV8Context2DPixelArrayResource>(args[0]->ToObject()->GetInternalField(0)->ToObject());
         if (pix && !pix->image.isNull()) {
-            pixmap.take(new QQuickCanvasPixmap(pix->image, r->context->canvas()->window()));
+            pixmap.take(new QQuickCanvasPixmap(pix->toImage(), r->context->canvas()->window()));
         } else if (imageItem) {
             pixmap.take(r->context->createPixmap(imageItem->source()));
         } else if (canvas) {
@@ -2669,7 +2677,9 @@ v8::Handle<v8::Value> ctx2d_imageData_data(v8::Local<v8::String>, const v8::Acce
     \brief Provides ordered and indexed access to the components of each pixel in image data
 
   The CanvasPixelArray object provides ordered, indexed access to the color components of each pixel of the image data.
-  The CanvasPixelArray can be accessed as normal Javascript array.
+  The CanvasPixelArray can be accessed as normal Javascript array. It is backed
+  directly by the image data, and follows the semantics of a Uint8ClampedArray:
+  values written to it are rounded and clamped to the range 0 to 255.
     \sa CanvasImageData
     \sa {http://www.w3.org/TR/2dcontext/#canvaspixelarray}{W3C 2d context standard for PixelArray}
   */
@@ -2688,59 +2698,6 @@ v8::Handle<v8::Value> ctx2d_pixelArray_length(v8::Local<v8::String>, const v8::A
     return v8::Integer::New(r->image.width() * r->image.height() * 4);
 }
 
-v8::Handle<v8::Value> ctx2d_pixelArray_indexed(uint32_t index, const v8::AccessorInfo& args)
-{
-    QV8Context2DPixelArrayResource *r = v8_resource_cast<QV8Context2DPixelArrayResource>(args.This());
-
-    if (r && index < static_cast<quint32>(r->image.width() * r->image.height() * 4)) {
-        const quint32 w = r->image.width();
-        const quint32 row = (index / 4) / w;
-        const quint32 col = (index / 4) % w;
-        const QRgb* pixel = reinterpret_cast<const QRgb*>(r->image.constScanLine(row));
-        pixel += col;
-        switch (index % 4) {
-        case 0:
-            return v8::Integer::New(qRed(*pixel));
-        case 1:
-            return v8::Integer::New(qGreen(*pixel));
-        case 2:
-            return v8::Integer::New(qBlue(*pixel));
-        case 3:
-            return v8::Integer::New(qAlpha(*pixel));
-        }
-    }
-    return v8::Undefined();
-}
-
-v8::Handle<v8::Value> ctx2d_pixelArray_indexed_set(uint32_t index, v8::Local<v8::Value> value, const v8::AccessorInfo& info)
-{
-    QV8Context2DPixelArrayResource *r = v8_resource_cast<QV8Context2DPixelArrayResource>(info.This());
-
-    const int v = value->Uint32Value();
-    if (r && index < static_cast<quint32>(r->image.width() * r->image.height() * 4) && v >= 0 && v <= 255) {
-        const quint32 w = r->image.width();
-        const quint32 row = (index / 4) / w;
-        const quint32 col = (index / 4) % w;
-
-        QRgb* pixel = reinterpret_cast<QRgb*>(r->image.scanLine(row));
-        pixel += col;
-        switch (index % 4) {
-        case 0:
-            *pixel = qRgba(v, qGreen(*pixel), qBlue(*pixel), qAlpha(*pixel));
-            break;
-        case 1:
-            *pixel = qRgba(qRed(*pixel), v, qBlue(*pixel), qAlpha(*pixel));
-            break;
-        case 2:
-            *pixel = qRgba(qRed(*pixel), qGreen(*pixel), v, qAlpha(*pixel));
-            break;
-        case 3:
-            *pixel = qRgba(qRed(*pixel), qGreen(*pixel), qBlue(*pixel), v);
-            break;
-        }
-    }
-    return v8::Undefined();
-}
 /*!
     \qmlmethod CanvasImageData QtQuick2::Context2D::createImageData(real sw, real sh)
 
@@ -2900,7 +2857,7 @@ static v8::Handle<v8::Value> ctx2d_putImageData(const v8::Arguments &args)
             dirtyHeight = h;
         }
 
-        QImage image = pixelArray->image.copy(dirtyX, dirtyY, dirtyWidth, dirtyHeight);
+        QImage image = pixelArray->image.copy(dirtyX, dirtyY, dirtyWidth, dirtyHeight).convertToFormat(QImage::Format_ARGB32);
         r->context->buffer()->drawImage(image, QRectF(dirtyX, dirtyY, dirtyWidth, dirtyHeight), QRectF(dx, dy, dirtyWidth, dirtyHeight));
     }
     return args.This();
@@ -3764,7 +3721,6 @@ QQuickContext2DEngineData::QQuickContext2DEngineData(QV8Engine *engine)
     v8::Local<v8::FunctionTemplate> ftPixelArray = v8::FunctionTemplate::New();
     ftPixelArray->InstanceTemplate()->SetHasExternalResource(true);
     ftPixelArray->InstanceTemplate()->SetAccessor(v8::String::New("length"), ctx2d_pixelArray_length, 0, v8::External::New(engine));
-    ftPixelArray->InstanceTemplate()->SetIndexedPropertyHandler(ctx2d_pixelArray_indexed, ctx2d_pixelArray_indexed_set, 0, 0, 0, v8::External::New(engine));
     constructorPixelArray = qPersistentNew(ftPixelArray->GetFunction());
 
     v8::Local<v8::FunctionTemplate> ftImageData = v8::FunctionTemplate::New();
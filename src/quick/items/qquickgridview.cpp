@@ -1544,6 +1544,26 @@ void QQuickGridView::setHighlightFollowsCurrentItem(bool autoHighlight)
     delegates; the fewer objects and bindings in a delegate, the faster a view may be
     scrolled.
 */
+
+/*!
+    \qmlproperty bool QtQuick2::GridView::reuseItems
+    \since QtQuick 2.2
+
+    This property holds whether delegate instances that scroll out of the view
+    are kept for reuse instead of being destroyed.
+
+    When enabled, an item released by the view is pooled and later rebound to
+    the index and model data of the next item that scrolls into view, avoiding
+    the cost of creating a new instance of the delegate.  A delegate can handle
+    the \l{DelegateModel::onPooled()}{DelegateModel.onPooled} and
+    \l{DelegateModel::onReused()}{DelegateModel.onReused} attached signals to
+    reset any state that is not bound to the model data.
+
+    This property only applies when the view creates its own DelegateModel; set
+    DelegateModel::reuseItems directly when assigning a DelegateModel as the model.
+
+    The default value is false.
+*/
 void QQuickGridView::setHighlightMoveDuration(int duration)
 {
     Q_D(QQuickGridView);
@@ -0,0 +1,398 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the QtQuick module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qquickhittestindex_p.h"
+
+#include "qquickitem_p.h"
+
+#include <QtCore/qvarlengtharray.h>
+
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE
+
+// Largest number of entries in a leaf
+static const int maxLeafSize = 4;
+
+// Fewest entries added since the last build that trigger a rebuild
+static const int minRebuildCount = 16;
+
+QQuickHitTestIndex::QQuickHitTestIndex()
+: m_built(0), m_removed(0)
+{
+}
+
+static int itemKinds(QQuickItem *item)
+{
+    QQuickItemPrivate *itemPrivate = QQuickItemPrivate::get(item);
+
+    int kinds = 0;
+    if (itemPrivate->acceptedMouseButtons())
+        kinds |= QQuickHitTestIndex::Mouse;
+    if (itemPrivate->hoverEnabled)
+        kinds |= QQuickHitTestIndex::Hover;
+#ifndef QT_NO_CURSOR
+    if (itemPrivate->hasCursor)
+        kinds |= QQuickHitTestIndex::Cursor;
+#endif
+    return kinds;
+}
+
+static QRectF sceneRect(QQuickItem *item)
+{
+    QQuickItemPrivate *itemPrivate = QQuickItemPrivate::get(item);
+    QRectF rect = itemPrivate->itemToWindowTransform().mapRect(QRectF(0, 0, item->width(), item->height()));
+    // Allow for rounding in the transform, contains() has the final say
+    return rect.adjusted(-1, -1, 1, 1);
+}
+
+// Items clipped away entirely end up with an empty rect and are never hit,
+// like the subtrees event delivery skips outside a clipping item
+static QRectF clippedSceneRect(QQuickItem *item)
+{
+    QRectF rect = sceneRect(item);
+    for (QQuickItem *parent = item->parentItem(); parent && !rect.isEmpty(); parent = parent->parentItem()) {
+        if (QQuickItemPrivate::get(parent)->flags & QQuickItem::ItemClipsChildrenToShape)
+            rect &= sceneRect(parent);
+    }
+    return rect;
+}
+
+// Called when the item is added to the window or starts or stops taking
+// input
+void QQuickHitTestIndex::updateItem(QQuickItem *item)
+{
+    int kinds = itemKinds(item);
+
+    QHash<QQuickItem *, int>::const_iterator it = m_entryIndex.constFind(item);
+    if (it == m_entryIndex.constEnd()) {
+        if (!kinds)
+            return;
+        Entry entry = { item, clippedSceneRect(item), kinds };
+        m_entryIndex.insert(item, m_entries.count());
+        m_entries.append(entry);
+        addCount(item, 1);
+    } else if (kinds) {
+        m_entries[*it].kinds = kinds;
+    } else {
+        removeEntry(*it);
+    }
+}
+
+// Called before the item is removed from the window, while its parents are
+// still set
+void QQuickHitTestIndex::removeItem(QQuickItem *item)
+{
+    m_moved.remove(item);
+
+    QHash<QQuickItem *, int>::const_iterator it = m_entryIndex.constFind(item);
+    if (it != m_entryIndex.constEnd())
+        removeEntry(*it);
+}
+
+void QQuickHitTestIndex::removeEntry(int index)
+{
+    QQuickItem *item = m_entries.at(index).item;
+    addCount(item, -1);
+    m_entryIndex.remove(item);
+
+    if (index < m_built) {
+        // Leave a hole in the hierarchy until the next rebuild
+        Entry &entry = m_entries[index];
+        entry.item = 0;
+        entry.rect = QRectF();
+        entry.kinds = 0;
+        ++m_removed;
+    } else {
+        if (index != m_entries.count() - 1) {
+            m_entries[index] = m_entries.last();
+            m_entryIndex[m_entries.at(index).item] = index;
+        }
+        m_entries.removeLast();
+    }
+}
+
+// Called when the item moved to a new parent in the same window
+void QQuickHitTestIndex::itemReparented(QQuickItem *item, QQuickItem *oldParent, QQuickItem *newParent)
+{
+    int count = m_subtreeCounts.value(item);
+    if (!count)
+        return;
+
+    if (oldParent)
+        addCount(oldParent, -count);
+    if (newParent)
+        addCount(newParent, count);
+    m_moved.insert(item);
+}
+
+// Only items with entries in their subtree affect the index
+void QQuickHitTestIndex::itemDirty(QQuickItem *item, quint32 dirtyType)
+{
+    const quint32 geometry = QQuickItemPrivate::TransformOrigin | QQuickItemPrivate::Transform
+                           | QQuickItemPrivate::BasicTransform | QQuickItemPrivate::Position
+                           | QQuickItemPrivate::Size | QQuickItemPrivate::Clip;
+
+    if ((dirtyType & geometry) && m_subtreeCounts.contains(item))
+        m_moved.insert(item);
+}
+
+void QQuickHitTestIndex::addCount(QQuickItem *item, int delta)
+{
+    for (; item; item = item->parentItem()) {
+        QHash<QQuickItem *, int>::iterator it = m_subtreeCounts.find(item);
+        if (it == m_subtreeCounts.end())
+            it = m_subtreeCounts.insert(item, 0);
+        *it += delta;
+        if (*it <= 0)
+            m_subtreeCounts.erase(it);
+    }
+}
+
+typedef QVarLengthArray<QQuickItem *, 16> ItemPath;
+
+// Event delivery visits children topmost first, each before its parent
+static bool deliveredBefore(const ItemPath *a, const ItemPath *b)
+{
+    int count = qMin(a->count(), b->count());
+    int ii = 0;
+    while (ii < count && a->at(ii) == b->at(ii))
+        ++ii;
+    if (ii == count)
+        return a->count() > b->count();
+
+    QList<QQuickItem *> children = QQuickItemPrivate::get(a->at(ii - 1))->paintOrderChildItems();
+    return children.indexOf(a->at(ii)) > children.indexOf(b->at(ii));
+}
+
+// Fills path with the ancestors of item, starting at root, unless event
+// delivery from root wouldn't reach it
+static bool deliveryPath(QQuickItem *root, QQuickItem *item, ItemPath *path)
+{
+    QQuickItemPrivate *itemPrivate = QQuickItemPrivate::get(item);
+    if (!itemPrivate->effectiveVisible || !itemPrivate->effectiveEnable)
+        return false;
+
+    for (QQuickItem *ancestor = item; ancestor; ancestor = ancestor->parentItem()) {
+        if (ancestor != root && QQuickItemPrivate::get(ancestor)->culled)
+            return false;
+        path->append(ancestor);
+        if (ancestor == root)
+            break;
+    }
+    if (path->last() != root)
+        return false;
+
+    std::reverse(path->begin(), path->end());
+    return true;
+}
+
+QVector<QQuickItem *> QQuickHitTestIndex::itemsAt(QQuickItem *root, const QPointF &scenePos, int kind)
+{
+    refitMoved();
+
+    int pending = m_entries.count() - m_built;
+    if (pending > qMax(minRebuildCount, m_built / 4) || m_removed > m_built / 2)
+        rebuild();
+
+    QVarLengthArray<QQuickItem *, 16> candidates;
+
+    QVarLengthArray<int, 64> stack;
+    if (!m_nodes.isEmpty())
+        stack.append(0);
+    while (!stack.isEmpty()) {
+        int index = stack.last();
+        stack.removeLast();
+
+        const Node &node = m_nodes.at(index);
+
+        if (!node.rect.contains(scenePos))
+            continue;
+
+        if (node.count) {
+            for (int ii = node.first; ii < node.first + node.count; ++ii) {
+                const Entry &entry = m_entries.at(ii);
+                if ((entry.kinds & kind) && entry.rect.contains(scenePos))
+                    candidates.append(entry.item);
+            }
+        } else {
+            stack.append(node.right);
+            stack.append(index + 1);
+        }
+    }
+
+    for (int ii = m_built; ii < m_entries.count(); ++ii) {
+        const Entry &entry = m_entries.at(ii);
+        if ((entry.kinds & kind) && entry.rect.contains(scenePos))
+            candidates.append(entry.item);
+    }
+
+    QVector<ItemPath> paths(candidates.count());
+    QVarLengthArray<const ItemPath *, 16> hits;
+    for (int ii = 0; ii < candidates.count(); ++ii) {
+        if (deliveryPath(root, candidates.at(ii), &paths[ii]))
+            hits.append(&paths.at(ii));
+    }
+
+    std::sort(hits.begin(), hits.end(), deliveredBefore);
+
+    QVector<QQuickItem *> items;
+    items.reserve(hits.count());
+    for (int ii = 0; ii < hits.count(); ++ii)
+        items.append(hits.at(ii)->last());
+    return items;
+}
+
+void QQuickHitTestIndex::refitItem(QQuickItem *item, QSet<int> *dirtyNodes)
+{
+    if (!m_subtreeCounts.contains(item))
+        return;
+
+    QHash<QQuickItem *, int>::const_iterator it = m_entryIndex.constFind(item);
+    if (it != m_entryIndex.constEnd()) {
+        m_entries[*it].rect = clippedSceneRect(item);
+        if (*it < m_built) {
+            for (int index = m_leaves.at(*it); index >= 0 && !dirtyNodes->contains(index);
+                 index = m_nodes.at(index).parent) {
+                dirtyNodes->insert(index);
+            }
+        }
+    }
+
+    const QList<QQuickItem *> &children = QQuickItemPrivate::get(item)->childItems;
+    for (int ii = 0; ii < children.count(); ++ii)
+        refitItem(children.at(ii), dirtyNodes);
+}
+
+// Recomputes the entries below the items that moved and the bounds of the
+// nodes holding them.  Children are stored after their parent, so
+// recomputing in reverse index order visits them first.
+void QQuickHitTestIndex::refitMoved()
+{
+    if (m_moved.isEmpty())
+        return;
+
+    QSet<int> dirtyNodes;
+    for (QSet<QQuickItem *>::const_iterator it = m_moved.constBegin(); it != m_moved.constEnd(); ++it)
+        refitItem(*it, &dirtyNodes);
+    m_moved.clear();
+
+    QList<int> nodes = dirtyNodes.toList();
+    std::sort(nodes.begin(), nodes.end());
+    for (int ii = nodes.count() - 1; ii >= 0; --ii) {
+        Node &node = m_nodes[nodes.at(ii)];
+        if (node.count) {
+            QRectF bounds = m_entries.at(node.first).rect;
+            for (int jj = node.first + 1; jj < node.first + node.count; ++jj)
+                bounds |= m_entries.at(jj).rect;
+            node.rect = bounds;
+        } else {
+            node.rect = m_nodes.at(nodes.at(ii) + 1).rect | m_nodes.at(node.right).rect;
+        }
+    }
+}
+
+void QQuickHitTestIndex::rebuild()
+{
+    int count = 0;
+    for (int ii = 0; ii < m_entries.count(); ++ii) {
+        if (m_entries.at(ii).item)
+            m_entries[count++] = m_entries.at(ii);
+    }
+    m_entries.resize(count);
+
+    m_nodes.clear();
+    m_leaves.resize(count);
+    if (count)
+        build(0, count, -1);
+
+    for (int ii = 0; ii < count; ++ii)
+        m_entryIndex[m_entries.at(ii).item] = ii;
+
+    m_built = count;
+    m_removed = 0;
+}
+
+static inline qreal centerX(const QRectF &r) { return r.x() + r.width() / 2; }
+static inline qreal centerY(const QRectF &r) { return r.y() + r.height() / 2; }
+
+struct EntryCenterLessThan
+{
+    EntryCenterLessThan(bool horizontal) : horizontal(horizontal) {}
+    template<typename T>
+    bool operator()(const T &a, const T &b) const
+    {
+        return horizontal ? centerX(a.rect) < centerX(b.rect) : centerY(a.rect) < centerY(b.rect);
+    }
+    bool horizontal;
+};
+
+// Builds the subtree for count entries starting at first, splitting them at
+// the median along the longer side of their bounds.  Returns the node index.
+int QQuickHitTestIndex::build(int first, int count, int parent)
+{
+    int index = m_nodes.count();
+    Node node = { QRectF(), first, 0, -1, parent };
+    m_nodes.append(node);
+
+    QRectF bounds = m_entries.at(first).rect;
+    for (int ii = first + 1; ii < first + count; ++ii)
+        bounds |= m_entries.at(ii).rect;
+    m_nodes[index].rect = bounds;
+
+    if (count <= maxLeafSize) {
+        m_nodes[index].count = count;
+        for (int ii = first; ii < first + count; ++ii)
+            m_leaves[ii] = index;
+        return index;
+    }
+
+    Entry *begin = m_entries.data() + first;
+    int half = count / 2;
+    std::nth_element(begin, begin + half, begin + count, EntryCenterLessThan(bounds.width() >= bounds.height()));
+
+    build(first, half, index);
+    int right = build(first + half, count - half, index);
+    m_nodes[index].right = right;
+    return index;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,136 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the QtQuick module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QQUICKHITTESTINDEX_P_H
+#define QQUICKHITTESTINDEX_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qhash.h>
+#include <QtCore/qrect.h>
+#include <QtCore/qset.h>
+#include <QtCore/qvector.h>
+#include <private/qtquickglobal_p.h>
+
+QT_BEGIN_NAMESPACE
+
+class QQuickItem;
+
+// A bounding volume hierarchy over the window space bounding rects of the
+// items that take mouse, hover or cursor input, clipped to the bounds of
+// their clipping ancestors.  It only narrows down the items that might be
+// under a point; callers still check contains(), clipping ancestors and so
+// on before delivering to an item.
+//
+// The index is updated as items are added, removed or reparented, and only
+// the entries below an item that moved are refit.  Stacking order,
+// visibility and enabled state are resolved when it is queried, so changing
+// them costs nothing here.  Items added since the hierarchy was last built
+// are scanned linearly until there are enough of them to rebuild.
+class Q_QUICK_PRIVATE_EXPORT QQuickHitTestIndex
+{
+public:
+    enum Kind {
+        Mouse = 0x01,
+        Hover = 0x02,
+        Cursor = 0x04
+    };
+
+    QQuickHitTestIndex();
+
+    void updateItem(QQuickItem *item);
+    void removeItem(QQuickItem *item);
+    void itemReparented(QQuickItem *item, QQuickItem *oldParent, QQuickItem *newParent);
+    void itemDirty(QQuickItem *item, quint32 dirtyType);
+
+    // Returns the visible and enabled items below root of the given kind
+    // whose bounds contain scenePos, topmost first, in the order the item
+    // tree is traversed for event delivery
+    QVector<QQuickItem *> itemsAt(QQuickItem *root, const QPointF &scenePos, int kind);
+
+private:
+    struct Entry {
+        QQuickItem *item;
+        QRectF rect;
+        int kinds;
+    };
+
+    // Leaves hold count > 0 entries starting at first; inner nodes have two
+    // children, the first at index + 1 and the second at right
+    struct Node {
+        QRectF rect;
+        int first;
+        int count;
+        int right;
+        int parent;
+    };
+
+    void removeEntry(int index);
+    void addCount(QQuickItem *item, int delta);
+    void refitMoved();
+    void refitItem(QQuickItem *item, QSet<int> *dirtyNodes);
+    void rebuild();
+    int build(int first, int count, int parent);
+
+    QVector<Entry> m_entries;
+    QVector<Node> m_nodes;
+    // The leaf holding each of the first m_built entries
+    QVector<int> m_leaves;
+    QHash<QQuickItem *, int> m_entryIndex;
+    // The number of entries in the subtree of each item that has any
+    QHash<QQuickItem *, int> m_subtreeCounts;
+    QSet<QQuickItem *> m_moved;
+    int m_built;
+    int m_removed;
+};
+
+QT_END_NAMESPACE
+
+#endif // QQUICKHITTESTINDEX_P_H
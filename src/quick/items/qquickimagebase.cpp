@@ -231,6 +231,9 @@ void QQuickImageBase::load()
 
             d->pix.connectFinished(this, thisRequestFinished);
             d->pix.connectDownloadProgress(this, thisRequestProgress);
+            // Decode images that can be seen before those that can't
+            if (!isVisible())
+                d->pix.setLoadPriority(-1);
             update(); //pixmap may have invalidated texture, updatePaintNode needs to be called before the next repaint
         } else {
             requestFinished();
@@ -283,6 +286,14 @@ void QQuickImageBase::componentComplete()
         load();
 }
 
+void QQuickImageBase::itemChange(ItemChange change, const ItemChangeData &value)
+{
+    Q_D(QQuickImageBase);
+    if (change == ItemVisibleHasChanged && d->pix.isLoading())
+        d->pix.setLoadPriority(value.boolValue ? 0 : -1);
+    QQuickItem::itemChange(change, value);
+}
+
 void QQuickImageBase::pixmapChange()
 {
     Q_D(QQuickImageBase);
@@ -2271,6 +2271,8 @@ void QQuickItem::setParentItem(QQuickItem *parentItem)
     QQuickWindow *parentWindow = parentItem ? QQuickItemPrivate::get(parentItem)->window : 0;
     if (oldParentWindow == parentWindow) {
         // Avoid freeing and reallocating resources if the window stays the same.
+        if (parentWindow)
+            QQuickWindowPrivate::get(parentWindow)->hitTestIndex.itemReparented(this, oldParentItem, parentItem);
         d->parentItem = parentItem;
     } else {
         if (oldParentWindow)
@@ -2529,6 +2531,8 @@ void QQuickItemPrivate::refWindow(QQuickWindow *c)
     if (!parentItem)
         QQuickWindowPrivate::get(window)->parentlessItems.insert(q);
 
+    QQuickWindowPrivate::get(window)->hitTestIndex.updateItem(q);
+
     for (int ii = 0; ii < childItems.count(); ++ii) {
         QQuickItem *child = childItems.at(ii);
         QQuickItemPrivate::get(child)->refWindow(c);
@@ -2557,6 +2561,7 @@ void QQuickItemPrivate::derefWindow()
     QQuickWindowPrivate *c = QQuickWindowPrivate::get(window);
     if (polishScheduled)
         c->itemsToPolish.remove(q);
+    c->hitTestIndex.removeItem(q);
     QMutableHashIterator<int, QQuickItem *> itemTouchMapIt(c->itemForTouchPointId);
     while (itemTouchMapIt.hasNext()) {
         if (itemTouchMapIt.next().value() == q)
@@ -5396,6 +5401,9 @@ void QQuickItemPrivate::dirty(DirtyType type)
     if (type & (TransformOrigin | Transform | BasicTransform | Position | Size))
         transformChanged();
 
+    if (window)
+        QQuickWindowPrivate::get(window)->hitTestIndex.itemDirty(q, type);
+
     if (!(dirtyAttributes & type) || (window && !prevDirtyItem)) {
         dirtyAttributes |= type;
         if (window && componentComplete) {
@@ -6421,6 +6429,9 @@ void QQuickItem::setAcceptedMouseButtons(Qt::MouseButtons buttons)
     buttons &= ~Qt::LeftButton;
     if (buttons || d->extra.isAllocated())
         d->extra.value().acceptedMouseButtons = buttons;
+
+    if (d->window)
+        QQuickWindowPrivate::get(d->window)->hitTestIndex.updateItem(this);
 }
 
 /*!
@@ -6486,7 +6497,11 @@ bool QQuickItem::acceptHoverEvents() const
 void QQuickItem::setAcceptHoverEvents(bool enabled)
 {
     Q_D(QQuickItem);
+    if (d->hoverEnabled == enabled)
+        return;
     d->hoverEnabled = enabled;
+    if (d->window)
+        QQuickWindowPrivate::get(d->window)->hitTestIndex.updateItem(this);
 }
 
 void QQuickItemPrivate::incrementCursorCount(int delta)
@@ -6551,6 +6566,7 @@ void QQuickItem::setCursor(const QCursor &cursor)
         d->incrementCursorCount(+1);
         d->hasCursor = true;
         if (d->window) {
+            QQuickWindowPrivate::get(d->window)->hitTestIndex.updateItem(this);
             QPointF pos = d->window->mapFromGlobal(QGuiApplicationPrivate::lastCursorPosition.toPoint());
             if (contains(mapFromScene(pos)))
                 QQuickWindowPrivate::get(d->window)->updateCursor(pos);
@@ -6576,6 +6592,7 @@ void QQuickItem::unsetCursor()
 
     if (d->window) {
         QQuickWindowPrivate *windowPrivate = QQuickWindowPrivate::get(d->window);
+        windowPrivate->hitTestIndex.updateItem(this);
         if (windowPrivate->cursorItem == this) {
             QPointF pos = d->window->mapFromGlobal(QGuiApplicationPrivate::lastCursorPosition.toPoint());
             windowPrivate->updateCursor(pos);
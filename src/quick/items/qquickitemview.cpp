@@ -288,7 +288,9 @@ void QQuickItemView::setModel(const QVariant &model)
         d->model = vim;
     } else {
         if (!d->ownModel) {
-            d->model = new QQmlDelegateModel(qmlContext(this), this);
+            QQmlDelegateModel *dataModel = new QQmlDelegateModel(qmlContext(this), this);
+            dataModel->setReuseItems(d->reuseItems);
+            d->model = dataModel;
             d->ownModel = true;
             if (isComponentComplete())
                 static_cast<QQmlDelegateModel *>(d->model.data())->componentComplete();
@@ -341,7 +343,9 @@ void QQuickItemView::setDelegate(QQmlComponent *delegate)
     if (delegate == this->delegate())
         return;
     if (!d->ownModel) {
-        d->model = new QQmlDelegateModel(qmlContext(this));
+        QQmlDelegateModel *dataModel = new QQmlDelegateModel(qmlContext(this));
+        dataModel->setReuseItems(d->reuseItems);
+        d->model = dataModel;
         d->ownModel = true;
     }
     if (QQmlDelegateModel *dataModel = qobject_cast<QQmlDelegateModel*>(d->model)) {
@@ -441,6 +445,25 @@ void QQuickItemView::setCacheBuffer(int b)
     }
 }
 
+bool QQuickItemView::reuseItems() const
+{
+    Q_D(const QQuickItemView);
+    return d->reuseItems;
+}
+
+void QQuickItemView::setReuseItems(bool reuse)
+{
+    Q_D(QQuickItemView);
+    if (d->reuseItems == reuse)
+        return;
+    d->reuseItems = reuse;
+    if (d->ownModel) {
+        if (QQmlDelegateModel *dataModel = qobject_cast<QQmlDelegateModel*>(d->model))
+            dataModel->setReuseItems(reuse);
+    }
+    emit reuseItemsChanged();
+}
+
 
 Qt::LayoutDirection QQuickItemView::layoutDirection() const
 {
@@ -1435,7 +1458,7 @@ QQuickItemViewPrivate::QQuickItemViewPrivate()
     , headerComponent(0), header(0), footerComponent(0), footer(0)
     , transitioner(0)
     , minExtent(0), maxExtent(0)
-    , ownModel(false), wrap(false)
+    , ownModel(false), reuseItems(false), wrap(false)
     , inLayout(false), inViewportMoved(false), forceLayout(false), currentIndexCleared(false)
     , haveHighlightRange(false), autoHighlight(true), highlightRangeStartValid(false), highlightRangeEndValid(false)
     , fillCacheBuffer(false), inRequest(false)
@@ -2279,6 +2302,9 @@ bool QQuickItemViewPrivate::releaseItem(FxViewItem *item)
         // item was not destroyed, and we no longer reference it.
         QQuickItemPrivate::get(item->item)->setCulled(true);
         unrequestedItems.insert(item->item, model->indexOf(item->item, q));
+    } else if (flags & QQmlInstanceModel::Pooled) {
+        // item was kept by the model for reuse; hide it until it is requested again.
+        QQuickItemPrivate::get(item->item)->setCulled(true);
     } else if (flags & QQmlInstanceModel::Destroyed) {
         item->item->setParentItem(0);
     }
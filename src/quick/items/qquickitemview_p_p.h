@@ -295,6 +295,7 @@ public:
     mutable qreal maxExtent;
 
     bool ownModel : 1;
+    bool reuseItems : 1;
     bool wrap : 1;
     bool inLayout : 1;
     bool inViewportMoved : 1;
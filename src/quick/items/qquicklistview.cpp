@@ -2131,6 +2131,26 @@ void QQuickListView::setOrientation(QQuickListView::Orientation orientation)
     scrolled.
 */
 
+/*!
+    \qmlproperty bool QtQuick2::ListView::reuseItems
+    \since QtQuick 2.2
+
+    This property holds whether delegate instances that scroll out of the view
+    are kept for reuse instead of being destroyed.
+
+    When enabled, an item released by the view is pooled and later rebound to
+    the index and model data of the next item that scrolls into view, avoiding
+    the cost of creating a new instance of the delegate.  A delegate can handle
+    the \l{DelegateModel::onPooled()}{DelegateModel.onPooled} and
+    \l{DelegateModel::onReused()}{DelegateModel.onReused} attached signals to
+    reset any state that is not bound to the model data.
+
+    This property only applies when the view creates its own DelegateModel; set
+    DelegateModel::reuseItems directly when assigning a DelegateModel as the model.
+
+    The default value is false.
+*/
+
 
 /*!
     \qmlproperty string QtQuick2::ListView::section.property
@@ -116,7 +116,7 @@ void QQuickPathViewAttached::setValue(const QByteArray &name, const QVariant &va
 QQuickPathViewPrivate::QQuickPathViewPrivate()
   : path(0), currentIndex(0), currentItemOffset(0.0), startPc(0)
     , offset(0.0), offsetAdj(0.0), mappedRange(1.0), mappedCache(0.0)
-    , stealMouse(false), ownModel(false), interactive(true), haveHighlightRange(true)
+    , stealMouse(false), ownModel(false), reuseItems(false), interactive(true), haveHighlightRange(true)
     , autoHighlight(true), highlightUp(false), layoutScheduled(false)
     , moving(false), flicking(false), dragging(false), inRequest(false), delegateValidated(false)
     , dragMargin(0), deceleration(100), maximumFlickVelocity(QML_FLICK_DEFAULTMAXVELOCITY)
@@ -227,6 +227,11 @@ void QQuickPathViewPrivate::releaseItem(QQuickItem *item)
         // item was not destroyed, and we no longer reference it.
         if (QQuickPathViewAttached *att = attached(item))
             att->setOnPath(false);
+    } else if (flags & QQmlInstanceModel::Pooled) {
+        // item was kept by the model for reuse; hide it until it is requested again.
+        if (QQuickPathViewAttached *att = attached(item))
+            att->setOnPath(false);
+        QQuickItemPrivate::get(item)->setCulled(true);
     } else if (flags & QQmlInstanceModel::Destroyed) {
         // but we still reference it
         item->setParentItem(0);
@@ -656,7 +661,9 @@ void QQuickPathView::setModel(const QVariant &model)
         d->model = vim;
     } else {
         if (!d->ownModel) {
-            d->model = new QQmlDelegateModel(qmlContext(this));
+            QQmlDelegateModel *dataModel = new QQmlDelegateModel(qmlContext(this));
+            dataModel->setReuseItems(d->reuseItems);
+            d->model = dataModel;
             d->ownModel = true;
             if (isComponentComplete())
                 static_cast<QQmlDelegateModel *>(d->model.data())->componentComplete();
@@ -1240,7 +1247,9 @@ void QQuickPathView::setDelegate(QQmlComponent *delegate)
     if (delegate == this->delegate())
         return;
     if (!d->ownModel) {
-        d->model = new QQmlDelegateModel(qmlContext(this));
+        QQmlDelegateModel *dataModel = new QQmlDelegateModel(qmlContext(this));
+        dataModel->setReuseItems(d->reuseItems);
+        d->model = dataModel;
         d->ownModel = true;
     }
     if (QQmlDelegateModel *dataModel = qobject_cast<QQmlDelegateModel*>(d->model)) {
@@ -1331,6 +1340,44 @@ void QQuickPathView::setCacheItemCount(int i)
     emit cacheItemCountChanged();
 }
 
+/*!
+    \qmlproperty bool QtQuick2::PathView::reuseItems
+    \since QtQuick 2.2
+
+    This property holds whether delegate instances that move off the path are
+    kept for reuse instead of being destroyed.
+
+    When enabled, an item that is no longer needed by the view is pooled and later
+    rebound to the model data of the next item that becomes visible, avoiding the
+    cost of creating a new instance of the delegate.  A delegate can handle the
+    \l{DelegateModel::onPooled()}{DelegateModel.onPooled} and
+    \l{DelegateModel::onReused()}{DelegateModel.onReused} attached signals to reset
+    any state that is not bound to the model data.
+
+    This property only applies when the view creates its own DelegateModel; set
+    DelegateModel::reuseItems directly when assigning a DelegateModel as the model.
+
+    The default value is false.
+*/
+bool QQuickPathView::reuseItems() const
+{
+    Q_D(const QQuickPathView);
+    return d->reuseItems;
+}
+
+void QQuickPathView::setReuseItems(bool reuse)
+{
+    Q_D(QQuickPathView);
+    if (d->reuseItems == reuse)
+        return;
+    d->reuseItems = reuse;
+    if (d->ownModel) {
+        if (QQmlDelegateModel *dataModel = qobject_cast<QQmlDelegateModel*>(d->model))
+            dataModel->setReuseItems(reuse);
+    }
+    emit reuseItemsChanged();
+}
+
 /*!
     \qmlproperty enumeration QtQuick2::PathView::snapMode
 
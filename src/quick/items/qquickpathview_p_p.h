@@ -142,6 +142,7 @@ public:
     qreal mappedCache;
     bool stealMouse : 1;
     bool ownModel : 1;
+    bool reuseItems : 1;
     bool interactive : 1;
     bool haveHighlightRange : 1;
     bool autoHighlight : 1;
@@ -62,12 +62,14 @@
 #include <QtGui/qmatrix4x4.h>
 #include <QtGui/qstylehints.h>
 #include <QtCore/qvarlengtharray.h>
+#include <QtCore/qpointer.h>
 #include <QtCore/qabstractanimation.h>
 #include <QtQml/qqmlincubator.h>
 
 #include <QtQuick/private/qquickpixmapcache_p.h>
 
 #include <private/qqmlprofilerservice_p.h>
+#include <private/qqmlengine_p.h>
 #include <private/qqmlmemoryprofiler_p.h>
 
 QT_BEGIN_NAMESPACE
@@ -249,6 +251,9 @@ void QQuickWindowPrivate::polishItems()
 {
     int maxPolishCycles = 100000;
 
+    // Deferred bindings may still have to move or resize items
+    QQmlEnginePrivate::updatePendingBindingsInThread();
+
     while (!itemsToPolish.isEmpty() && --maxPolishCycles > 0) {
         QSet<QQuickItem *> itms = itemsToPolish;
         itemsToPolish.clear();
@@ -258,6 +263,8 @@ void QQuickWindowPrivate::polishItems()
             QQuickItemPrivate::get(item)->polishScheduled = false;
             item->updatePolish();
         }
+
+        QQmlEnginePrivate::updatePendingBindingsInThread();
     }
 
     if (maxPolishCycles == 0)
@@ -535,7 +542,7 @@ bool QQuickWindowPrivate::translateTouchToMouse(QQuickItem *item, QTouchEvent *e
                     lastMousePosition = me->windowPos();
 
                     bool accepted = me->isAccepted();
-                    bool delivered = deliverHoverEvent(contentItem, me->windowPos(), last, me->modifiers(), accepted);
+                    bool delivered = deliverHoverEvent(me->windowPos(), last, me->modifiers(), accepted);
                     if (!delivered) {
                         //take care of any exits
                         accepted = clearHover();
@@ -1248,40 +1255,55 @@ QMouseEvent *QQuickWindowPrivate::cloneMouseEvent(QMouseEvent *event, QPointF *t
     return me;
 }
 
-bool QQuickWindowPrivate::deliverInitialMousePressEvent(QQuickItem *item, QMouseEvent *event)
+/*
+    The hit test index only narrows the items down by their bounding rects;
+    whether scenePos really hits the item is still decided by its contains()
+    and that of any ancestor clipping its children.
+*/
+bool QQuickWindowPrivate::isItemAt(QQuickItem *item, const QPointF &scenePos) const
+{
+    for (QQuickItem *parent = item->parentItem(); parent; parent = parent->parentItem()) {
+        if (QQuickItemPrivate::get(parent)->flags & QQuickItem::ItemClipsChildrenToShape) {
+            if (!parent->contains(parent->mapFromScene(scenePos)))
+                return false;
+        }
+    }
+    return item->contains(item->mapFromScene(scenePos));
+}
+
+bool QQuickWindowPrivate::deliverInitialMousePressEvent(QMouseEvent *event)
 {
     Q_Q(QQuickWindow);
 
-    QQuickItemPrivate *itemPrivate = QQuickItemPrivate::get(item);
+    const QVector<QQuickItem *> candidates
+            = hitTestIndex.itemsAt(contentItem, event->windowPos(), QQuickHitTestIndex::Mouse);
 
-    if (itemPrivate->flags & QQuickItem::ItemClipsChildrenToShape) {
-        QPointF p = item->mapFromScene(event->windowPos());
-        if (!item->contains(p))
-            return false;
-    }
+    // Delivery may delete or reparent the remaining candidates
+    QList<QPointer<QQuickItem> > items;
+    for (int ii = 0; ii < candidates.count(); ++ii)
+        items.append(candidates.at(ii));
 
-    QList<QQuickItem *> children = itemPrivate->paintOrderChildItems();
-    for (int ii = children.count() - 1; ii >= 0; --ii) {
-        QQuickItem *child = children.at(ii);
-        if (!child->isVisible() || !child->isEnabled() || QQuickItemPrivate::get(child)->culled)
+    for (int ii = 0; ii < items.count(); ++ii) {
+        QQuickItem *item = items.at(ii);
+        if (!item || item->window() != q)
+            continue;
+
+        QQuickItemPrivate *itemPrivate = QQuickItemPrivate::get(item);
+        if (!(itemPrivate->acceptedMouseButtons() & event->button()))
+            continue;
+        if (!isItemAt(item, event->windowPos()))
             continue;
-        if (deliverInitialMousePressEvent(child, event))
-            return true;
-    }
 
-    if (itemPrivate->acceptedMouseButtons() & event->button()) {
         QPointF localPos = item->mapFromScene(event->windowPos());
-        if (item->contains(localPos)) {
-            QScopedPointer<QMouseEvent> me(cloneMouseEvent(event, &localPos));
-            me->accept();
-            item->grabMouse();
-            q->sendEvent(item, me.data());
-            event->setAccepted(me->isAccepted());
-            if (me->isAccepted())
-                return true;
-            if (mouseGrabberItem)
-                mouseGrabberItem->ungrabMouse();
-        }
+        QScopedPointer<QMouseEvent> me(cloneMouseEvent(event, &localPos));
+        me->accept();
+        item->grabMouse();
+        q->sendEvent(item, me.data());
+        event->setAccepted(me->isAccepted());
+        if (me->isAccepted())
+            return true;
+        if (mouseGrabberItem)
+            mouseGrabberItem->ungrabMouse();
     }
 
     return false;
@@ -1296,7 +1318,7 @@ bool QQuickWindowPrivate::deliverMouseEvent(QMouseEvent *event)
     if (!mouseGrabberItem &&
          event->type() == QEvent::MouseButtonPress &&
          (event->buttons() & event->button()) == event->buttons()) {
-        if (deliverInitialMousePressEvent(contentItem, event))
+        if (deliverInitialMousePressEvent(event))
             event->accept();
         else
             event->ignore();
@@ -1354,7 +1376,7 @@ void QQuickWindow::mouseDoubleClickEvent(QMouseEvent *event)
 #endif
 
     if (!d->mouseGrabberItem && (event->buttons() & event->button()) == event->buttons()) {
-        if (d->deliverInitialMousePressEvent(d->contentItem, event))
+        if (d->deliverInitialMousePressEvent(event))
             event->accept();
         else
             event->ignore();
@@ -1399,7 +1421,7 @@ void QQuickWindow::mouseMoveEvent(QMouseEvent *event)
         d->lastMousePosition = event->windowPos();
 
         bool accepted = event->isAccepted();
-        bool delivered = d->deliverHoverEvent(d->contentItem, event->windowPos(), last, event->modifiers(), accepted);
+        bool delivered = d->deliverHoverEvent(event->windowPos(), last, event->modifiers(), accepted);
         if (!delivered) {
             //take care of any exits
             accepted = d->clearHover();
@@ -1411,70 +1433,63 @@ void QQuickWindow::mouseMoveEvent(QMouseEvent *event)
     d->deliverMouseEvent(event);
 }
 
-bool QQuickWindowPrivate::deliverHoverEvent(QQuickItem *item, const QPointF &scenePos, const QPointF &lastScenePos,
+bool QQuickWindowPrivate::deliverHoverEvent(const QPointF &scenePos, const QPointF &lastScenePos,
                                          Qt::KeyboardModifiers modifiers, bool &accepted)
 {
-    QQuickItemPrivate *itemPrivate = QQuickItemPrivate::get(item);
+    const QVector<QQuickItem *> candidates
+            = hitTestIndex.itemsAt(contentItem, scenePos, QQuickHitTestIndex::Hover);
 
-    if (itemPrivate->flags & QQuickItem::ItemClipsChildrenToShape) {
-        QPointF p = item->mapFromScene(scenePos);
-        if (!item->contains(p))
-            return false;
+    for (int ii = 0; ii < candidates.count(); ++ii) {
+        QQuickItem *item = candidates.at(ii);
+        if (isItemAt(item, scenePos)) {
+            hoverItem(item, scenePos, lastScenePos, modifiers, accepted);
+            return true;
+        }
     }
 
-    QList<QQuickItem *> children = itemPrivate->paintOrderChildItems();
-    for (int ii = children.count() - 1; ii >= 0; --ii) {
-        QQuickItem *child = children.at(ii);
-        if (!child->isVisible() || !child->isEnabled() || QQuickItemPrivate::get(child)->culled)
-            continue;
-        if (deliverHoverEvent(child, scenePos, lastScenePos, modifiers, accepted))
-            return true;
+    return false;
+}
+
+void QQuickWindowPrivate::hoverItem(QQuickItem *item, const QPointF &scenePos, const QPointF &lastScenePos,
+                                    Qt::KeyboardModifiers modifiers, bool &accepted)
+{
+    if (!hoverItems.isEmpty() && hoverItems[0] == item) {
+        //move
+        accepted = sendHoverEvent(QEvent::HoverMove, item, scenePos, lastScenePos, modifiers, accepted);
+        return;
     }
 
-    if (itemPrivate->hoverEnabled) {
-        QPointF p = item->mapFromScene(scenePos);
-        if (item->contains(p)) {
-            if (!hoverItems.isEmpty() && hoverItems[0] == item) {
-                //move
-                accepted = sendHoverEvent(QEvent::HoverMove, item, scenePos, lastScenePos, modifiers, accepted);
-            } else {
-                QList<QQuickItem *> itemsToHover;
-                QQuickItem* parent = item;
-                itemsToHover << item;
-                while ((parent = parent->parentItem()))
-                    itemsToHover << parent;
-
-                // Leaving from previous hovered items until we reach the item or one of its ancestors.
-                while (!hoverItems.isEmpty() && !itemsToHover.contains(hoverItems[0])) {
-                    sendHoverEvent(QEvent::HoverLeave, hoverItems[0], scenePos, lastScenePos, modifiers, accepted);
-                    hoverItems.removeFirst();
-                }
+    QList<QQuickItem *> itemsToHover;
+    QQuickItem* parent = item;
+    itemsToHover << item;
+    while ((parent = parent->parentItem()))
+        itemsToHover << parent;
 
-                if (!hoverItems.isEmpty() && hoverItems[0] == item){//Not entering a new Item
-                    // ### Shouldn't we send moves for the parent items as well?
-                    accepted = sendHoverEvent(QEvent::HoverMove, item, scenePos, lastScenePos, modifiers, accepted);
-                } else {
-                    // Enter items that are not entered yet.
-                    int startIdx = -1;
-                    if (!hoverItems.isEmpty())
-                        startIdx = itemsToHover.indexOf(hoverItems[0]) - 1;
-                    if (startIdx == -1)
-                        startIdx = itemsToHover.count() - 1;
-
-                    for (int i = startIdx; i >= 0; i--) {
-                        QQuickItem *itemToHover = itemsToHover[i];
-                        if (QQuickItemPrivate::get(itemToHover)->hoverEnabled) {
-                            hoverItems.prepend(itemToHover);
-                            sendHoverEvent(QEvent::HoverEnter, itemToHover, scenePos, lastScenePos, modifiers, accepted);
-                        }
-                    }
-                }
+    // Leaving from previous hovered items until we reach the item or one of its ancestors.
+    while (!hoverItems.isEmpty() && !itemsToHover.contains(hoverItems[0])) {
+        sendHoverEvent(QEvent::HoverLeave, hoverItems[0], scenePos, lastScenePos, modifiers, accepted);
+        hoverItems.removeFirst();
+    }
+
+    if (!hoverItems.isEmpty() && hoverItems[0] == item){//Not entering a new Item
+        // ### Shouldn't we send moves for the parent items as well?
+        accepted = sendHoverEvent(QEvent::HoverMove, item, scenePos, lastScenePos, modifiers, accepted);
+    } else {
+        // Enter items that are not entered yet.
+        int startIdx = -1;
+        if (!hoverItems.isEmpty())
+            startIdx = itemsToHover.indexOf(hoverItems[0]) - 1;
+        if (startIdx == -1)
+            startIdx = itemsToHover.count() - 1;
+
+        for (int i = startIdx; i >= 0; i--) {
+            QQuickItem *itemToHover = itemsToHover[i];
+            if (QQuickItemPrivate::get(itemToHover)->hoverEnabled) {
+                hoverItems.prepend(itemToHover);
+                sendHoverEvent(QEvent::HoverEnter, itemToHover, scenePos, lastScenePos, modifiers, accepted);
             }
-            return true;
         }
     }
-
-    return false;
 }
 
 #ifndef QT_NO_WHEELEVENT
@@ -1929,7 +1944,7 @@ void QQuickWindowPrivate::updateCursor(const QPointF &scenePos)
     Q_Q(QQuickWindow);
 
     QQuickItem *oldCursorItem = cursorItem;
-    cursorItem = findCursorItem(contentItem, scenePos);
+    cursorItem = findCursorItem(scenePos);
 
     if (cursorItem != oldCursorItem) {
         if (cursorItem)
@@ -1939,32 +1954,19 @@ void QQuickWindowPrivate::updateCursor(const QPointF &scenePos)
     }
 }
 
-QQuickItem *QQuickWindowPrivate::findCursorItem(QQuickItem *item, const QPointF &scenePos)
+QQuickItem *QQuickWindowPrivate::findCursorItem(const QPointF &scenePos)
 {
-    QQuickItemPrivate *itemPrivate = QQuickItemPrivate::get(item);
-    if (itemPrivate->flags & QQuickItem::ItemClipsChildrenToShape) {
-        QPointF p = item->mapFromScene(scenePos);
-        if (!item->contains(p))
-            return 0;
-    }
-
-    const int numCursorsInHierarchy = itemPrivate->extra.isAllocated() ? itemPrivate->extra.value().numItemsWithCursor : 0;
-    const int numChildrenWithCursor = itemPrivate->hasCursor ? numCursorsInHierarchy-1 : numCursorsInHierarchy;
+    const int numCursorsInHierarchy = QQuickItemPrivate::get(contentItem)->extra.isAllocated()
+            ? QQuickItemPrivate::get(contentItem)->extra.value().numItemsWithCursor : 0;
+    if (numCursorsInHierarchy <= 0)
+        return 0;
 
-    if (numChildrenWithCursor > 0) {
-        QList<QQuickItem *> children = itemPrivate->paintOrderChildItems();
-        for (int ii = children.count() - 1; ii >= 0; --ii) {
-            QQuickItem *child = children.at(ii);
-            if (!child->isVisible() || !child->isEnabled() || QQuickItemPrivate::get(child)->culled)
-                continue;
-            if (QQuickItem *cursorItem = findCursorItem(child, scenePos))
-                return cursorItem;
-        }
-    }
+    const QVector<QQuickItem *> candidates
+            = hitTestIndex.itemsAt(contentItem, scenePos, QQuickHitTestIndex::Cursor);
 
-    if (itemPrivate->hasCursor) {
-        QPointF p = item->mapFromScene(scenePos);
-        if (item->contains(p))
+    for (int ii = 0; ii < candidates.count(); ++ii) {
+        QQuickItem *item = candidates.at(ii);
+        if (isItemAt(item, scenePos))
             return item;
     }
     return 0;
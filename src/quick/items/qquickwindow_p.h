@@ -59,6 +59,7 @@
 
 #include <QtQuick/private/qsgcontext_p.h>
 #include <private/qquickdrag_p.h>
+#include <private/qquickhittestindex_p.h>
 
 #include <QtCore/qthread.h>
 #include <QtCore/qmutex.h>
@@ -119,6 +120,8 @@ public:
 #ifndef QT_NO_DRAGANDDROP
     QQuickDragGrabber dragGrabber;
 #endif
+    // Mouse, hover and cursor candidates by scene position
+    QQuickHitTestIndex hitTestIndex;
     int touchMouseId;
     bool checkIfDoubleClicked(ulong newPressEventTimestamp);
     ulong touchMousePressTimestamp;
@@ -129,7 +132,8 @@ public:
     void translateTouchEvent(QTouchEvent *touchEvent);
     static void transformTouchPoints(QList<QTouchEvent::TouchPoint> &touchPoints, const QTransform &transform);
     static QMouseEvent *cloneMouseEvent(QMouseEvent *event, QPointF *transformedLocalPos = 0);
-    bool deliverInitialMousePressEvent(QQuickItem *, QMouseEvent *);
+    bool isItemAt(QQuickItem *, const QPointF &scenePos) const;
+    bool deliverInitialMousePressEvent(QMouseEvent *);
     bool deliverMouseEvent(QMouseEvent *);
     bool sendFilteredMouseEvent(QQuickItem *, QQuickItem *, QEvent *);
 #ifndef QT_NO_WHEELEVENT
@@ -139,7 +143,8 @@ public:
             QHash<QQuickItem *, QList<QTouchEvent::TouchPoint> > *);
     bool deliverTouchEvent(QTouchEvent *);
     bool deliverTouchCancelEvent(QTouchEvent *);
-    bool deliverHoverEvent(QQuickItem *, const QPointF &scenePos, const QPointF &lastScenePos, Qt::KeyboardModifiers modifiers, bool &accepted);
+    bool deliverHoverEvent(const QPointF &scenePos, const QPointF &lastScenePos, Qt::KeyboardModifiers modifiers, bool &accepted);
+    void hoverItem(QQuickItem *, const QPointF &scenePos, const QPointF &lastScenePos, Qt::KeyboardModifiers modifiers, bool &accepted);
     bool deliverMatchingPointsToItem(QQuickItem *item, QTouchEvent *event, QSet<int> *acceptedNewPoints, const QSet<int> &matchingNewPoints, const QList<QTouchEvent::TouchPoint> &matchingPoints);
     QTouchEvent *touchEventForItemBounds(QQuickItem *target, const QTouchEvent &originalEvent);
     QTouchEvent *touchEventWithPoints(const QTouchEvent &event, const QList<QTouchEvent::TouchPoint> &newPoints);
@@ -153,7 +158,7 @@ public:
 #endif
 #ifndef QT_NO_CURSOR
     void updateCursor(const QPointF &scenePos);
-    QQuickItem *findCursorItem(QQuickItem *item, const QPointF &scenePos);
+    QQuickItem *findCursorItem(const QPointF &scenePos);
 #endif
 
     QList<QQuickItem*> hoverItems;
@@ -0,0 +1,968 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the QtQuick module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#define GL_GLEXT_PROTOTYPES
+
+#include "qsgbatchrenderer_p.h"
+#include "qsgmaterial.h"
+
+#include <QtCore/qvarlengtharray.h>
+#include <QtGui/qguiapplication.h>
+#include <QtGui/qopenglcontext.h>
+
+QT_BEGIN_NAMESPACE
+
+#ifndef QSG_NO_RENDER_TIMING
+static bool qsg_render_timing = !qgetenv("QSG_RENDER_TIMING").isEmpty();
+#endif
+
+// Number of nodes after the first node of a batch which are considered for
+// merging into it. Keeps batching linear in the size of the scene.
+static const int qsg_batch_lookahead = 64;
+
+// Merged batches are drawn with 16-bit indices.
+static const int qsg_batch_max_vertices = 65535;
+
+// Nodes with larger geometry gain nothing from being merged and would only
+// make every upload of the batch more expensive.
+static const int qsg_merge_max_vertices = 1024;
+
+static inline int qsg_sizeOfType(GLenum type)
+{
+    static int sizes[] = {
+        sizeof(char),
+        sizeof(unsigned char),
+        sizeof(short),
+        sizeof(unsigned short),
+        sizeof(int),
+        sizeof(unsigned int),
+        sizeof(float),
+        2,
+        3,
+        4,
+        sizeof(double)
+    };
+    Q_ASSERT(type >= GL_BYTE && type <= 0x140A); // the value of GL_DOUBLE
+    return sizes[type - GL_BYTE];
+}
+
+static inline bool qsg_isPerspective(const QMatrix4x4 *m)
+{
+    return m && (!qFuzzyIsNull((*m)(3, 0)) || !qFuzzyIsNull((*m)(3, 1))
+                 || !qFuzzyIsNull((*m)(3, 3) - 1));
+}
+
+static inline bool qsg_hasPositionAttribute(const QSGGeometry *g)
+{
+    if (g->attributeCount() < 1)
+        return false;
+    const QSGGeometry::Attribute &a = g->attributes()[0];
+    return a.isVertexCoordinate && a.position == 0 && a.tupleSize == 2 && a.type == GL_FLOAT;
+}
+
+// Number of indices the geometry takes up when drawn as GL_TRIANGLES.
+static inline int qsg_mergedIndexCount(const QSGGeometry *g)
+{
+    int count = g->indexCount() ? g->indexCount() : g->vertexCount();
+    if (g->drawingMode() == GL_TRIANGLE_STRIP)
+        return count < 3 ? 0 : (count - 2) * 3;
+    return count;
+}
+
+static bool qsg_isMergeable(QSGGeometryNode *node)
+{
+    const QSGGeometry *g = node->geometry();
+    if (g->drawingMode() != GL_TRIANGLES && g->drawingMode() != GL_TRIANGLE_STRIP)
+        return false;
+    if (g->vertexCount() > qsg_merge_max_vertices || !qsg_hasPositionAttribute(g))
+        return false;
+    if (g->indexCount() && g->indexType() != GL_UNSIGNED_SHORT)
+        return false;
+
+    // Merged vertices are transformed on the CPU and drawn with a shared matrix,
+    // so the material must not rely on the node's own matrix.
+    if (node->activeMaterial()->flags() & QSGMaterial::RequiresDeterminant)
+        return false;
+
+    return !qsg_isPerspective(node->matrix());
+}
+
+static QRectF qsg_geometryBounds(const QSGGeometry *g)
+{
+    const int count = g->vertexCount();
+    if (!count)
+        return QRectF();
+
+    const int stride = g->sizeOfVertex();
+    const char *data = static_cast<const char *>(g->vertexData());
+    const float *p = reinterpret_cast<const float *>(data);
+    float minX = p[0];
+    float maxX = p[0];
+    float minY = p[1];
+    float maxY = p[1];
+    for (int i = 1; i < count; ++i) {
+        p = reinterpret_cast<const float *>(data + i * stride);
+        minX = qMin(minX, p[0]);
+        maxX = qMax(maxX, p[0]);
+        minY = qMin(minY, p[1]);
+        maxY = qMax(maxY, p[1]);
+    }
+    return QRectF(minX, minY, maxX - minX, maxY - minY);
+}
+
+// Returns the closest transform node above \a node, stopping at \a top.
+static inline QSGNode *qsg_transformParent(QSGNode *node, QSGNode *top)
+{
+    for (QSGNode *n = node->parent(); n && n != top; n = n->parent()) {
+        if (n->type() == QSGNode::TransformNodeType)
+            return n;
+    }
+    return 0;
+}
+
+// Returns the transform of \a node relative to \a root, or to \a top if \a root is 0.
+static QMatrix4x4 qsg_matrixRelativeTo(QSGNode *node, QSGNode *root, QSGNode *top)
+{
+    QMatrix4x4 m;
+    QSGNode *stop = root ? root : top;
+    for (QSGNode *n = node->parent(); n && n != stop; n = n->parent()) {
+        if (n->type() == QSGNode::TransformNodeType)
+            m = static_cast<QSGTransformNode *>(n)->matrix() * m;
+    }
+    return m;
+}
+
+static void qsg_collectRenderableNodes(QSGNode *node, QSet<QSGNode *> *nodes)
+{
+    // Called for nodes which are being removed, possibly from within their
+    // destructor, so nothing but the node type can be looked at.
+    if (node->type() == QSGNode::GeometryNodeType)
+        nodes->insert(node);
+    for (QSGNode *c = node->firstChild(); c; c = c->nextSibling())
+        qsg_collectRenderableNodes(c, nodes);
+}
+
+/*!
+    \class QSGBatchRenderer
+    \brief The QSGBatchRenderer class renders the scene graph by merging
+    compatible geometry nodes into shared vertex buffers.
+
+    Geometry nodes that share clip, opacity, vertex layout and material state
+    (same QSGMaterial::type() and QSGMaterial::compare() returning 0) are merged
+    into one batch. The vertices of a batch are transformed on the CPU relative
+    to the closest transform node shared by all of its nodes, the batch root,
+    and the batch is drawn with a single glDrawElements() call using the batch
+    root's matrix. Moving the batch root, such as when a list is flicked, does
+    not require the batch to be uploaded again.
+
+    Nodes are drawn in scene order without depth testing. A node is only moved
+    into an earlier batch if it does not overlap any of the nodes it is moved
+    past, so the result is identical to drawing every node on its own.
+
+    Batches are kept across frames. Geometry and transform changes only cause
+    the affected batches to be uploaded again, and structural changes reuse
+    the vertex buffers of batches that come out of the rebuild unchanged.
+
+    The renderer is selected by setting the environment variable
+    QSG_RENDERER to "batch". The number of batches, draw calls and uploads
+    of the last frame are available through statistics() and are printed
+    when QSG_RENDER_TIMING is set.
+
+    \internal
+ */
+
+QSGBatchRenderer::QSGBatchRenderer(QSGContext *context)
+    : QSGRenderer(context)
+    , m_elements(64)
+    , m_dirtyElements(64)
+    , m_freeBuffers(16)
+    , m_currentClip(0)
+    , m_currentClipType(NoClip)
+    , m_currentMaterial(0)
+    , m_currentProgram(0)
+    , m_currentMatrix(0)
+    , m_currentBlending(false)
+    , m_rebuild_lists(true)
+    , m_rebatch(true)
+{
+    memset(&m_stats, 0, sizeof(m_stats));
+}
+
+QSGBatchRenderer::~QSGBatchRenderer()
+{
+    releaseBatches();
+    if (QOpenGLContext::currentContext() && !m_freeBuffers.isEmpty())
+        glDeleteBuffers(m_freeBuffers.size(), m_freeBuffers.data());
+}
+
+void QSGBatchRenderer::nodeChanged(QSGNode *node, QSGNode::DirtyState state)
+{
+    QSGRenderer::nodeChanged(node, state);
+
+    const quint32 rebuildBits = QSGNode::DirtyNodeAdded | QSGNode::DirtyNodeRemoved
+                                | QSGNode::DirtyMaterial | QSGNode::DirtyOpacity
+                                | QSGNode::DirtyForceUpdate;
+
+    if (state & rebuildBits)
+        m_rebuild_lists = true;
+
+    if (m_rebuild_lists) {
+        if (state & (QSGNode::DirtyNodeAdded | QSGNode::DirtyNodeRemoved))
+            qsg_collectRenderableNodes(node, &m_touchedNodes);
+        if (state & QSGNode::DirtyGeometry)
+            m_touchedNodes.insert(node);
+        if (state & QSGNode::DirtyMatrix)
+            m_dirtyTransforms.insert(node);
+        return;
+    }
+
+    if (state & QSGNode::DirtyGeometry) {
+        QHash<QSGNode *, int>::const_iterator it = m_elementIndex.constFind(node);
+        if (it != m_elementIndex.constEnd())
+            markElementDirty(it.value(), true);
+    }
+
+    if (state & QSGNode::DirtyMatrix) {
+        QSet<QSGNode *> visitedRoots;
+        invalidateSubtree(node, &visitedRoots);
+    }
+}
+
+void QSGBatchRenderer::markElementDirty(int index, bool geometryChanged)
+{
+    Element &e = m_elements.at(index);
+    if (!e.boundsDirty)
+        m_dirtyElements.add(index);
+    e.boundsDirty = true;
+    if (geometryChanged) {
+        e.geometryDirty = true;
+        if (e.batch >= 0)
+            m_batches.at(e.batch)->dirty = true;
+    }
+}
+
+void QSGBatchRenderer::invalidateSubtree(QSGNode *node, QSet<QSGNode *> *visitedRoots)
+{
+    if (node->isSubtreeBlocked())
+        return;
+
+    if (m_batchRoots.contains(node))
+        visitedRoots->insert(node);
+
+    if (node->type() == QSGNode::GeometryNodeType) {
+        QHash<QSGNode *, int>::const_iterator it = m_elementIndex.constFind(node);
+        if (it != m_elementIndex.constEnd()) {
+            markElementDirty(it.value(), false);
+            // Merged vertices are relative to the batch root, so they only
+            // change when the changed transform lies below the root.
+            const Element &e = m_elements.at(it.value());
+            if (e.batch >= 0) {
+                Batch *batch = m_batches.at(e.batch);
+                if (batch->merged && !visitedRoots->contains(batch->root))
+                    batch->dirty = true;
+            }
+        }
+    }
+
+    for (QSGNode *c = node->firstChild(); c; c = c->nextSibling())
+        invalidateSubtree(c, visitedRoots);
+}
+
+void QSGBatchRenderer::buildRenderList(QSGNode *node)
+{
+    if (node->isSubtreeBlocked())
+        return;
+
+    if (node->type() == QSGNode::GeometryNodeType || node->type() == QSGNode::RenderNodeType) {
+        Element e;
+        e.node = node;
+        e.batch = -1;
+        e.boundsDirty = true;
+        e.geometryDirty = true;
+        e.unbounded = true;
+        e.mergeable = false;
+        updateElementBounds(e);
+        m_elementIndex.insert(node, m_elements.size());
+        m_elements.add(e);
+    }
+
+    for (QSGNode *c = node->firstChild(); c; c = c->nextSibling())
+        buildRenderList(c);
+}
+
+void QSGBatchRenderer::updateElementBounds(Element &e)
+{
+    e.boundsDirty = false;
+
+    // Render nodes draw whatever they like, nothing can be moved past them.
+    if (e.node->type() != QSGNode::GeometryNodeType) {
+        e.unbounded = true;
+        e.mergeable = false;
+        return;
+    }
+
+    QSGGeometryNode *node = static_cast<QSGGeometryNode *>(e.node);
+    const QSGGeometry *g = node->geometry();
+    const QMatrix4x4 *m = node->matrix();
+
+    e.mergeable = qsg_isMergeable(node);
+    e.unbounded = !qsg_hasPositionAttribute(g) || qsg_isPerspective(m);
+    if (e.unbounded) {
+        e.geometryDirty = false;
+        e.bounds = QRectF();
+        return;
+    }
+
+    if (e.geometryDirty) {
+        e.localBounds = qsg_geometryBounds(g);
+        e.geometryDirty = false;
+    }
+    e.bounds = m ? m->mapRect(e.localBounds) : e.localBounds;
+}
+
+/*!
+    Returns true if the element at \a index, after its bounds have changed,
+    still does not overlap any element whose draw order it was swapped with
+    when the batches were formed.
+
+    Elements of a batch are never further than qsg_batch_lookahead from the
+    batch's first element, so only that window needs to be checked.
+ */
+bool QSGBatchRenderer::isBatchOrderValid(int index) const
+{
+    const Element &e = m_elements.at(index);
+    const int from = qMax(0, index - qsg_batch_lookahead);
+    const int to = qMin(m_elements.size(), index + qsg_batch_lookahead + 1);
+    for (int i = from; i < to; ++i) {
+        if (i == index)
+            continue;
+        const Element &o = m_elements.at(i);
+        const bool before = i < index;
+        const bool drawnBefore = o.batch < e.batch || (o.batch == e.batch && before);
+        if (before == drawnBefore)
+            continue;
+        if (e.unbounded || o.unbounded || e.bounds.intersects(o.bounds))
+            return false;
+    }
+    return true;
+}
+
+bool QSGBatchRenderer::isCompatible(const Element &a, const Element &b) const
+{
+    QSGGeometryNode *na = static_cast<QSGGeometryNode *>(a.node);
+    QSGGeometryNode *nb = static_cast<QSGGeometryNode *>(b.node);
+
+    if (na->clipList() != nb->clipList() || na->inheritedOpacity() != nb->inheritedOpacity())
+        return false;
+
+    const QSGGeometry *ga = na->geometry();
+    const QSGGeometry *gb = nb->geometry();
+    if (ga->sizeOfVertex() != gb->sizeOfVertex() || ga->attributeCount() != gb->attributeCount())
+        return false;
+    if (ga->attributes() != gb->attributes()) {
+        for (int i = 0; i < ga->attributeCount(); ++i) {
+            const QSGGeometry::Attribute &x = ga->attributes()[i];
+            const QSGGeometry::Attribute &y = gb->attributes()[i];
+            if (x.position != y.position || x.tupleSize != y.tupleSize || x.type != y.type)
+                return false;
+        }
+    }
+
+    QSGMaterial *ma = na->activeMaterial();
+    QSGMaterial *mb = nb->activeMaterial();
+    return ma->type() == mb->type() && (ma == mb || ma->compare(mb) == 0);
+}
+
+/*!
+    Returns the deepest transform node which is an ancestor of all the nodes
+    in \a batch, or 0 if they only share the renderer's root node.
+ */
+QSGNode *QSGBatchRenderer::findBatchRoot(const Batch *batch) const
+{
+    QSGNode *top = rootNode();
+
+    // Transform nodes above the first node, closest first
+    QVarLengthArray<QSGNode *, 32> chain;
+    for (QSGNode *n = qsg_transformParent(m_elements.at(batch->elements.first()).node, top);
+         n; n = qsg_transformParent(n, top)) {
+        chain.append(n);
+    }
+
+    int depth = 0;
+    for (int i = 1; i < batch->elements.size() && depth < chain.size(); ++i) {
+        int found = chain.size();
+        QSGNode *n = qsg_transformParent(m_elements.at(batch->elements.at(i)).node, top);
+        for (; n && found == chain.size(); n = qsg_transformParent(n, top)) {
+            for (int k = depth; k < chain.size(); ++k) {
+                if (chain.at(k) == n) {
+                    found = k;
+                    break;
+                }
+            }
+        }
+        depth = found;
+    }
+
+    return depth < chain.size() ? chain.at(depth) : 0;
+}
+
+/*!
+    Returns true if the vertex buffer of \a batch, which is left over from
+    before the render list was rebuilt, still matches its nodes.
+ */
+bool QSGBatchRenderer::isBatchDataValid(const Batch *batch) const
+{
+    QSGNode *stop = batch->root ? batch->root : rootNode();
+    for (int i = 0; i < batch->nodes.size(); ++i) {
+        QSGNode *node = batch->nodes.at(i);
+        if (m_touchedNodes.contains(node))
+            return false;
+        for (QSGNode *n = node; n && n != stop; n = n->parent()) {
+            if (m_dirtyTransforms.contains(n))
+                return false;
+        }
+    }
+    return true;
+}
+
+void QSGBatchRenderer::releaseBatches()
+{
+    for (int i = 0; i < m_batches.size(); ++i) {
+        Batch *batch = m_batches.at(i);
+        if (batch->vbo)
+            m_freeBuffers.add(batch->vbo);
+        if (batch->ibo)
+            m_freeBuffers.add(batch->ibo);
+        delete batch;
+    }
+    m_batches.clear();
+    m_batchRoots.clear();
+}
+
+GLuint QSGBatchRenderer::takeBuffer()
+{
+    GLuint id = 0;
+    if (!m_freeBuffers.isEmpty()) {
+        id = m_freeBuffers.last();
+        m_freeBuffers.pop_back();
+    } else {
+        glGenBuffers(1, &id);
+    }
+    return id;
+}
+
+void QSGBatchRenderer::prepareBatches()
+{
+    // Merged batches from the previous frame, by their first node, so that
+    // their vertex buffers can be taken over by identical new batches.
+    QHash<QSGNode *, Batch *> oldBatches;
+    for (int i = 0; i < m_batches.size(); ++i) {
+        Batch *batch = m_batches.at(i);
+        if (batch->merged && batch->vbo && !batch->dirty)
+            oldBatches.insert(batch->nodes.first(), batch);
+    }
+    QVector<Batch *> previous = m_batches;
+    m_batches.clear();
+    m_batchRoots.clear();
+
+    const int count = m_elements.size();
+    for (int i = 0; i < count; ++i)
+        m_elements.at(i).batch = -1;
+
+    QVarLengthArray<QRectF, qsg_batch_lookahead> skipped;
+    for (int i = 0; i < count; ++i) {
+        Element &e = m_elements.at(i);
+        if (e.batch >= 0)
+            continue;
+
+        Batch *batch = new Batch;
+        batch->elements << i;
+        e.batch = m_batches.size();
+        m_batches << batch;
+
+        if (!e.mergeable)
+            continue;
+
+        skipped.clear();
+        int vertexCount = static_cast<QSGGeometryNode *>(e.node)->geometry()->vertexCount();
+        const int end = qMin(count, i + qsg_batch_lookahead);
+        for (int j = i + 1; j < end; ++j) {
+            Element &c = m_elements.at(j);
+            if (c.batch >= 0)
+                continue;
+            if (c.unbounded)
+                break;
+
+            bool overlaps = false;
+            for (int k = 0; k < skipped.size() && !overlaps; ++k)
+                overlaps = skipped.at(k).intersects(c.bounds);
+
+            int vertices = c.mergeable ? static_cast<QSGGeometryNode *>(c.node)->geometry()->vertexCount() : 0;
+            if (!overlaps && c.mergeable && vertexCount + vertices <= qsg_batch_max_vertices
+                && isCompatible(e, c)) {
+                vertexCount += vertices;
+                c.batch = e.batch;
+                batch->elements << j;
+            } else {
+                skipped.append(c.bounds);
+            }
+        }
+
+        batch->merged = batch->elements.size() > 1;
+        if (!batch->merged)
+            continue;
+
+        batch->root = findBatchRoot(batch);
+        m_batchRoots.insert(batch->root);
+
+        Batch *old = oldBatches.value(e.node);
+        if (!old || old->root != batch->root || old->nodes.size() != batch->elements.size())
+            continue;
+        bool sameNodes = true;
+        for (int k = 0; k < batch->elements.size() && sameNodes; ++k)
+            sameNodes = old->nodes.at(k) == m_elements.at(batch->elements.at(k)).node;
+        if (!sameNodes || !isBatchDataValid(old))
+            continue;
+
+        batch->nodes = old->nodes;
+        batch->vbo = old->vbo;
+        batch->ibo = old->ibo;
+        batch->vertexCount = old->vertexCount;
+        batch->indexCount = old->indexCount;
+        batch->dirty = false;
+        old->vbo = 0;
+        old->ibo = 0;
+    }
+
+    for (int i = 0; i < previous.size(); ++i) {
+        Batch *batch = previous.at(i);
+        if (batch->vbo)
+            m_freeBuffers.add(batch->vbo);
+        if (batch->ibo)
+            m_freeBuffers.add(batch->ibo);
+        delete batch;
+    }
+
+    m_touchedNodes.clear();
+    m_dirtyTransforms.clear();
+}
+
+void QSGBatchRenderer::uploadBatch(Batch *batch)
+{
+    batch->dirty = false;
+
+    int vertexCount = 0;
+    int indexCount = 0;
+    bool mergeable = true;
+    for (int i = 0; i < batch->elements.size(); ++i) {
+        const Element &e = m_elements.at(batch->elements.at(i));
+        const QSGGeometry *g = static_cast<QSGGeometryNode *>(e.node)->geometry();
+        mergeable = mergeable && e.mergeable;
+        vertexCount += g->vertexCount();
+        indexCount += qsg_mergedIndexCount(g);
+    }
+
+    // The nodes have changed in a way that no longer allows them to be
+    // merged. Draw them one by one, which keeps the order, and form new
+    // batches on the next frame.
+    if (!mergeable || vertexCount > qsg_batch_max_vertices) {
+        batch->merged = false;
+        m_rebatch = true;
+        return;
+    }
+
+    const int stride = static_cast<QSGGeometryNode *>(m_elements.at(batch->elements.first()).node)
+            ->geometry()->sizeOfVertex();
+    m_vertexScratch.resize(vertexCount * stride);
+    m_indexScratch.resize(indexCount);
+    batch->nodes.resize(batch->elements.size());
+
+    char *vertices = m_vertexScratch.data();
+    quint16 *indices = m_indexScratch.data();
+    int base = 0;
+    for (int i = 0; i < batch->elements.size(); ++i) {
+        QSGGeometryNode *node = static_cast<QSGGeometryNode *>(m_elements.at(batch->elements.at(i)).node);
+        const QSGGeometry *g = node->geometry();
+        const int count = g->vertexCount();
+        batch->nodes[i] = node;
+
+        memcpy(vertices, g->vertexData(), count * stride);
+        QMatrix4x4 m = qsg_matrixRelativeTo(node, batch->root, rootNode());
+        if (!m.isIdentity()) {
+            for (int v = 0; v < count; ++v) {
+                float *p = reinterpret_cast<float *>(vertices + v * stride);
+                const float x = p[0];
+                const float y = p[1];
+                p[0] = m(0, 0) * x + m(0, 1) * y + m(0, 3);
+                p[1] = m(1, 0) * x + m(1, 1) * y + m(1, 3);
+            }
+        }
+        vertices += count * stride;
+
+        const quint16 *src = g->indexCount() ? g->indexDataAsUShort() : 0;
+        const int srcCount = src ? g->indexCount() : count;
+        if (g->drawingMode() == GL_TRIANGLE_STRIP) {
+            for (int k = 0; k + 2 < srcCount; ++k) {
+                *indices++ = base + (src ? src[k] : k);
+                *indices++ = base + (src ? src[k + 1] : k + 1);
+                *indices++ = base + (src ? src[k + 2] : k + 2);
+            }
+        } else {
+            for (int k = 0; k < srcCount; ++k)
+                *indices++ = base + (src ? src[k] : k);
+        }
+        base += count;
+    }
+
+    if (!batch->vbo)
+        batch->vbo = takeBuffer();
+    if (!batch->ibo)
+        batch->ibo = takeBuffer();
+
+    glBindBuffer(GL_ARRAY_BUFFER, batch->vbo);
+    glBufferData(GL_ARRAY_BUFFER, m_vertexScratch.size(), m_vertexScratch.constData(), GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, batch->ibo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexCount * sizeof(quint16), m_indexScratch.constData(), GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+    batch->vertexCount = vertexCount;
+    batch->indexCount = indexCount;
+
+    ++m_stats.uploads;
+    m_stats.uploadedBytes += m_vertexScratch.size() + indexCount * sizeof(quint16);
+}
+
+void QSGBatchRenderer::render()
+{
+#if defined (QML_RUNTIME_TESTING)
+    static bool dumpTree = qApp->arguments().contains(QLatin1String("--dump-tree"));
+    if (dumpTree) {
+        printf("\n\n");
+        QSGNodeDumper::dump(rootNode());
+    }
+#endif
+
+    memset(&m_stats, 0, sizeof(m_stats));
+
+    glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    glDisable(GL_BLEND);
+
+    glFrontFace(isMirrored() ? GL_CW : GL_CCW);
+    glDisable(GL_CULL_FACE);
+
+    glDepthMask(true);
+#if defined(QT_OPENGL_ES)
+    glClearDepthf(1);
+#else
+    glClearDepth(1);
+#endif
+
+    glDisable(GL_SCISSOR_TEST);
+    glClearColor(m_clear_color.redF(), m_clear_color.greenF(), m_clear_color.blueF(), m_clear_color.alphaF());
+
+    bindable()->clear(clearMode());
+
+    // Everything is drawn in scene order, so the depth buffer is not used.
+    glDisable(GL_DEPTH_TEST);
+    glDepthMask(false);
+
+    QRect r = viewportRect();
+    glViewport(r.x(), deviceRect().bottom() - r.bottom(), r.width(), r.height());
+    m_current_projection_matrix = projectionMatrix();
+    m_current_model_view_matrix.setToIdentity();
+    m_current_determinant = 1;
+
+    m_currentClip = 0;
+    m_currentClipType = NoClip;
+    glDisable(GL_STENCIL_TEST);
+
+    m_currentMaterial = 0;
+    m_currentProgram = 0;
+    m_currentMatrix = 0;
+    m_currentBlending = false;
+
+    if (m_rebuild_lists) {
+        m_elements.reset();
+        m_elementIndex.clear();
+        m_dirtyElements.reset();
+        buildRenderList(rootNode());
+        m_rebuild_lists = false;
+        m_rebatch = true;
+    } else {
+        for (int i = 0; i < m_dirtyElements.size(); ++i) {
+            const int index = m_dirtyElements.at(i);
+            Element &e = m_elements.at(index);
+            const QRectF oldBounds = e.bounds;
+            const bool wasUnbounded = e.unbounded;
+            updateElementBounds(e);
+            // Shrinking never creates new overlaps
+            if (!m_rebatch && (e.unbounded || wasUnbounded || !oldBounds.contains(e.bounds)))
+                m_rebatch = !isBatchOrderValid(index);
+        }
+        m_dirtyElements.reset();
+    }
+
+    if (m_rebatch) {
+        m_rebatch = false;
+        prepareBatches();
+    }
+
+    for (int i = 0; i < m_batches.size(); ++i) {
+        Batch *batch = m_batches.at(i);
+        if (batch->merged && batch->dirty)
+            uploadBatch(batch);
+    }
+
+    for (int i = 0; i < m_batches.size(); ++i)
+        renderBatch(m_batches.at(i));
+
+    if (m_currentProgram)
+        m_currentProgram->deactivate();
+
+    m_stats.nodes = m_elements.size();
+
+#ifndef QSG_NO_RENDER_TIMING
+    if (qsg_render_timing) {
+        printf("   - batch renderer: nodes=%d, batches=%d (merged=%d), draw calls=%d, uploads=%d (%d bytes)\n",
+               m_stats.nodes, m_stats.batches, m_stats.mergedBatches, m_stats.drawCalls,
+               m_stats.uploads, m_stats.uploadedBytes);
+    }
+#endif
+}
+
+void QSGBatchRenderer::renderBatch(Batch *batch)
+{
+    QSGNode *first = m_elements.at(batch->elements.first()).node;
+    if (first->type() == QSGNode::RenderNodeType) {
+        renderRenderNode(static_cast<QSGRenderNode *>(first));
+        return;
+    }
+
+    ++m_stats.batches;
+
+    if (!batch->merged) {
+        for (int i = 0; i < batch->elements.size(); ++i) {
+            QSGGeometryNode *node = static_cast<QSGGeometryNode *>(m_elements.at(batch->elements.at(i)).node);
+            renderGeometry(node, node->matrix(), 0);
+        }
+        return;
+    }
+
+    ++m_stats.mergedBatches;
+    const QMatrix4x4 *matrix = batch->root
+            ? &static_cast<QSGTransformNode *>(batch->root)->combinedMatrix()
+            : 0;
+    renderGeometry(static_cast<QSGGeometryNode *>(first), matrix, batch);
+}
+
+/*!
+    Draws \a node with \a matrix as model-view matrix. If \a batch is given,
+    the merged vertices of the whole batch are drawn using the state of \a node.
+ */
+void QSGBatchRenderer::renderGeometry(QSGGeometryNode *node, const QMatrix4x4 *matrix, Batch *batch)
+{
+    QSGMaterialShader::RenderState::DirtyStates updates;
+
+#if defined (QML_RUNTIME_TESTING)
+    static bool dumpTree = qApp->arguments().contains(QLatin1String("--dump-tree"));
+    if (dumpTree)
+        qDebug() << node << (batch ? batch->elements.size() : 1);
+#endif
+
+    if (m_currentMatrix != matrix) {
+        m_currentMatrix = matrix;
+        if (m_currentMatrix)
+            m_current_model_view_matrix = *m_currentMatrix;
+        else
+            m_current_model_view_matrix.setToIdentity();
+        m_current_determinant = m_current_model_view_matrix.determinant();
+        updates |= QSGMaterialShader::RenderState::DirtyMatrix;
+    }
+
+    if (m_current_opacity != node->inheritedOpacity()) {
+        updates |= QSGMaterialShader::RenderState::DirtyOpacity;
+        m_current_opacity = node->inheritedOpacity();
+    }
+
+    Q_ASSERT(node->activeMaterial());
+
+    QSGMaterial *material = node->activeMaterial();
+    QSGMaterialShader *program = m_context->prepareMaterial(material);
+    Q_ASSERT(program->program()->isLinked());
+
+    bool changeClip = node->clipList() != m_currentClip;
+    if (changeClip) {
+        m_currentClipType = updateStencilClip(node->clipList());
+        m_currentClip = node->clipList();
+    }
+
+    bool changeProgram = (changeClip && (m_currentClipType & StencilClip)) || m_currentProgram != program;
+    if (changeProgram) {
+        if (m_currentProgram)
+            m_currentProgram->deactivate();
+        m_currentProgram = program;
+        m_currentProgram->activate();
+        updates |= (QSGMaterialShader::RenderState::DirtyMatrix | QSGMaterialShader::RenderState::DirtyOpacity);
+    }
+
+    if (changeProgram || m_currentMaterial != material || updates) {
+        program->updateState(state(updates), material, changeProgram ? 0 : m_currentMaterial);
+        m_currentMaterial = material;
+    }
+
+    bool blending = (material->flags() & QSGMaterial::Blending) || m_current_opacity < 1;
+    if (blending != m_currentBlending) {
+        if (blending)
+            glEnable(GL_BLEND);
+        else
+            glDisable(GL_BLEND);
+        m_currentBlending = blending;
+    }
+
+    const QSGGeometry *g = node->geometry();
+    ++m_stats.drawCalls;
+
+    if (!batch) {
+        draw(program, g);
+        return;
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, batch->vbo);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, batch->ibo);
+
+    char const *const *attrNames = program->attributeNames();
+    int offset = 0;
+    for (int j = 0; attrNames[j] && j < g->attributeCount(); ++j) {
+        const QSGGeometry::Attribute &a = g->attributes()[j];
+        if (*attrNames[j]) {
+#if defined(QT_OPENGL_ES_2)
+            GLboolean normalize = a.type != GL_FLOAT;
+#else
+            GLboolean normalize = a.type != GL_FLOAT && a.type != GL_DOUBLE;
+#endif
+            glVertexAttribPointer(a.position, a.tupleSize, a.type, normalize, g->sizeOfVertex(), (char *) 0 + offset);
+        }
+        offset += a.tupleSize * qsg_sizeOfType(a.type);
+    }
+
+    glDrawElements(GL_TRIANGLES, batch->indexCount, GL_UNSIGNED_SHORT, 0);
+
+    // QSGRenderer::draw() and the stencil clip expect client side arrays
+    // unless they bound a buffer themselves.
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+}
+
+void QSGBatchRenderer::renderRenderNode(QSGRenderNode *renderNode)
+{
+    if (m_currentProgram)
+        m_currentProgram->deactivate();
+    m_currentMaterial = 0;
+    m_currentProgram = 0;
+    m_currentMatrix = 0;
+
+    if (renderNode->clipList() != m_currentClip) {
+        m_currentClipType = updateStencilClip(renderNode->clipList());
+        m_currentClip = renderNode->clipList();
+    }
+
+    if (!m_currentBlending) {
+        glEnable(GL_BLEND);
+        m_currentBlending = true;
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+    QMatrix4x4 projection = projectionMatrix();
+
+    QSGRenderNode::RenderState state;
+    state.projectionMatrix = &projection;
+    state.scissorEnabled = m_currentClipType & ScissorClip;
+    state.stencilEnabled = m_currentClipType & StencilClip;
+    state.scissorRect = m_current_scissor_rect;
+    state.stencilValue = m_current_stencil_value;
+
+    renderNode->render(state);
+    ++m_stats.drawCalls;
+
+    QSGRenderNode::StateFlags changes = renderNode->changedStates();
+    if (changes & QSGRenderNode::ViewportState) {
+        QRect r = viewportRect();
+        glViewport(r.x(), deviceRect().bottom() - r.bottom(), r.width(), r.height());
+    }
+    if (changes & QSGRenderNode::StencilState) {
+        glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
+        glStencilMask(0xff);
+        glDisable(GL_STENCIL_TEST);
+    }
+    if (changes & (QSGRenderNode::StencilState | QSGRenderNode::ScissorState)) {
+        glDisable(GL_SCISSOR_TEST);
+        m_currentClip = 0;
+        m_currentClipType = NoClip;
+    }
+    if (changes & QSGRenderNode::DepthState) {
+#if defined(QT_OPENGL_ES)
+        glClearDepthf(1);
+#else
+        glClearDepth(1);
+#endif
+        glDisable(GL_DEPTH_TEST);
+        glDepthMask(false);
+    }
+    if (changes & QSGRenderNode::ColorState)
+        bindable()->reactivate();
+    if (changes & QSGRenderNode::BlendState) {
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    }
+    if (changes & QSGRenderNode::CullState) {
+        glFrontFace(isMirrored() ? GL_CW : GL_CCW);
+        glDisable(GL_CULL_FACE);
+    }
+
+    m_current_model_view_matrix.setToIdentity();
+    m_current_determinant = 1;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,155 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the QtQuick module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QSGBATCHRENDERER_P_H
+#define QSGBATCHRENDERER_P_H
+
+#include "qsgrenderer_p.h"
+
+#include <QtGui/private/qdatabuffer_p.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qset.h>
+#include <QtCore/qvector.h>
+#include "qsgrendernode_p.h"
+
+QT_BEGIN_NAMESPACE
+
+class Q_QUICK_PRIVATE_EXPORT QSGBatchRenderer : public QSGRenderer
+{
+    Q_OBJECT
+public:
+    struct Statistics
+    {
+        int nodes;          // geometry and render nodes in the render list
+        int batches;        // batches drawn, merged or not
+        int mergedBatches;  // batches drawn from a shared vertex buffer
+        int drawCalls;
+        int uploads;        // vertex buffer uploads done this frame
+        int uploadedBytes;
+    };
+
+    QSGBatchRenderer(QSGContext *context);
+    ~QSGBatchRenderer();
+
+    void render();
+
+    void nodeChanged(QSGNode *node, QSGNode::DirtyState state);
+
+    const Statistics &statistics() const { return m_stats; }
+
+private:
+    struct Element
+    {
+        QSGNode *node;
+        QRectF localBounds;         // bounds of the geometry in node coordinates
+        QRectF bounds;              // bounds of the geometry in scene coordinates
+        int batch;                  // index into m_batches, which is also the draw order
+        uint boundsDirty : 1;
+        uint geometryDirty : 1;
+        uint unbounded : 1;         // perspective or unknown geometry, overlaps everything
+        uint mergeable : 1;
+    };
+
+    struct Batch
+    {
+        Batch() : root(0), vbo(0), ibo(0), vertexCount(0), indexCount(0)
+                , merged(false), dirty(true) { }
+
+        QVector<int> elements;      // indices into m_elements, in draw order
+        QVector<QSGNode *> nodes;   // nodes whose vertices are in the vertex buffer
+        QSGNode *root;              // transform node the merged vertices are relative to
+        GLuint vbo;
+        GLuint ibo;
+        int vertexCount;
+        int indexCount;
+        uint merged : 1;
+        uint dirty : 1;
+    };
+
+    void buildRenderList(QSGNode *node);
+    void updateElementBounds(Element &e);
+    void markElementDirty(int index, bool geometryChanged);
+    bool isBatchOrderValid(int index) const;
+    void invalidateSubtree(QSGNode *node, QSet<QSGNode *> *visitedRoots);
+
+    void prepareBatches();
+    void releaseBatches();
+    bool isCompatible(const Element &a, const Element &b) const;
+    QSGNode *findBatchRoot(const Batch *batch) const;
+    bool isBatchDataValid(const Batch *batch) const;
+    void uploadBatch(Batch *batch);
+    GLuint takeBuffer();
+
+    void renderBatch(Batch *batch);
+    void renderGeometry(QSGGeometryNode *node, const QMatrix4x4 *matrix, Batch *batch);
+    void renderRenderNode(QSGRenderNode *node);
+
+    QDataBuffer<Element> m_elements;
+    QVector<Batch *> m_batches;
+    QHash<QSGNode *, int> m_elementIndex;
+    QSet<QSGNode *> m_batchRoots;
+    QDataBuffer<int> m_dirtyElements;
+    QDataBuffer<GLuint> m_freeBuffers;
+
+    // Changes seen while a list rebuild is pending, used to keep the vertex
+    // buffers of batches that come out of the rebuild unchanged.
+    QSet<QSGNode *> m_touchedNodes;
+    QSet<QSGNode *> m_dirtyTransforms;
+
+    QByteArray m_vertexScratch;
+    QVector<quint16> m_indexScratch;
+
+    const QSGClipNode *m_currentClip;
+    ClipType m_currentClipType;
+    QSGMaterial *m_currentMaterial;
+    QSGMaterialShader *m_currentProgram;
+    const QMatrix4x4 *m_currentMatrix;
+    bool m_currentBlending;
+
+    Statistics m_stats;
+
+    bool m_rebuild_lists;
+    bool m_rebatch;
+};
+
+QT_END_NAMESPACE
+
+#endif // QSGBATCHRENDERER_P_H
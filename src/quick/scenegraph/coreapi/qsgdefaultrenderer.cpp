@@ -130,9 +130,12 @@ QSGDefaultRenderer::QSGDefaultRenderer(QSGContext *context)
     , m_opaqueNodes(64)
     , m_transparentNodes(64)
     , m_renderGroups(4)
+    , m_currentClipType(NoClip)
+    , m_currentNodeRenderOrder(0)
     , m_rebuild_lists(false)
     , m_sort_front_to_back(false)
     , m_render_node_added(false)
+    , m_incremental(false)
     , m_currentRenderOrder(1)
 {
 #if defined(QML_RUNTIME_TESTING)
@@ -150,8 +153,22 @@ void QSGDefaultRenderer::nodeChanged(QSGNode *node, QSGNode::DirtyState state)
                                 | QSGNode::DirtyMaterial | QSGNode::DirtyOpacity
                                 | QSGNode::DirtyForceUpdate;
 
-    if (state & rebuildBits)
-        m_rebuild_lists = true;
+    if (!m_incremental || (state & QSGNode::DirtyForceUpdate)) {
+        if (state & rebuildBits)
+            m_rebuild_lists = true;
+        return;
+    }
+
+    if (m_rebuild_lists)
+        return;
+
+    // Removals are applied right away, as the nodes may be deleted before the
+    // next frame. Added and changed subtrees are inserted in render(), once
+    // the update pass has given them valid clip lists and opacities.
+    if (state & QSGNode::DirtyNodeRemoved)
+        removeSubtree(node, true);
+    if (state & (QSGNode::DirtyNodeAdded | QSGNode::DirtyMaterial | QSGNode::DirtyOpacity))
+        m_pendingNodes.insert(node);
 }
 
 void QSGDefaultRenderer::render()
@@ -211,15 +228,27 @@ void QSGDefaultRenderer::render()
     m_currentProgram = 0;
     m_currentMatrix = 0;
 
-    bool sortNodes = m_rebuild_lists;
+    bool sortNodes = false;
 
     if (m_rebuild_lists) {
+        m_rebuild_lists = false;
+        clearIncrementalLists();
         m_opaqueNodes.reset();
         m_transparentNodes.reset();
         m_renderGroups.reset();
+        m_incremental = !m_sort_front_to_back && buildIncrementalLists();
+        sortNodes = !m_incremental;
+    } else if (m_incremental && !m_pendingNodes.isEmpty()) {
+        m_incremental = updateIncrementalLists();
+        sortNodes = !m_incremental;
+    }
+
+    if (sortNodes) {
+        // The scene contains render nodes, or front-to-back sorting is enabled,
+        // so build the flat lists and render groups from scratch.
+        clearIncrementalLists();
         m_currentRenderOrder = 1;
         buildLists(rootNode());
-        m_rebuild_lists = false;
         m_render_node_added = false;
         RenderGroup group = { m_opaqueNodes.size(), m_transparentNodes.size() };
         m_renderGroups.add(group);
@@ -247,9 +276,39 @@ void QSGDefaultRenderer::render()
     int debugtimeSorting = debugTimer.elapsed();
 #endif
 
+    if (m_incremental) {
+        glDisable(GL_BLEND);
+        glDepthMask(true);
+#ifdef QML_RUNTIME_TESTING
+        if (m_render_opaque_nodes)
+#endif
+        {
+            beginRenderNodes();
+            QMap<BucketKey, QMap<SortKey, QSGNode *> >::const_iterator it = m_opaqueBuckets.constBegin();
+            for (; it != m_opaqueBuckets.constEnd(); ++it) {
+                const QMap<SortKey, QSGNode *> &nodes = it.value();
+                QMap<SortKey, QSGNode *>::const_iterator node = nodes.constBegin();
+                for (; node != nodes.constEnd(); ++node)
+                    renderNode(node.value());
+            }
+        }
+
+        glEnable(GL_BLEND);
+        glDepthMask(false);
+#ifdef QML_RUNTIME_TESTING
+        if (m_render_alpha_nodes)
+#endif
+        {
+            beginRenderNodes();
+            QMap<int, QSGNode *>::const_iterator it = m_transparentOrder.constBegin();
+            for (; it != m_transparentOrder.constEnd(); ++it)
+                renderNode(it.value());
+        }
+    }
+
     int opaqueStart = 0;
     int transparentStart = 0;
-    for (int i = 0; i < m_renderGroups.size(); ++i) {
+    for (int i = 0; !m_incremental && i < m_renderGroups.size(); ++i) {
         int opaqueEnd = m_renderGroups.at(i).opaqueEnd;
         int transparentEnd = m_renderGroups.at(i).transparentEnd;
 
@@ -313,6 +372,8 @@ void QSGDefaultRenderer::render()
 void QSGDefaultRenderer::setSortFrontToBackEnabled(bool sort)
 {
     printf("setting sorting to... %d\n", sort);
+    if (m_sort_front_to_back != sort)
+        m_rebuild_lists = true;
     m_sort_front_to_back = sort;
 }
 
@@ -363,186 +424,434 @@ void QSGDefaultRenderer::buildLists(QSGNode *node)
         buildLists(c);
 }
 
+/*
+    The incremental lists keep opaque nodes in buckets of equal clip and material
+    type, each bucket grouped by material and matrix, and transparent nodes ordered
+    by render order. The render orders used as keys are assigned in tree order with
+    gaps, so that nodes added later can be given keys in between without
+    renumbering the whole scene. Structural changes only touch the subtrees that
+    changed. The nodes themselves are given dense render orders once the lists
+    are up to date, so that the gaps do not cost any depth buffer precision.
+ */
+
+static const int qsg_render_order_spacing = 64;
+
+bool QSGDefaultRenderer::buildIncrementalLists()
+{
+    QVector<QSGGeometryNode *> nodes;
+    if (!collectGeometryNodes(rootNode(), &nodes))
+        return false;
+    for (int i = 0; i < nodes.size(); ++i)
+        insertNode(nodes.at(i), (i + 1) * qsg_render_order_spacing);
+    assignRenderOrders();
+    return true;
+}
+
+void QSGDefaultRenderer::clearIncrementalLists()
+{
+    m_opaqueBuckets.clear();
+    m_transparentOrder.clear();
+    m_renderOrders.clear();
+    m_nodeInfo.clear();
+    m_pendingNodes.clear();
+}
+
+/*!
+    Inserts the subtrees which were added or changed since the last frame.
+    Returns false if a render node was found, in which case the lists need to
+    be built from scratch.
+ */
+bool QSGDefaultRenderer::updateIncrementalLists()
+{
+    QSet<QSGNode *> pending;
+    qSwap(pending, m_pendingNodes);
+
+    for (QSet<QSGNode *>::const_iterator it = pending.constBegin(); it != pending.constEnd(); ++it) {
+        QSGNode *node = *it;
+        removeSubtree(node, false);
+        if (nodeUpdater()->isNodeBlocked(node, rootNode()))
+            continue;
+        if (!insertSubtree(node))
+            return false;
+    }
+
+    assignRenderOrders();
+    return true;
+}
+
+/*!
+    Appends the geometry nodes of the subtree at \a node in tree order to
+    \a nodes. Returns false if the subtree contains a render node.
+ */
+bool QSGDefaultRenderer::collectGeometryNodes(QSGNode *node, QVector<QSGGeometryNode *> *nodes) const
+{
+    if (node->isSubtreeBlocked())
+        return true;
+
+    if (node->type() == QSGNode::GeometryNodeType)
+        nodes->append(static_cast<QSGGeometryNode *>(node));
+    else if (node->type() == QSGNode::RenderNodeType)
+        return false;
+
+    for (QSGNode *c = node->firstChild(); c; c = c->nextSibling()) {
+        if (!collectGeometryNodes(c, nodes))
+            return false;
+    }
+    return true;
+}
+
+bool QSGDefaultRenderer::insertSubtree(QSGNode *node)
+{
+    QVector<QSGGeometryNode *> nodes;
+    if (!collectGeometryNodes(node, &nodes))
+        return false;
+    if (nodes.isEmpty())
+        return true;
+
+    QSGGeometryNode *preceding = findPrecedingNode(node);
+    const int before = preceding ? m_nodeInfo.value(preceding).renderOrder : 0;
+    QMap<int, QSGGeometryNode *>::const_iterator next = m_renderOrders.upperBound(before);
+    const int after = next != m_renderOrders.constEnd()
+            ? next.key()
+            : before + (nodes.size() + 1) * qsg_render_order_spacing;
+
+    if (after - before <= nodes.size()) {
+        renumber(preceding, nodes);
+        return true;
+    }
+
+    const int step = (after - before) / (nodes.size() + 1);
+    for (int i = 0; i < nodes.size(); ++i)
+        insertNode(nodes.at(i), before + (i + 1) * step);
+    return true;
+}
+
+/*!
+    Removes the nodes of the subtree at \a node from the lists. As this is
+    also called for nodes which are being deleted, only the node type and
+    tree structure are looked at.
+ */
+void QSGDefaultRenderer::removeSubtree(QSGNode *node, bool dropPending)
+{
+    if (node->type() == QSGNode::GeometryNodeType)
+        removeNode(node);
+    if (dropPending)
+        m_pendingNodes.remove(node);
+
+    for (QSGNode *c = node->firstChild(); c; c = c->nextSibling())
+        removeSubtree(c, dropPending);
+}
+
+void QSGDefaultRenderer::insertNode(QSGGeometryNode *node, int renderOrder)
+{
+    QSGMaterial *m = node->activeMaterial();
+
+    NodeInfo info;
+    info.renderOrder = renderOrder;
+#ifdef FORCE_NO_REORDER
+    info.opaque = false;
+#else
+    info.opaque = !(m->flags() & QSGMaterial::Blending) && node->inheritedOpacity() >= 1;
+#endif
+    info.bucket.clip = node->clipList();
+    info.bucket.type = node->material()->type();
+    info.key.material = m;
+    info.key.matrix = node->matrix();
+    info.key.node = node;
+
+    m_renderOrders.insert(renderOrder, node);
+    m_nodeInfo.insert(node, info);
+
+    if (info.opaque) {
+        m_opaqueBuckets[info.bucket].insert(info.key, node);
+    } else {
+        m_transparentOrder.insert(renderOrder, node);
+    }
+}
+
+void QSGDefaultRenderer::removeNode(QSGNode *node)
+{
+    QHash<QSGNode *, NodeInfo>::iterator it = m_nodeInfo.find(node);
+    if (it == m_nodeInfo.end())
+        return;
+
+    const NodeInfo &info = it.value();
+    m_renderOrders.remove(info.renderOrder);
+    if (info.opaque) {
+        // The key is the one the node was inserted with, so the lookup does not
+        // depend on the material or matrix the node has now.
+        QMap<BucketKey, QMap<SortKey, QSGNode *> >::iterator bucket = m_opaqueBuckets.find(info.bucket);
+        Q_ASSERT(bucket != m_opaqueBuckets.end());
+        bucket.value().remove(info.key);
+        if (bucket.value().isEmpty())
+            m_opaqueBuckets.erase(bucket);
+    } else {
+        m_transparentOrder.remove(info.renderOrder);
+    }
+    m_nodeInfo.erase(it);
+}
+
+/*!
+    Assigns new, evenly spaced keys to all nodes, placing \a nodes
+    right after \a after, or first if \a after is 0. Only needed when the gap
+    between two existing nodes is used up.
+ */
+void QSGDefaultRenderer::renumber(QSGGeometryNode *after, const QVector<QSGGeometryNode *> &nodes)
+{
+    QVector<QSGGeometryNode *> sequence;
+    sequence.reserve(m_renderOrders.size() + nodes.size());
+    if (!after)
+        sequence += nodes;
+    for (QMap<int, QSGGeometryNode *>::const_iterator it = m_renderOrders.constBegin();
+         it != m_renderOrders.constEnd(); ++it) {
+        sequence << it.value();
+        if (it.value() == after)
+            sequence += nodes;
+    }
+
+    m_renderOrders.clear();
+    m_transparentOrder.clear();
+    for (int i = 0; i < sequence.size(); ++i) {
+        QSGGeometryNode *node = sequence.at(i);
+        const int renderOrder = (i + 1) * qsg_render_order_spacing;
+        QHash<QSGNode *, NodeInfo>::iterator it = m_nodeInfo.find(node);
+        if (it == m_nodeInfo.end()) {
+            insertNode(node, renderOrder);
+            continue;
+        }
+        it.value().renderOrder = renderOrder;
+        m_renderOrders.insert(renderOrder, node);
+        if (!it.value().opaque)
+            m_transparentOrder.insert(renderOrder, node);
+    }
+}
+
+/*!
+    Gives the nodes consecutive render orders in tree order, so that the depth
+    range is divided evenly between them however the keys are spaced.
+ */
+void QSGDefaultRenderer::assignRenderOrders()
+{
+    int renderOrder = 0;
+    for (QMap<int, QSGGeometryNode *>::const_iterator it = m_renderOrders.constBegin();
+         it != m_renderOrders.constEnd(); ++it) {
+        it.value()->setRenderOrder(++renderOrder);
+    }
+    m_currentRenderOrder = renderOrder + 1;
+}
+
+/*!
+    Returns the last geometry node in the lists which comes before \a node
+    in tree order, or 0 if there is none.
+ */
+QSGGeometryNode *QSGDefaultRenderer::findPrecedingNode(QSGNode *node) const
+{
+    QSGNode *n = node;
+    while (n != rootNode()) {
+        if (QSGNode *previous = n->previousSibling()) {
+            if (QSGGeometryNode *last = findLastNode(previous))
+                return last;
+            n = previous;
+        } else {
+            n = n->parent();
+            if (!n)
+                return 0;
+            if (n->type() == QSGNode::GeometryNodeType && m_nodeInfo.contains(n))
+                return static_cast<QSGGeometryNode *>(n);
+        }
+    }
+    return 0;
+}
+
+QSGGeometryNode *QSGDefaultRenderer::findLastNode(QSGNode *node) const
+{
+    for (QSGNode *c = node->lastChild(); c; c = c->previousSibling()) {
+        if (QSGGeometryNode *last = findLastNode(c))
+            return last;
+    }
+    if (node->type() == QSGNode::GeometryNodeType && m_nodeInfo.contains(node))
+        return static_cast<QSGGeometryNode *>(node);
+    return 0;
+}
+
 void QSGDefaultRenderer::renderNodes(QSGNode *const *nodes, int count)
 {
-    const float scale = 1.0f / m_currentRenderOrder;
-    int currentRenderOrder = 0x80000000;
-    ClipType currentClipType = NoClip;
-    QMatrix4x4 projection = projectionMatrix();
-    m_current_projection_matrix.setColumn(2, scale * projection.column(2));
+    beginRenderNodes();
 
-    //int clipChangeCount = 0;
-    //int programChangeCount = 0;
-    //int materialChangeCount = 0;
+    for (int i = 0; i < count; ++i)
+        renderNode(nodes[i]);
+}
 
-    for (int i = 0; i < count; ++i) {
-        if (nodes[i]->type() == QSGNode::RenderNodeType) {
-            QSGRenderNode *renderNode = static_cast<QSGRenderNode *>(nodes[i]);
+void QSGDefaultRenderer::beginRenderNodes()
+{
+    const float scale = 1.0f / m_currentRenderOrder;
+    m_currentNodeRenderOrder = 0x80000000;
+    m_currentClipType = NoClip;
+    m_projection = projectionMatrix();
+    m_current_projection_matrix.setColumn(2, scale * m_projection.column(2));
+}
 
-            if (m_currentProgram)
-                m_currentProgram->deactivate();
-            m_currentMaterial = 0;
-            m_currentProgram = 0;
-            m_currentMatrix = 0;
-            currentRenderOrder = 0x80000000;
+void QSGDefaultRenderer::renderNode(QSGNode *node)
+{
+    if (node->type() == QSGNode::RenderNodeType) {
+        QSGRenderNode *renderNode = static_cast<QSGRenderNode *>(node);
 
-            bool changeClip = renderNode->clipList() != m_currentClip;
-            // The clip function relies on there not being any depth testing..
-            glDisable(GL_DEPTH_TEST);
-            if (changeClip) {
-                currentClipType = updateStencilClip(renderNode->clipList());
-                m_currentClip = renderNode->clipList();
-                //++clipChangeCount;
-            }
+        if (m_currentProgram)
+            m_currentProgram->deactivate();
+        m_currentMaterial = 0;
+        m_currentProgram = 0;
+        m_currentMatrix = 0;
+        m_currentNodeRenderOrder = 0x80000000;
+
+        bool changeClip = renderNode->clipList() != m_currentClip;
+        // The clip function relies on there not being any depth testing..
+        glDisable(GL_DEPTH_TEST);
+        if (changeClip) {
+            m_currentClipType = updateStencilClip(renderNode->clipList());
+            m_currentClip = renderNode->clipList();
+        }
 
-            glDepthMask(false);
-            glBindBuffer(GL_ARRAY_BUFFER, 0);
-            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-
-            QSGRenderNode::RenderState state;
-            state.projectionMatrix = &projection;
-            state.scissorEnabled = currentClipType & ScissorClip;
-            state.stencilEnabled = currentClipType & StencilClip;
-            state.scissorRect = m_current_scissor_rect;
-            state.stencilValue = m_current_stencil_value;
-
-            renderNode->render(state);
-
-            QSGRenderNode::StateFlags changes = renderNode->changedStates();
-            if (changes & QSGRenderNode::ViewportState) {
-                QRect r = viewportRect();
-                glViewport(r.x(), deviceRect().bottom() - r.bottom(), r.width(), r.height());
-            }
-            if (changes & QSGRenderNode::StencilState) {
-                glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
-                glStencilMask(0xff);
-                glDisable(GL_STENCIL_TEST);
-            }
-            if (changes & (QSGRenderNode::StencilState | QSGRenderNode::ScissorState)) {
-                glDisable(GL_SCISSOR_TEST);
-                m_currentClip = 0;
-                currentClipType = NoClip;
-            }
-            if (changes & QSGRenderNode::DepthState) {
+        glDepthMask(false);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+        QSGRenderNode::RenderState state;
+        state.projectionMatrix = &m_projection;
+        state.scissorEnabled = m_currentClipType & ScissorClip;
+        state.stencilEnabled = m_currentClipType & StencilClip;
+        state.scissorRect = m_current_scissor_rect;
+        state.stencilValue = m_current_stencil_value;
+
+        renderNode->render(state);
+
+        QSGRenderNode::StateFlags changes = renderNode->changedStates();
+        if (changes & QSGRenderNode::ViewportState) {
+            QRect r = viewportRect();
+            glViewport(r.x(), deviceRect().bottom() - r.bottom(), r.width(), r.height());
+        }
+        if (changes & QSGRenderNode::StencilState) {
+            glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
+            glStencilMask(0xff);
+            glDisable(GL_STENCIL_TEST);
+        }
+        if (changes & (QSGRenderNode::StencilState | QSGRenderNode::ScissorState)) {
+            glDisable(GL_SCISSOR_TEST);
+            m_currentClip = 0;
+            m_currentClipType = NoClip;
+        }
+        if (changes & QSGRenderNode::DepthState) {
 #if defined(QT_OPENGL_ES)
-                glClearDepthf(1);
+            glClearDepthf(1);
 #else
-                glClearDepth(1);
+            glClearDepth(1);
 #endif
-                if (m_clear_mode & QSGRenderer::ClearDepthBuffer) {
-                    glDepthMask(true);
-                    glClear(GL_DEPTH_BUFFER_BIT);
-                }
-                glDepthMask(false);
-                glDepthFunc(GL_LESS);
-            }
-            if (changes & QSGRenderNode::ColorState)
-                bindable()->reactivate();
-            if (changes & QSGRenderNode::BlendState) {
-                glEnable(GL_BLEND);
-                glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
-            }
-            if (changes & QSGRenderNode::CullState) {
-                glFrontFace(isMirrored() ? GL_CW : GL_CCW);
-                glDisable(GL_CULL_FACE);
+            if (m_clear_mode & QSGRenderer::ClearDepthBuffer) {
+                glDepthMask(true);
+                glClear(GL_DEPTH_BUFFER_BIT);
             }
+            glDepthMask(false);
+            glDepthFunc(GL_LESS);
+        }
+        if (changes & QSGRenderNode::ColorState)
+            bindable()->reactivate();
+        if (changes & QSGRenderNode::BlendState) {
+            glEnable(GL_BLEND);
+            glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+        }
+        if (changes & QSGRenderNode::CullState) {
+            glFrontFace(isMirrored() ? GL_CW : GL_CCW);
+            glDisable(GL_CULL_FACE);
+        }
 
-            glEnable(GL_DEPTH_TEST);
+        glEnable(GL_DEPTH_TEST);
 
-            m_current_model_view_matrix.setToIdentity();
-            m_current_determinant = 1;
-        } else if (nodes[i]->type() == QSGNode::GeometryNodeType) {
-            QSGGeometryNode *geomNode = static_cast<QSGGeometryNode *>(nodes[i]);
+        m_current_model_view_matrix.setToIdentity();
+        m_current_determinant = 1;
+    } else if (node->type() == QSGNode::GeometryNodeType) {
+        QSGGeometryNode *geomNode = static_cast<QSGGeometryNode *>(node);
 
-            QSGMaterialShader::RenderState::DirtyStates updates;
+        QSGMaterialShader::RenderState::DirtyStates updates;
 
 #if defined (QML_RUNTIME_TESTING)
-            static bool dumpTree = qApp->arguments().contains(QLatin1String("--dump-tree"));
-            if (dumpTree)
-                qDebug() << geomNode;
+        static bool dumpTree = qApp->arguments().contains(QLatin1String("--dump-tree"));
+        if (dumpTree)
+            qDebug() << geomNode;
 #endif
 
-            bool changeMatrix = m_currentMatrix != geomNode->matrix();
+        bool changeMatrix = m_currentMatrix != geomNode->matrix();
 
-            if (changeMatrix) {
-                m_currentMatrix = geomNode->matrix();
-                if (m_currentMatrix)
-                    m_current_model_view_matrix = *m_currentMatrix;
-                else
-                    m_current_model_view_matrix.setToIdentity();
-                m_current_determinant = m_current_model_view_matrix.determinant();
-                updates |= QSGMaterialShader::RenderState::DirtyMatrix;
-            }
+        if (changeMatrix) {
+            m_currentMatrix = geomNode->matrix();
+            if (m_currentMatrix)
+                m_current_model_view_matrix = *m_currentMatrix;
+            else
+                m_current_model_view_matrix.setToIdentity();
+            m_current_determinant = m_current_model_view_matrix.determinant();
+            updates |= QSGMaterialShader::RenderState::DirtyMatrix;
+        }
 
-            bool changeOpacity = m_current_opacity != geomNode->inheritedOpacity();
-            if (changeOpacity) {
-                updates |= QSGMaterialShader::RenderState::DirtyOpacity;
-                m_current_opacity = geomNode->inheritedOpacity();
-            }
+        bool changeOpacity = m_current_opacity != geomNode->inheritedOpacity();
+        if (changeOpacity) {
+            updates |= QSGMaterialShader::RenderState::DirtyOpacity;
+            m_current_opacity = geomNode->inheritedOpacity();
+        }
 
-            Q_ASSERT(geomNode->activeMaterial());
+        Q_ASSERT(geomNode->activeMaterial());
 
-            QSGMaterial *material = geomNode->activeMaterial();
-            QSGMaterialShader *program = m_context->prepareMaterial(material);
-            Q_ASSERT(program->program()->isLinked());
+        QSGMaterial *material = geomNode->activeMaterial();
+        QSGMaterialShader *program = m_context->prepareMaterial(material);
+        Q_ASSERT(program->program()->isLinked());
 
-            bool changeClip = geomNode->clipList() != m_currentClip;
-            if (changeClip) {
-                // The clip function relies on there not being any depth testing..
-                glDisable(GL_DEPTH_TEST);
-                currentClipType = updateStencilClip(geomNode->clipList());
-                glEnable(GL_DEPTH_TEST);
-                m_currentClip = geomNode->clipList();
+        bool changeClip = geomNode->clipList() != m_currentClip;
+        if (changeClip) {
+            // The clip function relies on there not being any depth testing..
+            glDisable(GL_DEPTH_TEST);
+            m_currentClipType = updateStencilClip(geomNode->clipList());
+            glEnable(GL_DEPTH_TEST);
+            m_currentClip = geomNode->clipList();
 #ifdef FORCE_NO_REORDER
-                glDepthMask(false);
+            glDepthMask(false);
 #else
-                glDepthMask((material->flags() & QSGMaterial::Blending) == 0 && m_current_opacity == 1);
+            glDepthMask((material->flags() & QSGMaterial::Blending) == 0 && m_current_opacity == 1);
 #endif
-                //++clipChangeCount;
-            }
+        }
 
-            bool changeProgram = (changeClip && (currentClipType & StencilClip)) || m_currentProgram != program;
-            if (changeProgram) {
-                if (m_currentProgram)
-                    m_currentProgram->deactivate();
-                m_currentProgram = program;
-                m_currentProgram->activate();
-                //++programChangeCount;
-                updates |= (QSGMaterialShader::RenderState::DirtyMatrix | QSGMaterialShader::RenderState::DirtyOpacity);
+        bool changeProgram = (changeClip && (m_currentClipType & StencilClip)) || m_currentProgram != program;
+        if (changeProgram) {
+            if (m_currentProgram)
+                m_currentProgram->deactivate();
+            m_currentProgram = program;
+            m_currentProgram->activate();
+            updates |= (QSGMaterialShader::RenderState::DirtyMatrix | QSGMaterialShader::RenderState::DirtyOpacity);
 
 #ifdef RENDERER_DEBUG
-                materialChanges++;
+            materialChanges++;
 #endif
-            }
+        }
 
-            bool changeRenderOrder = currentRenderOrder != geomNode->renderOrder();
-            if (changeRenderOrder) {
-                currentRenderOrder = geomNode->renderOrder();
-                m_current_projection_matrix.setColumn(3, projection.column(3)
-                                                      + (m_currentRenderOrder - 1 - 2 * currentRenderOrder)
-                                                      * m_current_projection_matrix.column(2));
-                updates |= QSGMaterialShader::RenderState::DirtyMatrix;
-            }
+        bool changeRenderOrder = m_currentNodeRenderOrder != geomNode->renderOrder();
+        if (changeRenderOrder) {
+            m_currentNodeRenderOrder = geomNode->renderOrder();
+            m_current_projection_matrix.setColumn(3, m_projection.column(3)
+                                                  + (m_currentRenderOrder - 1 - 2 * m_currentNodeRenderOrder)
+                                                  * m_current_projection_matrix.column(2));
+            updates |= QSGMaterialShader::RenderState::DirtyMatrix;
+        }
 
-            if (changeProgram || m_currentMaterial != material) {
-                program->updateState(state(updates), material, changeProgram ? 0 : m_currentMaterial);
-                m_currentMaterial = material;
-                //++materialChangeCount;
-            }
+        if (changeProgram || m_currentMaterial != material) {
+            program->updateState(state(updates), material, changeProgram ? 0 : m_currentMaterial);
+            m_currentMaterial = material;
+        }
 
-            //glDepthRange((geomNode->renderOrder() + 0.1) * scale, (geomNode->renderOrder() + 0.9) * scale);
+        //glDepthRange((geomNode->renderOrder() + 0.1) * scale, (geomNode->renderOrder() + 0.9) * scale);
 
-            const QSGGeometry *g = geomNode->geometry();
-            draw(program, g);
+        const QSGGeometry *g = geomNode->geometry();
+        draw(program, g);
 
 #ifdef RENDERER_DEBUG
-            geometryNodesDrawn++;
+        geometryNodesDrawn++;
 #endif
-        }
     }
-    //qDebug("Clip: %i, shader program: %i, material: %i times changed while drawing %s items",
-    //    clipChangeCount, programChangeCount, materialChangeCount,
-    //    &list == &m_transparentNodes ? "transparent" : "opaque");
 }
 
 QT_END_NAMESPACE
@@ -45,6 +45,10 @@
 #include "qsgrenderer_p.h"
 
 #include <QtGui/private/qdatabuffer_p.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qmap.h>
+#include <QtCore/qset.h>
+#include <QtCore/qvector.h>
 #include "qsgrendernode_p.h"
 
 QT_BEGIN_NAMESPACE
@@ -63,8 +67,53 @@ public:
     bool isSortFrontToBackEnabled() const;
 
 private:
+    struct BucketKey
+    {
+        const QSGClipNode *clip;
+        QSGMaterialType *type;
+        bool operator<(const BucketKey &other) const {
+            return clip != other.clip ? clip < other.clip : type < other.type;
+        }
+    };
+
+    struct SortKey
+    {
+        const QSGMaterial *material;
+        const QMatrix4x4 *matrix;
+        const QSGNode *node;
+        bool operator<(const SortKey &other) const {
+            if (material != other.material)
+                return material < other.material;
+            return matrix != other.matrix ? matrix < other.matrix : node < other.node;
+        }
+    };
+
+    struct NodeInfo
+    {
+        int renderOrder;
+        bool opaque;
+        BucketKey bucket;
+        SortKey key;
+    };
+
     void buildLists(QSGNode *node);
     void renderNodes(QSGNode *const *nodes, int count);
+    void beginRenderNodes();
+    void renderNode(QSGNode *node);
+
+    // Incremental list maintenance, used while the scene contains no render nodes
+    bool buildIncrementalLists();
+    void clearIncrementalLists();
+    bool updateIncrementalLists();
+    bool collectGeometryNodes(QSGNode *node, QVector<QSGGeometryNode *> *nodes) const;
+    bool insertSubtree(QSGNode *node);
+    void removeSubtree(QSGNode *node, bool dropPending);
+    void insertNode(QSGGeometryNode *node, int renderOrder);
+    void removeNode(QSGNode *node);
+    void assignRenderOrders();
+    void renumber(QSGGeometryNode *after, const QVector<QSGGeometryNode *> &nodes);
+    QSGGeometryNode *findPrecedingNode(QSGNode *node) const;
+    QSGGeometryNode *findLastNode(QSGNode *node) const;
 
     const QSGClipNode *m_currentClip;
     QSGMaterial *m_currentMaterial;
@@ -75,9 +124,20 @@ private:
     struct RenderGroup { int opaqueEnd, transparentEnd; };
     QDataBuffer<RenderGroup> m_renderGroups;
 
+    QMap<BucketKey, QMap<SortKey, QSGNode *> > m_opaqueBuckets;
+    QMap<int, QSGNode *> m_transparentOrder;
+    QMap<int, QSGGeometryNode *> m_renderOrders;
+    QHash<QSGNode *, NodeInfo> m_nodeInfo;
+    QSet<QSGNode *> m_pendingNodes;
+
+    QMatrix4x4 m_projection;
+    ClipType m_currentClipType;
+    int m_currentNodeRenderOrder;
+
     bool m_rebuild_lists;
     bool m_sort_front_to_back;
     bool m_render_node_added;
+    bool m_incremental;
     int m_currentRenderOrder;
 
 #ifdef QML_RUNTIME_TESTING
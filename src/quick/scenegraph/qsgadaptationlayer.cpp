@@ -47,6 +47,14 @@
 #include <private/qrawfont_p.h>
 #include <QtGui/qguiapplication.h>
 #include <qdir.h>
+#include <QtCore/qcryptographichash.h>
+#include <QtCore/qdatastream.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qrunnable.h>
+#include <QtCore/qsavefile.h>
+#include <QtCore/qthread.h>
+#include <QtCore/qthreadpool.h>
 
 #include <private/qqmlprofilerservice_p.h>
 #include <QElapsedTimer>
@@ -58,6 +66,273 @@ static bool qsg_render_timing = !qgetenv("QSG_RENDER_TIMING").isEmpty();
 static QElapsedTimer qsg_render_timer;
 #endif
 
+/*
+    Distance fields can be rendered by a pool of worker threads so that new
+    text does not stall the render thread.  This is opt-in, as glyphs stay
+    invisible until their field comes back: QSG_DISTANCEFIELD_THREADS sets the
+    number of workers, and the default of 0 renders them in update() as before.
+
+    When QSG_DISTANCEFIELD_CACHE_DIR is set, rendered fields are also written
+    there, keyed by a hash of the font file and the glyph index, and read back
+    instead of being rendered again.
+*/
+class QSGDistanceFieldThreadPool : public QThreadPool
+{
+public:
+    QSGDistanceFieldThreadPool()
+    {
+        bool ok = false;
+        int threads = qgetenv("QSG_DISTANCEFIELD_THREADS").toInt(&ok);
+        setThreadCount(ok ? threads : 0);
+    }
+
+    int threadCount() const { return threads.load(); }
+    void setThreadCount(int count)
+    {
+        count = qMax(0, count);
+        setMaxThreadCount(qMax(1, count));
+        threads.store(count);
+    }
+
+private:
+    QAtomicInt threads;
+};
+
+Q_GLOBAL_STATIC(QSGDistanceFieldThreadPool, qsg_distanceFieldThreadPool)
+
+class QSGDistanceFieldGlyphResults : public QObject
+{
+    Q_OBJECT
+public:
+    QSGDistanceFieldGlyphResults() : cancelled(false) {}
+
+    void add(glyph_t glyph, const QImage &image)
+    {
+        QMutexLocker locker(&mutex);
+        bool first = ready.isEmpty();
+        ready.insert(glyph, image);
+        locker.unlock();
+
+        if (first)
+            emit glyphsReady();
+    }
+
+    QHash<glyph_t, QImage> take()
+    {
+        QMutexLocker locker(&mutex);
+        QHash<glyph_t, QImage> glyphs;
+        glyphs.swap(ready);
+        return glyphs;
+    }
+
+    void cancel()
+    {
+        QMutexLocker locker(&mutex);
+        cancelled = true;
+    }
+
+    bool isCancelled()
+    {
+        QMutexLocker locker(&mutex);
+        return cancelled;
+    }
+
+Q_SIGNALS:
+    void glyphsReady();
+
+private:
+    QMutex mutex;
+    QHash<glyph_t, QImage> ready;
+    bool cancelled;
+};
+
+static QString qsg_distanceFieldCacheFile(const QString &path, glyph_t glyph)
+{
+    if (path.isEmpty())
+        return QString();
+    return path + QLatin1Char('/') + QString::number(glyph) + QLatin1String(".df");
+}
+
+static bool qsg_readDistanceField(const QString &fileName, QImage *image)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_0);
+
+    quint32 magic = 0;
+    qint32 width = 0;
+    qint32 height = 0;
+    QByteArray data;
+    stream >> magic >> width >> height >> data;
+    if (stream.status() != QDataStream::Ok || magic != 0x51534446 || width <= 0 || height <= 0
+            || data.size() != width * height) {
+        return false;
+    }
+
+    QImage field(width, height, QImage::Format_Indexed8);
+    for (int y = 0; y < height; ++y)
+        memcpy(field.scanLine(y), data.constData() + y * width, width);
+    *image = field;
+    return true;
+}
+
+static void qsg_writeDistanceField(const QString &fileName, const QImage &image)
+{
+    QByteArray data;
+    data.resize(image.width() * image.height());
+    for (int y = 0; y < image.height(); ++y)
+        memcpy(data.data() + y * image.width(), image.constScanLine(y), image.width());
+
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly))
+        return;
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_0);
+    stream << quint32(0x51534446) << qint32(image.width()) << qint32(image.height()) << data;
+    file.commit();
+}
+
+static QImage qsg_renderDistanceField(glyph_t glyph, const QPainterPath &path, bool doubleResolution,
+                                      const QString &cacheFile)
+{
+    QImage image;
+    if (!cacheFile.isEmpty() && qsg_readDistanceField(cacheFile, &image))
+        return image;
+
+    image = QDistanceField(path, glyph, doubleResolution).toImage(QImage::Format_Indexed8);
+    if (!cacheFile.isEmpty() && !image.isNull())
+        qsg_writeDistanceField(cacheFile, image);
+    return image;
+}
+
+class QSGDistanceFieldGlyphJob : public QRunnable
+{
+public:
+    QSGDistanceFieldGlyphJob(const QSharedPointer<QSGDistanceFieldGlyphResults> &results, glyph_t glyph,
+                             const QPainterPath &path, bool doubleResolution, const QString &cacheFile)
+        : results(results), glyph(glyph), path(path), doubleResolution(doubleResolution), cacheFile(cacheFile)
+    {
+    }
+
+    void run()
+    {
+        if (results->isCancelled())
+            return;
+        results->add(glyph, qsg_renderDistanceField(glyph, path, doubleResolution, cacheFile));
+    }
+
+private:
+    QSharedPointer<QSGDistanceFieldGlyphResults> results;
+    glyph_t glyph;
+    QPainterPath path;
+    bool doubleResolution;
+    QString cacheFile;
+};
+
+struct QSGDistanceFieldDiskCache
+{
+    QSGDistanceFieldDiskCache()
+        : path(QString::fromLocal8Bit(qgetenv("QSG_DISTANCEFIELD_CACHE_DIR")))
+    {
+    }
+
+    QMutex mutex;
+    QString path;
+    // Hashing a large font file is not free, so each file is only hashed once
+    QHash<QByteArray, QByteArray> fileHashes;
+};
+
+Q_GLOBAL_STATIC(QSGDistanceFieldDiskCache, qsg_distanceFieldDiskCache)
+
+static QString qsg_distanceFieldCachePath(const QRawFont &font, bool doubleResolution)
+{
+    QSGDistanceFieldDiskCache *diskCache = qsg_distanceFieldDiskCache();
+    if (!diskCache)
+        return QString();
+
+    QMutexLocker locker(&diskCache->mutex);
+    const QString cacheDir = diskCache->path;
+    if (cacheDir.isEmpty())
+        return QString();
+
+    QFontEngine::FaceId faceId = QRawFontPrivate::get(font)->fontEngine->faceId();
+    if (faceId.filename.isEmpty())
+        return QString();
+
+    QHash<QByteArray, QByteArray> &fileHashes = diskCache->fileHashes;
+    QHash<QByteArray, QByteArray>::const_iterator it = fileHashes.constFind(faceId.filename);
+    if (it == fileHashes.constEnd()) {
+        QByteArray hash;
+        QFile file(QFile::decodeName(faceId.filename));
+        if (file.open(QIODevice::ReadOnly)) {
+            QCryptographicHash sha1(QCryptographicHash::Sha1);
+            while (!file.atEnd())
+                sha1.addData(file.read(64 * 1024));
+            hash = sha1.result().toHex();
+        }
+        it = fileHashes.insert(faceId.filename, hash);
+    }
+    if (it->isEmpty())
+        return QString();
+
+    QString path = cacheDir + QLatin1Char('/') + QString::fromLatin1(*it)
+            + QLatin1Char('-') + QString::number(faceId.index)
+            + QLatin1Char('-') + QString::number(QT_DISTANCEFIELD_SCALE(doubleResolution));
+    if (!QDir().mkpath(path))
+        return QString();
+    return path;
+}
+
+/*!
+    Returns the number of worker threads distance fields are rendered on.
+    0 means they are rendered on the render thread, in update().
+*/
+int QSGDistanceFieldGlyphCache::renderThreadCount()
+{
+    QSGDistanceFieldThreadPool *pool = qsg_distanceFieldThreadPool();
+    return pool ? pool->threadCount() : 0;
+}
+
+/*!
+    Renders distance fields on \a count worker threads, or in update() if \a count
+    is 0.  The default is 0, or the value of QSG_DISTANCEFIELD_THREADS.
+*/
+void QSGDistanceFieldGlyphCache::setRenderThreadCount(int count)
+{
+    if (QSGDistanceFieldThreadPool *pool = qsg_distanceFieldThreadPool())
+        pool->setThreadCount(count);
+}
+
+/*!
+    Returns the directory rendered distance fields are stored in, or an empty
+    string if they are not stored.
+*/
+QString QSGDistanceFieldGlyphCache::diskCachePath()
+{
+    QSGDistanceFieldDiskCache *diskCache = qsg_distanceFieldDiskCache();
+    if (!diskCache)
+        return QString();
+    QMutexLocker locker(&diskCache->mutex);
+    return diskCache->path;
+}
+
+/*!
+    Stores rendered distance fields in \a path.  The default is the value of
+    QSG_DISTANCEFIELD_CACHE_DIR.  Only glyph caches created afterwards use the
+    new path.
+*/
+void QSGDistanceFieldGlyphCache::setDiskCachePath(const QString &path)
+{
+    if (QSGDistanceFieldDiskCache *diskCache = qsg_distanceFieldDiskCache()) {
+        QMutexLocker locker(&diskCache->mutex);
+        diskCache->path = path;
+    }
+}
+
 QSGDistanceFieldGlyphCache::Texture QSGDistanceFieldGlyphCache::s_emptyTexture;
 
 QSGDistanceFieldGlyphCache::QSGDistanceFieldGlyphCache(QSGDistanceFieldGlyphCacheManager *man, QOpenGLContext *c, const QRawFont &font)
@@ -75,10 +350,19 @@ QSGDistanceFieldGlyphCache::QSGDistanceFieldGlyphCache(QSGDistanceFieldGlyphCach
     m_referenceFont = font;
     m_referenceFont.setPixelSize(QT_DISTANCEFIELD_BASEFONTSIZE(m_doubleGlyphResolution));
     Q_ASSERT(m_referenceFont.isValid());
+
+    m_renderFont = font;
+    m_renderFont.setPixelSize(QT_DISTANCEFIELD_BASEFONTSIZE(m_doubleGlyphResolution)
+                              * QT_DISTANCEFIELD_SCALE(m_doubleGlyphResolution));
+
+    m_results = QSharedPointer<QSGDistanceFieldGlyphResults>(new QSGDistanceFieldGlyphResults);
+    m_diskCachePath = qsg_distanceFieldCachePath(font, m_doubleGlyphResolution);
 }
 
 QSGDistanceFieldGlyphCache::~QSGDistanceFieldGlyphCache()
 {
+    // Jobs that already started still finish, but nobody picks up the result
+    m_results->cancel();
 }
 
 QSGDistanceFieldGlyphCache::GlyphData &QSGDistanceFieldGlyphCache::glyphData(glyph_t glyph)
@@ -159,7 +443,7 @@ void QSGDistanceFieldGlyphCache::update()
 {
     m_populatingGlyphs.clear();
 
-    if (m_pendingGlyphs.isEmpty())
+    if (m_pendingGlyphs.isEmpty() && m_renderingGlyphs.isEmpty())
         return;
 
 #ifndef QSG_NO_RENDER_TIMING
@@ -170,21 +454,40 @@ void QSGDistanceFieldGlyphCache::update()
 
     QHash<glyph_t, QImage> distanceFields;
 
+    QSGDistanceFieldThreadPool *pool = qsg_distanceFieldThreadPool();
     for (int i = 0; i < m_pendingGlyphs.size(); ++i) {
         glyph_t glyphIndex = m_pendingGlyphs.at(i);
 
-        QImage distanceField = qt_renderDistanceFieldGlyph(m_referenceFont, glyphIndex, m_doubleGlyphResolution);
-        distanceFields.insert(glyphIndex, distanceField);
+        QPainterPath path = m_renderFont.pathForGlyph(glyphIndex);
+        QString cacheFile = qsg_distanceFieldCacheFile(m_diskCachePath, glyphIndex);
+        if (pool && pool->threadCount() > 0) {
+            // The glyph stays invisible until its field comes back
+            m_renderingGlyphs.insert(glyphIndex);
+            pool->start(new QSGDistanceFieldGlyphJob(m_results, glyphIndex, path, m_doubleGlyphResolution, cacheFile));
+        } else {
+            distanceFields.insert(glyphIndex, qsg_renderDistanceField(glyphIndex, path, m_doubleGlyphResolution, cacheFile));
+        }
+    }
+
+    m_pendingGlyphs.reset();
+
+    if (!m_renderingGlyphs.isEmpty()) {
+        QHash<glyph_t, QImage> rendered = m_results->take();
+        for (QHash<glyph_t, QImage>::const_iterator it = rendered.constBegin(); it != rendered.constEnd(); ++it) {
+            if (m_renderingGlyphs.remove(it.key()))
+                distanceFields.insert(it.key(), it.value());
+        }
     }
 
 #ifndef QSG_NO_RENDER_TIMING
     qint64 renderTime = 0;
-    int count = m_pendingGlyphs.size();
+    int count = distanceFields.size();
     if (profileFrames)
         renderTime = qsg_render_timer.nsecsElapsed();
 #endif
 
-    m_pendingGlyphs.reset();
+    if (distanceFields.isEmpty())
+        return;
 
     storeGlyphs(distanceFields);
 
@@ -236,14 +539,29 @@ void QSGDistanceFieldGlyphCache::setGlyphsPosition(const QList<GlyphPosition> &g
     }
 }
 
+// Owners are asked to render again when glyphs they may be waiting for are ready
 void QSGDistanceFieldGlyphCache::registerOwnerElement(QQuickItem *ownerElement)
 {
-    Q_UNUSED(ownerElement);
+    if (!ownerElement)
+        return;
+
+    Owner &owner = m_owners[ownerElement];
+    if (owner.ref++ == 0) {
+        owner.item = ownerElement;
+        bool ok = QObject::connect(m_results.data(), SIGNAL(glyphsReady()), ownerElement, SLOT(triggerPreprocess()));
+        Q_ASSERT_X(ok, Q_FUNC_INFO, "QML element that owns a glyph node must have triggerPreprocess() slot");
+        Q_UNUSED(ok);
+    }
 }
 
 void QSGDistanceFieldGlyphCache::unregisterOwnerElement(QQuickItem *ownerElement)
 {
-    Q_UNUSED(ownerElement);
+    QHash<QQuickItem *, Owner>::iterator it = m_owners.find(ownerElement);
+    if (it != m_owners.end() && --it->ref <= 0) {
+        if (it->item)
+            QObject::disconnect(m_results.data(), SIGNAL(glyphsReady()), ownerElement, SLOT(triggerPreprocess()));
+        m_owners.erase(it);
+    }
 }
 
 void QSGDistanceFieldGlyphCache::processPendingGlyphs()
@@ -303,3 +621,5 @@ void QSGDistanceFieldGlyphCache::updateTexture(GLuint oldTex, GLuint newTex, con
 }
 
 QT_END_NAMESPACE
+
+#include "qsgadaptationlayer.moc"
@@ -55,6 +55,7 @@
 #include <QtGui/private/qdatabuffer_p.h>
 #include <private/qopenglcontext_p.h>
 #include <private/qdistancefield_p.h>
+#include <private/qqmlguard_p.h>
 
 // ### remove
 #include <QtQuick/private/qquicktext_p.h>
@@ -66,6 +67,7 @@ class QImage;
 class TextureReference;
 class QSGDistanceFieldGlyphCacheManager;
 class QSGDistanceFieldGlyphNode;
+class QSGDistanceFieldGlyphResults;
 
 class Q_QUICK_PRIVATE_EXPORT QSGRectangleNode : public QSGGeometryNode
 {
@@ -214,6 +216,11 @@ public:
     virtual void unregisterOwnerElement(QQuickItem *ownerElement);
     virtual void processPendingGlyphs();
 
+    static int renderThreadCount();
+    static void setRenderThreadCount(int count);
+    static QString diskCachePath();
+    static void setDiskCachePath(const QString &path);
+
 protected:
     struct GlyphPosition {
         glyph_t glyph;
@@ -262,6 +269,20 @@ private:
     QSet<glyph_t> m_populatingGlyphs;
     QLinkedList<QSGDistanceFieldGlyphConsumer*> m_registeredNodes;
 
+    // Glyphs handed to the worker threads, and where their distance fields
+    // come back.  Results for glyphs removed in the meantime are dropped.
+    QRawFont m_renderFont;
+    QSharedPointer<QSGDistanceFieldGlyphResults> m_results;
+    QSet<glyph_t> m_renderingGlyphs;
+    struct Owner {
+        Owner() : ref(0) {}
+
+        QQmlGuard<QQuickItem> item;
+        int ref;
+    };
+    QHash<QQuickItem *, Owner> m_owners;
+    QString m_diskCachePath;
+
     static Texture s_emptyTexture;
 };
 
@@ -280,6 +301,7 @@ inline void QSGDistanceFieldGlyphCache::removeGlyph(glyph_t glyph)
     GlyphData &gd = glyphData(glyph);
     gd.texCoord = TexCoord();
     gd.texture = &s_emptyTexture;
+    m_renderingGlyphs.remove(glyph);
 }
 
 inline bool QSGDistanceFieldGlyphCache::containsGlyph(glyph_t glyph)
@@ -41,6 +41,7 @@
 
 #include <QtQuick/private/qsgcontext_p.h>
 #include <QtQuick/private/qsgdefaultrenderer_p.h>
+#include <QtQuick/private/qsgbatchrenderer_p.h>
 #include <QtQuick/private/qsgdistancefieldutil_p.h>
 #include <QtQuick/private/qsgdefaultdistancefieldglyphcache_p.h>
 #include <QtQuick/private/qsgdefaultrectanglenode_p.h>
@@ -52,6 +53,7 @@
 #include <QtQuick/QSGFlatColorMaterial>
 
 #include <QtQuick/private/qsgtexture_p.h>
+#include <QtQuick/private/qsgatlastexture_p.h>
 #include <QtQuick/private/qquickpixmapcache_p.h>
 
 #include <QGuiApplication>
@@ -109,6 +111,7 @@ public:
         : gl(0)
         , depthStencilBufferManager(0)
         , distanceFieldCacheManager(0)
+        , atlasManager(0)
     #if !defined(QT_OPENGL_ES) || defined(QT_OPENGL_ES_2_ANGLE)
         , distanceFieldAntialiasing(QSGGlyphNode::HighQualitySubPixelAntialiasing)
     #else
@@ -116,6 +119,7 @@ public:
     #endif
         , flashMode(qmlFlashMode())
         , distanceFieldDisabled(qmlDisableDistanceField())
+        , batchRenderer(qgetenv("QSG_RENDERER") == "batch")
     {
         renderAlpha = qmlTranslucentMode() ? 0.5 : 1;
     }
@@ -131,12 +135,14 @@ public:
     QHash<QQuickTextureFactory *, QSGTexture *> textures;
     QSGDepthStencilBufferManager *depthStencilBufferManager;
     QSGDistanceFieldGlyphCacheManager *distanceFieldCacheManager;
+    QSGAtlasTexture::Manager *atlasManager;
 
     QSGDistanceFieldGlyphNode::AntialiasingMode distanceFieldAntialiasing;
 
     bool flashMode;
     float renderAlpha;
     bool distanceFieldDisabled;
+    bool batchRenderer;
 };
 
 class QSGTextureCleanupEvent : public QEvent
@@ -192,6 +198,8 @@ void QSGContext::invalidate()
     d->depthStencilBufferManager = 0;
     delete d->distanceFieldCacheManager;
     d->distanceFieldCacheManager = 0;
+    delete d->atlasManager;
+    d->atlasManager = 0;
 
     d->gl = 0;
 
@@ -208,8 +216,14 @@ QSGTexture *QSGContext::textureForFactory(QQuickTextureFactory *factory, QQuickW
     d->textureMutex.lock();
     QSGTexture *texture = d->textures.value(factory);
     if (!texture) {
-        if (QQuickDefaultTextureFactory *dtf = qobject_cast<QQuickDefaultTextureFactory *>(factory))
-            texture = createTexture(dtf->image());
+        if (QQuickDefaultTextureFactory *dtf = qobject_cast<QQuickDefaultTextureFactory *>(factory)) {
+            // Images from the pixmap cache are only drawn through image nodes,
+            // which respect the texture's sub rect, so they can go into the atlas.
+            if (d->atlasManager)
+                texture = d->atlasManager->create(dtf->image());
+            if (!texture)
+                texture = createTexture(dtf->image());
+        }
         else
             texture = factory->createTexture(window);
         d->textures.insert(factory, texture);
@@ -263,6 +277,8 @@ void QSGContext::initialize(QOpenGLContext *context)
     Q_ASSERT(!d->gl);
     d->gl = context;
 
+    d->atlasManager = new QSGAtlasTexture::Manager();
+
     precompileMaterials();
 
     emit initialized();
@@ -411,9 +427,14 @@ QSGGlyphNode *QSGContext::createGlyphNode()
 
     The renderers are used for the toplevel renderer and once for every
     QQuickShaderEffectSource used in the QML scene.
+
+    \sa setBatchRendererEnabled()
  */
 QSGRenderer *QSGContext::createRenderer()
 {
+    Q_D(QSGContext);
+    if (d->batchRenderer)
+        return new QSGBatchRenderer(this);
     return new QSGDefaultRenderer(this);
 }
 
@@ -602,6 +623,30 @@ bool QSGContext::isDistanceFieldEnabled() const
 
 
 
+/*!
+    Sets whether renderers created from now on should merge compatible
+    geometry nodes into batches. The default is taken from the QSG_RENDERER
+    environment variable being set to "batch".
+
+    \sa createRenderer()
+ */
+void QSGContext::setBatchRendererEnabled(bool enabled)
+{
+    d_func()->batchRenderer = enabled;
+}
+
+
+/*!
+    Returns true if renderers created by this context merge compatible
+    geometry nodes into batches.
+ */
+bool QSGContext::isBatchRendererEnabled() const
+{
+    return d_func()->batchRenderer;
+}
+
+
+
 /*!
     Creates a new animation driver.
  */
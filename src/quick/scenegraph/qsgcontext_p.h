@@ -123,6 +123,9 @@ public:
     void setDistanceFieldEnabled(bool enabled);
     bool isDistanceFieldEnabled() const;
 
+    void setBatchRendererEnabled(bool enabled);
+    bool isBatchRendererEnabled() const;
+
     virtual QAnimationDriver *createAnimationDriver(QObject *parent);
 
     static QQuickTextureFactory *createTextureFactoryFromImage(const QImage &image);
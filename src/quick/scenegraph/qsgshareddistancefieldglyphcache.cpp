@@ -387,6 +387,8 @@ void QSGSharedDistanceFieldGlyphCache::releaseGlyphs(const QSet<glyph_t> &glyphs
 
 void QSGSharedDistanceFieldGlyphCache::registerOwnerElement(QQuickItem *ownerElement)
 {
+    QSGDistanceFieldGlyphCache::registerOwnerElement(ownerElement);
+
     Owner &owner = m_registeredOwners[ownerElement];
     if (owner.ref == 0) {
         owner.item = ownerElement;
@@ -400,6 +402,8 @@ void QSGSharedDistanceFieldGlyphCache::registerOwnerElement(QQuickItem *ownerEle
 
 void QSGSharedDistanceFieldGlyphCache::unregisterOwnerElement(QQuickItem *ownerElement)
 {
+    QSGDistanceFieldGlyphCache::unregisterOwnerElement(ownerElement);
+
     QHash<QQuickItem *, Owner>::iterator it = m_registeredOwners.find(ownerElement);
     if (it != m_registeredOwners.end() && --it->ref <= 0) {
         if (it->item)
@@ -2,6 +2,7 @@
 
 # Core API
 HEADERS += \
+    $$PWD/coreapi/qsgbatchrenderer_p.h \
     $$PWD/coreapi/qsgdefaultrenderer_p.h \
     $$PWD/coreapi/qsggeometry.h \
     $$PWD/coreapi/qsgmaterial.h \
@@ -13,6 +14,7 @@ HEADERS += \
     $$PWD/coreapi/qsggeometry_p.h
 
 SOURCES += \
+    $$PWD/coreapi/qsgbatchrenderer.cpp \
     $$PWD/coreapi/qsgdefaultrenderer.cpp \
     $$PWD/coreapi/qsggeometry.cpp \
     $$PWD/coreapi/qsgmaterial.cpp \
@@ -25,6 +27,7 @@ SOURCES += \
 # Util API
 HEADERS += \
     $$PWD/util/qsgareaallocator_p.h \
+    $$PWD/util/qsgatlastexture_p.h \
     $$PWD/util/qsgdepthstencilbuffer_p.h \
     $$PWD/util/qsgflatcolormaterial.h \
     $$PWD/util/qsgsimplematerial.h \
@@ -41,6 +44,7 @@ HEADERS += \
 
 SOURCES += \
     $$PWD/util/qsgareaallocator.cpp \
+    $$PWD/util/qsgatlastexture.cpp \
     $$PWD/util/qsgdepthstencilbuffer.cpp \
     $$PWD/util/qsgflatcolormaterial.cpp \
     $$PWD/util/qsgsimplerectnode.cpp \
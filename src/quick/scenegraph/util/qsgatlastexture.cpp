@@ -0,0 +1,396 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the QtQuick module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qsgatlastexture_p.h"
+
+#include <QtCore/QElapsedTimer>
+
+#include <QtGui/QOpenGLContext>
+
+#include <private/qqmlprofilerservice_p.h>
+
+QT_BEGIN_NAMESPACE
+
+#ifndef GL_BGRA
+#define GL_BGRA 0x80E1
+#endif
+
+extern void qsg_swizzleBGRAToRGBA(QImage *image);
+
+namespace QSGAtlasTexture
+{
+
+#ifndef QSG_NO_RENDER_TIMING
+static bool qsg_render_timing = !qgetenv("QSG_RENDER_TIMING").isEmpty();
+static QElapsedTimer qsg_renderer_timer;
+#endif
+
+static int qsg_envInt(const char *name, int defaultValue)
+{
+    QByteArray content = qgetenv(name);
+
+    bool ok = false;
+    int value = content.toInt(&ok);
+    return ok ? value : defaultValue;
+}
+
+/*!
+    \class QSGAtlasTexture::Manager
+    \internal
+
+    The manager packs small images into a few large textures, so that items
+    showing different images can share one texture and be drawn without
+    texture switches in between, and so that the renderer can merge them.
+
+    The atlas size can be set with QSG_ATLAS_WIDTH and QSG_ATLAS_HEIGHT.
+    Images larger than QSG_ATLAS_SIZE_LIMIT in either dimension get a texture
+    of their own; setting it to 0 disables the atlas. At most
+    QSG_ATLAS_COUNT atlases are kept alive at the same time.
+ */
+
+Manager::Manager()
+    : m_atlas_size_limit(0)
+    , m_max_atlases(0)
+{
+    int maxTextureSize = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
+
+    int w = qMin(maxTextureSize, qsg_envInt("QSG_ATLAS_WIDTH", 1024));
+    int h = qMin(maxTextureSize, qsg_envInt("QSG_ATLAS_HEIGHT", 1024));
+
+    m_atlas_size = QSize(w, h);
+    m_atlas_size_limit = qsg_envInt("QSG_ATLAS_SIZE_LIMIT", qMax(w, h) / 4);
+    m_max_atlases = qsg_envInt("QSG_ATLAS_COUNT", 4);
+}
+
+
+Manager::~Manager()
+{
+    invalidate();
+}
+
+/*!
+    Releases the atlas textures. Atlases which still have textures in them
+    are detached from the manager and live on until their last texture is
+    deleted, as textures can outlive the context, for instance when their
+    providers are deleted later.
+ */
+void Manager::invalidate()
+{
+    for (int i = 0; i < m_atlases.size(); ++i)
+        m_atlases.at(i)->detach();
+    m_atlases.clear();
+}
+
+/*!
+    Returns a texture for \a image inside one of the atlases, or 0 if the
+    image is too large or there is no space left for it.
+ */
+QSGTexture *Manager::create(const QImage &image)
+{
+    if (image.isNull()
+            || image.width() > m_atlas_size_limit
+            || image.height() > m_atlas_size_limit)
+        return 0;
+
+    for (int i = 0; i < m_atlases.size(); ++i) {
+        if (Texture *t = m_atlases.at(i)->create(image))
+            return t;
+    }
+
+    if (m_atlases.size() >= m_max_atlases)
+        return 0;
+
+    Atlas *atlas = new Atlas(this, m_atlas_size);
+    m_atlases << atlas;
+    return atlas->create(image);
+}
+
+/*!
+    Called when the last texture in \a atlas is removed. Only the first atlas
+    is kept around, the others are released so that a burst of images does
+    not keep its texture memory alive forever.
+ */
+void Manager::atlasEmptied(Atlas *atlas)
+{
+    int index = m_atlases.indexOf(atlas);
+    if (index <= 0)
+        return;
+    m_atlases.removeAt(index);
+    delete atlas;
+}
+
+
+
+Atlas::Atlas(Manager *manager, const QSize &size)
+    : m_manager(manager)
+    , m_allocator(size)
+    , m_texture_id(0)
+    , m_size(size)
+    , m_allocated(false)
+    , m_use_bgra_fallback(false)
+    , m_filtering(QSGTexture::None)
+{
+    m_internalFormat = GL_RGBA;
+    m_externalFormat = GL_BGRA;
+
+#ifdef QT_OPENGL_ES
+    const char *ext = (const char *) glGetString(GL_EXTENSIONS);
+    if (strstr(ext, "GL_EXT_bgra")
+            || strstr(ext, "GL_EXT_texture_format_BGRA8888")
+            || strstr(ext, "GL_IMG_texture_format_BGRA8888")) {
+        m_internalFormat = m_externalFormat = GL_BGRA;
+    } else {
+        m_externalFormat = GL_RGBA;
+        m_use_bgra_fallback = true;
+    }
+#endif
+}
+
+Atlas::~Atlas()
+{
+    Q_ASSERT(m_pending_uploads.isEmpty());
+    invalidate();
+}
+
+void Atlas::invalidate()
+{
+    if (m_texture_id && QOpenGLContext::currentContext())
+        glDeleteTextures(1, &m_texture_id);
+    m_texture_id = 0;
+    m_allocated = false;
+}
+
+/*!
+    Releases the texture and detaches the atlas from its manager. Images
+    which were not uploaded yet are dropped. The atlas deletes itself once
+    the last texture in it is removed, or right away if it is empty.
+ */
+void Atlas::detach()
+{
+    invalidate();
+    m_manager = 0;
+    m_pending_uploads.clear();
+    if (m_allocator.isEmpty())
+        delete this;
+}
+
+int Atlas::textureId() const
+{
+    // A detached atlas has no context to create a texture in
+    if (!m_texture_id && m_manager)
+        glGenTextures(1, &const_cast<Atlas *>(this)->m_texture_id);
+    return m_texture_id;
+}
+
+/*!
+    Allocates a one pixel wider area than needed for \a image on each side.
+    The border is filled with the edge pixels, so that linear filtering at
+    the edges of the image does not pick up its neighbours in the atlas.
+ */
+Texture *Atlas::create(const QImage &image)
+{
+    QRect rect = m_allocator.allocate(QSize(image.width() + 2, image.height() + 2));
+    if (rect.width() > 0 && rect.height() > 0) {
+        Texture *t = new Texture(this, rect, image);
+        m_pending_uploads << t;
+        return t;
+    }
+    return 0;
+}
+
+void Atlas::remove(Texture *t)
+{
+    m_allocator.deallocate(t->atlasSubRectWithPadding());
+    int index = m_pending_uploads.indexOf(t);
+    if (index >= 0)
+        m_pending_uploads.remove(index);
+    if (m_allocator.isEmpty()) {
+        if (m_manager)
+            m_manager->atlasEmptied(this);
+        else
+            delete this;
+    }
+}
+
+void Atlas::upload(Texture *texture)
+{
+    const QImage &image = texture->image();
+    const QRect &r = texture->atlasSubRectWithPadding();
+
+    QImage tmp(r.width(), r.height(), QImage::Format_ARGB32_Premultiplied);
+    {
+        QImage src = image.format() == QImage::Format_ARGB32_Premultiplied
+                || image.format() == QImage::Format_RGB32
+                ? image
+                : image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+
+        const int w = src.width();
+        const int h = src.height();
+        for (int y = 0; y < h; ++y) {
+            const quint32 *s = reinterpret_cast<const quint32 *>(src.constScanLine(y));
+            quint32 *d = reinterpret_cast<quint32 *>(tmp.scanLine(y + 1));
+            d[0] = s[0];
+            memcpy(d + 1, s, w * sizeof(quint32));
+            d[w + 1] = s[w - 1];
+        }
+        // RGB32 stores 0xff in the alpha byte, so the result is opaque either way.
+        memcpy(tmp.scanLine(0), tmp.constScanLine(1), tmp.bytesPerLine());
+        memcpy(tmp.scanLine(h + 1), tmp.constScanLine(h), tmp.bytesPerLine());
+    }
+
+    if (m_use_bgra_fallback)
+        qsg_swizzleBGRAToRGBA(&tmp);
+
+    glTexSubImage2D(GL_TEXTURE_2D, 0,
+                    r.x(), r.y(), r.width(), r.height(),
+                    m_externalFormat, GL_UNSIGNED_BYTE, tmp.constBits());
+}
+
+void Atlas::bind(QSGTexture::Filtering filtering)
+{
+    if (!m_manager)
+        return;
+
+    bool forceFiltering = false;
+    if (!m_allocated) {
+        m_allocated = true;
+
+        glBindTexture(GL_TEXTURE_2D, textureId());
+        glTexImage2D(GL_TEXTURE_2D, 0, m_internalFormat, m_size.width(), m_size.height(), 0, m_externalFormat, GL_UNSIGNED_BYTE, 0);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        forceFiltering = true;
+    } else {
+        glBindTexture(GL_TEXTURE_2D, m_texture_id);
+    }
+
+    if (!m_pending_uploads.isEmpty()) {
+#ifndef QSG_NO_RENDER_TIMING
+        bool profileFrames = qsg_render_timing || QQmlProfilerService::enabled;
+        if (profileFrames)
+            qsg_renderer_timer.start();
+#endif
+
+        for (int i = 0; i < m_pending_uploads.size(); ++i)
+            upload(m_pending_uploads.at(i));
+
+#ifndef QSG_NO_RENDER_TIMING
+        if (qsg_render_timing) {
+            printf("   - AtlasTexture(%dx%d), uploaded %d textures in %dms\n",
+                   m_size.width(), m_size.height(),
+                   m_pending_uploads.size(),
+                   (int) qsg_renderer_timer.elapsed());
+        }
+        if (QQmlProfilerService::enabled) {
+            QQmlProfilerService::sceneGraphFrame(
+                        QQmlProfilerService::SceneGraphTexturePrepare,
+                        0,  // bind (not relevant)
+                        0,  // convert (not relevant)
+                        0,  // swizzle (not relevant)
+                        qsg_renderer_timer.nsecsElapsed(), // (upload all of the above)
+                        0); // mipmap (not used ever...)
+        }
+#endif
+
+        m_pending_uploads.clear();
+    }
+
+    if (forceFiltering || uint(filtering) != m_filtering) {
+        GLint filter = filtering == QSGTexture::Linear ? GL_LINEAR : GL_NEAREST;
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
+        m_filtering = filtering;
+    }
+}
+
+
+
+/*!
+    \class QSGAtlasTexture::Texture
+    \internal
+
+    A sub rectangle of an atlas. The image is kept for removedFromAtlas().
+ */
+
+Texture::Texture(Atlas *atlas, const QRect &textureRect, const QImage &image)
+    : QSGTexture()
+    , m_allocated_rect(textureRect)
+    , m_image(image)
+    , m_atlas(atlas)
+    , m_nonatlas_texture(0)
+    , m_has_alpha(image.hasAlphaChannel())
+{
+    m_allocated_rect_without_padding = m_allocated_rect.adjusted(1, 1, -1, -1);
+    float w = atlas->size().width();
+    float h = atlas->size().height();
+
+    m_texture_coords_rect = QRectF(m_allocated_rect_without_padding.x() / w,
+                                   m_allocated_rect_without_padding.y() / h,
+                                   m_allocated_rect_without_padding.width() / w,
+                                   m_allocated_rect_without_padding.height() / h);
+}
+
+Texture::~Texture()
+{
+    m_atlas->remove(this);
+    if (m_nonatlas_texture)
+        delete m_nonatlas_texture;
+}
+
+void Texture::bind()
+{
+    m_atlas->bind(filtering());
+}
+
+QSGTexture *Texture::removedFromAtlas() const
+{
+    if (!m_nonatlas_texture) {
+        m_nonatlas_texture = new QSGPlainTexture;
+        m_nonatlas_texture->setImage(m_image);
+        m_nonatlas_texture->setFiltering(filtering());
+    }
+    return m_nonatlas_texture;
+}
+
+}
+
+QT_END_NAMESPACE
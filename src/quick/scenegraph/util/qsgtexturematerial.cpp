@@ -117,7 +117,9 @@ void QSGOpaqueTextureMaterialShader::updateState(const RenderState &state, QSGMa
     }
     t->setMipmapFiltering(tx->mipmapFiltering());
 
-    if (oldTx == 0 || oldTx->texture()->textureId() != t->textureId())
+    // Textures in an atlas share their id, but each carries its own filtering,
+    // which is only applied to the shared texture in bind().
+    if (oldTx == 0 || oldTx->texture()->textureId() != t->textureId() || t->isAtlasTexture())
         t->bind();
     else
         t->updateBindOptions();
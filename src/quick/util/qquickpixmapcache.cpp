@@ -59,7 +59,15 @@
 #include <QNetworkReply>
 #include <QPixmapCache>
 #include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QSaveFile>
+#include <QCryptographicHash>
 #include <QThread>
+#include <QElapsedTimer>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QSet>
 #include <QMutex>
 #include <QMutexLocker>
 #include <QWaitCondition>
@@ -73,10 +81,22 @@
 
 #include <private/qqmlprofilerservice_p.h>
 
+#if defined(Q_OS_UNIX)
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 #define IMAGEREQUEST_MAX_REQUEST_COUNT       8
 #define IMAGEREQUEST_MAX_REDIRECT_RECURSION 16
+#define CACHE_LIMIT_KB 2048
 #define CACHE_EXPIRE_TIME 30
 #define CACHE_REMOVAL_FRACTION 4
+#define DISK_CACHE_MAGIC 0x51504358 // "QPCX"
+#define DISK_CACHE_VERSION 1
+#define DISK_CACHE_LIMIT_KB (64 * 1024)
 
 QT_BEGIN_NAMESPACE
 
@@ -85,8 +105,19 @@ QT_BEGIN_NAMESPACE
 static bool qsg_leak_check = !qgetenv("QML_LEAK_CHECK").isEmpty();
 #endif
 
-// The cache limit describes the maximum "junk" in the cache.
-static int cache_limit = 2048 * 1024; // 2048 KB cache limit for embedded in qpixmapcache.cpp
+// QML_IMAGE_DECODING_THREADS=n sets the default number of threads each engine
+// decodes images on.  Zero or a negative value uses one thread per core.
+static int defaultDecodingThreadCount()
+{
+    static int count = -1;
+    if (count == -1) {
+        bool ok = false;
+        count = qgetenv("QML_IMAGE_DECODING_THREADS").toInt(&ok);
+        if (!ok || count <= 0)
+            count = qMax(1, QThread::idealThreadCount());
+    }
+    return count;
+}
 
 static inline QString imageProviderId(const QUrl &url)
 {
@@ -137,13 +168,17 @@ public:
     QQuickPixmapReply(QQuickPixmapData *);
     ~QQuickPixmapReply();
 
+    enum Source { Provider, LocalFile, Network };
+
     QQuickPixmapData *data;
     QQmlEngine *engineForReader; // always access reader inside readerMutex
     QSize requestSize;
     QUrl url;
+    Source source;
 
     bool loading;
     int redirectCount;
+    int priority; // always access inside the reader's mutex
 
     class Event : public QEvent {
     public:
@@ -184,6 +219,24 @@ private:
     QQuickPixmapReader *reader;
 };
 
+class QQuickPixmapDecodeJob : public QRunnable
+{
+public:
+    QQuickPixmapDecodeJob(QQuickPixmapReader *reader, QQuickPixmapReply *reply, const QUrl &url,
+                          const QSize &requestSize, const QString &localFile, const QByteArray &data)
+        : reader(reader), reply(reply), url(url), requestSize(requestSize), localFile(localFile), data(data) {}
+
+    void run();
+
+private:
+    QQuickPixmapReader *reader;
+    QQuickPixmapReply *reply;
+    QUrl url;
+    QSize requestSize;
+    QString localFile;
+    QByteArray data;
+};
+
 class QQuickPixmapData;
 class QQuickPixmapReader : public QThread
 {
@@ -194,6 +247,10 @@ public:
 
     QQuickPixmapReply *getImage(QQuickPixmapData *);
     void cancel(QQuickPixmapReply *rep);
+    void setPriority(QQuickPixmapReply *rep, int priority);
+
+    int decodingThreadCount() const;
+    void setDecodingThreadCount(int count);
 
     static QQuickPixmapReader *instance(QQmlEngine *engine);
     static QQuickPixmapReader *existingInstance(QQmlEngine *engine);
@@ -203,12 +260,19 @@ protected:
 
 private:
     friend class QQuickPixmapReaderThreadObject;
+    friend class QQuickPixmapDecodeJob;
     void processJobs();
     void processJob(QQuickPixmapReply *, const QUrl &, const QSize &);
     void networkRequestDone(QNetworkReply *);
+    QQuickPixmapReply *takeNextJob();
+    void startDecoding(QQuickPixmapReply *, const QUrl &, const QSize &, const QString &, const QByteArray &);
 
     QList<QQuickPixmapReply*> jobs;
     QList<QQuickPixmapReply*> cancelled;
+    // Replies whose image is queued or being decoded on decodePool.  These
+    // are only deleted once their decode job has finished with them.
+    QSet<QQuickPixmapReply*> decoding;
+    QThreadPool decodePool;
     QQmlEngine *engine;
     QObject *eventLoopQuitHack;
 
@@ -236,7 +300,7 @@ public:
     QQuickPixmapData(QQuickPixmap *pixmap, const QUrl &u, const QSize &s, const QString &e)
     : refCount(1), inCache(false), pixmapStatus(QQuickPixmap::Error), 
       url(u), errorString(e), requestSize(s), textureFactory(0), reply(0), prevUnreferenced(0),
-      prevUnreferencedPtr(0), nextUnreferenced(0)
+      prevUnreferencedPtr(0), nextUnreferenced(0), unreferencedTime(0)
     {
         declarativePixmaps.insert(pixmap);
     }
@@ -244,7 +308,7 @@ public:
     QQuickPixmapData(QQuickPixmap *pixmap, const QUrl &u, const QSize &r)
     : refCount(1), inCache(false), pixmapStatus(QQuickPixmap::Loading), 
       url(u), requestSize(r), textureFactory(0), reply(0), prevUnreferenced(0), prevUnreferencedPtr(0),
-      nextUnreferenced(0)
+      nextUnreferenced(0), unreferencedTime(0)
     {
         declarativePixmaps.insert(pixmap);
     }
@@ -252,7 +316,7 @@ public:
     QQuickPixmapData(QQuickPixmap *pixmap, const QUrl &u, QQuickTextureFactory *texture, const QSize &s, const QSize &r)
     : refCount(1), inCache(false), pixmapStatus(QQuickPixmap::Ready),
       url(u), implicitSize(s), requestSize(r), textureFactory(texture), reply(0), prevUnreferenced(0),
-      prevUnreferencedPtr(0), nextUnreferenced(0)
+      prevUnreferencedPtr(0), nextUnreferenced(0), unreferencedTime(0)
     {
         declarativePixmaps.insert(pixmap);
     }
@@ -260,7 +324,7 @@ public:
     QQuickPixmapData(QQuickPixmap *pixmap, QQuickTextureFactory *texture)
     : refCount(1), inCache(false), pixmapStatus(QQuickPixmap::Ready),
       textureFactory(texture), reply(0), prevUnreferenced(0),
-      prevUnreferencedPtr(0), nextUnreferenced(0)
+      prevUnreferencedPtr(0), nextUnreferenced(0), unreferencedTime(0)
     {
         if (texture)
             requestSize = implicitSize = texture->textureSize();
@@ -301,6 +365,7 @@ public:
     QQuickPixmapData *prevUnreferenced;
     QQuickPixmapData**prevUnreferencedPtr;
     QQuickPixmapData *nextUnreferenced;
+    qint64 unreferencedTime;
 };
 
 int QQuickPixmapReply::finishedIndex = -1;
@@ -377,12 +442,234 @@ static bool readImage(const QUrl& url, QIODevice *dev, QImage *image, QString *e
     }
 }
 
+// The disk cache keeps decoded, already scaled images of local files, in a
+// format that can be mapped straight into a QImage.  It is shared by all
+// engines and is read from the decoding threads.
+struct QQuickPixmapDiskCache
+{
+    QQuickPixmapDiskCache()
+        : path(QString::fromLocal8Bit(qgetenv("QML_IMAGE_CACHE_DIR"))), created(false),
+          limit(DISK_CACHE_LIMIT_KB * 1024), used(-1)
+    {
+        // QML_IMAGE_CACHE_LIMIT (in kilobytes) overrides the default size
+        bool ok = false;
+        int kilobytes = qgetenv("QML_IMAGE_CACHE_LIMIT").toInt(&ok);
+        if (ok && kilobytes >= 0)
+            limit = kilobytes * 1024;
+    }
+
+    QMutex mutex;
+    QString path;
+    bool created;
+    int limit;
+    qint64 used; // Bytes in the cache directory, or -1 until it is scanned
+};
+Q_GLOBAL_STATIC(QQuickPixmapDiskCache, pixmapDiskCache);
+
+// Native byte order and layout; a cache file is never shared between machines
+struct QQuickPixmapDiskCacheHeader
+{
+    qint32 magic;
+    qint32 version;
+    qint32 format;
+    qint32 width;
+    qint32 height;
+    qint32 bytesPerLine;
+    qint32 implicitWidth;
+    qint32 implicitHeight;
+};
+
+// Entries are keyed by the file's path, size and modification time, and by
+// the requested size.  Files without a modification time, such as those in
+// resources, are not cached.
+static QString diskCacheFileName(const QString &localFile, const QSize &requestSize)
+{
+    QQuickPixmapDiskCache *cache = pixmapDiskCache();
+    QMutexLocker locker(&cache->mutex);
+    if (cache->path.isEmpty())
+        return QString();
+
+    QFileInfo info(localFile);
+    const QDateTime modified = info.lastModified();
+    if (!modified.isValid())
+        return QString();
+
+    if (!cache->created) {
+        if (!QDir().mkpath(cache->path))
+            return QString();
+        cache->created = true;
+    }
+
+    QCryptographicHash sha1(QCryptographicHash::Sha1);
+    sha1.addData(info.absoluteFilePath().toUtf8());
+    sha1.addData(QByteArray::number(info.size()));
+    sha1.addData(QByteArray::number(modified.toMSecsSinceEpoch()));
+    sha1.addData(QByteArray::number(requestSize.width()) + 'x' + QByteArray::number(requestSize.height()));
+    return cache->path + QLatin1Char('/') + QString::fromLatin1(sha1.result().toHex()) + QLatin1String(".qpx");
+}
+
+static bool isValidDiskCacheFile(const QQuickPixmapDiskCacheHeader &header, qint64 size)
+{
+    return header.magic == DISK_CACHE_MAGIC && header.version == DISK_CACHE_VERSION
+            && (header.format == QImage::Format_RGB32 || header.format == QImage::Format_ARGB32_Premultiplied)
+            && header.width > 0 && header.height > 0 && header.bytesPerLine >= header.width * 4
+            && size == qint64(sizeof(header)) + qint64(header.bytesPerLine) * header.height;
+}
+
+#if defined(Q_OS_UNIX)
+struct QQuickPixmapDiskCacheMapping
+{
+    void *data;
+    size_t size;
+};
+
+static void unmapDiskCacheFile(void *mapping)
+{
+    QQuickPixmapDiskCacheMapping *m = static_cast<QQuickPixmapDiskCacheMapping *>(mapping);
+    ::munmap(m->data, m->size);
+    delete m;
+}
+
+static bool readDiskCache(const QString &fileName, QImage *image, QSize *impsize)
+{
+    int fd = ::open(QFile::encodeName(fileName).constData(), O_RDONLY);
+    if (fd == -1)
+        return false;
+
+    // The mapping outlives the descriptor, so no file stays open per image
+    struct stat statBuf;
+    qint64 size = 0;
+    void *data = MAP_FAILED;
+    if (::fstat(fd, &statBuf) == 0 && statBuf.st_size > qint64(sizeof(QQuickPixmapDiskCacheHeader))) {
+        size = statBuf.st_size;
+        data = ::mmap(0, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    ::close(fd);
+    if (data == MAP_FAILED)
+        return false;
+
+    QQuickPixmapDiskCacheHeader header;
+    memcpy(&header, data, sizeof(header));
+    if (!isValidDiskCacheFile(header, size)) {
+        ::munmap(data, size);
+        return false;
+    }
+
+    // The image refers to the mapped pixels, and unmaps them once it is released
+    QQuickPixmapDiskCacheMapping *mapping = new QQuickPixmapDiskCacheMapping;
+    mapping->data = data;
+    mapping->size = size;
+    *image = QImage(static_cast<const uchar *>(data) + sizeof(header), header.width, header.height,
+                    header.bytesPerLine, QImage::Format(header.format), unmapDiskCacheFile, mapping);
+    if (impsize)
+        *impsize = QSize(header.implicitWidth, header.implicitHeight);
+    return true;
+}
+#else
+static bool readDiskCache(const QString &fileName, QImage *image, QSize *impsize)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QQuickPixmapDiskCacheHeader header;
+    if (file.read(reinterpret_cast<char *>(&header), sizeof(header)) != qint64(sizeof(header))
+            || !isValidDiskCacheFile(header, file.size()))
+        return false;
+
+    QImage result(header.width, header.height, QImage::Format(header.format));
+    if (result.bytesPerLine() != header.bytesPerLine
+            || file.read(reinterpret_cast<char *>(result.bits()), result.byteCount()) != result.byteCount())
+        return false;
+
+    *image = result;
+    if (impsize)
+        *impsize = QSize(header.implicitWidth, header.implicitHeight);
+    return true;
+}
+#endif
+
+// Removes the least recently written entries, other than keep, once the
+// cache has grown past its limit.  Called with the cache mutex locked.
+static void pruneDiskCache(QQuickPixmapDiskCache *cache, const QString &keep = QString())
+{
+    if (cache->path.isEmpty() || (cache->used >= 0 && cache->used <= cache->limit))
+        return;
+
+    const QFileInfoList entries = QDir(cache->path).entryInfoList(QStringList(QLatin1String("*.qpx")),
+                                                                  QDir::Files, QDir::Time | QDir::Reversed);
+    cache->used = 0;
+    for (int ii = 0; ii < entries.count(); ++ii)
+        cache->used += entries.at(ii).size();
+
+    // Prune below the limit, so that the next few writes don't prune again
+    const qint64 target = qint64(cache->limit) * 3 / 4;
+    for (int ii = 0; ii < entries.count() && cache->used > target; ++ii) {
+        const QFileInfo &entry = entries.at(ii);
+        if (entry.absoluteFilePath() != keep && QFile::remove(entry.absoluteFilePath()))
+            cache->used -= entry.size();
+    }
+}
+
+static void writeDiskCache(const QString &fileName, const QImage &image, const QSize &implicitSize)
+{
+    const qint64 size = qint64(sizeof(QQuickPixmapDiskCacheHeader)) + image.byteCount();
+
+    QQuickPixmapDiskCache *cache = pixmapDiskCache();
+    {
+        QMutexLocker locker(&cache->mutex);
+        if (size > cache->limit)
+            return;
+    }
+
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly))
+        return;
+
+    const QQuickPixmapDiskCacheHeader header = {
+        DISK_CACHE_MAGIC, DISK_CACHE_VERSION, image.format(), image.width(), image.height(),
+        image.bytesPerLine(), implicitSize.width(), implicitSize.height()
+    };
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(image.constBits()), image.byteCount());
+    if (!file.commit())
+        return;
+
+    QMutexLocker locker(&cache->mutex);
+    if (cache->used >= 0)
+        cache->used += size;
+    pruneDiskCache(cache, QFileInfo(fileName).absoluteFilePath());
+}
+
+// Reads a local image file, going through the disk cache if one is set.
+static bool readLocalImage(const QUrl &url, QFile *file, QImage *image, QString *errorString, QSize *impsize,
+                           const QSize &requestSize)
+{
+    const QString cacheFile = diskCacheFileName(file->fileName(), requestSize);
+    if (!cacheFile.isEmpty() && readDiskCache(cacheFile, image, impsize))
+        return true;
+
+    if (!readImage(url, file, image, errorString, impsize, requestSize))
+        return false;
+
+    if (!cacheFile.isEmpty()) {
+        // Store the image in the format the texture factory would convert it to anyway
+        const QImage::Format format = image->hasAlphaChannel() ? QImage::Format_ARGB32_Premultiplied
+                                                               : QImage::Format_RGB32;
+        if (image->format() != format)
+            *image = image->convertToFormat(format);
+        writeDiskCache(cacheFile, *image, impsize ? *impsize : image->size());
+    }
+    return true;
+}
+
 QQuickPixmapReader::QQuickPixmapReader(QQmlEngine *eng)
 : QThread(eng), engine(eng), threadObject(0), accessManager(0)
 {
     eventLoopQuitHack = new QObject;
     eventLoopQuitHack->moveToThread(this);
     connect(eventLoopQuitHack, SIGNAL(destroyed(QObject*)), SLOT(quit()), Qt::DirectConnection);
+    decodePool.setMaxThreadCount(defaultDecodingThreadCount());
     start(QThread::LowestPriority);
 }
 
@@ -400,13 +687,20 @@ QQuickPixmapReader::~QQuickPixmapReader()
         delete reply;
     }
     jobs.clear();
-    QList<QQuickPixmapReply*> activeJobs = replies.values();
+    QList<QQuickPixmapReply*> activeJobs = replies.values() + decoding.toList();
     foreach (QQuickPixmapReply *reply, activeJobs) {
         if (reply->loading) {
             cancelled.append(reply);
             reply->data = 0;
         }
     }
+    mutex.unlock();
+
+    // Decode jobs that have already started run to completion, but no longer
+    // post their results.
+    decodePool.waitForDone();
+
+    mutex.lock();
     if (threadObject) threadObject->processJobs();
     mutex.unlock();
 
@@ -438,25 +732,15 @@ void QQuickPixmapReader::networkRequestDone(QNetworkReply *reply)
             }
         }
 
-        QImage image;
-        QQuickPixmapReply::ReadError error = QQuickPixmapReply::NoError;
-        QString errorString;
-        QSize readSize;
         if (reply->error()) {
-            error = QQuickPixmapReply::Loading;
-            errorString = reply->errorString();
+            // send completion event to the QQuickPixmapReply
+            mutex.lock();
+            if (!cancelled.contains(job))
+                job->postReply(QQuickPixmapReply::Loading, reply->errorString(), QSize(), 0);
+            mutex.unlock();
         } else {
-            QByteArray all = reply->readAll();
-            QBuffer buff(&all);
-            buff.open(QIODevice::ReadOnly);
-            if (!readImage(reply->url(), &buff, &image, &errorString, &readSize, job->requestSize))
-                error = QQuickPixmapReply::Decoding;
-       }
-        // send completion event to the QQuickPixmapReply
-        mutex.lock();
-        if (!cancelled.contains(job))
-            job->postReply(error, errorString, readSize, textureFactoryForImage(image));
-        mutex.unlock();
+            startDecoding(job, reply->url(), job->requestSize, QString(), reply->readAll());
+        }
     }
     reply->deleteLater();
 
@@ -495,36 +779,109 @@ void QQuickPixmapReader::processJobs()
     QMutexLocker locker(&mutex);
 
     while (true) {
-        if (cancelled.isEmpty() && (jobs.isEmpty() || replies.count() >= IMAGEREQUEST_MAX_REQUEST_COUNT)) 
-            return; // Nothing else to do
-
-        // Clean cancelled jobs
-        if (cancelled.count()) {
-            for (int i = 0; i < cancelled.count(); ++i) {
-                QQuickPixmapReply *job = cancelled.at(i);
-                QNetworkReply *reply = replies.key(job, 0);
-                if (reply && reply->isRunning()) {
-                    // cancel any jobs already started
-                    replies.remove(reply);
-                    reply->close();
-                }
-                // deleteLater, since not owned by this thread
-                job->deleteLater();
+        // Clean cancelled jobs, except for those a decode job still refers to
+        for (int i = 0; i < cancelled.count();) {
+            QQuickPixmapReply *job = cancelled.at(i);
+            if (decoding.contains(job)) {
+                ++i;
+                continue;
             }
-            cancelled.clear();
+            QNetworkReply *reply = replies.key(job, 0);
+            if (reply && reply->isRunning()) {
+                // cancel any jobs already started
+                replies.remove(reply);
+                reply->close();
+            }
+            // deleteLater, since not owned by this thread
+            job->deleteLater();
+            cancelled.removeAt(i);
         }
 
-        if (!jobs.isEmpty() && replies.count() < IMAGEREQUEST_MAX_REQUEST_COUNT) {
-            QQuickPixmapReply *runningJob = jobs.takeLast();
-            runningJob->loading = true;
+        QQuickPixmapReply *runningJob = takeNextJob();
+        if (!runningJob)
+            return; // Nothing else to do
+
+        runningJob->loading = true;
+
+        QUrl url = runningJob->url;
+        QSize requestSize = runningJob->requestSize;
+        locker.unlock();
+        processJob(runningJob, url, requestSize);
+        locker.relock();
+    }
+}
+
+// Takes the most recently requested of the jobs with the highest priority,
+// skipping those whose network or decoding queue is already full.  Must be
+// called with the mutex locked.
+QQuickPixmapReply *QQuickPixmapReader::takeNextJob()
+{
+    const bool networkFull = replies.count() >= IMAGEREQUEST_MAX_REQUEST_COUNT;
+    const bool decodingFull = decoding.count() >= decodePool.maxThreadCount();
+
+    int next = -1;
+    for (int i = jobs.count() - 1; i >= 0; --i) {
+        QQuickPixmapReply *job = jobs.at(i);
+        if (next != -1 && job->priority <= jobs.at(next)->priority)
+            continue;
+        if ((job->source == QQuickPixmapReply::Network && networkFull)
+                || (job->source == QQuickPixmapReply::LocalFile && decodingFull))
+            continue;
+        next = i;
+    }
+
+    return next == -1 ? 0 : jobs.takeAt(next);
+}
+
+void QQuickPixmapReader::startDecoding(QQuickPixmapReply *job, const QUrl &url, const QSize &requestSize,
+                                       const QString &localFile, const QByteArray &data)
+{
+    mutex.lock();
+    decoding.insert(job);
+    const int priority = job->priority;
+    mutex.unlock();
+
+    decodePool.start(new QQuickPixmapDecodeJob(this, job, url, requestSize, localFile, data), priority);
+}
 
-            QUrl url = runningJob->url;
-            QSize requestSize = runningJob->requestSize;
-            locker.unlock();
-            processJob(runningJob, url, requestSize);
-            locker.relock();
+void QQuickPixmapDecodeJob::run()
+{
+    reader->mutex.lock();
+    const bool cancelled = reader->cancelled.contains(reply);
+    reader->mutex.unlock();
+
+    QImage image;
+    QQuickPixmapReply::ReadError errorCode = QQuickPixmapReply::NoError;
+    QString errorStr;
+    QSize readSize;
+
+    // Don't bother decoding images nobody is waiting for any more
+    if (!cancelled) {
+        QThread::currentThread()->setPriority(QThread::LowestPriority);
+        if (localFile.isEmpty()) {
+            QBuffer buff(&data);
+            buff.open(QIODevice::ReadOnly);
+            if (!readImage(url, &buff, &image, &errorStr, &readSize, requestSize))
+                errorCode = QQuickPixmapReply::Decoding;
+        } else {
+            QFile f(localFile);
+            if (f.open(QIODevice::ReadOnly)) {
+                if (!readLocalImage(url, &f, &image, &errorStr, &readSize, requestSize))
+                    errorCode = QQuickPixmapReply::Loading;
+            } else {
+                errorStr = QQuickPixmap::tr("Cannot open: %1").arg(url.toString());
+                errorCode = QQuickPixmapReply::Loading;
+            }
         }
     }
+
+    QMutexLocker locker(&reader->mutex);
+    reader->decoding.remove(reply);
+    if (!reader->cancelled.contains(reply))
+        reply->postReply(errorCode, errorStr, readSize, textureFactoryForImage(image));
+    // start the next job, or clean up the reply if it was cancelled
+    if (reader->threadObject)
+        reader->threadObject->processJobs();
 }
 
 void QQuickPixmapReader::processJob(QQuickPixmapReply *runningJob, const QUrl &url, 
@@ -592,23 +949,8 @@ void QQuickPixmapReader::processJob(QQuickPixmapReply *runningJob, const QUrl &u
     } else {
         QString lf = QQmlFile::urlToLocalFileOrQrc(url);
         if (!lf.isEmpty()) {
-            // Image is local - load/decode immediately
-            QImage image;
-            QQuickPixmapReply::ReadError errorCode = QQuickPixmapReply::NoError;
-            QString errorStr;
-            QFile f(lf);
-            QSize readSize;
-            if (f.open(QIODevice::ReadOnly)) {
-                if (!readImage(url, &f, &image, &errorStr, &readSize, requestSize))
-                    errorCode = QQuickPixmapReply::Loading;
-            } else {
-                errorStr = QQuickPixmap::tr("Cannot open: %1").arg(url.toString());
-                errorCode = QQuickPixmapReply::Loading;
-            }
-            mutex.lock();
-            if (!cancelled.contains(runningJob))
-                runningJob->postReply(errorCode, errorStr, readSize, textureFactoryForImage(image));
-            mutex.unlock();
+            // Image is local - decode it on the pool straight away
+            startDecoding(runningJob, url, requestSize, lf, QByteArray());
         } else {
             // Network resource
             QNetworkRequest req(url);
@@ -653,6 +995,27 @@ QQuickPixmapReply *QQuickPixmapReader::getImage(QQuickPixmapData *data)
     return reply;
 }
 
+void QQuickPixmapReader::setPriority(QQuickPixmapReply *reply, int priority)
+{
+    // Only affects replies that are still waiting to be started
+    mutex.lock();
+    reply->priority = priority;
+    mutex.unlock();
+}
+
+int QQuickPixmapReader::decodingThreadCount() const
+{
+    return decodePool.maxThreadCount();
+}
+
+void QQuickPixmapReader::setDecodingThreadCount(int count)
+{
+    decodePool.setMaxThreadCount(count > 0 ? count : defaultDecodingThreadCount());
+    mutex.lock();
+    if (threadObject) threadObject->processJobs();
+    mutex.unlock();
+}
+
 void QQuickPixmapReader::cancel(QQuickPixmapReply *reply)
 {
     mutex.lock();
@@ -720,6 +1083,15 @@ public:
 
     void purgeCache();
 
+    int cacheLimit() const { return m_cacheLimit; }
+    void setCacheLimit(int bytes);
+    int cacheExpiry() const { return m_cacheExpiry; }
+    void setCacheExpiry(int seconds);
+
+    void cacheHit(const QUrl &);
+    void cacheMiss(const QUrl &);
+    void pixmapDecoded(const QQuickPixmapData *);
+
 protected:
     virtual void timerEvent(QTimerEvent *);
 
@@ -728,20 +1100,46 @@ public:
 
 private:
     void shrinkCache(int remove);
+    int releaseLastUnreferenced();
+    void expireCache();
+    void startExpiryTimer();
 
     QQuickPixmapData *m_unreferencedPixmaps;
     QQuickPixmapData *m_lastUnreferencedPixmap;
 
+    // The cache limit describes the maximum "junk" in the cache, in bytes
+    int m_cacheLimit;
+    // Unreferenced pixmaps are released after this many seconds, 0 keeps them
+    int m_cacheExpiry;
+    QElapsedTimer m_clock;
+
     int m_unreferencedCost;
     int m_timerId;
     bool m_destroying;
+
+    int m_hits;
+    int m_misses;
+    int m_evictions;
 };
 Q_GLOBAL_STATIC(QQuickPixmapStore, pixmapStore);
 
 
 QQuickPixmapStore::QQuickPixmapStore()
-    : m_unreferencedPixmaps(0), m_lastUnreferencedPixmap(0), m_unreferencedCost(0), m_timerId(-1), m_destroying(false)
+    : m_unreferencedPixmaps(0), m_lastUnreferencedPixmap(0), m_cacheLimit(CACHE_LIMIT_KB * 1024),
+      m_cacheExpiry(CACHE_EXPIRE_TIME), m_unreferencedCost(0), m_timerId(-1), m_destroying(false),
+      m_hits(0), m_misses(0), m_evictions(0)
 {
+    // QML_PIXMAP_CACHE_LIMIT (in kilobytes) and QML_PIXMAP_CACHE_EXPIRY (in
+    // seconds) override the defaults
+    bool ok = false;
+    int limit = qgetenv("QML_PIXMAP_CACHE_LIMIT").toInt(&ok);
+    if (ok && limit >= 0)
+        m_cacheLimit = limit * 1024;
+    int expiry = qgetenv("QML_PIXMAP_CACHE_EXPIRY").toInt(&ok);
+    if (ok && expiry >= 0)
+        m_cacheExpiry = expiry;
+
+    m_clock.start();
 }
 
 QQuickPixmapStore::~QQuickPixmapStore()
@@ -789,8 +1187,18 @@ void QQuickPixmapStore::unreferencePixmap(QQuickPixmapData *data)
     Q_ASSERT(data->prevUnreferencedPtr == 0);
     Q_ASSERT(data->nextUnreferenced == 0);
 
+    // A pixmap that can never fit would only flush everything else out
+    if (!m_destroying && data->cost() > m_cacheLimit) {
+        ++m_evictions;
+        QQmlPixmapProfiler().cacheEviction(data->url, m_evictions);
+        data->removeFromCache();
+        delete data;
+        return;
+    }
+
     data->nextUnreferenced = m_unreferencedPixmaps;
     data->prevUnreferencedPtr = &m_unreferencedPixmaps;
+    data->unreferencedTime = m_clock.elapsed();
     if (!m_destroying) // the texture factories may have been cleaned up already.
         m_unreferencedCost += data->cost();
 
@@ -803,10 +1211,10 @@ void QQuickPixmapStore::unreferencePixmap(QQuickPixmapData *data)
     if (!m_lastUnreferencedPixmap)
         m_lastUnreferencedPixmap = data;
 
-    shrinkCache(-1); // Shrink the cache incase it has become larger than cache_limit
+    shrinkCache(-1); // Shrink the cache incase it has become larger than m_cacheLimit
 
     if (m_timerId == -1 && m_unreferencedPixmaps && !m_destroying)
-        m_timerId = startTimer(CACHE_EXPIRE_TIME * 1000);
+        startExpiryTimer();
 }
 
 void QQuickPixmapStore::referencePixmap(QQuickPixmapData *data)
@@ -828,31 +1236,55 @@ void QQuickPixmapStore::referencePixmap(QQuickPixmapData *data)
     m_unreferencedCost -= data->cost();
 }
 
+// The unreferenced pixmaps are kept in least recently used order, and are
+// released starting with the one that was unreferenced longest ago.
 void QQuickPixmapStore::shrinkCache(int remove)
 {
-    while ((remove > 0 || m_unreferencedCost > cache_limit) && m_lastUnreferencedPixmap) {
-        QQuickPixmapData *data = m_lastUnreferencedPixmap;
-        Q_ASSERT(data->nextUnreferenced == 0);
+    while ((remove > 0 || m_unreferencedCost > m_cacheLimit) && m_lastUnreferencedPixmap)
+        remove -= releaseLastUnreferenced();
+}
 
-        *data->prevUnreferencedPtr = 0;
-        m_lastUnreferencedPixmap = data->prevUnreferenced;
-        data->prevUnreferencedPtr = 0;
-        data->prevUnreferenced = 0;
+// Returns the cost of the released pixmap
+int QQuickPixmapStore::releaseLastUnreferenced()
+{
+    QQuickPixmapData *data = m_lastUnreferencedPixmap;
+    Q_ASSERT(data->nextUnreferenced == 0);
 
-        if (!m_destroying) {
-            remove -= data->cost();
-            m_unreferencedCost -= data->cost();
-        }
-        data->removeFromCache();
-        delete data;
+    *data->prevUnreferencedPtr = 0;
+    m_lastUnreferencedPixmap = data->prevUnreferenced;
+    data->prevUnreferencedPtr = 0;
+    data->prevUnreferenced = 0;
+
+    int cost = 0;
+    if (!m_destroying) {
+        cost = data->cost();
+        m_unreferencedCost -= cost;
+        ++m_evictions;
+        QQmlPixmapProfiler().cacheEviction(data->url, m_evictions);
     }
+    data->removeFromCache();
+    delete data;
+    return cost;
 }
 
-void QQuickPixmapStore::timerEvent(QTimerEvent *)
+void QQuickPixmapStore::expireCache()
 {
-    int removalCost = m_unreferencedCost / CACHE_REMOVAL_FRACTION;
+    const qint64 expired = m_clock.elapsed() - qint64(m_cacheExpiry) * 1000;
+    while (m_lastUnreferencedPixmap && m_lastUnreferencedPixmap->unreferencedTime <= expired)
+        releaseLastUnreferenced();
+}
+
+// Checks for expired pixmaps a few times per expiry period, so that they are
+// released at most 1/CACHE_REMOVAL_FRACTION of the period late.
+void QQuickPixmapStore::startExpiryTimer()
+{
+    if (m_cacheExpiry > 0)
+        m_timerId = startTimer(qMax(1, m_cacheExpiry * 1000 / CACHE_REMOVAL_FRACTION));
+}
 
-    shrinkCache(removalCost);
+void QQuickPixmapStore::timerEvent(QTimerEvent *)
+{
+    expireCache();
 
     if (m_unreferencedPixmaps == 0) {
         killTimer(m_timerId);
@@ -860,6 +1292,41 @@ void QQuickPixmapStore::timerEvent(QTimerEvent *)
     }
 }
 
+void QQuickPixmapStore::setCacheLimit(int bytes)
+{
+    m_cacheLimit = qMax(0, bytes);
+    shrinkCache(-1);
+}
+
+void QQuickPixmapStore::setCacheExpiry(int seconds)
+{
+    m_cacheExpiry = qMax(0, seconds);
+    if (m_timerId >= 0) {
+        killTimer(m_timerId);
+        m_timerId = -1;
+    }
+    expireCache();
+    if (m_unreferencedPixmaps && !m_destroying)
+        startExpiryTimer();
+}
+
+void QQuickPixmapStore::cacheHit(const QUrl &url)
+{
+    ++m_hits;
+    QQmlPixmapProfiler().cacheHit(url, m_hits);
+}
+
+void QQuickPixmapStore::cacheMiss(const QUrl &url)
+{
+    ++m_misses;
+    QQmlPixmapProfiler().cacheMiss(url, m_misses);
+}
+
+void QQuickPixmapStore::pixmapDecoded(const QQuickPixmapData *data)
+{
+    QQmlPixmapProfiler().decoded(data->url, data->cost());
+}
+
 void QQuickPixmapStore::purgeCache()
 {
     shrinkCache(m_unreferencedCost);
@@ -870,9 +1337,69 @@ void QQuickPixmap::purgeCache()
     pixmapStore()->purgeCache();
 }
 
+int QQuickPixmap::cacheLimit()
+{
+    return pixmapStore()->cacheLimit();
+}
+
+// The cache is shared by all engines, so the limit applies to all of them
+void QQuickPixmap::setCacheLimit(int bytes)
+{
+    pixmapStore()->setCacheLimit(bytes);
+}
+
+int QQuickPixmap::cacheExpiry()
+{
+    return pixmapStore()->cacheExpiry();
+}
+
+void QQuickPixmap::setCacheExpiry(int seconds)
+{
+    pixmapStore()->setCacheExpiry(seconds);
+}
+
+QString QQuickPixmap::diskCachePath()
+{
+    QQuickPixmapDiskCache *cache = pixmapDiskCache();
+    QMutexLocker locker(&cache->mutex);
+    return cache->path;
+}
+
+// An empty path disables the disk cache
+void QQuickPixmap::setDiskCachePath(const QString &path)
+{
+    QQuickPixmapDiskCache *cache = pixmapDiskCache();
+    QMutexLocker locker(&cache->mutex);
+    cache->path = path;
+    cache->created = false;
+    cache->used = -1;
+}
+
+int QQuickPixmap::diskCacheLimit()
+{
+    QQuickPixmapDiskCache *cache = pixmapDiskCache();
+    QMutexLocker locker(&cache->mutex);
+    return cache->limit;
+}
+
+// Once the disk cache grows past bytes, its oldest entries are removed
+void QQuickPixmap::setDiskCacheLimit(int bytes)
+{
+    QQuickPixmapDiskCache *cache = pixmapDiskCache();
+    QMutexLocker locker(&cache->mutex);
+    cache->limit = qMax(0, bytes);
+    pruneDiskCache(cache);
+}
+
 QQuickPixmapReply::QQuickPixmapReply(QQuickPixmapData *d)
-: data(d), engineForReader(0), requestSize(d->requestSize), url(d->url), loading(false), redirectCount(0)
+: data(d), engineForReader(0), requestSize(d->requestSize), url(d->url), source(Network), loading(false),
+  redirectCount(0), priority(0)
 {
+    if (url.scheme() == QLatin1String("image"))
+        source = Provider;
+    else if (!QQmlFile::urlToLocalFileOrQrc(url).isEmpty())
+        source = LocalFile;
+
     if (finishedIndex == -1) {
         finishedIndex = QMetaMethod::fromSignal(&QQuickPixmapReply::finished).methodIndex();
         downloadProgressIndex = QMetaMethod::fromSignal(&QQuickPixmapReply::downloadProgress).methodIndex();
@@ -897,6 +1424,7 @@ bool QQuickPixmapReply::event(QEvent *event)
                 pixmapProfiler.finishLoading(data->url);
                 data->textureFactory = de->textureFactory;
                 data->implicitSize = de->implicitSize;
+                pixmapStore()->pixmapDecoded(data);
                 if (data->implicitSize.width() > 0)
                     pixmapProfiler.setSize(url, data->implicitSize.width(), data->implicitSize.height());
             } else {
@@ -1051,7 +1579,7 @@ static QQuickPixmapData* createPixmapDataSync(QQuickPixmap *declarativePixmap, Q
     if (f.open(QIODevice::ReadOnly)) {
         QImage image;
 
-        if (readImage(url, &f, &image, &errorString, &readSize, requestSize)) {
+        if (readLocalImage(url, &f, &image, &errorString, &readSize, requestSize)) {
             *ok = true;
             return new QQuickPixmapData(declarativePixmap, url, textureFactoryForImage(image), readSize, requestSize);
         }
@@ -1233,8 +1761,13 @@ void QQuickPixmap::load(QQmlEngine *engine, const QUrl &url, const QSize &reques
 
     // If Cache is disabled, the pixmap will always be loaded, even if there is an existing
     // cached version.
-    if (options & QQuickPixmap::Cache)
+    if (options & QQuickPixmap::Cache) {
         iter = store->m_cache.find(key);
+        if (iter == store->m_cache.end())
+            store->cacheMiss(url);
+        else
+            store->cacheHit(url);
+    }
 
     if (iter == store->m_cache.end()) {
         if (url.scheme() == QLatin1String("image")) {
@@ -1256,6 +1789,7 @@ void QQuickPixmap::load(QQmlEngine *engine, const QUrl &url, const QSize &reques
             d = createPixmapDataSync(this, engine, url, requestSize, &ok);
             if (ok) {
                 pixmapProfiler.finishLoading(url);
+                pixmapStore()->pixmapDecoded(d);
                 if (d->implicitSize.width() > 0)
                     QQmlPixmapProfiler().setSize(url, d->implicitSize.width(), d->implicitSize.height());
                 if (options & QQuickPixmap::Cache)
@@ -1285,6 +1819,34 @@ void QQuickPixmap::load(QQmlEngine *engine, const QUrl &url, const QSize &reques
     }
 }
 
+// Requests with a higher priority are started before those with a lower one,
+// and requests with the same priority newest first.  The default is 0.  This
+// has no effect once the request has been started.
+void QQuickPixmap::setLoadPriority(int priority)
+{
+    if (!d || !d->reply)
+        return;
+
+    QMutexLocker locker(&QQuickPixmapReader::readerMutex);
+    if (QQuickPixmapReader *reader = QQuickPixmapReader::existingInstance(d->reply->engineForReader))
+        reader->setPriority(d->reply, priority);
+}
+
+int QQuickPixmap::decodingThreadCount(QQmlEngine *engine)
+{
+    QMutexLocker locker(&QQuickPixmapReader::readerMutex);
+    if (QQuickPixmapReader *reader = QQuickPixmapReader::existingInstance(engine))
+        return reader->decodingThreadCount();
+    return defaultDecodingThreadCount();
+}
+
+// Zero or a negative count restores the default, see defaultDecodingThreadCount()
+void QQuickPixmap::setDecodingThreadCount(QQmlEngine *engine, int count)
+{
+    QMutexLocker locker(&QQuickPixmapReader::readerMutex);
+    QQuickPixmapReader::instance(engine)->setDecodingThreadCount(count);
+}
+
 void QQuickPixmap::clear()
 {
     if (d) {
@@ -120,7 +120,19 @@ public:
     bool connectDownloadProgress(QObject *, const char *);
     bool connectDownloadProgress(QObject *, int);
 
+    void setLoadPriority(int priority);
+
     static void purgeCache();
+    static int cacheLimit();
+    static void setCacheLimit(int bytes);
+    static int cacheExpiry();
+    static void setCacheExpiry(int seconds);
+    static QString diskCachePath();
+    static void setDiskCachePath(const QString &path);
+    static int diskCacheLimit();
+    static void setDiskCacheLimit(int bytes);
+    static int decodingThreadCount(QQmlEngine *);
+    static void setDecodingThreadCount(QQmlEngine *, int count);
 
 private:
     Q_DISABLE_COPY(QQuickPixmap)
@@ -14,6 +14,7 @@ PRIVATETESTS += \
     qquickitemparticle \
     qquicklineextruder \
     qquickmaskextruder \
+    qquickparticleaffector \
     qquickparticlegroup \
     qquickparticlesystem \
     qquickpointattractor \
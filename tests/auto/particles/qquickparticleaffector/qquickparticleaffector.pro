@@ -0,0 +1,11 @@
+CONFIG += testcase
+TARGET = tst_qquickparticleaffector
+SOURCES += tst_qquickparticleaffector.cpp
+macx:CONFIG -= app_bundle
+
+include (../../shared/util.pri)
+TESTDATA = data/*
+
+QT += core-private gui-private v8-private qml-private quick-private quickparticles-private testlib
+
+DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0
@@ -0,0 +1,143 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include "../shared/particlestestsshared.h"
+#include <private/qquickparticlesystem_p.h>
+#include <private/qquickparticleaffector_p.h>
+
+#include "../../shared/util.h"
+
+class tst_qquickparticleaffector : public QQmlDataTest
+{
+    Q_OBJECT
+public:
+    tst_qquickparticleaffector() : m_threadCount(1) {}
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void threaded_data();
+    void threaded();
+
+private:
+    QVector<float> simulate(int threads);
+
+    int m_threadCount;
+};
+
+void tst_qquickparticleaffector::initTestCase()
+{
+    QQmlDataTest::initTestCase();
+    m_threadCount = QQuickParticleAffector::threadCount();
+}
+
+void tst_qquickparticleaffector::cleanupTestCase()
+{
+    QQuickParticleAffector::setThreadCount(m_threadCount);
+}
+
+//Steps threaded.qml by hand and returns the state of every particle
+QVector<float> tst_qquickparticleaffector::simulate(int threads)
+{
+    QQuickParticleAffector::setThreadCount(threads);
+
+    QVector<float> state;
+    QQuickView* view = createView(testFileUrl("threaded.qml"));
+    if (!view)
+        return state;
+    QQuickParticleSystem* system = view->rootObject()->findChild<QQuickParticleSystem*>("system");
+    //Pretend we're running, but we manually advance the simulation
+    system->m_running = true;
+    system->m_animation = 0;
+    system->reset();
+
+    //The emitter picks positions and velocities with qrand()
+    qsrand(1);
+    int curTime = 1;
+    system->updateCurrentTime(curTime);
+    for (int i = 0; i < 50; ++i) {
+        curTime += 16;
+        system->updateCurrentTime(curTime);
+    }
+    //Several simulation steps in one frame
+    curTime += 100;
+    system->updateCurrentTime(curTime);
+
+    foreach (QQuickParticleData *d, system->groupData[0]->data) {
+        if (d->t == -1)
+            continue; //Particle data unused
+        state << d->x << d->y << d->vx << d->vy << d->ax << d->ay << d->t;
+    }
+    delete view;
+    return state;
+}
+
+void tst_qquickparticleaffector::threaded_data()
+{
+    QTest::addColumn<int>("threads");
+
+    QTest::newRow("2 threads") << 2;
+    QTest::newRow("4 threads") << 4;
+    QTest::newRow("ideal") << qMax(2, QThread::idealThreadCount());
+}
+
+void tst_qquickparticleaffector::threaded()
+{
+    QFETCH(int, threads);
+
+    //Batches above 1024 particles are split into ranges, one per thread
+    QVector<float> serial = simulate(1);
+    QCOMPARE(serial.count(), 5000 * 7);
+
+    QVector<float> threaded = simulate(threads);
+    QCOMPARE(QQuickParticleAffector::threadCount(), threads);
+    QCOMPARE(threaded.count(), serial.count());
+    for (int i = 0; i < serial.count(); ++i) {
+        if (threaded[i] != serial[i])
+            QFAIL(qPrintable(QString::fromLatin1("Particle %1 differs: %2 != %3")
+                             .arg(i / 7).arg(threaded[i]).arg(serial[i])));
+    }
+}
+
+QTEST_MAIN(tst_qquickparticleaffector);
+
+#include "tst_qquickparticleaffector.moc"
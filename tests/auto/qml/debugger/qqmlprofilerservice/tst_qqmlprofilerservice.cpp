@@ -111,6 +111,10 @@ public:
         PixmapLoadingStarted,
         PixmapLoadingFinished,
         PixmapLoadingError,
+        PixmapCacheHit,
+        PixmapCacheMiss,
+        PixmapCacheEviction,
+        PixmapDecoded,
 
         MaximumPixmapEventType
     };
@@ -258,6 +262,11 @@ void QQmlProfilerClient::messageReceived(const QByteArray &message)
             stream >> data.animationcount;
         if (data.detailType == QQmlProfilerClient::PixmapCacheCountChanged)
             stream >> data.animationcount;
+        if (data.detailType == QQmlProfilerClient::PixmapCacheHit
+                || data.detailType == QQmlProfilerClient::PixmapCacheMiss
+                || data.detailType == QQmlProfilerClient::PixmapCacheEviction
+                || data.detailType == QQmlProfilerClient::PixmapDecoded)
+            stream >> data.animationcount;
         break;
     }
     case QQmlProfilerClient::SceneGraphFrame: {
@@ -410,23 +419,33 @@ void tst_QQmlProfilerService::pixmapCacheData()
     QCOMPARE(m_client->traceMessages.first().messageType, (int)QQmlProfilerClient::Event);
     QCOMPARE(m_client->traceMessages.first().detailType, (int)QQmlProfilerClient::StartTrace);
 
-    // image starting to load
+    // image not found in the cache
     QCOMPARE(m_client->traceMessages[8].messageType, (int)QQmlProfilerClient::PixmapCacheEvent);
-    QCOMPARE(m_client->traceMessages[8].detailType, (int)QQmlProfilerClient::PixmapLoadingStarted);
+    QCOMPARE(m_client->traceMessages[8].detailType, (int)QQmlProfilerClient::PixmapCacheMiss);
+    QVERIFY(m_client->traceMessages[8].animationcount >= 1); // total misses
 
-    // image loaded
+    // image starting to load
     QCOMPARE(m_client->traceMessages[9].messageType, (int)QQmlProfilerClient::PixmapCacheEvent);
-    QCOMPARE(m_client->traceMessages[9].detailType, (int)QQmlProfilerClient::PixmapLoadingFinished);
+    QCOMPARE(m_client->traceMessages[9].detailType, (int)QQmlProfilerClient::PixmapLoadingStarted);
 
-    // image size
+    // image loaded
     QCOMPARE(m_client->traceMessages[10].messageType, (int)QQmlProfilerClient::PixmapCacheEvent);
-    QCOMPARE(m_client->traceMessages[10].detailType, (int)QQmlProfilerClient::PixmapSizeKnown);
-    QCOMPARE(m_client->traceMessages[10].line, 2); // width
-    QCOMPARE(m_client->traceMessages[10].column, 2); // height
+    QCOMPARE(m_client->traceMessages[10].detailType, (int)QQmlProfilerClient::PixmapLoadingFinished);
 
-    // cache size
+    // decoded bytes
     QCOMPARE(m_client->traceMessages[11].messageType, (int)QQmlProfilerClient::PixmapCacheEvent);
-    QCOMPARE(m_client->traceMessages[11].detailType, (int)QQmlProfilerClient::PixmapCacheCountChanged);
+    QCOMPARE(m_client->traceMessages[11].detailType, (int)QQmlProfilerClient::PixmapDecoded);
+    QCOMPARE(m_client->traceMessages[11].animationcount, 2 * 2 * 4);
+
+    // image size
+    QCOMPARE(m_client->traceMessages[12].messageType, (int)QQmlProfilerClient::PixmapCacheEvent);
+    QCOMPARE(m_client->traceMessages[12].detailType, (int)QQmlProfilerClient::PixmapSizeKnown);
+    QCOMPARE(m_client->traceMessages[12].line, 2); // width
+    QCOMPARE(m_client->traceMessages[12].column, 2); // height
+
+    // cache size
+    QCOMPARE(m_client->traceMessages[13].messageType, (int)QQmlProfilerClient::PixmapCacheEvent);
+    QCOMPARE(m_client->traceMessages[13].detailType, (int)QQmlProfilerClient::PixmapCacheCountChanged);
 
     // must end with "EndTrace"
     QCOMPARE(m_client->traceMessages.last().messageType, (int)QQmlProfilerClient::Event);
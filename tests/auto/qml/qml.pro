@@ -51,6 +51,7 @@ PRIVATETESTS += \
     qqmlparser \
     qquickworkerscript \
     qqmlbundle \
+    qmlcachegen \
     qrcqml \
     v4 \
     qqmltimer \
@@ -0,0 +1,6 @@
+import QtQml 2.0
+
+QtObject {
+    property int value: child.value * 2
+    property QtObject child: Child { value: 21 }
+}
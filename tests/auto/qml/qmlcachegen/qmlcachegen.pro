@@ -0,0 +1,12 @@
+CONFIG += testcase
+TARGET = tst_qmlcachegen
+QT += qml testlib qml-private core-private
+macx:CONFIG -= app_bundle
+
+SOURCES += tst_qmlcachegen.cpp
+
+include (../../shared/util.pri)
+TESTDATA = data/*
+
+cross_compile: DEFINES += QTEST_CROSS_COMPILED
+DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0
@@ -0,0 +1,155 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <qtest.h>
+#include <QLibraryInfo>
+#include <QDir>
+#include <QProcess>
+#include <QTemporaryDir>
+#include <QQmlEngine>
+#include <QQmlComponent>
+#include <private/qqmlengine_p.h>
+#include <private/qqmltypeloader_p.h>
+
+#include "../../shared/util.h"
+
+class tst_qmlcachegen : public QQmlDataTest
+{
+    Q_OBJECT
+public:
+    tst_qmlcachegen() {}
+
+private slots:
+    void initTestCase();
+#if !defined(QTEST_CROSS_COMPILED) // the tool only runs on the target
+    void compileError();
+    void cacheUsedByEngine();
+#endif
+
+private:
+    int runQmlCacheGen(const QStringList &arguments);
+
+    QString qmlcachegenPath;
+};
+
+void tst_qmlcachegen::initTestCase()
+{
+    QQmlDataTest::initTestCase();
+
+    qmlcachegenPath = QLibraryInfo::location(QLibraryInfo::BinariesPath) + QLatin1String("/qmlcachegen");
+#ifdef Q_OS_WIN
+    qmlcachegenPath += QLatin1String(".exe");
+#endif
+    if (!QFileInfo(qmlcachegenPath).exists()) {
+        QString message = QString::fromLatin1("qmlcachegen executable not found (looked for %0)")
+                .arg(qmlcachegenPath);
+        QFAIL(qPrintable(message));
+    }
+}
+
+int tst_qmlcachegen::runQmlCacheGen(const QStringList &arguments)
+{
+    QProcess process;
+    process.start(qmlcachegenPath, QStringList() << QLatin1String("-q") << arguments);
+    if (!process.waitForFinished() || process.exitStatus() != QProcess::NormalExit)
+        return -1;
+    return process.exitCode();
+}
+
+#if !defined(QTEST_CROSS_COMPILED)
+void tst_qmlcachegen::compileError()
+{
+    QTemporaryDir cacheDir;
+    QVERIFY(cacheDir.isValid());
+    const QString stamp = cacheDir.path() + QLatin1String("/qmlcache.stamp");
+
+    // A stamp left by an earlier run must not survive a failing one
+    QFile oldStamp(stamp);
+    QVERIFY(oldStamp.open(QIODevice::WriteOnly));
+    oldStamp.close();
+
+    QStringList arguments;
+    arguments << QLatin1String("-s") << stamp << QLatin1String("-o") << cacheDir.path()
+              << testFile("valid") << testFile("error.qml");
+    int exitCode = runQmlCacheGen(arguments);
+    QVERIFY(exitCode != -1);
+    QVERIFY(exitCode != 0);
+    QVERIFY(!QFile::exists(stamp));
+}
+
+void tst_qmlcachegen::cacheUsedByEngine()
+{
+    QTemporaryDir cacheDir;
+    QVERIFY(cacheDir.isValid());
+    const QString stamp = cacheDir.path() + QLatin1String("/qmlcache.stamp");
+
+    QStringList arguments;
+    arguments << QLatin1String("-s") << stamp << QLatin1String("-o") << cacheDir.path()
+              << testFile("valid");
+    QCOMPARE(runQmlCacheGen(arguments), 0);
+    QVERIFY(QFile::exists(stamp));
+    QCOMPARE(QDir(cacheDir.path()).entryList(QStringList() << QLatin1String("*.qmlc")).count(), 2);
+
+    // The type loader reads the variable when the engine is created
+    qputenv("QML_COMPILATION_CACHE_DIR", QFile::encodeName(cacheDir.path()));
+    QQmlEngine engine;
+    qputenv("QML_COMPILATION_CACHE_DIR", QByteArray());
+
+    QQmlComponent component(&engine, testFileUrl("valid/Main.qml"));
+    QVERIFY2(component.isReady(), qPrintable(component.errorString()));
+    QScopedPointer<QObject> object(component.create());
+    QVERIFY(object);
+    QCOMPARE(object->property("value").toInt(), 42);
+
+    QQmlTypeLoader &typeLoader = QQmlEnginePrivate::get(&engine)->typeLoader;
+    foreach (const QString &fileName, QStringList() << "valid/Main.qml" << "valid/Child.qml") {
+        QQmlTypeData *typeData = typeLoader.getType(testFileUrl(fileName));
+        QVERIFY(typeData);
+        bool fromCache = typeData->isCompiledFromCache();
+        typeData->release();
+        QVERIFY2(fromCache, qPrintable(fileName + QLatin1String(" was compiled from source")));
+    }
+}
+#endif
+
+QTEST_MAIN(tst_qmlcachegen)
+
+#include "tst_qmlcachegen.moc"
@@ -0,0 +1,17 @@
+import QtQuick 2.0
+
+Item {
+    property int a: 1
+    property int b: 2
+    property int c: 3
+    property int d: 4
+
+    property var evaluations: ({ 'sum': 0, 'total': 0 })
+
+    // total depends on sum, and is declared first so that it is notified first
+    property int total: { evaluations.total++; return a + sum }
+    property int sum: { evaluations.sum++; return a + b + c + d }
+
+    function sumEvaluations() { return evaluations.sum }
+    function totalEvaluations() { return evaluations.total }
+}
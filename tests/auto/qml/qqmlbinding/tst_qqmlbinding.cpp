@@ -42,6 +42,7 @@
 #include <QtQml/qqmlengine.h>
 #include <QtQml/qqmlcomponent.h>
 #include <private/qqmlbind_p.h>
+#include <private/qqmlengine_p.h>
 #include <QtQuick/private/qquickrectangle_p.h>
 #include "../../shared/util.h"
 
@@ -58,6 +59,7 @@ private slots:
     void restoreBindingWithLoop();
     void restoreBindingWithoutCrash();
     void deletedObject();
+    void deferredUpdates();
 
 private:
     QQmlEngine engine;
@@ -232,6 +234,57 @@ void tst_qqmlbinding::deletedObject()
     delete rect;
 }
 
+static int evaluations(QObject *object, const char *function)
+{
+    QVariant count;
+    QMetaObject::invokeMethod(object, function, Q_RETURN_ARG(QVariant, count));
+    return count.toInt();
+}
+
+void tst_qqmlbinding::deferredUpdates()
+{
+    QQmlEngine engine;
+    QQmlEnginePrivate *ep = QQmlEnginePrivate::get(&engine);
+    ep->deferBindingUpdates = true;
+
+    QQmlComponent c(&engine, testFileUrl("deferredUpdates.qml"));
+    QScopedPointer<QObject> object(c.create());
+    QVERIFY(object != 0);
+
+    QCOMPARE(object->property("sum").toInt(), 10);
+    QCOMPARE(object->property("total").toInt(), 11);
+    QCOMPARE(evaluations(object.data(), "sumEvaluations"), 1);
+    QCOMPARE(evaluations(object.data(), "totalEvaluations"), 1);
+
+    object->setProperty("a", 10);
+    object->setProperty("b", 20);
+    object->setProperty("c", 30);
+    object->setProperty("d", 40);
+
+    // Nothing is evaluated until the queue is processed
+    QCOMPARE(object->property("sum").toInt(), 10);
+    QCOMPARE(evaluations(object.data(), "sumEvaluations"), 1);
+
+    ep->updatePendingBindings();
+
+    // Each binding is evaluated once, sum before the total that reads it
+    QCOMPARE(object->property("sum").toInt(), 100);
+    QCOMPARE(object->property("total").toInt(), 110);
+    QCOMPARE(evaluations(object.data(), "sumEvaluations"), 2);
+    QCOMPARE(evaluations(object.data(), "totalEvaluations"), 2);
+    QCOMPARE(ep->bindingEvaluations, quint64(2));
+    QVERIFY(ep->bindingNotifications > ep->bindingEvaluations);
+    QVERIFY(ep->pendingBindings.isEmpty());
+
+    // Without an explicit request, the queue is processed from the event loop
+    object->setProperty("d", 4);
+    QCOMPARE(object->property("sum").toInt(), 100);
+    QTRY_COMPARE(object->property("sum").toInt(), 64);
+    QCOMPARE(object->property("total").toInt(), 74);
+    QCOMPARE(evaluations(object.data(), "sumEvaluations"), 3);
+    QCOMPARE(evaluations(object.data(), "totalEvaluations"), 3);
+}
+
 QTEST_MAIN(tst_qqmlbinding)
 
 #include "tst_qqmlbinding.moc"
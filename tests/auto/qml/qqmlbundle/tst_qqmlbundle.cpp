@@ -65,9 +65,12 @@ private slots:
 
     void import();
 
+    void index();
+    void componentFromIndexedBundle();
+
 private:
     QStringList findFiles(const QDir &d);
-    bool makeBundle(const QString &path, const QString &name);
+    bool makeBundle(const QString &path, const QString &name, bool index = false);
 };
 
 void tst_qqmlbundle::initTestCase()
@@ -211,8 +214,78 @@ void tst_qqmlbundle::import()
     delete o;
 }
 
+// Test lookups through the index, including files removed and added after
+// the index was written
+void tst_qqmlbundle::index()
+{
+    QVERIFY(makeBundle(testFile("relativeResolution.2"), "my.bundle"));
+    const QString bundleFile = testFile("relativeResolution.2/my.bundle");
+
+    QStringList fileNames;
+    {
+    QQmlBundle bundle(bundleFile);
+    QVERIFY(bundle.open(QFile::ReadWrite));
+    QVERIFY(!bundle.hasIndex());
+    foreach (const QQmlBundle::FileEntry *entry, bundle.files())
+        fileNames << entry->fileName();
+    QVERIFY(fileNames.count() > 1);
+
+    bundle.remove(bundle.find(fileNames.first()));
+    QVERIFY(bundle.writeIndex());
+    QVERIFY(bundle.hasIndex());
+    QCOMPARE(bundle.files().count(), fileNames.count() - 1);
+    }
+
+    {
+    QQmlBundle bundle(bundleFile);
+    QVERIFY(bundle.open(QFile::ReadOnly));
+    QVERIFY(bundle.hasIndex());
+    QVERIFY(bundle.find(fileNames.first()) == 0);
+    for (int ii = 1; ii < fileNames.count(); ++ii) {
+        const QQmlBundle::FileEntry *entry = bundle.find(fileNames.at(ii));
+        QVERIFY(entry != 0);
+        QCOMPARE(entry->fileName(), fileNames.at(ii));
+    }
+    QVERIFY(bundle.find(QLatin1String("doesNotExist.qml")) == 0);
+    }
+
+    // Files appended to an indexed bundle are found by scanning the tail
+    {
+    QQmlBundle bundle(bundleFile);
+    QVERIFY(bundle.open(QFile::ReadWrite));
+    QVERIFY(bundle.add(QLatin1String("appended.qml"), testFile("componentFromBundle/bundledata/test.qml")));
+    }
+
+    {
+    QQmlBundle bundle(bundleFile);
+    QVERIFY(bundle.open(QFile::ReadOnly));
+    QVERIFY(bundle.hasIndex());
+    QVERIFY(bundle.find(QLatin1String("appended.qml")) != 0);
+    QVERIFY(bundle.find(fileNames.last()) != 0);
+    }
+}
+
+void tst_qqmlbundle::componentFromIndexedBundle()
+{
+    QVERIFY(makeBundle(testFile("componentFromBundle"), "my.bundle", true));
+
+    QQmlEngine engine;
+    engine.addNamedBundle("mybundle", testFile("componentFromBundle/my.bundle"));
+
+    QQmlComponent component(&engine, QUrl("bundle://mybundle/test.qml"));
+    QVERIFY(component.isReady());
+
+    QObject *o = component.create();
+    QVERIFY(o != 0);
+
+    QCOMPARE(o->property("test1").toInt(), 11);
+    QCOMPARE(o->property("test2").toBool(), true);
+
+    delete o;
+}
+
 // Transform the data available under <path>/bundledata to a bundle named <path>/<name>
-bool tst_qqmlbundle::makeBundle(const QString &path, const QString &name)
+bool tst_qqmlbundle::makeBundle(const QString &path, const QString &name, bool index)
 {
     QDir dir(path);
     dir.remove(name);
@@ -234,6 +307,12 @@ bool tst_qqmlbundle::makeBundle(const QString &path, const QString &name)
         bundle.add(shortFileName, fileName);
     }
 
+    if (index) {
+        bundle.close();
+        if (!bundle.open(QFile::ReadWrite) || !bundle.writeIndex())
+            return false;
+    }
+
     return true;
 }
 
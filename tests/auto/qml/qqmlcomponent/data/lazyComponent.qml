@@ -0,0 +1,14 @@
+import QtQuick 2.0
+
+Item {
+    id: root
+    property int value: 10
+
+    property Component valid: Component {
+        Item { property int value: root.value * 2 }
+    }
+
+    property Component invalid: Component {
+        Item { nonExistentProperty: 1 }
+    }
+}
@@ -117,6 +117,8 @@ private slots:
     void onDestructionCount();
     void recursion();
     void recursionContinuation();
+    void lazyComponent_data();
+    void lazyComponent();
 
 private:
     QQmlEngine engine;
@@ -442,6 +444,55 @@ void tst_qqmlcomponent::recursionContinuation()
     QVERIFY(object->property("success").toBool());
 }
 
+void tst_qqmlcomponent::lazyComponent_data()
+{
+    QTest::addColumn<bool>("fromData");
+
+    QTest::newRow("url") << false;
+    QTest::newRow("data") << true;
+}
+
+void tst_qqmlcomponent::lazyComponent()
+{
+    QFETCH(bool, fromData);
+
+    QQmlEngine engine;
+    QQmlComponent component(&engine);
+    if (fromData) {
+        QFile file(testFile("lazyComponent.qml"));
+        QVERIFY(file.open(QIODevice::ReadOnly));
+        component.setData(file.readAll(), testFileUrl("lazyComponent.qml"));
+    } else {
+        component.loadUrl(testFileUrl("lazyComponent.qml"));
+    }
+
+    // Errors in nested component bodies are only reported once the component is created
+    QScopedPointer<QObject> object(component.create());
+    QVERIFY2(object != 0, qPrintable(component.errorString()));
+
+    QQmlComponent *valid = qvariant_cast<QQmlComponent *>(object->property("valid"));
+    QVERIFY(valid != 0);
+    QCOMPARE(valid->status(), QQmlComponent::Ready);
+
+    QScopedPointer<QObject> first(valid->create());
+    QVERIFY2(first != 0, qPrintable(valid->errorString()));
+    QCOMPARE(first->property("value").toInt(), 20);
+
+    QScopedPointer<QObject> second(valid->create());
+    QVERIFY(second != 0);
+    QCOMPARE(second->property("value").toInt(), 20);
+
+    QQmlComponent *invalid = qvariant_cast<QQmlComponent *>(object->property("invalid"));
+    QVERIFY(invalid != 0);
+    QCOMPARE(invalid->status(), QQmlComponent::Ready);
+
+    QScopedPointer<QObject> broken(invalid->create());
+    QVERIFY(broken == 0);
+    QCOMPARE(invalid->status(), QQmlComponent::Error);
+    QCOMPARE(invalid->errors().count(), 1);
+    QCOMPARE(invalid->errors().at(0).line(), 12);
+}
+
 QTEST_MAIN(tst_qqmlcomponent)
 
 #include "tst_qqmlcomponent.moc"
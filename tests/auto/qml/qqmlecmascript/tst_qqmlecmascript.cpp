@@ -2812,6 +2812,29 @@ void tst_qqmlecmascript::callQtInvokables()
     QCOMPARE(o->actuals().count(), 1);
     QCOMPARE(qvariant_cast<QJsonValue>(o->actuals().at(0)), QJsonValue(QJsonValue::Undefined));
 
+    // Calling again with the same argument types uses the previously resolved overload
+    o->reset();
+    QVERIFY(EVALUATE_VALUE("object.method_overload(12)", v8::Undefined()));
+    QCOMPARE(o->error(), false);
+    QCOMPARE(o->invoked(), 16);
+    QCOMPARE(o->actuals().count(), 1);
+    QCOMPARE(o->actuals().at(0), QVariant(12));
+
+    o->reset();
+    QVERIFY(EVALUATE_VALUE("object.method_overload(\"World\")", v8::Undefined()));
+    QCOMPARE(o->error(), false);
+    QCOMPARE(o->invoked(), 18);
+    QCOMPARE(o->actuals().count(), 1);
+    QCOMPARE(o->actuals().at(0), QVariant(QString("World")));
+
+    o->reset();
+    QVERIFY(EVALUATE_VALUE("object.method_overload(12, 13)", v8::Undefined()));
+    QCOMPARE(o->error(), false);
+    QCOMPARE(o->invoked(), 17);
+    QCOMPARE(o->actuals().count(), 2);
+    QCOMPARE(o->actuals().at(0), QVariant(12));
+    QCOMPARE(o->actuals().at(1), QVariant(13));
+
     o->reset();
     QVERIFY(EVALUATE_ERROR("object.method_unknown(null)"));
     QCOMPARE(o->error(), false);
@@ -0,0 +1,7 @@
+import QtQml 2.0
+
+Node7 {
+    property QtObject brokenPartner: Node4 { }
+
+    doesNotExist: brokenPartner.value
+}
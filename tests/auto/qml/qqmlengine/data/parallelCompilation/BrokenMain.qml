@@ -0,0 +1,7 @@
+import QtQml 2.0
+
+QtObject {
+    property QtObject n13: Node13 { }
+    property QtObject broken: Broken { }
+    property QtObject n15: Node15 { }
+}
@@ -0,0 +1,12 @@
+import QtQml 2.0
+
+QtObject {
+    property QtObject n8: Node8 { }
+    property QtObject n9: Node9 { }
+    property QtObject n10: Node10 { }
+    property QtObject n11: Node11 { }
+    property QtObject n12: Node12 { }
+    property QtObject n13: Node13 { }
+    property QtObject n14: Node14 { }
+    property QtObject n15: Node15 { }
+}
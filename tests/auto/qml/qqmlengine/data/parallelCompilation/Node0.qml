@@ -0,0 +1,7 @@
+import QtQml 2.0
+
+QtObject {
+    property int value: 0
+    property string label: "Node0"
+    property string path: label
+}
@@ -0,0 +1,10 @@
+import QtQml 2.0
+
+Node0 {
+    property int weight1: 1
+    property QtObject partner1: Node0 { value: weight1 }
+
+    value: weight1 * 10 + partner1.value
+    label: "Node1"
+    path: label + "/" + partner1.path
+}
@@ -0,0 +1,10 @@
+import QtQml 2.0
+
+Node4 {
+    property int weight10: 10
+    property QtObject partner10: Node3 { value: weight10 }
+
+    value: weight10 * 10 + partner10.value
+    label: "Node10"
+    path: label + "/" + partner10.path
+}
@@ -0,0 +1,10 @@
+import QtQml 2.0
+
+Node5 {
+    property int weight11: 11
+    property QtObject partner11: Node3 { value: weight11 }
+
+    value: weight11 * 10 + partner11.value
+    label: "Node11"
+    path: label + "/" + partner11.path
+}
@@ -0,0 +1,10 @@
+import QtQml 2.0
+
+Node5 {
+    property int weight12: 12
+    property QtObject partner12: Node4 { value: weight12 }
+
+    value: weight12 * 10 + partner12.value
+    label: "Node12"
+    path: label + "/" + partner12.path
+}
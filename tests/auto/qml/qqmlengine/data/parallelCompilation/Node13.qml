@@ -0,0 +1,10 @@
+import QtQml 2.0
+
+Node6 {
+    property int weight13: 13
+    property QtObject partner13: Node4 { value: weight13 }
+
+    value: weight13 * 10 + partner13.value
+    label: "Node13"
+    path: label + "/" + partner13.path
+}
@@ -0,0 +1,10 @@
+import QtQml 2.0
+
+Node6 {
+    property int weight14: 14
+    property QtObject partner14: Node4 { value: weight14 }
+
+    value: weight14 * 10 + partner14.value
+    label: "Node14"
+    path: label + "/" + partner14.path
+}
@@ -0,0 +1,10 @@
+import QtQml 2.0
+
+Node7 {
+    property int weight15: 15
+    property QtObject partner15: Node5 { value: weight15 }
+
+    value: weight15 * 10 + partner15.value
+    label: "Node15"
+    path: label + "/" + partner15.path
+}
@@ -0,0 +1,10 @@
+import QtQml 2.0
+
+Node0 {
+    property int weight2: 2
+    property QtObject partner2: Node0 { value: weight2 }
+
+    value: weight2 * 10 + partner2.value
+    label: "Node2"
+    path: label + "/" + partner2.path
+}
@@ -0,0 +1,10 @@
+import QtQml 2.0
+
+Node1 {
+    property int weight3: 3
+    property QtObject partner3: Node1 { value: weight3 }
+
+    value: weight3 * 10 + partner3.value
+    label: "Node3"
+    path: label + "/" + partner3.path
+}
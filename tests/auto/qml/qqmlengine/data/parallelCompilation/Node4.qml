@@ -0,0 +1,10 @@
+import QtQml 2.0
+
+Node1 {
+    property int weight4: 4
+    property QtObject partner4: Node1 { value: weight4 }
+
+    value: weight4 * 10 + partner4.value
+    label: "Node4"
+    path: label + "/" + partner4.path
+}
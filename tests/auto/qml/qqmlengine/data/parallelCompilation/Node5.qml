@@ -0,0 +1,10 @@
+import QtQml 2.0
+
+Node2 {
+    property int weight5: 5
+    property QtObject partner5: Node1 { value: weight5 }
+
+    value: weight5 * 10 + partner5.value
+    label: "Node5"
+    path: label + "/" + partner5.path
+}
@@ -0,0 +1,10 @@
+import QtQml 2.0
+
+Node2 {
+    property int weight6: 6
+    property QtObject partner6: Node2 { value: weight6 }
+
+    value: weight6 * 10 + partner6.value
+    label: "Node6"
+    path: label + "/" + partner6.path
+}
@@ -0,0 +1,10 @@
+import QtQml 2.0
+
+Node3 {
+    property int weight7: 7
+    property QtObject partner7: Node2 { value: weight7 }
+
+    value: weight7 * 10 + partner7.value
+    label: "Node7"
+    path: label + "/" + partner7.path
+}
@@ -0,0 +1,10 @@
+import QtQml 2.0
+
+Node3 {
+    property int weight8: 8
+    property QtObject partner8: Node2 { value: weight8 }
+
+    value: weight8 * 10 + partner8.value
+    label: "Node8"
+    path: label + "/" + partner8.path
+}
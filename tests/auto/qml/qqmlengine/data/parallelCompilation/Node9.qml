@@ -0,0 +1,10 @@
+import QtQml 2.0
+
+Node4 {
+    property int weight9: 9
+    property QtObject partner9: Node3 { value: weight9 }
+
+    value: weight9 * 10 + partner9.value
+    label: "Node9"
+    path: label + "/" + partner9.path
+}
@@ -53,6 +53,7 @@
 #include <QQmlNetworkAccessManagerFactory>
 #include <QQmlExpression>
 #include <QQmlIncubationController>
+#include <QThread>
 #include <private/qqmlengine_p.h>
 #include <private/qqmlabstracturlinterceptor_p.h>
 
@@ -82,6 +83,8 @@ private slots:
     void qtqmlModule();
     void urlInterceptor_data();
     void urlInterceptor();
+    void parallelCompilation_data();
+    void parallelCompilation();
 
 public slots:
     QObject *createAQObjectForOwnershipTest ()
@@ -770,6 +773,82 @@ void tst_qqmlengine::urlInterceptor()
     QCOMPARE(o->property("absoluteUrl").toString(), expectedAbsoluteUrl);
 }
 
+static void dumpObject(QObject *object, const QString &prefix, QStringList *dump)
+{
+    const QMetaObject *mo = object->metaObject();
+
+    // Composite type names carry a per-process counter
+    QString className = QString::fromUtf8(mo->className());
+    int suffix = className.indexOf(QLatin1String("_QML"));
+    if (suffix != -1)
+        className.truncate(suffix);
+    dump->append(prefix + QLatin1Char(':') + className);
+
+    for (int ii = 0; ii < mo->propertyCount(); ++ii) {
+        QMetaProperty property = mo->property(ii);
+        QString name = prefix + QLatin1Char('.') + QString::fromUtf8(property.name());
+        QVariant value = property.read(object);
+        if (QObject *child = qvariant_cast<QObject *>(value))
+            dumpObject(child, name, dump);
+        else
+            dump->append(name + QLatin1Char('=') + value.toString());
+    }
+}
+
+static QStringList dumpComponent(QQmlComponent *component)
+{
+    QStringList dump;
+    if (component->isError()) {
+        foreach (const QQmlError &error, component->errors())
+            dump.append(error.toString());
+        return dump;
+    }
+
+    QScopedPointer<QObject> object(component->create());
+    if (object)
+        dumpObject(object.data(), QLatin1String("root"), &dump);
+    return dump;
+}
+
+void tst_qqmlengine::parallelCompilation_data()
+{
+    QTest::addColumn<QString>("file");
+    QTest::addColumn<bool>("valid");
+
+    QTest::newRow("interdependent types") << "parallelCompilation/Main.qml" << true;
+    QTest::newRow("type with errors") << "parallelCompilation/BrokenMain.qml" << false;
+}
+
+// Compiling on worker threads must give the same types and errors as compiling serially
+void tst_qqmlengine::parallelCompilation()
+{
+    QFETCH(QString, file);
+    QFETCH(bool, valid);
+
+    QQmlEngine serialEngine;
+    QQmlEnginePrivate::get(&serialEngine)->typeLoader.setWorkerThreadCount(0);
+
+    QQmlComponent serialComponent(&serialEngine, testFileUrl(file));
+    QCOMPARE(serialComponent.isReady(), valid);
+    QStringList expected = dumpComponent(&serialComponent);
+    QVERIFY(!expected.isEmpty());
+
+    QQmlEngine parallelEngine;
+    QQmlEnginePrivate::get(&parallelEngine)->typeLoader.setWorkerThreadCount(qMax(4, QThread::idealThreadCount()));
+
+    for (int ii = 0; ii < 20; ++ii) {
+        parallelEngine.clearComponentCache();
+
+        QQmlComponent::CompilationMode mode = (ii % 2) ? QQmlComponent::Asynchronous
+                                                       : QQmlComponent::PreferSynchronous;
+        QQmlComponent component(&parallelEngine);
+        component.loadUrl(testFileUrl(file), mode);
+        QTRY_VERIFY(!component.isLoading());
+        QCOMPARE(component.isReady(), valid);
+        QCOMPARE(dumpComponent(&component), expected);
+    }
+}
+
 QTEST_MAIN(tst_qqmlengine)
 
 #include "tst_qqmlengine.moc"
@@ -42,6 +42,7 @@
 #include <qtest.h>
 #include "../../shared/util.h"
 #include <private/qqmlcompiler_p.h>
+#include <private/qqmlcomponent_p.h>
 
 #include <QVector3D>
 #include <QVector4D>
@@ -64,6 +65,8 @@ private slots:
     void vector3d();
     void vector4d();
     void time();
+
+    void internedOperands();
 };
 
 void tst_qqmlinstruction::dump()
@@ -704,6 +707,38 @@ void tst_qqmlinstruction::time()
     QCOMPARE(Q_ALIGNOF(QQmlInstruction::instr_storeTime::QTime), Q_ALIGNOF(QTime));
 }
 
+void tst_qqmlinstruction::internedOperands()
+{
+    QQmlEngine engine;
+    const QByteArray qml("import QtQml 2.0\nQtObject { objectName: \"shared name\" }");
+
+    QQmlComponent first(&engine);
+    first.setData(qml, QUrl("file:///first.qml"));
+    QQmlComponent second(&engine);
+    second.setData(qml, QUrl("file:///second.qml"));
+
+    QQmlCompiledData *firstData = QQmlComponentPrivate::get(&first)->cc;
+    QQmlCompiledData *secondData = QQmlComponentPrivate::get(&second)->cc;
+    QVERIFY(firstData);
+    QVERIFY(secondData);
+    QVERIFY(firstData != secondData);
+
+    int firstIndex = firstData->primitives.indexOf(QLatin1String("shared name"));
+    int secondIndex = secondData->primitives.indexOf(QLatin1String("shared name"));
+    QVERIFY(firstIndex != -1);
+    QVERIFY(secondIndex != -1);
+
+    // Both documents refer to the engine's copy of the string
+    QCOMPARE(firstData->primitives.at(firstIndex).constData(),
+             secondData->primitives.at(secondIndex).constData());
+
+    int count = 0, bytes = 0, hits = 0, bytesSaved = 0;
+    QQmlEnginePrivate::get(&engine)->internPool.stats(&count, &bytes, &hits, &bytesSaved);
+    QVERIFY(count > 0);
+    QVERIFY(hits > 0);
+    QVERIFY(bytesSaved >= int(sizeof("shared name") - 1) * int(sizeof(QChar)));
+}
+
 QTEST_MAIN(tst_qqmlinstruction)
 
 #include "tst_qqmlinstruction.moc"
@@ -43,6 +43,7 @@
 #include <QtQuick/private/qquicktext_p.h>
 #include <QtQml/private/qqmlengine_p.h>
 #include <QtQml/private/qqmllistmodel_p.h>
+#include <QtQml/private/qqmllistmodelworkeragent_p.h>
 #include <QtQml/private/qqmlexpression_p.h>
 #include <QQmlComponent>
 
@@ -111,6 +112,8 @@ private slots:
     void property_changes_worker_data();
     void worker_sync_data();
     void worker_sync();
+    void worker_sync_changes_data();
+    void worker_sync_changes();
     void worker_remove_element_data();
     void worker_remove_element();
     void worker_remove_list_data();
@@ -704,6 +707,88 @@ void tst_qqmllistmodelworkerscript::worker_sync()
     qApp->processEvents();
 }
 
+void tst_qqmllistmodelworkerscript::worker_sync_changes_data()
+{
+    worker_sync_data();
+}
+
+void tst_qqmllistmodelworkerscript::worker_sync_changes()
+{
+    QFETCH(bool, dynamicRoles);
+
+    // Each sync() replays only the changes made since the previous one, unless the model
+    // was also modified from the main thread.  Models with dynamic roles are always resynced.
+    const QQmlListModelWorkerAgent::SyncMode replay = dynamicRoles
+            ? QQmlListModelWorkerAgent::FullSync : QQmlListModelWorkerAgent::ReplaySync;
+
+    QQmlListModel model;
+    model.setDynamicRoles(dynamicRoles);
+    QQmlEngine eng;
+    QQmlComponent component(&eng, testFileUrl("model.qml"));
+    QQuickItem *item = createWorkerTest(&eng, &component, &model);
+    QVERIFY(item != 0);
+
+    QVariantList operations;
+    operations << "append({'name': 'a'})" << "append({'name': 'b'})" << "append({'name': 'c'})"
+               << "append({'name': 'd'})" << "append({'name': 'e'})";
+    QVERIFY(QMetaObject::invokeMethod(item, "evalExpressionViaWorker", Q_ARG(QVariant, operations)));
+    waitForWorker(item);
+
+    const int role = roleFromName(&model, "name");
+    QVERIFY(role != -1);
+    QString names;
+    for (int i = 0; i < model.count(); ++i)
+        names += model.data(i, role).toString();
+    QCOMPARE(names, QString("abcde"));
+    QCOMPARE(model.agent()->lastSyncMode(), replay);
+
+    QSignalSpy spyInserted(&model, SIGNAL(rowsInserted(QModelIndex,int,int)));
+    QSignalSpy spyRemoved(&model, SIGNAL(rowsRemoved(QModelIndex,int,int)));
+    QSignalSpy spyMoved(&model, SIGNAL(rowsMoved(QModelIndex,int,int,QModelIndex,int)));
+    QSignalSpy spyChanged(&model, SIGNAL(dataChanged(QModelIndex,QModelIndex,QVector<int>)));
+
+    operations.clear();
+    operations << "setProperty(1, 'name', 'B')" << "move(0, 3, 1)" << "remove(4)"
+               << "insert(0, {'name': 'f'})";
+    QVERIFY(QMetaObject::invokeMethod(item, "evalExpressionViaWorker", Q_ARG(QVariant, operations)));
+    waitForWorker(item);
+
+    names.clear();
+    for (int i = 0; i < model.count(); ++i)
+        names += model.data(i, role).toString();
+    QCOMPARE(names, QString("fBcda"));
+    QCOMPARE(model.agent()->lastSyncMode(), replay);
+    QCOMPARE(spyChanged.count(), 1);
+    QCOMPARE(spyMoved.count(), 1);
+    QCOMPARE(spyRemoved.count(), 1);
+    QCOMPARE(spyInserted.count(), 1);
+
+    // A change made on the main thread is overwritten by the worker's copy.
+    model.setProperty(0, "name", "g");
+    operations.clear();
+    operations << "setProperty(2, 'name', 'C')";
+    QVERIFY(QMetaObject::invokeMethod(item, "evalExpressionViaWorker", Q_ARG(QVariant, operations)));
+    waitForWorker(item);
+
+    names.clear();
+    for (int i = 0; i < model.count(); ++i)
+        names += model.data(i, role).toString();
+    QCOMPARE(names, QString("fBCda"));
+    QCOMPARE(model.agent()->lastSyncMode(), QQmlListModelWorkerAgent::FullSync);
+
+    operations.clear();
+    operations << "append({'name': 'h'})" << "clear()" << "append({'name': 'x'})";
+    QVERIFY(QMetaObject::invokeMethod(item, "evalExpressionViaWorker", Q_ARG(QVariant, operations)));
+    waitForWorker(item);
+
+    QCOMPARE(model.count(), 1);
+    QCOMPARE(model.data(0, role).toString(), QString("x"));
+    QCOMPARE(model.agent()->lastSyncMode(), replay);
+
+    delete item;
+    qApp->processEvents();
+}
+
 void tst_qqmllistmodelworkerscript::worker_remove_element_data()
 {
     worker_sync_data();
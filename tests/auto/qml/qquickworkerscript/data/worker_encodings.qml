@@ -0,0 +1,66 @@
+import QtQuick 2.0
+
+BaseWorker {
+    id: worker
+    source: "script.js"
+
+    property var sent
+    property bool matches: false
+
+    // Unlike ==, tells NaN, 0 and -0 apart exactly.
+    function same(a, b) {
+        if (typeof a != typeof b)
+            return false
+        if (typeof a == "number")
+            return a === b ? (a !== 0 || 1 / a === 1 / b) : (a !== a && b !== b)
+        if (a === null || b === null || typeof a != "object")
+            return a === b
+        if ((a instanceof Array) != (b instanceof Array))
+            return false
+        var keys = Object.keys(a)
+        if (keys.length != Object.keys(b).length)
+            return false
+        for (var i = 0; i < keys.length; ++i) {
+            if (!b.hasOwnProperty(keys[i]) || !same(a[keys[i]], b[keys[i]]))
+                return false
+        }
+        return true
+    }
+
+    function longString(length) {
+        var s = ""
+        for (var i = 0; i < length; ++i)
+            s += String.fromCharCode(0x20 + (i * 7919) % 0xd000)
+        return s
+    }
+
+    function numbers() {
+        return [0, -0, NaN, Infinity, -Infinity, 1.7976931348623157e308, -1e308, 5e-324,
+                9007199254740993, 2147483647, 2147483648, -2147483649, 4294967296,
+                0.1, 1 / 3, -42, 7]
+    }
+
+    function value(kind) {
+        switch (kind) {
+        case "shared string":
+            return longString(1500)
+        case "number array":
+            return numbers()
+        case "short number array":
+            return [NaN, -0, 1e300]
+        case "mixed array":
+            var mixed = numbers()
+            mixed.push("text", longString(1100), true, null, [-0, NaN], { "a": -0, "b": "c" })
+            return mixed
+        }
+        return undefined
+    }
+
+    function testSendValue(kind) {
+        worker.matches = false
+        worker.sent = value(kind)
+        worker.sendMessage(worker.sent)
+    }
+
+    onMessage: worker.matches = same(worker.sent, messageObject)
+}
@@ -0,0 +1,6 @@
+import QtQuick 2.2
+
+BaseWorker {
+    source: "script.js"
+    workerThread: 5
+}
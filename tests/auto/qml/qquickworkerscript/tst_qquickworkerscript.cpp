@@ -64,11 +64,15 @@ private slots:
     void messaging_sendQObjectList();
     void messaging_sendJsObject();
     void messaging_sendExternalObject();
+    void messaging_encodings();
+    void messaging_encodings_data();
+    void messaging_sendByteArray();
     void script_with_pragma();
     void script_included();
     void scriptError_onLoad();
     void scriptError_onCall();
     void stressDispose();
+    void threadPool();
 
 private:
     void waitForEchoMessage(QQuickWorkerScript *worker) {
@@ -205,6 +209,57 @@ void tst_QQuickWorkerScript::messaging_sendExternalObject()
     delete obj;
 }
 
+void tst_QQuickWorkerScript::messaging_encodings()
+{
+    QFETCH(QString, kind);
+
+    QQmlComponent component(&m_engine, testFileUrl("worker_encodings.qml"));
+    QQuickWorkerScript *worker = qobject_cast<QQuickWorkerScript*>(component.create());
+    QVERIFY(worker != 0);
+
+    // The value is built, sent and compared in JavaScript, as converting it to
+    // a QVariant would lose NaN and -0.
+    QVERIFY(QMetaObject::invokeMethod(worker, "testSendValue", Q_ARG(QVariant, kind)));
+    waitForEchoMessage(worker);
+
+    QVERIFY(worker->property("matches").toBool());
+
+    qApp->processEvents();
+    delete worker;
+}
+
+void tst_QQuickWorkerScript::messaging_encodings_data()
+{
+    QTest::addColumn<QString>("kind");
+
+    QTest::newRow("shared string") << "shared string";
+    QTest::newRow("number array") << "number array";
+    QTest::newRow("short number array") << "short number array";
+    QTest::newRow("mixed array") << "mixed array";
+}
+
+void tst_QQuickWorkerScript::messaging_sendByteArray()
+{
+    QQmlComponent component(&m_engine, testFileUrl("worker.qml"));
+    QQuickWorkerScript *worker = qobject_cast<QQuickWorkerScript*>(component.create());
+    QVERIFY(worker != 0);
+
+    QByteArray bytes;
+    for (int i = 0; i < 3000; ++i)
+        bytes.append(char(i * 31));
+
+    QVERIFY(QMetaObject::invokeMethod(worker, "testSend", Q_ARG(QVariant, QVariant(bytes))));
+    waitForEchoMessage(worker);
+
+    const QMetaObject *mo = worker->metaObject();
+    QVariant response = mo->property(mo->indexOfProperty("response")).read(worker).value<QVariant>();
+    QCOMPARE(response.userType(), int(QMetaType::QByteArray));
+    QCOMPARE(response.toByteArray(), bytes);
+
+    qApp->processEvents();
+    delete worker;
+}
+
 void tst_QQuickWorkerScript::script_with_pragma()
 {
     QVariant value(100);
@@ -295,6 +350,50 @@ void tst_QQuickWorkerScript::stressDispose()
     }
 }
 
+void tst_QQuickWorkerScript::threadPool()
+{
+    QQmlEngine engine;
+    QQmlEnginePrivate *ep = QQmlEnginePrivate::get(&engine);
+    ep->workerScriptThreadCount = 3;
+
+    QQmlComponent component(&engine, testFileUrl("worker.qml"));
+    QList<QQuickWorkerScript *> workers;
+    for (int ii = 0; ii < 4; ++ii) {
+        QQuickWorkerScript *worker = qobject_cast<QQuickWorkerScript*>(component.create());
+        QVERIFY(worker != 0);
+        workers << worker;
+    }
+
+    // Assigned round-robin, threads are only created when needed
+    QCOMPARE(ep->workerScriptEngines.count(), 3);
+    QVERIFY(ep->workerScriptEngines.at(0) != ep->workerScriptEngines.at(1));
+    QVERIFY(ep->workerScriptEngines.at(1) != ep->workerScriptEngines.at(2));
+
+    QQmlComponent pinnedComponent(&engine, testFileUrl("worker_pinned.qml"));
+    QQuickWorkerScript *pinned = qobject_cast<QQuickWorkerScript*>(pinnedComponent.create());
+    QVERIFY(pinned != 0);
+    QCOMPARE(pinned->workerThread(), 5);
+    QCOMPARE(ep->workerScriptEngines.count(), 3);
+    workers << pinned;
+
+    // workerThread was added in QtQuick 2.2
+    QQmlComponent oldComponent(&engine);
+    oldComponent.setData("import QtQuick 2.0\nWorkerScript { workerThread: 1 }", QUrl());
+    QVERIFY(oldComponent.isError());
+
+    foreach (QQuickWorkerScript *worker, workers) {
+        QVariant value(workers.indexOf(worker));
+        QVERIFY(QMetaObject::invokeMethod(worker, "testSend", Q_ARG(QVariant, value)));
+        waitForEchoMessage(worker);
+
+        const QMetaObject *mo = worker->metaObject();
+        QCOMPARE(mo->property(mo->indexOfProperty("response")).read(worker).value<QVariant>(), value);
+    }
+
+    qApp->processEvents();
+    qDeleteAll(workers);
+}
+
 QTEST_MAIN(tst_QQuickWorkerScript)
 
 #include "tst_qquickworkerscript.moc"
@@ -0,0 +1,20 @@
+import QtQuick 2.0
+
+Rectangle {
+    width: 300; height: 200
+    color: "blue"
+
+    // Small images end up next to each other in the texture atlas. Scaling one
+    // up with linear filtering must not pick up pixels from its neighbours.
+    Image {
+        source: "heart.png"
+        x: 200; width: 100; height: 100
+    }
+
+    Image {
+        objectName: "scaled"
+        source: "green.png"; sourceSize.width: 4; sourceSize.height: 4
+        width: 200; height: 200
+        smooth: true
+    }
+}
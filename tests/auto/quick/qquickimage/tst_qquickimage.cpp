@@ -93,6 +93,7 @@ private slots:
     void big();
     void tiling_QTBUG_6716();
     void tiling_QTBUG_6716_data();
+    void atlasNoBleeding();
     void noLoading();
     void paintedWidthHeight();
     void sourceSize_QTBUG_14303();
@@ -519,6 +520,23 @@ void tst_qquickimage::tiling_QTBUG_6716_data()
     QTest::newRow("horizontal_tiling") << "htiling.qml";
 }
 
+void tst_qquickimage::atlasNoBleeding()
+{
+    QQuickView view(testFileUrl("atlas.qml"));
+    view.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&view));
+
+    QQuickImage *scaled = findItem<QQuickImage>(view.rootObject(), "scaled");
+    QVERIFY(scaled != 0);
+    QTRY_COMPARE(scaled->status(), QQuickImage::Ready);
+
+    QImage img = view.grabWindow();
+    for (int x = 0; x < scaled->width(); ++x) {
+        for (int y = 0; y < scaled->height(); ++y)
+            QCOMPARE(img.pixel(x, y), qRgb(0, 255, 0));
+    }
+}
+
 void tst_qquickimage::noLoading()
 {
     qRegisterMetaType<QQuickImageBase::Status>();
@@ -0,0 +1,39 @@
+import QtQuick 2.2
+import QtQml.Models 2.1
+
+ListView {
+    id: list
+    width: 240
+    height: 320
+    cacheBuffer: 0
+    reuseItems: true
+
+    property int createdCount: 0
+    property int pooledCount: 0
+    property int reusedCount: 0
+
+    model: ListModel {
+        id: listModel
+        Component.onCompleted: {
+            for (var i = 0; i < 100; ++i)
+                append({ "name": "Item" + i })
+        }
+    }
+
+    delegate: Rectangle {
+        objectName: "wrapper"
+        width: list.width
+        height: 20
+
+        property int modelIndex: index
+        property string modelName: name
+        property bool highlighted: false
+
+        Component.onCompleted: list.createdCount++
+        DelegateModel.onPooled: list.pooledCount++
+        DelegateModel.onReused: {
+            list.reusedCount++
+            highlighted = false
+        }
+    }
+}
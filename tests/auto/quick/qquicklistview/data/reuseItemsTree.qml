@@ -0,0 +1,24 @@
+import QtQuick 2.2
+
+ListView {
+    id: list
+    width: 240
+    height: 320
+    cacheBuffer: 0
+    reuseItems: true
+
+    property int reusedCount: 0
+
+    model: treeModel
+
+    delegate: Rectangle {
+        objectName: "wrapper"
+        width: list.width
+        height: 20
+
+        property int modelIndex: index
+        property bool modelHasChildren: hasModelChildren
+
+        DelegateModel.onReused: list.reusedCount++
+    }
+}
@@ -41,6 +41,7 @@
 
 #include <QtTest/QtTest>
 #include <QtCore/QStringListModel>
+#include <QtGui/QStandardItemModel>
 #include <QtQuick/qquickview.h>
 #include <QtQml/qqmlengine.h>
 #include <QtQml/qqmlcontext.h>
@@ -209,6 +210,8 @@ private slots:
     void defaultHighlightMoveDuration();
     void accessEmptyCurrentItem_QTBUG_30227();
     void delayedChanges_QTBUG_30555();
+    void reuseItems();
+    void reuseItems_hasModelChildren();
 
 private:
     template <class T> void items(const QUrl &source);
@@ -6880,6 +6883,93 @@ void tst_QQuickListView::delayedChanges_QTBUG_30555()
     delete window;
 }
 
+void tst_QQuickListView::reuseItems()
+{
+    QQuickView *window = createView();
+    window->setSource(testFileUrl("reuseItems.qml"));
+    window->show();
+    QVERIFY(QTest::qWaitForWindowExposed(window));
+
+    QQuickListView *listview = qobject_cast<QQuickListView *>(window->rootObject());
+    QVERIFY(listview != 0);
+    QVERIFY(listview->reuseItems());
+    QTRY_COMPARE(QQuickItemPrivate::get(listview)->polishScheduled, false);
+
+    QQuickItem *contentItem = listview->contentItem();
+    const int createdCount = listview->property("createdCount").toInt();
+    QVERIFY(createdCount > 0);
+
+    // Each step releases the item leaving the top of the view, which is then reused for the
+    // item entering at the bottom on the following step.
+    for (int y = 10; y <= 400; y += 10) {
+        listview->setContentY(y);
+        QTRY_COMPARE(QQuickItemPrivate::get(listview)->polishScheduled, false);
+    }
+
+    QVERIFY(listview->property("pooledCount").toInt() > 0);
+    QVERIFY(listview->property("reusedCount").toInt() > 0);
+    QVERIFY(listview->property("createdCount").toInt() <= createdCount + 1);
+
+    for (int i = 20; i < 30; ++i) {
+        QQuickItem *item = findItem<QQuickItem>(contentItem, "wrapper", i);
+        QVERIFY(item);
+        QCOMPARE(item->y(), qreal(i * 20));
+        QCOMPARE(item->property("modelIndex").toInt(), i);
+        QCOMPARE(item->property("modelName").toString(), QString("Item%1").arg(i));
+    }
+
+    // Disabling reuse destroys the pooled items, and new items are created again.
+    listview->setReuseItems(false);
+    const int reusedCount = listview->property("reusedCount").toInt();
+    listview->setContentY(800);
+    QTRY_COMPARE(QQuickItemPrivate::get(listview)->polishScheduled, false);
+    QCOMPARE(listview->property("reusedCount").toInt(), reusedCount);
+    QQuickItem *item = findItem<QQuickItem>(contentItem, "wrapper", 40);
+    QVERIFY(item);
+    QCOMPARE(item->property("modelName").toString(), QString("Item40"));
+
+    delete window;
+}
+
+void tst_QQuickListView::reuseItems_hasModelChildren()
+{
+    // Every third row has children, so reused items are rebound to rows which
+    // differ from their previous one.
+    QStandardItemModel model;
+    for (int i = 0; i < 100; ++i) {
+        QStandardItem *item = new QStandardItem(QString("Item%1").arg(i));
+        if (i % 3 == 0)
+            item->appendRow(new QStandardItem(QString("Child%1").arg(i)));
+        model.appendRow(item);
+    }
+
+    QQuickView *window = createView();
+    window->rootContext()->setContextProperty("treeModel", &model);
+    window->setSource(testFileUrl("reuseItemsTree.qml"));
+    window->show();
+    QVERIFY(QTest::qWaitForWindowExposed(window));
+
+    QQuickListView *listview = qobject_cast<QQuickListView *>(window->rootObject());
+    QVERIFY(listview != 0);
+    QTRY_COMPARE(QQuickItemPrivate::get(listview)->polishScheduled, false);
+
+    for (int y = 10; y <= 400; y += 10) {
+        listview->setContentY(y);
+        QTRY_COMPARE(QQuickItemPrivate::get(listview)->polishScheduled, false);
+    }
+    QVERIFY(listview->property("reusedCount").toInt() > 0);
+
+    QQuickItem *contentItem = listview->contentItem();
+    for (int i = 20; i < 30; ++i) {
+        QQuickItem *item = findItem<QQuickItem>(contentItem, "wrapper", i);
+        QVERIFY(item);
+        QCOMPARE(item->property("modelIndex").toInt(), i);
+        QCOMPARE(item->property("modelHasChildren").toBool(), i % 3 == 0);
+    }
+
+    delete window;
+}
+
 QTEST_MAIN(tst_QQuickListView)
 
 #include "tst_qquicklistview.moc"
@@ -44,10 +44,17 @@
 #include <QtQml/qqmlengine.h>
 #include <QtQuick/qquickimageprovider.h>
 #include <QNetworkReply>
+#include <QTemporaryDir>
 #include "../../shared/util.h"
 #include "testhttpserver.h"
 #include <QtNetwork/QNetworkConfigurationManager>
 
+#ifdef Q_OS_UNIX
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 #ifndef QT_NO_CONCURRENT
 #include <qtconcurrentrun.h>
 #include <qfuture.h>
@@ -75,6 +82,10 @@ private slots:
 #endif
     void lockingCrash();
     void uncached();
+    void cacheLimit();
+    void diskCache();
+    void loadPriority();
+    void cancelQueued();
 #if PIXMAP_DATA_LEAK_TEST
     void dataLeak();
 #endif
@@ -473,6 +484,283 @@ void tst_qquickpixmapcache::uncached()
     }
 }
 
+void tst_qquickpixmapcache::cacheLimit()
+{
+    QQmlEngine engine;
+    engine.addImageProvider(QLatin1String("mypixmaps"), new MyPixmapProvider);
+    const int defaultLimit = QQuickPixmap::cacheLimit();
+
+    QUrl url("image://mypixmaps/limited");
+    MyPixmapProvider::fillColor = qRgb(255, 0, 0);
+    {
+        QQuickPixmap p;
+        p.load(&engine, url, QQuickPixmap::Cache);
+    }
+
+    // The released pixmap fits into the default limit, so it is still cached
+    MyPixmapProvider::fillColor = qRgb(0, 255, 0);
+    {
+        QQuickPixmap p;
+        p.load(&engine, url, QQuickPixmap::Cache);
+        QCOMPARE(p.image().pixel(0,0), qRgb(255, 0, 0));
+    }
+
+    // Lowering the limit below the size of the pixmap releases it, and it is
+    // not kept once it is unreferenced again
+    QQuickPixmap::setCacheLimit(1024 * 1024);
+    QCOMPARE(QQuickPixmap::cacheLimit(), 1024 * 1024);
+    {
+        QQuickPixmap p;
+        p.load(&engine, url, QQuickPixmap::Cache);
+        QCOMPARE(p.image().pixel(0,0), qRgb(0, 255, 0));
+    }
+
+    MyPixmapProvider::fillColor = qRgb(0, 0, 255);
+    {
+        QQuickPixmap p;
+        p.load(&engine, url, QQuickPixmap::Cache);
+        QCOMPARE(p.image().pixel(0,0), qRgb(0, 0, 255));
+    }
+
+    QQuickPixmap::setCacheLimit(defaultLimit);
+    MyPixmapProvider::fillColor = qRgb(255, 0, 0);
+}
+
+void tst_qquickpixmapcache::diskCache()
+{
+    QTemporaryDir cacheDir;
+    QVERIFY(cacheDir.isValid());
+    QQuickPixmap::setDiskCachePath(cacheDir.path());
+    QCOMPARE(QQuickPixmap::diskCachePath(), cacheDir.path());
+    const int defaultLimit = QQuickPixmap::diskCacheLimit();
+
+    QUrl url = testFileUrl("exists.png");
+    {
+        QQuickPixmap p;
+        p.load(&engine, url, QSize(), 0);
+        QVERIFY(p.isReady());
+        QVERIFY(p.image().pixel(0, 0) != qRgb(255, 0, 0));
+    }
+    QDir dir(cacheDir.path());
+    QStringList entries = dir.entryList(QDir::Files);
+    QCOMPARE(entries.count(), 1);
+
+    // Paint the cached pixels red, so that only a cache hit loads a red image
+    QFile cacheFile(dir.filePath(entries.first()));
+    QVERIFY(cacheFile.open(QIODevice::ReadWrite));
+    const int headerSize = 8 * sizeof(qint32);
+    QVERIFY(cacheFile.size() > headerSize);
+    QVector<QRgb> red((cacheFile.size() - headerSize) / sizeof(QRgb), qRgb(255, 0, 0));
+    QVERIFY(cacheFile.seek(headerSize));
+    QVERIFY(cacheFile.write(reinterpret_cast<const char *>(red.constData()), red.count() * sizeof(QRgb)) > 0);
+    cacheFile.close();
+
+    QQuickPixmap::purgeCache();
+    {
+        QQuickPixmap p;
+        p.load(&engine, url, QSize(), 0);
+        QVERIFY(p.isReady());
+        QCOMPARE(p.image().pixel(0, 0), qRgb(255, 0, 0));
+    }
+    QCOMPARE(dir.entryList(QDir::Files).count(), 1);
+
+    // A different requested size is a different entry
+    {
+        QQuickPixmap p;
+        p.load(&engine, url, QSize(1, 1), 0);
+        QVERIFY(p.isReady());
+        QCOMPARE(p.width(), 1);
+    }
+    QCOMPARE(dir.entryList(QDir::Files).count(), 2);
+
+    // Lowering the limit prunes the cache
+    QQuickPixmap::setDiskCacheLimit(0);
+    QCOMPARE(QQuickPixmap::diskCacheLimit(), 0);
+    QCOMPARE(dir.entryList(QDir::Files).count(), 0);
+
+    // Entries larger than the limit are not written at all
+    {
+        QQuickPixmap p;
+        p.load(&engine, url, QSize(3, 3), 0);
+        QVERIFY(p.isReady());
+    }
+    QCOMPARE(dir.entryList(QDir::Files).count(), 0);
+
+    QQuickPixmap::setDiskCacheLimit(defaultLimit);
+    QQuickPixmap::purgeCache();
+    {
+        QQuickPixmap p;
+        p.load(&engine, url, QSize(3, 3), 0);
+        QVERIFY(p.isReady());
+    }
+    entries = dir.entryList(QDir::Files);
+    QCOMPARE(entries.count(), 1);
+    const QString olderEntry = dir.filePath(entries.first());
+
+    // Writing past the limit removes older entries, but not the new one
+    QQuickPixmap::setDiskCacheLimit(QFileInfo(olderEntry).size() + 1);
+    {
+        QQuickPixmap p;
+        p.load(&engine, url, QSize(2, 2), 0);
+        QVERIFY(p.isReady());
+        QCOMPARE(p.width(), 2);
+    }
+    entries = dir.entryList(QDir::Files);
+    QCOMPARE(entries.count(), 1);
+    QVERIFY(dir.filePath(entries.first()) != olderEntry);
+
+    QQuickPixmap::setDiskCacheLimit(defaultLimit);
+    QQuickPixmap::setDiskCachePath(QString());
+}
+
+// Blocks the reader thread in requestImage() until released, so that the
+// requests made in the meantime stay queued.
+class BlockingImageProvider : public QQuickImageProvider
+{
+public:
+    BlockingImageProvider()
+        : QQuickImageProvider(Image, ForceAsynchronousImageLoading) {}
+
+    virtual QImage requestImage(const QString &, QSize *size, const QSize &) {
+        entered.release();
+        released.acquire();
+        QImage image(4, 4, QImage::Format_RGB32);
+        image.fill(Qt::blue);
+        if (size)
+            *size = image.size();
+        return image;
+    }
+
+    QSemaphore entered;
+    QSemaphore released;
+};
+
+class BlockingImageRelease
+{
+public:
+    BlockingImageRelease(BlockingImageProvider *provider) : provider(provider) {}
+    ~BlockingImageRelease() { provider->released.release(); }
+
+private:
+    BlockingImageProvider *provider;
+};
+
+class FinishedRecorder : public QObject
+{
+    Q_OBJECT
+public:
+    FinishedRecorder(int id, QList<int> *finished, QObject *parent = 0)
+        : QObject(parent), id(id), finished(finished) {}
+
+public slots:
+    void done() { finished->append(id); }
+
+private:
+    int id;
+    QList<int> *finished;
+};
+
+void tst_qquickpixmapcache::loadPriority()
+{
+    QQmlEngine engine;
+    BlockingImageProvider *provider = new BlockingImageProvider;
+    engine.addImageProvider(QLatin1String("blocking"), provider);
+    QQuickPixmap::setDecodingThreadCount(&engine, 1);
+    QCOMPARE(QQuickPixmap::decodingThreadCount(&engine), 1);
+
+    QList<int> finished;
+    QObject recorders;
+    QQuickPixmap blocker;
+    QQuickPixmap pixmaps[4];
+    {
+        BlockingImageRelease release(provider);
+        blocker.load(&engine, QUrl("image://blocking/priority"), QQuickPixmap::Asynchronous);
+        QVERIFY(provider->entered.tryAcquire(1, 5000));
+
+        // Distinct request sizes keep the requests apart, as they are not cached
+        for (int i = 0; i < 4; ++i) {
+            pixmaps[i].load(&engine, testFileUrl("exists.png"), QSize(i + 1, i + 1), QQuickPixmap::Asynchronous);
+            QVERIFY(pixmaps[i].isLoading());
+            QVERIFY(pixmaps[i].connectFinished(new FinishedRecorder(i, &finished, &recorders), SLOT(done())));
+        }
+        pixmaps[2].setLoadPriority(10);
+        pixmaps[0].setLoadPriority(5);
+    }
+
+    // With a single decoding thread the jobs are started, and so finish, one at
+    // a time: highest priority first, then newest first.
+    QTRY_COMPARE(finished.count(), 4);
+    QCOMPARE(finished, QList<int>() << 2 << 0 << 3 << 1);
+}
+
+void tst_qquickpixmapcache::cancelQueued()
+{
+#ifndef Q_OS_UNIX
+    QSKIP("Needs a named pipe to hold a decoding job");
+#else
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString fifoPath = dir.path() + QLatin1String("/fifo.png");
+    QVERIFY(::mkfifo(QFile::encodeName(fifoPath).constData(), 0600) == 0);
+
+    QFile source(testFile("exists.png"));
+    QVERIFY(source.open(QIODevice::ReadOnly));
+    const QByteArray png = source.readAll();
+
+    QQmlEngine engine;
+    BlockingImageProvider *provider = new BlockingImageProvider;
+    engine.addImageProvider(QLatin1String("blocking"), provider);
+    QQuickPixmap::setDecodingThreadCount(&engine, 1);
+
+    QList<int> finished;
+    FinishedRecorder queuedRecorder(0, &finished);
+    FinishedRecorder decodingRecorder(1, &finished);
+    FinishedRecorder lastRecorder(2, &finished);
+
+    QQuickPixmap blocker;
+    QQuickPixmap queued;
+    QQuickPixmap decoding;
+    QQuickPixmap last;
+    {
+        BlockingImageRelease release(provider);
+        blocker.load(&engine, QUrl("image://blocking/cancel"), QQuickPixmap::Asynchronous);
+        QVERIFY(provider->entered.tryAcquire(1, 5000));
+
+        // Opening the pipe blocks the decoding job until the test writes to it
+        decoding.load(&engine, QUrl::fromLocalFile(fifoPath), QQuickPixmap::Asynchronous);
+        QVERIFY(decoding.connectFinished(&decodingRecorder, SLOT(done())));
+        decoding.setLoadPriority(10);
+
+        queued.load(&engine, testFileUrl("exists.png"), QSize(1, 1), QQuickPixmap::Asynchronous);
+        QVERIFY(queued.connectFinished(&queuedRecorder, SLOT(done())));
+        last.load(&engine, testFileUrl("exists.png"), QSize(2, 2), QQuickPixmap::Asynchronous);
+        QVERIFY(last.connectFinished(&lastRecorder, SLOT(done())));
+
+        queued.clear();
+    }
+
+    // The pipe can only be opened for writing once the decoding job has opened
+    // it for reading.
+    int fd = -1;
+    for (int i = 0; fd == -1 && i < 500; ++i) {
+        fd = ::open(QFile::encodeName(fifoPath).constData(), O_WRONLY | O_NONBLOCK);
+        if (fd == -1)
+            QTest::qWait(10);
+    }
+    QVERIFY(fd != -1);
+
+    decoding.clear();
+    QVERIFY(::write(fd, png.constData(), png.size()) == png.size());
+    ::close(fd);
+
+    QTRY_COMPARE(finished, QList<int>() << 2);
+    QVERIFY(last.isReady());
+
+    // Give a late delivery of the cancelled replies a chance to show up
+    QTest::qWait(50);
+    QCOMPARE(finished, QList<int>() << 2);
+#endif
+}
 
 #if PIXMAP_DATA_LEAK_TEST
 // This test should not be enabled by default as it
@@ -250,6 +250,31 @@ int TestTouchItem::mousePressNum = 0;
 int TestTouchItem::mouseMoveNum = 0;
 int TestTouchItem::mouseReleaseNum = 0;
 
+class PressRecordingItem : public QQuickItem
+{
+Q_OBJECT
+public:
+    PressRecordingItem(QQuickItem *parent = 0) : QQuickItem(parent)
+    {
+        setAcceptedMouseButtons(Qt::LeftButton);
+    }
+
+    static QQuickItem *pressedItem;
+
+protected:
+    void mousePressEvent(QMouseEvent *) { pressedItem = this; }
+};
+
+QQuickItem *PressRecordingItem::pressedItem = 0;
+
+static QQuickItem *itemPressedAt(QQuickWindow *window, const QPoint &pos)
+{
+    PressRecordingItem::pressedItem = 0;
+    QTest::mousePress(window, Qt::LeftButton, 0, pos);
+    QTest::mouseRelease(window, Qt::LeftButton, 0, pos);
+    return PressRecordingItem::pressedItem;
+}
+
 class ConstantUpdateItem : public QQuickItem
 {
 Q_OBJECT
@@ -315,6 +340,8 @@ private slots:
 
     void ignoreUnhandledMouseEvents();
 
+    void mousePressTarget();
+
     void ownershipRootItem();
 
     void hideThenDelete_data();
@@ -1154,6 +1181,80 @@ void tst_qquickwindow::ignoreUnhandledMouseEvents()
 }
 
 
+void tst_qquickwindow::mousePressTarget()
+{
+    QQuickWindow window;
+    window.resize(200, 200);
+
+    PressRecordingItem bottom(window.contentItem());
+    bottom.setSize(QSizeF(100, 100));
+
+    PressRecordingItem top(window.contentItem());
+    top.setPosition(QPointF(50, 50));
+    top.setSize(QSizeF(100, 100));
+
+    QQuickItem clippingItem(window.contentItem());
+    clippingItem.setPosition(QPointF(100, 0));
+    clippingItem.setSize(QSizeF(50, 50));
+    clippingItem.setClip(true);
+
+    PressRecordingItem clippedItem(&clippingItem);
+    clippedItem.setSize(QSizeF(100, 100));
+
+    // Enough items that the window doesn't just scan a handful of them
+    QList<QQuickItem *> strip;
+    for (int ii = 0; ii < 40; ++ii) {
+        PressRecordingItem *item = new PressRecordingItem(window.contentItem());
+        item->setPosition(QPointF(ii * 5, 150));
+        item->setSize(QSizeF(5, 50));
+        strip.append(item);
+    }
+
+    window.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&window));
+
+    QCOMPARE(itemPressedAt(&window, QPoint(12, 175)), strip.at(2));
+    QCOMPARE(itemPressedAt(&window, QPoint(197, 175)), strip.at(39));
+
+    // Later siblings are stacked on top, unless z says otherwise.
+    QCOMPARE(itemPressedAt(&window, QPoint(75, 75)), &top);
+    bottom.setZ(1);
+    QCOMPARE(itemPressedAt(&window, QPoint(75, 75)), &bottom);
+    QCOMPARE(itemPressedAt(&window, QPoint(125, 75)), &top);
+
+    // Only the part of clippedItem inside clippingItem takes presses, also
+    // after clippingItem moved.
+    QCOMPARE(itemPressedAt(&window, QPoint(125, 25)), &clippedItem);
+    QCOMPARE(itemPressedAt(&window, QPoint(175, 25)), static_cast<QQuickItem *>(0));
+    clippingItem.setX(150);
+    QCOMPARE(itemPressedAt(&window, QPoint(175, 25)), &clippedItem);
+    QCOMPARE(itemPressedAt(&window, QPoint(125, 25)), static_cast<QQuickItem *>(0));
+
+    // A child is reached before its parent, wherever it came from.
+    clippedItem.setParentItem(&bottom);
+    QCOMPARE(itemPressedAt(&window, QPoint(25, 25)), &clippedItem);
+    QCOMPARE(itemPressedAt(&window, QPoint(75, 75)), &clippedItem);
+    QCOMPARE(itemPressedAt(&window, QPoint(175, 25)), static_cast<QQuickItem *>(0));
+
+    clippedItem.setVisible(false);
+    QCOMPARE(itemPressedAt(&window, QPoint(25, 25)), &bottom);
+    bottom.setEnabled(false);
+    QCOMPARE(itemPressedAt(&window, QPoint(75, 75)), &top);
+    bottom.setEnabled(true);
+
+    // Moving the new parent moves the reparented item along.
+    clippedItem.setParentItem(&clippingItem);
+    clippedItem.setVisible(true);
+    clippingItem.setX(100);
+    QCOMPARE(itemPressedAt(&window, QPoint(125, 25)), &clippedItem);
+    QCOMPARE(itemPressedAt(&window, QPoint(25, 25)), &bottom);
+
+    delete strip.takeAt(2);
+    QCOMPARE(itemPressedAt(&window, QPoint(12, 175)), static_cast<QQuickItem *>(0));
+    QCOMPARE(itemPressedAt(&window, QPoint(17, 175)), strip.at(2));
+    qDeleteAll(strip);
+}
+
 void tst_qquickwindow::ownershipRootItem()
 {
     qmlRegisterType<RootItemAccessor>("Test", 1, 0, "RootItemAccessor");
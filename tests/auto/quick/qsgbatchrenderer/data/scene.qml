@@ -0,0 +1,157 @@
+import QtQuick 2.0
+
+Rectangle {
+    id: root
+    width: 320
+    height: 240
+    color: "white"
+
+    // Toggled by the test to check that updates to batched nodes are drawn
+    property bool changed: false
+
+    // Flat colors with mixed opacities, interleaved with other materials
+    Repeater {
+        model: 8
+        Rectangle {
+            x: 10 + index * 12
+            y: 10
+            width: 20
+            height: 40
+            color: index % 2 ? "red" : "blue"
+            opacity: index % 3 ? 1 : 0.5
+        }
+    }
+
+    Rectangle {
+        x: 120
+        y: 10
+        width: 60
+        height: 40
+        gradient: Gradient {
+            GradientStop { position: 0; color: root.changed ? "yellow" : "black" }
+            GradientStop { position: 1; color: "cyan" }
+        }
+    }
+
+    Image {
+        x: 190
+        y: 10
+        width: 40
+        height: 40
+        source: "colors.png"
+    }
+
+    Rectangle {
+        x: 210
+        y: 30
+        width: 40
+        height: 40
+        color: "magenta"
+        opacity: 0.6
+    }
+
+    Text {
+        x: 260
+        y: 10
+        text: "Batch"
+        font.pixelSize: 16
+    }
+
+    // Scissor clip
+    Item {
+        x: 10
+        y: 70
+        width: 100
+        height: 60
+        clip: true
+
+        Rectangle {
+            x: root.changed ? -20 : 10
+            y: 10
+            width: 120
+            height: 30
+            color: "green"
+        }
+        Image {
+            x: 60
+            y: root.changed ? 20 : 30
+            source: "colors.png"
+        }
+        Rectangle {
+            x: 30
+            y: 35
+            width: 20
+            height: 40
+            color: "orange"
+        }
+    }
+
+    // Stencil clip, with a nested scissor clip
+    Item {
+        x: 150
+        y: 80
+        width: 80
+        height: 80
+        rotation: 30
+        clip: true
+
+        Rectangle {
+            x: -20
+            y: -20
+            width: 120
+            height: 50
+            color: "purple"
+        }
+        Item {
+            x: 10
+            y: 40
+            width: 50
+            height: 30
+            clip: true
+
+            Rectangle {
+                x: root.changed ? 0 : -10
+                width: 80
+                height: 20
+                color: "navy"
+            }
+            Image {
+                y: 10
+                source: "colors.png"
+            }
+        }
+    }
+
+    // Nested opacity
+    Item {
+        x: 10
+        y: 150
+        width: 300
+        height: 80
+        opacity: root.changed ? 0.3 : 0.7
+
+        Rectangle {
+            width: 80
+            height: 80
+            color: "red"
+        }
+        Rectangle {
+            x: 40
+            y: 20
+            width: 80
+            height: 40
+            color: "blue"
+            opacity: 0.5
+        }
+        Image {
+            x: 130
+            source: "colors.png"
+            opacity: 0.8
+        }
+        Text {
+            x: 220
+            text: "Opacity"
+            font.pixelSize: 16
+        }
+    }
+}
@@ -0,0 +1,128 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <qtest.h>
+
+#include <QtCore/qdir.h>
+
+#include <QtQuick/qquickitem.h>
+#include <QtQuick/qquickview.h>
+#include <QtQuick/private/qquickwindow_p.h>
+#include <QtQuick/private/qsgbatchrenderer_p.h>
+#include <QtQuick/private/qsgcontext_p.h>
+
+#include "../../shared/util.h"
+
+class tst_qsgbatchrenderer : public QQmlDataTest
+{
+    Q_OBJECT
+public:
+    tst_qsgbatchrenderer() {}
+
+private slots:
+    void compareWithDefaultRenderer();
+};
+
+// Counts the pixels that differ by more than a rounding error
+static int differingPixels(const QImage &a, const QImage &b)
+{
+    int count = 0;
+    for (int y = 0; y < a.height(); ++y) {
+        for (int x = 0; x < a.width(); ++x) {
+            QRgb pa = a.pixel(x, y);
+            QRgb pb = b.pixel(x, y);
+            if (qAbs(qRed(pa) - qRed(pb)) > 8 || qAbs(qGreen(pa) - qGreen(pb)) > 8
+                    || qAbs(qBlue(pa) - qBlue(pb)) > 8 || qAbs(qAlpha(pa) - qAlpha(pb)) > 8)
+                ++count;
+        }
+    }
+    return count;
+}
+
+void tst_qsgbatchrenderer::compareWithDefaultRenderer()
+{
+    // [batch][changed]
+    QImage images[2][2];
+
+    for (int batch = 0; batch < 2; ++batch) {
+        QQuickView view;
+        QSGContext *context = QQuickWindowPrivate::get(&view)->context;
+        bool wasEnabled = context->isBatchRendererEnabled();
+        context->setBatchRendererEnabled(batch);
+
+        view.setSource(testFileUrl("scene.qml"));
+        QVERIFY(view.rootObject());
+        view.show();
+        QVERIFY(QTest::qWaitForWindowExposed(&view));
+
+        images[batch][0] = view.grabWindow();
+        view.rootObject()->setProperty("changed", true);
+        images[batch][1] = view.grabWindow();
+
+        bool usedBatchRenderer = qobject_cast<QSGBatchRenderer *>(QQuickWindowPrivate::get(&view)->renderer) != 0;
+        context->setBatchRendererEnabled(wasEnabled);
+        QCOMPARE(usedBatchRenderer, bool(batch));
+    }
+
+    // The change is visible, so the second frame exercises the incremental update
+    QVERIFY(differingPixels(images[0][0], images[0][1]) > 0);
+
+    for (int changed = 0; changed < 2; ++changed) {
+        const QImage &expected = images[0][changed];
+        const QImage &actual = images[1][changed];
+        QCOMPARE(actual.size(), expected.size());
+
+        // Transforming vertices on the CPU may move a few edge pixels under the rotated clip
+        int differing = differingPixels(actual, expected);
+        if (differing > expected.width() * expected.height() / 500) {
+            QString base = QDir::tempPath() + QLatin1String("/tst_qsgbatchrenderer_")
+                    + QString::number(changed);
+            expected.save(base + QLatin1String("_default.png"));
+            actual.save(base + QLatin1String("_batch.png"));
+            QFAIL(qPrintable(QString::fromLatin1("%1 pixels differ from the default renderer, saved to %2_*.png")
+                             .arg(differing).arg(base)));
+        }
+    }
+}
+
+QTEST_MAIN(tst_qsgbatchrenderer)
+
+#include "tst_qsgbatchrenderer.moc"
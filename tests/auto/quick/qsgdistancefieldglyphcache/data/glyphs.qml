@@ -0,0 +1,35 @@
+import QtQuick 2.0
+
+Rectangle {
+    width: 480
+    height: 120
+    color: "white"
+
+    property alias firstText: first.text
+    property alias secondText: second.text
+    property alias thirdText: third.text
+
+    Text {
+        id: first
+        objectName: "first"
+        x: 0; y: 0; width: 160; height: 120
+        font.pixelSize: 64
+        color: "black"
+    }
+
+    Text {
+        id: second
+        objectName: "second"
+        x: 160; y: 0; width: 160; height: 120
+        font.pixelSize: 64
+        color: "black"
+    }
+
+    Text {
+        id: third
+        objectName: "third"
+        x: 320; y: 0; width: 160; height: 120
+        font.pixelSize: 64
+        color: "black"
+    }
+}
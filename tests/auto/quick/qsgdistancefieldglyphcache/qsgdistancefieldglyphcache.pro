@@ -0,0 +1,15 @@
+CONFIG += testcase
+TARGET = tst_qsgdistancefieldglyphcache
+SOURCES += tst_qsgdistancefieldglyphcache.cpp
+
+macx:CONFIG -= app_bundle
+
+TESTDATA = data/*
+
+include(../../shared/util.pri)
+
+CONFIG += parallel_test
+QT += core-private gui-private v8-private qml-private quick-private testlib
+
+OTHER_FILES += \
+    data/glyphs.qml
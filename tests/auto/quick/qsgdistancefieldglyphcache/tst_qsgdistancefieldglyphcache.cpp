@@ -0,0 +1,209 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <qtest.h>
+
+#include <QtCore/qdatastream.h>
+#include <QtCore/qdiriterator.h>
+#include <QtCore/qfileinfo.h>
+#include <QtCore/qtemporarydir.h>
+#include <QtGui/qfont.h>
+#include <QtGui/qrawfont.h>
+#include <QtQuick/qquickitem.h>
+#include <QtQuick/qquickview.h>
+#include <QtQuick/private/qsgadaptationlayer_p.h>
+
+#include "../../shared/util.h"
+
+class tst_qsgdistancefieldglyphcache : public QQmlDataTest
+{
+    Q_OBJECT
+public:
+    tst_qsgdistancefieldglyphcache() {}
+
+private slots:
+    void initTestCase();
+    void cleanup();
+
+    void asyncGlyphs();
+    void diskCache();
+
+private:
+    QTemporaryDir cacheDir;
+};
+
+static QRect itemRect(QQuickView *view, const char *name)
+{
+    QQuickItem *item = view->rootObject()->findChild<QQuickItem *>(name);
+    return item ? item->mapRectToScene(QRectF(0, 0, item->width(), item->height())).toRect() : QRect();
+}
+
+static int darkPixels(const QImage &image, const QRect &rect)
+{
+    int count = 0;
+    for (int y = rect.top(); y <= rect.bottom() && y < image.height(); ++y) {
+        for (int x = rect.left(); x <= rect.right() && x < image.width(); ++x) {
+            if (qGray(image.pixel(x, y)) < 128)
+                ++count;
+        }
+    }
+    return count;
+}
+
+// The file format written by QSGDistanceFieldGlyphCache
+static bool readField(const QString &fileName, int *width, int *height, QByteArray *data)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_0);
+    quint32 magic = 0;
+    qint32 w = 0;
+    qint32 h = 0;
+    stream >> magic >> w >> h >> *data;
+    *width = w;
+    *height = h;
+    return stream.status() == QDataStream::Ok && magic == 0x51534446;
+}
+
+static bool writeField(const QString &fileName, int width, int height, const QByteArray &data)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_0);
+    stream << quint32(0x51534446) << qint32(width) << qint32(height) << data;
+    return stream.status() == QDataStream::Ok;
+}
+
+void tst_qsgdistancefieldglyphcache::initTestCase()
+{
+    QQmlDataTest::initTestCase();
+
+    // Must be set before any glyph cache is created
+    QVERIFY(cacheDir.isValid());
+    QSGDistanceFieldGlyphCache::setDiskCachePath(cacheDir.path());
+}
+
+void tst_qsgdistancefieldglyphcache::cleanup()
+{
+    QSGDistanceFieldGlyphCache::setRenderThreadCount(0);
+}
+
+void tst_qsgdistancefieldglyphcache::asyncGlyphs()
+{
+    QCOMPARE(QSGDistanceFieldGlyphCache::renderThreadCount(), 0);
+    QSGDistanceFieldGlyphCache::setRenderThreadCount(2);
+    QCOMPARE(QSGDistanceFieldGlyphCache::renderThreadCount(), 2);
+
+    QQuickView view;
+    view.setSource(testFileUrl("glyphs.qml"));
+    QVERIFY(view.rootObject());
+    view.rootObject()->setProperty("firstText", QLatin1String("async"));
+
+    view.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&view));
+
+    // The glyphs are rendered on the worker threads, uploaded and shown
+    const QRect first = itemRect(&view, "first");
+    QTRY_VERIFY(darkPixels(view.grabWindow(), first) > 0);
+
+    // Glyphs requested by a node that is already on screen are shown as well
+    view.rootObject()->setProperty("secondText", QLatin1String("qrt"));
+    const QRect second = itemRect(&view, "second");
+    QTRY_VERIFY(darkPixels(view.grabWindow(), second) > 0);
+    QVERIFY(darkPixels(view.grabWindow(), first) > 0);
+}
+
+void tst_qsgdistancefieldglyphcache::diskCache()
+{
+    QQuickView view;
+    view.setSource(testFileUrl("glyphs.qml"));
+    QVERIFY(view.rootObject());
+    view.rootObject()->setProperty("firstText", QLatin1String("H"));
+
+    view.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&view));
+    QTRY_VERIFY(darkPixels(view.grabWindow(), itemRect(&view, "first")) > 0);
+
+    // The field of "H" was written to the disk cache
+    QFont font = view.rootObject()->findChild<QQuickItem *>("first")->property("font").value<QFont>();
+    QRawFont rawFont = QRawFont::fromFont(font);
+    QVector<quint32> glyphs = rawFont.glyphIndexesForString(QLatin1String("HW"));
+    QCOMPARE(glyphs.count(), 2);
+
+    QString fieldFile;
+    QDirIterator it(cacheDir.path(), QStringList() << QString::number(glyphs.at(0)) + QLatin1String(".df"),
+                    QDir::Files, QDirIterator::Subdirectories);
+    if (it.hasNext())
+        fieldFile = it.next();
+    QVERIFY2(!fieldFile.isEmpty(), "No distance field was written to the disk cache");
+
+    int width = 0;
+    int height = 0;
+    QByteArray data;
+    QVERIFY(readField(fieldFile, &width, &height, &data));
+    QVERIFY(width > 0);
+    QVERIFY(height > 0);
+    QCOMPARE(data.size(), width * height);
+    QVERIFY(data.count(char(0)) < data.size());
+
+    // Plant an empty field for "W", which has not been rendered yet.  If it
+    // is read back from the cache, "W" is invisible.
+    QString plantedFile = QFileInfo(fieldFile).absolutePath() + QLatin1Char('/')
+            + QString::number(glyphs.at(1)) + QLatin1String(".df");
+    QVERIFY(!QFile::exists(plantedFile));
+    QVERIFY(writeField(plantedFile, 256, height, QByteArray(256 * height, 0)));
+
+    // "M" is rendered normally, and is shown in the same frame as "W"
+    view.rootObject()->setProperty("secondText", QLatin1String("W"));
+    view.rootObject()->setProperty("thirdText", QLatin1String("M"));
+    QTRY_VERIFY(darkPixels(view.grabWindow(), itemRect(&view, "third")) > 0);
+    QCOMPARE(darkPixels(view.grabWindow(), itemRect(&view, "second")), 0);
+}
+
+QTEST_MAIN(tst_qsgdistancefieldglyphcache)
+
+#include "tst_qsgdistancefieldglyphcache.moc"
@@ -68,6 +68,8 @@ QUICKTESTS =  \
     qquickview \
     qquickcanvasitem \
     qquickscreen \
+    qsgbatchrenderer \
+    qsgdistancefieldglyphcache \
     touchmouse \
     dialogs \
 
@@ -7,5 +7,5 @@ testDataFiles.files = data
 testDataFiles.path = .
 DEPLOYMENT += testDataFiles
 
-QT += core-private gui-private v8-private qml-private quick-private opengl-private testlib
+QT += core-private gui-private v8-private qml-private quick-private quickparticles-private opengl-private testlib
 DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0
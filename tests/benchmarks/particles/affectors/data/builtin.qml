@@ -0,0 +1,109 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+import QtQuick 2.0
+import QtQuick.Particles 2.0
+
+Rectangle {
+    color: "black"
+    width: 320
+    height: 320
+
+    ParticleSystem {
+        id: sys
+        objectName: "system"
+        anchors.fill: parent
+        running: false //Benchmark will manage it
+
+        ImageParticle {
+            source: "../../shared/star.png"
+        }
+
+        Emitter{
+            id: emitter
+            x: 160
+            y: 160
+            enabled: false
+            size: 8
+            emitRate: 20000
+            lifeSpan: Emitter.InfiniteLife
+            maximumEmitted: 20000
+            velocity: AngleDirection { angleVariation: 360; magnitude: 50; magnitudeVariation: 50 }
+            Component.onCompleted: emitter.burst(20000);
+        }
+
+        //The benchmark enables one of these at a time
+        Gravity {
+            objectName: "gravity"
+            enabled: false
+            magnitude: 10
+            angle: 90
+        }
+
+        Friction {
+            objectName: "friction"
+            enabled: false
+            factor: 0.5
+        }
+
+        Wander {
+            objectName: "wander"
+            enabled: false
+            xVariance: 100
+            yVariance: 100
+            pace: 100
+        }
+
+        Turbulence {
+            objectName: "turbulence"
+            enabled: false
+            anchors.fill: parent
+            strength: 10
+        }
+
+        Attractor {
+            objectName: "attractor"
+            enabled: false
+            pointX: 160
+            pointY: 160
+            strength: 100
+        }
+    }
+}
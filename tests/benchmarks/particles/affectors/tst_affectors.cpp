@@ -43,6 +43,7 @@
 #include <QtTest/QtTest>
 #include "../../../auto/particles/shared/particlestestsshared.h"
 #include <private/qquickparticlesystem_p.h>
+#include <private/qquickparticleaffector_p.h>
 
 class tst_affectors : public QObject
 {
@@ -55,6 +56,10 @@ private slots:
     void test_basic_data();
     void test_filtered();
     void test_filtered_data();
+    void test_builtin();
+    void test_builtin_data();
+    void test_threads();
+    void test_threads_data();
 };
 
 tst_affectors::tst_affectors()
@@ -159,6 +164,91 @@ void tst_affectors::test_filtered()
     delete view;
 }
 
+void tst_affectors::test_builtin_data()
+{
+    QTest::addColumn<QString> ("affector");
+    QTest::addColumn<int> ("dt");
+    const char *affectors[] = { "gravity", "friction", "wander", "turbulence", "attractor" };
+    for (int i = 0; i < 5; ++i) {
+        QByteArray name(affectors[i]);
+        QTest::newRow((name + " 16ms").constData()) << QString::fromLatin1(affectors[i]) << 16;
+        QTest::newRow((name + " 100ms").constData()) << QString::fromLatin1(affectors[i]) << 100;
+    }
+}
+
+void tst_affectors::test_builtin()
+{
+    QFETCH(QString, affector);
+    QFETCH(int, dt);
+    QQuickView* view = createView(QCoreApplication::applicationDirPath() + "/data/builtin.qml");
+    QQuickParticleSystem* system = view->rootObject()->findChild<QQuickParticleSystem*>("system");
+    QObject* enabledAffector = view->rootObject()->findChild<QObject*>(affector);
+    QVERIFY(enabledAffector);
+    enabledAffector->setProperty("enabled", true);
+    //Pretend we're running, but we manually advance the simulation
+    system->m_running = true;
+    system->m_animation = 0;
+    system->reset();
+
+    int curTime = 1;
+    system->updateCurrentTime(curTime);//Fixed point and get init out of the way - including emission
+
+    QBENCHMARK {
+        curTime += dt;
+        system->updateCurrentTime(curTime);
+    }
+
+    QVERIFY(extremelyFuzzyCompare(system->groupData[0]->size(), 20000, 10));//Small simulation variance is permissible.
+    delete view;
+}
+
+void tst_affectors::test_threads_data()
+{
+    QTest::addColumn<QString> ("affector");
+    QTest::addColumn<int> ("threads");
+    const char *affectors[] = { "gravity", "turbulence", "attractor" };
+    QList<int> threadCounts;
+    threadCounts << 1 << 2 << 4;
+    if (QThread::idealThreadCount() > 4)
+        threadCounts << QThread::idealThreadCount();
+    for (int i = 0; i < 3; ++i) {
+        foreach (int threads, threadCounts) {
+            QByteArray name = QByteArray(affectors[i]) + ' ' + QByteArray::number(threads) + " threads";
+            QTest::newRow(name.constData()) << QString::fromLatin1(affectors[i]) << threads;
+        }
+    }
+}
+
+void tst_affectors::test_threads()
+{
+    QFETCH(QString, affector);
+    QFETCH(int, threads);
+    int oldThreads = QQuickParticleAffector::threadCount();
+    QQuickParticleAffector::setThreadCount(threads);
+
+    QQuickView* view = createView(QCoreApplication::applicationDirPath() + "/data/builtin.qml");
+    QQuickParticleSystem* system = view->rootObject()->findChild<QQuickParticleSystem*>("system");
+    QObject* enabledAffector = view->rootObject()->findChild<QObject*>(affector);
+    QVERIFY(enabledAffector);
+    enabledAffector->setProperty("enabled", true);
+    //Pretend we're running, but we manually advance the simulation
+    system->m_running = true;
+    system->m_animation = 0;
+    system->reset();
+
+    int curTime = 1;
+    system->updateCurrentTime(curTime);//Fixed point and get init out of the way - including emission
+
+    QBENCHMARK {
+        curTime += 16;
+        system->updateCurrentTime(curTime);
+    }
+
+    QVERIFY(extremelyFuzzyCompare(system->groupData[0]->size(), 20000, 10));//Small simulation variance is permissible.
+    delete view;
+    QQuickParticleAffector::setThreadCount(oldThreads);
+}
+
 QTEST_MAIN(tst_affectors);
 
 #include "tst_affectors.moc"
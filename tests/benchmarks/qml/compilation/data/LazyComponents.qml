@@ -0,0 +1,80 @@
+import QtQml 2.0
+
+QtObject {
+    id: root
+
+    property int base: 10
+
+    property Component first: Component {
+        QtObject {
+            property int value: root.base + 1
+            property string name: "first " + value
+            property var list: [value, value * 2, value * 3]
+        }
+    }
+
+    property Component second: Component {
+        QtObject {
+            property int value: root.base + 2
+            property string name: "second " + value
+            property QtObject child: QtObject {
+                property int doubled: value * 2
+            }
+        }
+    }
+
+    property Component third: Component {
+        QtObject {
+            property int value: root.base + 3
+            property string name: "third " + value
+            signal triggered(int amount)
+            onTriggered: value += amount
+        }
+    }
+
+    property Component fourth: Component {
+        QtObject {
+            property int value: root.base + 4
+            property string name: "fourth " + value
+            function scaled(factor) { return value * factor }
+        }
+    }
+
+    property Component fifth: Component {
+        QtObject {
+            property int value: root.base + 5
+            property string name: "fifth " + value
+            property Component nested: Component {
+                QtObject {
+                    property int value: root.base + 50
+                }
+            }
+        }
+    }
+
+    property Component sixth: Component {
+        QtObject {
+            property int value: root.base + 6
+            property string name: "sixth " + value
+            property bool odd: value % 2 == 1
+        }
+    }
+
+    property Component seventh: Component {
+        QtObject {
+            property int value: root.base + 7
+            property string name: "seventh " + value
+            property real ratio: value / root.base
+        }
+    }
+
+    property Component eighth: Component {
+        QtObject {
+            property int value: root.base + 8
+            property string name: "eighth " + value
+            property string upper: name.toUpperCase()
+        }
+    }
+
+    property var components: [first, second, third, fourth, fifth, sixth, seventh, eighth]
+}
@@ -0,0 +1,129 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the QtQml module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+import QtQuick 2.0
+
+Rectangle {
+    id: dialog
+    property string title: "Dialog"
+    property string message
+    property bool shown: false
+    property int buttonCount: 2
+    property real margin: 8
+
+    signal accepted()
+    signal rejected()
+
+    function show(text) {
+        message = text
+        shown = true
+    }
+
+    function hide() {
+        shown = false
+    }
+
+    width: Math.max(titleText.width, messageText.width) + 4 * margin
+    height: column.height + 2 * margin
+    radius: 4
+    color: "lightsteelblue"
+    border.color: "steelblue"
+    opacity: shown ? 1 : 0
+    scale: shown ? 1 : 0.8
+
+    Behavior on opacity { NumberAnimation { duration: 150 } }
+    Behavior on scale { NumberAnimation { duration: 150; easing.type: Easing.OutQuad } }
+
+    Column {
+        id: column
+        anchors.centerIn: parent
+        spacing: dialog.margin
+
+        Text {
+            id: titleText
+            anchors.horizontalCenter: parent.horizontalCenter
+            text: dialog.title
+            font.bold: true
+            font.pixelSize: 16
+        }
+
+        Text {
+            id: messageText
+            anchors.horizontalCenter: parent.horizontalCenter
+            text: dialog.message
+            wrapMode: Text.WordWrap
+        }
+
+        Row {
+            anchors.horizontalCenter: parent.horizontalCenter
+            spacing: dialog.margin
+
+            Repeater {
+                model: dialog.buttonCount
+                Rectangle {
+                    width: 64; height: 24
+                    radius: 2
+                    color: mouse.pressed ? "steelblue" : "white"
+                    Text {
+                        anchors.centerIn: parent
+                        text: index == 0 ? "OK" : "Cancel"
+                    }
+                    MouseArea {
+                        id: mouse
+                        anchors.fill: parent
+                        onClicked: {
+                            dialog.hide()
+                            if (index == 0)
+                                dialog.accepted()
+                            else
+                                dialog.rejected()
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    states: State {
+        name: "hidden"; when: !dialog.shown
+        PropertyChanges { target: column; enabled: false }
+    }
+}
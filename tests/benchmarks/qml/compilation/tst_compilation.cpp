@@ -48,10 +48,16 @@
 #include <QtQml/private/qqmljsparser_p.h>
 #include <QtQml/private/qqmljslexer_p.h>
 #include <QtQml/private/qqmlscript_p.h>
+#include <QtQml/private/qqmlengine_p.h>
+#include <QtQml/private/qqmlcomponent_p.h>
+#include <QtQml/private/qqmlcompiler_p.h>
 
 #include <QFile>
 #include <QDebug>
 #include <QTextStream>
+#include <QDir>
+#include <QTemporaryDir>
+#include <QThread>
 
 class tst_compilation : public QObject
 {
@@ -62,6 +68,16 @@ public:
 private slots:
     void boomblock();
 
+    void compilationcache_data();
+    void compilationcache();
+
+    void parallelcompilation_data();
+    void parallelcompilation();
+
+    void lazycomponents();
+    void lazycomponents_retained_data();
+    void lazycomponents_retained();
+
     void jsparser_data();
     void jsparser();
 
@@ -100,6 +116,128 @@ void tst_compilation::boomblock()
     }
 }
 
+static void removeCacheFiles(const QString &path)
+{
+    QDir dir(path);
+    foreach (const QString &file, dir.entryList(QStringList() << QLatin1String("*.qmlc"), QDir::Files))
+        dir.remove(file);
+}
+
+void tst_compilation::compilationcache_data()
+{
+    QTest::addColumn<bool>("warm");
+
+    QTest::newRow("cold") << false;
+    QTest::newRow("warm") << true;
+}
+
+void tst_compilation::compilationcache()
+{
+    QFETCH(bool, warm);
+
+    QTemporaryDir cacheDir;
+    QVERIFY(cacheDir.isValid());
+
+    QQmlEngine cacheEngine;
+    QQmlEnginePrivate::get(&cacheEngine)->typeLoader.setCompilationCachePath(cacheDir.path());
+
+    // Load once to get rid of initialization effects and populate the cache
+    {
+        QQmlComponent c(&cacheEngine, TEST_FILE("Dialog.qml"));
+        QVERIFY(c.isReady());
+    }
+    QVERIFY(!QDir(cacheDir.path()).entryList(QStringList() << QLatin1String("*.qmlc")).isEmpty());
+
+    QBENCHMARK {
+        cacheEngine.clearComponentCache();
+        if (!warm)
+            removeCacheFiles(cacheDir.path());
+        QQmlComponent c(&cacheEngine, TEST_FILE("Dialog.qml"));
+        QVERIFY(c.isReady());
+    }
+}
+
+void tst_compilation::parallelcompilation_data()
+{
+    QTest::addColumn<int>("threads");
+
+    QTest::newRow("serial") << 0;
+    QTest::newRow("parallel") << QThread::idealThreadCount();
+}
+
+void tst_compilation::parallelcompilation()
+{
+    QFETCH(int, threads);
+
+    QQmlEngine threadedEngine;
+    QQmlEnginePrivate::get(&threadedEngine)->typeLoader.setWorkerThreadCount(threads);
+
+    //get rid of initialization effects
+    {
+        QQmlComponent c(&threadedEngine, TEST_FILE("parallel/Main.qml"));
+        QVERIFY(c.isReady());
+    }
+
+    QBENCHMARK {
+        threadedEngine.clearComponentCache();
+        QQmlComponent c(&threadedEngine, TEST_FILE("parallel/Main.qml"));
+        QVERIFY(c.isReady());
+    }
+}
+
+void tst_compilation::lazycomponents()
+{
+    QQmlEngine lazyEngine;
+
+    //get rid of initialization effects
+    {
+        QQmlComponent c(&lazyEngine, TEST_FILE("LazyComponents.qml"));
+        QVERIFY(c.isReady());
+    }
+
+    QBENCHMARK {
+        lazyEngine.clearComponentCache();
+        QQmlComponent c(&lazyEngine, TEST_FILE("LazyComponents.qml"));
+        QVERIFY(c.isReady());
+    }
+}
+
+void tst_compilation::lazycomponents_retained_data()
+{
+    QTest::addColumn<bool>("create");
+
+    QTest::newRow("loaded") << false;
+    QTest::newRow("created") << true;
+}
+
+// Reports the memory kept to compile nested component bodies on first creation
+void tst_compilation::lazycomponents_retained()
+{
+    QFETCH(bool, create);
+
+    QQmlEngine lazyEngine;
+    QQmlComponent c(&lazyEngine, TEST_FILE("LazyComponents.qml"));
+    QScopedPointer<QObject> object(c.create());
+    QVERIFY(object);
+
+    QList<QObject *> created;
+    if (create) {
+        foreach (const QVariant &value, object->property("components").toList()) {
+            QQmlComponent *component = qobject_cast<QQmlComponent *>(value.value<QObject *>());
+            QVERIFY(component);
+            QObject *o = component->create();
+            QVERIFY(o);
+            created << o;
+        }
+    }
+
+    QQmlCompiledData *data = QQmlComponentPrivate::get(&c)->cc;
+    QVERIFY(data);
+    QTest::setBenchmarkResult(data->lazyUnitSize(), QTest::BytesAllocated);
+
+    qDeleteAll(created);
+}
+
 void tst_compilation::jsparser_data()
 {
     QTest::addColumn<QString>("file");
@@ -0,0 +1,17 @@
+import Qt.test 1.0
+
+TestObject {
+    id: root
+
+    function runtest() {
+        var r = root;
+        var p = Qt.point(1, 2);
+
+        for (var ii = 0; ii < 250000; ++ii) {
+            r.overloadedMethod(ii)
+            r.overloadedMethod("Hello world!")
+            r.overloadedMethod(r)
+            r.overloadedMethod(p)
+        }
+    }
+}
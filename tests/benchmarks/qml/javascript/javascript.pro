@@ -1,7 +1,7 @@
 CONFIG += testcase
 TEMPLATE = app
 TARGET = tst_javascript
-QT += qml testlib
+QT += qml quick testlib
 macx:CONFIG -= app_bundle
 
 SOURCES += tst_javascript.cpp testtypes.cpp
@@ -43,21 +43,60 @@
 #define TESTTYPES_H
 
 #include <QtCore/qobject.h>
+#include <QtCore/qpoint.h>
+#include <QtCore/qrect.h>
+#include <QtCore/qurl.h>
+#include <QtCore/qvariant.h>
+#include <QtGui/qcolor.h>
+#include <QtQml/qqmllist.h>
 
 class TestObject : public QObject 
 {
     Q_OBJECT
     Q_PROPERTY(int intValue READ intValue);
     Q_PROPERTY(QString stringValue READ stringValue);
+    Q_PROPERTY(QPointF pointValue READ pointValue);
+    Q_PROPERTY(QRectF rectValue READ rectValue);
+    Q_PROPERTY(QColor colorValue READ colorValue);
+    Q_PROPERTY(QUrl urlValue READ urlValue);
+    Q_PROPERTY(QVariant variantValue READ variantValue);
+    Q_PROPERTY(QQmlListProperty<QObject> listValue READ listValue);
+    Q_PROPERTY(QList<int> intListValue READ intListValue);
 
 public:
-    TestObject() : m_string("Hello world!") {}
+    TestObject()
+        : m_string("Hello world!"), m_point(10, 20), m_rect(10, 20, 30, 40), m_color(Qt::red)
+        , m_url("http://qt-project.org/"), m_variant(13)
+    {
+        m_intList << 1 << 2 << 3;
+    }
 
     int intValue() const { return 13; }
     QString stringValue() const { return m_string; }
+    QPointF pointValue() const { return m_point; }
+    QRectF rectValue() const { return m_rect; }
+    QColor colorValue() const { return m_color; }
+    QUrl urlValue() const { return m_url; }
+    QVariant variantValue() const { return m_variant; }
+    QQmlListProperty<QObject> listValue() { return QQmlListProperty<QObject>(this, m_list); }
+    QList<int> intListValue() const { return m_intList; }
+
+    Q_INVOKABLE int method(int v) { return v; }
+
+    Q_INVOKABLE int overloadedMethod(int v) { return v; }
+    Q_INVOKABLE int overloadedMethod(const QString &v) { return v.length(); }
+    Q_INVOKABLE int overloadedMethod(QObject *v) { return v ? 1 : 0; }
+    Q_INVOKABLE int overloadedMethod(const QPointF &v) { return int(v.x()); }
 
 private:
     QString m_string;
+    QPointF m_point;
+    QRectF m_rect;
+    QColor m_color;
+    QUrl m_url;
+    QVariant m_variant;
+    QList<QObject *> m_list;
+    QList<int> m_intList;
 }; 
 
 void registerTypes();
@@ -1,8 +1,5 @@
-requires(qtHaveModule(opengl))
+TEMPLATE = subdirs
 
-QT += opengl
-CONFIG += console
-macx:CONFIG -= app_bundle
-
-SOURCES += paintbenchmark.cpp
-DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0
+SUBDIRS += \
+           paintbenchmark \
+           qquickcontext2d
@@ -0,0 +1,10 @@
+CONFIG += testcase
+TEMPLATE = app
+TARGET = tst_qquickcontext2d
+QT += qml quick testlib
+macx:CONFIG -= app_bundle
+CONFIG += release
+
+SOURCES += tst_qquickcontext2d.cpp
+
+DEFINES += SRCDIR=\\\"$$PWD\\\"
@@ -0,0 +1,92 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <qtest.h>
+#include <QtTest/QtTest>
+#include <QtQuick/QQuickView>
+#include <QtQuick/QQuickItem>
+
+class tst_qquickcontext2d : public QObject
+{
+    Q_OBJECT
+public:
+    tst_qquickcontext2d() {}
+
+private slots:
+    void imageData_data();
+    void imageData();
+};
+
+void tst_qquickcontext2d::imageData_data()
+{
+    QTest::addColumn<QString>("function");
+
+    QTest::newRow("getImageData") << "getImageData";
+    QTest::newRow("putImageData") << "putImageData";
+    QTest::newRow("invert") << "invert";
+    QTest::newRow("grayscale") << "grayscale";
+}
+
+// Runs script functions that read and write every component of a 256x256
+// ImageData, which is dominated by the cost of indexing CanvasPixelArray.
+void tst_qquickcontext2d::imageData()
+{
+    QFETCH(QString, function);
+
+    QQuickView window;
+    window.setSource(QUrl::fromLocalFile(SRCDIR "/data/imagedata.qml"));
+    window.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&window));
+
+    QQuickItem *canvas = window.rootObject();
+    QVERIFY(canvas);
+    QTRY_VERIFY(canvas->property("available").toBool());
+    QVERIFY(QMetaObject::invokeMethod(canvas, "prepare"));
+
+    const QByteArray name = function.toLatin1();
+    QBENCHMARK {
+        QMetaObject::invokeMethod(canvas, name.constData());
+    }
+}
+
+QTEST_MAIN(tst_qquickcontext2d)
+
+#include "tst_qquickcontext2d.moc"
@@ -6,13 +6,17 @@ SUBDIRS += \
            javascript \
            holistic \
            pointers \
+           qqmlbundle \
            qqmlcomponent \
            qqmlimage \
            qqmlmetaproperty \
            script \
            qmltime \
            js \
-           qquickwindow
+           qquicklistview \
+           qquickwindow \
+           qquickworkerscript \
+           qsgrenderer
 
 qtHaveModule(opengl): SUBDIRS += painting
 
@@ -0,0 +1,9 @@
+CONFIG += testcase
+TEMPLATE = app
+TARGET = tst_qqmlbundle
+QT += qml qml-private testlib
+macx:CONFIG -= app_bundle
+
+SOURCES += tst_qqmlbundle.cpp
+
+DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0
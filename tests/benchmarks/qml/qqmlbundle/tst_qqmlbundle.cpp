@@ -0,0 +1,189 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <qtest.h>
+#include <QQmlEngine>
+#include <QQmlComponent>
+#include <QTemporaryDir>
+#include <QFile>
+#include <QDir>
+#include <private/qqmlbundle_p.h>
+
+// Compares startup lookups in bundles with and without a file name index.
+// The bundles mimic a deployed application with a large number of small files.
+
+class tst_qqmlbundle : public QObject
+{
+    Q_OBJECT
+
+public:
+    tst_qqmlbundle() {}
+
+private slots:
+    void initTestCase();
+
+    void lookup_data();
+    void lookup();
+    void component_data();
+    void component();
+
+private:
+    QString bundleFile(int fileCount, bool indexed);
+    QStringList fileNames(int fileCount) const;
+
+    QTemporaryDir dir;
+    QHash<QString, QString> bundles;
+};
+
+void tst_qqmlbundle::initTestCase()
+{
+    QVERIFY(dir.isValid());
+}
+
+QStringList tst_qqmlbundle::fileNames(int fileCount) const
+{
+    QStringList rv;
+    for (int ii = 0; ii < fileCount; ++ii)
+        rv << QString::fromLatin1("components/group%1/Type%2.qml").arg(ii % 20).arg(ii);
+    return rv;
+}
+
+QString tst_qqmlbundle::bundleFile(int fileCount, bool indexed)
+{
+    const QString key = QString::number(fileCount) + (indexed ? QLatin1String("i") : QLatin1String("l"));
+    if (bundles.contains(key))
+        return bundles.value(key);
+
+    const QString source = dir.path() + QLatin1String("/Type.qml");
+    if (!QFile::exists(source)) {
+        QFile file(source);
+        file.open(QFile::WriteOnly);
+        file.write("import QtQml 2.0\nQtObject {\n    property int value: 10\n}\n");
+    }
+    const QString main = dir.path() + QLatin1String("/main.qml");
+    if (!QFile::exists(main)) {
+        QFile file(main);
+        file.open(QFile::WriteOnly);
+        file.write("import QtQml 2.0\nimport \"components/group0\"\nQtObject {\n"
+                   "    property QtObject a: Type0 {}\n"
+                   "    property QtObject b: Type20 {}\n"
+                   "    property QtObject c: Type40 {}\n}\n");
+    }
+
+    const QString fileName = dir.path() + QLatin1Char('/') + key + QLatin1String(".bundle");
+    {
+        QQmlBundle bundle(fileName);
+        if (!bundle.open(QFile::WriteOnly))
+            return QString();
+        bundle.add(QLatin1String("main.qml"), main);
+        foreach (const QString &name, fileNames(fileCount))
+            bundle.add(name, source);
+    }
+    if (indexed) {
+        QQmlBundle bundle(fileName);
+        if (!bundle.open(QFile::ReadWrite) || !bundle.writeIndex())
+            return QString();
+    }
+
+    bundles.insert(key, fileName);
+    return fileName;
+}
+
+void tst_qqmlbundle::lookup_data()
+{
+    QTest::addColumn<int>("fileCount");
+    QTest::addColumn<bool>("indexed");
+
+    QTest::newRow("200 files, linear") << 200 << false;
+    QTest::newRow("200 files, indexed") << 200 << true;
+    QTest::newRow("2000 files, linear") << 2000 << false;
+    QTest::newRow("2000 files, indexed") << 2000 << true;
+}
+
+// Opens the bundle and looks up every file once, as the type loader does
+// when resolving the types of an application at startup.
+void tst_qqmlbundle::lookup()
+{
+    QFETCH(int, fileCount);
+    QFETCH(bool, indexed);
+
+    const QString fileName = bundleFile(fileCount, indexed);
+    QVERIFY(!fileName.isEmpty());
+    const QStringList names = fileNames(fileCount);
+
+    QBENCHMARK {
+        QQmlBundle bundle(fileName);
+        bundle.open(QFile::ReadOnly);
+        Q_ASSERT(bundle.hasIndex() == indexed);
+        foreach (const QString &name, names) {
+            if (!bundle.find(name))
+                QFAIL("file not found");
+        }
+    }
+}
+
+void tst_qqmlbundle::component_data()
+{
+    lookup_data();
+}
+
+void tst_qqmlbundle::component()
+{
+    QFETCH(int, fileCount);
+    QFETCH(bool, indexed);
+
+    const QString fileName = bundleFile(fileCount, indexed);
+    QVERIFY(!fileName.isEmpty());
+
+    QBENCHMARK {
+        QQmlEngine engine;
+        engine.addNamedBundle(QLatin1String("app"), fileName);
+        QQmlComponent component(&engine, QUrl(QLatin1String("bundle://app/main.qml")));
+        QObject *o = component.create();
+        if (!o)
+            QFAIL(qPrintable(component.errorString()));
+        delete o;
+    }
+}
+
+QTEST_MAIN(tst_qqmlbundle)
+
+#include "tst_qqmlbundle.moc"
@@ -42,7 +42,9 @@
 #include <qtest.h>
 #include <QQmlEngine>
 #include <QQmlComponent>
+#include <QTemporaryDir>
 #include <private/qquickimage_p.h>
+#include <private/qquickpixmapcache_p.h>
 
 class tst_qmlgraphicsimage : public QObject
 {
@@ -51,14 +53,37 @@ public:
     tst_qmlgraphicsimage() {}
 
 private slots:
+    void initTestCase();
     void qmlgraphicsimage();
     void qmlgraphicsimage_file();
     void qmlgraphicsimage_url();
+    void qmlgraphicsimage_async_data();
+    void qmlgraphicsimage_async();
 
 private:
     QQmlEngine engine;
+    QTemporaryDir imageDir;
+    QList<QUrl> imageUrls;
 };
 
+void tst_qmlgraphicsimage::initTestCase()
+{
+    // Distinct, noisy images, so that every one of them has to be decoded
+    QVERIFY(imageDir.isValid());
+    qsrand(1);
+    for (int ii = 0; ii < 200; ++ii) {
+        QImage image(256, 256, QImage::Format_RGB32);
+        for (int y = 0; y < image.height(); ++y) {
+            QRgb *line = reinterpret_cast<QRgb *>(image.scanLine(y));
+            for (int x = 0; x < image.width(); ++x)
+                line[x] = qRgb(qrand() % 256, x, y);
+        }
+        QString fileName = imageDir.path() + QLatin1String("/image") + QString::number(ii) + QLatin1String(".png");
+        QVERIFY(image.save(fileName));
+        imageUrls << QUrl::fromLocalFile(fileName);
+    }
+}
+
 void tst_qmlgraphicsimage::qmlgraphicsimage()
 {
     int x = 0;
@@ -103,6 +128,44 @@ void tst_qmlgraphicsimage::qmlgraphicsimage_url()
     }
 }
 
+void tst_qmlgraphicsimage::qmlgraphicsimage_async_data()
+{
+    QTest::addColumn<int>("threads");
+
+    QTest::newRow("1 thread") << 1;
+    QTest::newRow("2 threads") << 2;
+    QTest::newRow("4 threads") << 4;
+    QTest::newRow("ideal threads") << qMax(1, QThread::idealThreadCount());
+}
+
+// Loads a grid's worth of thumbnails asynchronously and waits for all of them
+// to be decoded.
+void tst_qmlgraphicsimage::qmlgraphicsimage_async()
+{
+    QFETCH(int, threads);
+
+    QQuickPixmap::setDecodingThreadCount(&engine, threads);
+    QCOMPARE(QQuickPixmap::decodingThreadCount(&engine), threads);
+
+    QBENCHMARK {
+        QList<QQuickImage *> images;
+        foreach (const QUrl &url, imageUrls) {
+            QQuickImage *image = new QQuickImage;
+            QQmlEngine::setContextForObject(image, engine.rootContext());
+            image->setAsynchronous(true);
+            image->setCache(false);
+            image->setSource(url);
+            images << image;
+        }
+
+        foreach (QQuickImage *image, images)
+            QTRY_COMPARE_WITH_TIMEOUT(image->status(), QQuickImageBase::Ready, 60000);
+        qDeleteAll(images);
+    }
+
+    QQuickPixmap::setDecodingThreadCount(&engine, 0);
+}
+
 QTEST_MAIN(tst_qmlgraphicsimage)
 
 #include "tst_qqmlimage.moc"
@@ -1,7 +1,7 @@
 CONFIG += testcase
 TEMPLATE = app
 TARGET = tst_qqmlmetaproperty
-QT += qml testlib
+QT += qml testlib qml-private core-private v8-private
 macx:CONFIG -= app_bundle
 
 SOURCES += tst_qqmlmetaproperty.cpp 
@@ -45,6 +45,10 @@
 #include <QQmlProperty>
 #include <QFile>
 #include <QDebug>
+#include <private/qqmlengine_p.h>
+#include <private/qqmldata_p.h>
+#include <private/qqmlpropertycache_p.h>
+#include <private/qhashedstring_p.h>
 
 class tst_qmlmetaproperty : public QObject
 {
@@ -61,6 +65,8 @@ public slots:
 private slots:
     void lookup_data();
     void lookup();
+    void cacheLookup_data();
+    void cacheLookup();
 
 private:
     QQmlEngine engine;
@@ -106,5 +112,46 @@ void tst_qmlmetaproperty::lookup()
     delete obj;
 }
 
+void tst_qmlmetaproperty::cacheLookup_data()
+{
+    QTest::addColumn<QString>("file");
+    QTest::addColumn<bool>("missing");
+
+    QTest::newRow("Simple Object") << SRCDIR "/data/object.qml" << false;
+    QTest::newRow("Synthesized Object") << SRCDIR "/data/synthesized_object.qml" << false;
+    QTest::newRow("Missing property") << SRCDIR "/data/synthesized_object.qml" << true;
+}
+
+// Looks up every property of the object by name through its property cache
+void tst_qmlmetaproperty::cacheLookup()
+{
+    QFETCH(QString, file);
+    QFETCH(bool, missing);
+
+    QQmlComponent c(&engine, file);
+    QVERIFY(c.isReady());
+
+    QObject *obj = c.create();
+    QVERIFY(obj);
+
+    // Synthesized objects have their cache attached by the VME
+    QQmlData *ddata = QQmlData::get(obj);
+    QQmlPropertyCache *cache = (ddata && ddata->propertyCache)
+            ? ddata->propertyCache : QQmlEnginePrivate::get(&engine)->cache(obj);
+    QVERIFY(cache);
+
+    QList<QHashedString> names;
+    foreach (const QString &name, cache->propertyNames())
+        names << QHashedString(missing ? name + QLatin1Char('_') : name);
+    QVERIFY(!names.isEmpty());
+
+    QBENCHMARK {
+        foreach (const QHashedString &name, names)
+            cache->property(name, obj, 0);
+    }
+
+    delete obj;
+}
+
 QTEST_MAIN(tst_qmlmetaproperty)
 #include "tst_qqmlmetaproperty.moc"
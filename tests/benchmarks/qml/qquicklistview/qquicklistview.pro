@@ -0,0 +1,10 @@
+CONFIG += testcase
+TEMPLATE = app
+TARGET = tst_qquicklistview
+QT += qml quick quick-private testlib
+macx:CONFIG -= app_bundle
+CONFIG += release
+
+SOURCES += tst_qquicklistview.cpp
+
+DEFINES += SRCDIR=\\\"$$PWD\\\"
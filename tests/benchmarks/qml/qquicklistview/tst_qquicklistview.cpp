@@ -0,0 +1,95 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <qtest.h>
+#include <QtTest/QtTest>
+#include <QtQuick/QQuickView>
+#include <QtQuick/private/qquicklistview_p.h>
+
+class tst_qquicklistview : public QObject
+{
+    Q_OBJECT
+public:
+    tst_qquicklistview() {}
+
+private slots:
+    void flick_data();
+    void flick();
+};
+
+void tst_qquicklistview::flick_data()
+{
+    QTest::addColumn<bool>("reuseItems");
+
+    QTest::newRow("create") << false;
+    QTest::newRow("reuse") << true;
+}
+
+// Scrolls a list one row at a time, so every step releases a delegate at one edge
+// of the view and requests another at the opposite edge.
+void tst_qquicklistview::flick()
+{
+    QFETCH(bool, reuseItems);
+
+    QQuickView window;
+    window.setSource(QUrl::fromLocalFile(SRCDIR "/data/flick.qml"));
+    window.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&window));
+
+    QQuickListView *listview = qobject_cast<QQuickListView *>(window.rootObject());
+    QVERIFY(listview);
+    listview->setReuseItems(reuseItems);
+    QCOMPARE(listview->count(), 1000);
+
+    const qreal step = 24;
+    const qreal maximum = 500 * step;
+
+    QBENCHMARK {
+        for (qreal y = 0; y <= maximum; y += step)
+            listview->setContentY(y);
+        for (qreal y = maximum; y >= 0; y -= step)
+            listview->setContentY(y);
+    }
+}
+
+QTEST_MAIN(tst_qquicklistview)
+
+#include "tst_qquicklistview.moc"
@@ -54,6 +54,8 @@ public:
 
 private slots:
     void tst_updateCursor();
+    void hover();
+    void press();
     void cleanupTestCase();
 private:
     QQuickWindow* window;
@@ -66,8 +68,15 @@ tst_qquickwindow::tst_qquickwindow()
     window->setPosition(100, 100);
     for ( int i=0; i<8000; i++ ) {
         QQuickRectangle *r =new QQuickRectangle(window->contentItem());
+        r->setPosition(QPointF((i % 100) * 2.5, (i / 100) * 2.5));
+        r->setSize(QSizeF(10, 10));
         for ( int j=0; j<10; ++j ) {
-            new QQuickRectangle(r);
+            QQuickRectangle *c = new QQuickRectangle(r);
+            c->setSize(QSizeF(5, 5));
+            if (j == 0 && i % 10 == 0) {
+                c->setAcceptHoverEvents(true);
+                c->setAcceptedMouseButtons(Qt::LeftButton);
+            }
         }
     }
     window->show();
@@ -86,6 +95,31 @@ void tst_qquickwindow::tst_updateCursor()
     }
 }
 
+void tst_qquickwindow::hover()
+{
+    QPointF positions[] = { QPointF(50, 50), QPointF(120, 80) };
+    int i = 0;
+    QBENCHMARK {
+        QPointF pos = positions[i++ % 2];
+        QMouseEvent move(QEvent::MouseMove, pos, pos, window->mapToGlobal(pos.toPoint()),
+                         Qt::NoButton, Qt::NoButton, Qt::NoModifier);
+        QCoreApplication::sendEvent(window, &move);
+    }
+}
+
+void tst_qquickwindow::press()
+{
+    QPointF pos(100, 100);
+    QBENCHMARK {
+        QMouseEvent press(QEvent::MouseButtonPress, pos, pos, window->mapToGlobal(pos.toPoint()),
+                          Qt::LeftButton, Qt::LeftButton, Qt::NoModifier);
+        QCoreApplication::sendEvent(window, &press);
+        QMouseEvent release(QEvent::MouseButtonRelease, pos, pos, window->mapToGlobal(pos.toPoint()),
+                            Qt::LeftButton, Qt::NoButton, Qt::NoModifier);
+        QCoreApplication::sendEvent(window, &release);
+    }
+}
+
 QTEST_MAIN(tst_qquickwindow);
 
 #include "tst_qquickwindow.moc"
@@ -0,0 +1,10 @@
+CONFIG += testcase
+TEMPLATE = app
+TARGET = tst_qquickworkerscript
+QT += qml qml-private quick testlib
+macx:CONFIG -= app_bundle
+CONFIG += release
+
+SOURCES += tst_qquickworkerscript.cpp
+
+DEFINES += SRCDIR=\\\"$$PWD\\\"
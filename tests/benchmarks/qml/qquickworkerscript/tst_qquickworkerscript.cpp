@@ -0,0 +1,145 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <qtest.h>
+#include <QtTest/QtTest>
+#include <QtQml/qqmlengine.h>
+#include <QtQml/qqmlcomponent.h>
+#include <private/qqmlengine_p.h>
+
+class tst_qquickworkerscript : public QObject
+{
+    Q_OBJECT
+public:
+    tst_qquickworkerscript() {}
+
+private slots:
+    void concurrent_data();
+    void concurrent();
+    void message_data();
+    void message();
+};
+
+void tst_qquickworkerscript::concurrent_data()
+{
+    QTest::addColumn<int>("threads");
+    QTest::addColumn<int>("workers");
+
+    const int ideal = qMax(1, QThread::idealThreadCount());
+    QTest::newRow("1 thread, 1 worker") << 1 << 1;
+    QTest::newRow("1 thread, 4 workers") << 1 << 4;
+    QTest::newRow("2 threads, 4 workers") << 2 << 4;
+    QTest::newRow("4 threads, 4 workers") << 4 << 4;
+    QTest::newRow("ideal threads, ideal workers") << ideal << ideal;
+}
+
+// Sends the same CPU bound job to each worker at once and waits for all of
+// them to reply.
+void tst_qquickworkerscript::concurrent()
+{
+    QFETCH(int, threads);
+    QFETCH(int, workers);
+
+    QQmlEngine engine;
+    QQmlEnginePrivate::get(&engine)->workerScriptThreadCount = threads;
+
+    QQmlComponent component(&engine, QUrl::fromLocalFile(SRCDIR "/data/busy.qml"));
+    QList<QObject *> scripts;
+    for (int ii = 0; ii < workers; ++ii) {
+        QObject *script = component.create();
+        QVERIFY2(script, qPrintable(component.errorString()));
+        scripts << script;
+    }
+
+    QBENCHMARK {
+        QList<QSignalSpy *> spies;
+        foreach (QObject *script, scripts) {
+            spies << new QSignalSpy(script, SIGNAL(done()));
+            QMetaObject::invokeMethod(script, "run", Q_ARG(QVariant, 100000));
+        }
+        foreach (QSignalSpy *spy, spies)
+            QTRY_COMPARE_WITH_TIMEOUT(spy->count(), 1, 60000);
+        qDeleteAll(spies);
+    }
+
+    QCOMPARE(scripts.first()->property("result").toInt(), 9592);
+    qDeleteAll(scripts);
+}
+
+void tst_qquickworkerscript::message_data()
+{
+    QTest::addColumn<QString>("kind");
+    QTest::addColumn<int>("size");
+
+    const char *kinds[] = { "string", "numbers" };
+    const int sizes[] = { 1024, 64 * 1024, 1024 * 1024, 10 * 1024 * 1024 };
+    for (int ii = 0; ii < 2; ++ii) {
+        for (int jj = 0; jj < 4; ++jj) {
+            QByteArray name = QByteArray(kinds[ii]) + ' ' + QByteArray::number(sizes[jj] / 1024) + "KB";
+            QTest::newRow(name.constData()) << QString::fromLatin1(kinds[ii]) << sizes[jj];
+        }
+    }
+}
+
+// Sends a payload to a worker that echoes it straight back, so each iteration
+// covers two transfers.
+void tst_qquickworkerscript::message()
+{
+    QFETCH(QString, kind);
+    QFETCH(int, size);
+
+    QQmlEngine engine;
+    QQmlComponent component(&engine, QUrl::fromLocalFile(SRCDIR "/data/echo.qml"));
+    QScopedPointer<QObject> script(component.create());
+    QVERIFY2(script, qPrintable(component.errorString()));
+
+    QMetaObject::invokeMethod(script.data(), "build", Q_ARG(QVariant, kind), Q_ARG(QVariant, size));
+
+    QBENCHMARK {
+        QSignalSpy spy(script.data(), SIGNAL(done()));
+        QMetaObject::invokeMethod(script.data(), "send");
+        QTRY_COMPARE_WITH_TIMEOUT(spy.count(), 1, 60000);
+    }
+}
+
+QTEST_MAIN(tst_qquickworkerscript)
+
+#include "tst_qquickworkerscript.moc"
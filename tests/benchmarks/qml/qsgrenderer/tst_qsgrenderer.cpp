@@ -0,0 +1,237 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtQuick/QQuickWindow>
+#include <QtQuick/private/qquickrectangle_p.h>
+#include <QtQuick/private/qquickwindow_p.h>
+#include <QtQuick/private/qsgbatchrenderer_p.h>
+
+#include <qtest.h>
+#include <QtTest/QtTest>
+
+// Run with QT_QPA_PLATFORM=offscreen and a software GL (e.g. Mesa llvmpipe)
+// to get draw submission costs without a GPU in the way.
+
+class tst_qsgrenderer : public QObject
+{
+    Q_OBJECT
+public:
+    tst_qsgrenderer() : window(0) { }
+
+private slots:
+    void init();
+    void cleanup();
+
+    void staticScene_data();
+    void staticScene();
+    void moveItem_data();
+    void moveItem();
+    void scrollContent_data();
+    void scrollContent();
+    void addRemoveItem_data();
+    void addRemoveItem();
+    void changeColor_data();
+    void changeColor();
+
+private:
+    void createScene(bool batch, int rows = 200);
+    void reportStatistics();
+
+    QQuickWindow *window;
+    QQuickItem *content;
+    QList<QQuickRectangle *> rects;
+};
+
+void tst_qsgrenderer::init()
+{
+    window = 0;
+    content = 0;
+    rects.clear();
+}
+
+void tst_qsgrenderer::cleanup()
+{
+    delete window;
+    window = 0;
+}
+
+void tst_qsgrenderer::createScene(bool batch, int rows)
+{
+    window = new QQuickWindow;
+    window->resize(400, 400);
+    QQuickWindowPrivate::get(window)->context->setBatchRendererEnabled(batch);
+
+    // A list-like scene: rows of cells with a few different colors
+    static const QColor colors[] = { Qt::red, Qt::green, Qt::blue, Qt::gray };
+    content = new QQuickItem(window->contentItem());
+    for (int row = 0; row < rows; ++row) {
+        QQuickItem *delegate = new QQuickItem(content);
+        delegate->setY(row * 10);
+        for (int column = 0; column < 20; ++column) {
+            QQuickRectangle *r = new QQuickRectangle(delegate);
+            r->setX(column * 20);
+            r->setWidth(18);
+            r->setHeight(8);
+            r->setColor(colors[(row + column) % 4]);
+            rects << r;
+        }
+    }
+
+    window->show();
+    QVERIFY(QTest::qWaitForWindowExposed(window));
+}
+
+void tst_qsgrenderer::reportStatistics()
+{
+    QSGBatchRenderer *renderer = qobject_cast<QSGBatchRenderer *>(QQuickWindowPrivate::get(window)->renderer);
+    if (!renderer)
+        return;
+    const QSGBatchRenderer::Statistics &s = renderer->statistics();
+    qDebug("nodes=%d, batches=%d (merged=%d), draw calls=%d, uploads=%d (%d bytes)",
+           s.nodes, s.batches, s.mergedBatches, s.drawCalls, s.uploads, s.uploadedBytes);
+}
+
+void tst_qsgrenderer::staticScene_data()
+{
+    QTest::addColumn<bool>("batch");
+    QTest::newRow("default") << false;
+    QTest::newRow("batch") << true;
+}
+
+void tst_qsgrenderer::staticScene()
+{
+    QFETCH(bool, batch);
+    createScene(batch);
+
+    QBENCHMARK {
+        window->grabWindow();
+    }
+    reportStatistics();
+}
+
+void tst_qsgrenderer::moveItem_data()
+{
+    staticScene_data();
+}
+
+void tst_qsgrenderer::moveItem()
+{
+    QFETCH(bool, batch);
+    createScene(batch);
+
+    QQuickRectangle *r = rects.at(rects.size() / 2);
+    int x = 0;
+    QBENCHMARK {
+        r->setX(++x % 2 ? 1 : 0);
+        window->grabWindow();
+    }
+    reportStatistics();
+}
+
+void tst_qsgrenderer::scrollContent_data()
+{
+    staticScene_data();
+}
+
+void tst_qsgrenderer::scrollContent()
+{
+    QFETCH(bool, batch);
+    createScene(batch);
+
+    int y = 0;
+    QBENCHMARK {
+        content->setY(-(++y % 100));
+        window->grabWindow();
+    }
+    reportStatistics();
+}
+
+// Structural changes should cost the same regardless of how large the rest
+// of the scene is, as the renderer only updates its lists for the subtree
+// which changed.
+void tst_qsgrenderer::addRemoveItem_data()
+{
+    QTest::addColumn<int>("rows");
+    QTest::newRow("50 rows") << 50;
+    QTest::newRow("200 rows") << 200;
+    QTest::newRow("800 rows") << 800;
+}
+
+void tst_qsgrenderer::addRemoveItem()
+{
+    QFETCH(int, rows);
+    createScene(false, rows);
+
+    QQuickItem *parent = rects.at(rects.size() / 2)->parentItem();
+    QQuickRectangle *r = new QQuickRectangle;
+    r->setWidth(18);
+    r->setHeight(8);
+    r->setColor(Qt::yellow);
+    QBENCHMARK {
+        r->setParentItem(r->parentItem() ? 0 : parent);
+        window->grabWindow();
+    }
+    delete r;
+}
+
+void tst_qsgrenderer::changeColor_data()
+{
+    addRemoveItem_data();
+}
+
+void tst_qsgrenderer::changeColor()
+{
+    QFETCH(int, rows);
+    createScene(false, rows);
+
+    // Toggles between an opaque and a translucent color, moving the
+    // rectangle between the opaque and the transparent list.
+    QQuickRectangle *r = rects.at(rects.size() / 2);
+    int i = 0;
+    QBENCHMARK {
+        r->setColor(++i % 2 ? QColor(255, 0, 0, 128) : QColor(Qt::red));
+        window->grabWindow();
+    }
+}
+
+QTEST_MAIN(tst_qsgrenderer)
+
+#include "tst_qsgrenderer.moc"
@@ -79,6 +79,7 @@ static void showHelp()
               << "  ls         List the files in the bundle" << std::endl
               << "  cat        Concatenates files and print on the standard output" << std::endl
               << "  optimize   Insert optimization data for all recognised content" << std::endl
+              << "  index      Write a file name index for fast lookups at load time" << std::endl
               << std::endl
               << "See 'qmlbundle help <command>' for more information on a specific command." << std::endl;
 }
@@ -100,6 +101,11 @@ static void usage(const QString &action, const QString &error = QString())
         std::cerr << "usage: qmlbundle ls <bundle name>" << std::endl;
     } else if (action == QLatin1String("cat")) {
         std::cerr << "usage: qmlbundle cat <bundle name> [files]" << std::endl;
+    } else if (action == QLatin1String("index")) {
+        std::cerr << "usage: qmlbundle index <bundle name>" << std::endl
+                  << std::endl
+                  << "Rewrites the bundle with a sorted index of its files at the head." << std::endl
+                  << "Files added afterwards are still found, but without using the index." << std::endl;
     } else {
         showHelp();
     }
@@ -212,6 +218,17 @@ int main(int argc, char *argv[])
                     bundle.addMetaLink(file->fileName(), QLatin1String("qml:preparse"), preparse);
             }
         }
+    } else if (action == QLatin1String("index")) {
+        if (args.isEmpty()) {
+            usage(action, "You must specify a bundle");
+            return EXIT_FAILURE;
+        }
+        const QString bundleFileName = args.takeFirst();
+        QQmlBundle bundle(bundleFileName);
+        if (!bundle.open(QFile::ReadWrite) || !bundle.writeIndex()) {
+            std::cerr << "cannot write index to " << qPrintable(bundleFileName) << std::endl;
+            return EXIT_FAILURE;
+        }
     } else {
         showHelp();
     }
@@ -0,0 +1,241 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the tools applications of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <private/qqmlengine_p.h>
+#include <private/qqmlcompilationcache_p.h>
+#include <QtQml/qqmlengine.h>
+#include <QtQml/qqmlcomponent.h>
+#include <QtGui/QGuiApplication>
+#include <QtCore/QDir>
+#include <QtCore/QDirIterator>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <iostream>
+
+static void usage(bool showHelp = false)
+{
+    std::cerr << "Usage: qmlcachegen [options] -o <cache directory> <files or directories>" << std::endl;
+
+    if (showHelp) {
+        std::cerr << " Compiles QML documents into the cache files the engine reads when" << std::endl
+                  << " QML_COMPILATION_CACHE_DIR points at the cache directory." << std::endl
+                  << " Directories are searched recursively for .qml files." << std::endl
+                  << " The options are:" << std::endl
+                  << "  -o <dir>                write the cache files to dir" << std::endl
+                  << "  -I <dir>                add dir to the QML import path" << std::endl
+                  << "  -s <file>               write file once every document has compiled" << std::endl
+                  << "  -t --timings            report the compile time of each file" << std::endl
+                  << "  -q --quiet              only report errors" << std::endl
+                  << "  -h                      display this output" << std::endl;
+    }
+}
+
+static bool compile(QQmlEngine *engine, const QString &fileName, qint64 *elapsed)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    // Local files are loaded and compiled synchronously
+    QQmlComponent component(engine, QUrl::fromLocalFile(fileName));
+    *elapsed = timer.nsecsElapsed();
+
+    if (component.isError()) {
+        foreach (const QQmlError &error, component.errors())
+            std::cerr << qPrintable(error.toString()) << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+// Cache files are named after the source of the document, not its location
+static QString cacheFileName(const QQmlCompilationCache *cache, const QString &fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return QString();
+    return cache->fileName(QQmlCompilationCache::sourceHash(file.readAll()));
+}
+
+int main(int argc, char *argv[])
+{
+    // don't require a window manager even though we're a QGuiApplication
+    qputenv("QT_QPA_PLATFORM", QByteArrayLiteral("minimal"));
+
+    QGuiApplication app(argc, argv);
+
+    const QStringList args = app.arguments();
+
+    QString outputDir;
+    QString stampFile;
+    QStringList importPaths;
+    QStringList inputs;
+    bool timings = false;
+    bool quiet = false;
+
+    int index = 1;
+    while (index < args.size()) {
+        const QString arg = args.at(index++);
+        const QString next = index < args.size() ? args.at(index) : QString();
+
+        if (arg == QLatin1String("-h") || arg == QLatin1String("--help")) {
+            usage(/*showHelp*/ true);
+            return 0;
+        } else if (arg == QLatin1String("-t") || arg == QLatin1String("--timings")) {
+            timings = true;
+        } else if (arg == QLatin1String("-q") || arg == QLatin1String("--quiet")) {
+            quiet = true;
+        } else if (arg == QLatin1String("-o") || arg == QLatin1String("-I") || arg == QLatin1String("-s")) {
+            if (next.isEmpty()) {
+                std::cerr << "qmlcachegen: argument to '" << qPrintable(arg) << "' is missing" << std::endl;
+                return EXIT_FAILURE;
+            }
+            if (arg == QLatin1String("-o"))
+                outputDir = next;
+            else if (arg == QLatin1String("-s"))
+                stampFile = next;
+            else
+                importPaths.append(next);
+            ++index; // consume the next argument
+        } else if (arg.startsWith(QLatin1Char('-'))) {
+            usage(/*show help*/ true);
+            std::cerr << "qmlcachegen: invalid option '" << qPrintable(arg) << "'" << std::endl;
+            return EXIT_FAILURE;
+        } else {
+            inputs.append(arg);
+        }
+    }
+
+    if (outputDir.isEmpty() || inputs.isEmpty()) {
+        usage();
+        return outputDir.isEmpty() && inputs.isEmpty() ? 0 : EXIT_FAILURE;
+    }
+
+    // A stale stamp would let the build skip a run that failed
+    if (!stampFile.isEmpty())
+        QFile::remove(stampFile);
+
+    QStringList fileNames;
+    foreach (const QString &input, inputs) {
+        QFileInfo info(input);
+        if (info.isDir()) {
+            QStringList dirFiles;
+            QDirIterator it(info.absoluteFilePath(), QStringList() << QLatin1String("*.qml"),
+                            QDir::Files, QDirIterator::Subdirectories);
+            while (it.hasNext())
+                dirFiles.append(it.next());
+            dirFiles.sort();
+            fileNames += dirFiles;
+        } else if (info.isFile()) {
+            fileNames.append(info.absoluteFilePath());
+        } else {
+            std::cerr << "qmlcachegen: '" << qPrintable(input) << "' no such file or directory" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    fileNames.removeDuplicates();
+
+    QQmlEngine engine;
+    foreach (const QString &path, importPaths)
+        engine.addImportPath(QDir(path).absolutePath());
+
+    QQmlTypeLoader &typeLoader = QQmlEnginePrivate::get(&engine)->typeLoader;
+    typeLoader.setCompilationCachePath(QDir(outputDir).absolutePath());
+    QQmlCompilationCache *cache = typeLoader.compilationCache();
+
+    // Stale files would hide documents that can no longer be cached
+    foreach (const QString &fileName, fileNames)
+        QFile::remove(cacheFileName(cache, fileName));
+
+    bool ok = true;
+    QHash<QString, qint64> elapsed;
+    foreach (const QString &fileName, fileNames) {
+        if (!compile(&engine, fileName, &elapsed[fileName]))
+            ok = false;
+    }
+
+    if (!ok) {
+        std::cerr << "qmlcachegen: compilation failed" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if (timings) {
+        // A document is compiled by the first file that uses it, so compile each file on its
+        // own again.  Its dependencies are now loaded from the cache, which is cheap.
+        foreach (const QString &fileName, fileNames) {
+            engine.clearComponentCache();
+            QFile::remove(cacheFileName(cache, fileName));
+            if (!compile(&engine, fileName, &elapsed[fileName]))
+                return EXIT_FAILURE;
+        }
+    }
+
+    int cached = 0;
+    foreach (const QString &fileName, fileNames) {
+        bool isCached = QFile::exists(cacheFileName(cache, fileName));
+        if (isCached)
+            ++cached;
+        if (timings) {
+            std::cout << qPrintable(QString::number(elapsed.value(fileName) / 1000000.0, 'f', 2))
+                      << " ms\t" << qPrintable(fileName)
+                      << (isCached ? "" : " (not cached)") << std::endl;
+        } else if (!isCached && !quiet) {
+            std::cerr << "qmlcachegen: warning: '" << qPrintable(fileName) << "' cannot be cached" << std::endl;
+        }
+    }
+
+    if (!quiet) {
+        std::cout << "qmlcachegen: cached " << cached << " of " << fileNames.count()
+                  << " files in " << qPrintable(QDir::toNativeSeparators(cache->path())) << std::endl;
+    }
+
+    if (!stampFile.isEmpty()) {
+        QFile stamp(stampFile);
+        if (!stamp.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            std::cerr << "qmlcachegen: cannot write '" << qPrintable(stampFile) << "'" << std::endl;
+            return EXIT_FAILURE;
+        }
+        stamp.write(QByteArray::number(cached) + '\n');
+    }
+
+    return 0;
+}
@@ -0,0 +1,14 @@
+QT       = core gui qml qml-private core-private
+
+CONFIG += qpa_minimal_plugin
+
+SOURCES += main.cpp
+
+OTHER_FILES += qmlcache.prf
+
+# The feature file lets projects precompile their QML with CONFIG += qmlcache
+qmlcacheprf.files = qmlcache.prf
+qmlcacheprf.path = $$[QT_HOST_DATA]/mkspecs/features
+INSTALLS += qmlcacheprf
+
+load(qt_tool)
@@ -1,6 +1,7 @@
 TEMPLATE = subdirs
 qtHaveModule(quick): SUBDIRS += qmlscene qmlplugindump
 qtHaveModule(qmltest): SUBDIRS += qmltestrunner
+qtHaveModule(gui): SUBDIRS += qmlcachegen
 SUBDIRS += \
     qmlmin \
     qmlprofiler \
@@ -8,6 +9,9 @@ SUBDIRS += \
 qtHaveModule(quick):qtHaveModule(widgets): SUBDIRS += qmleasing
 
 # qmlmin & qmlbundle are build tools.
+# qmlcachegen is a build tool too, but its output is only valid for the
+# engine build that runs it, so it is built for the target and only run
+# by qmlcache.prf in native builds.
 # qmlscene is needed by the autotests.
 # qmltestrunner may be useful for manual testing.
 # qmlplugindump cannot be a build tool, because it loads target plugins.